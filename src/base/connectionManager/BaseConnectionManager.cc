@@ -1,6 +1,8 @@
 #include "BaseConnectionManager.h"
 
 #include <cassert>
+#include <algorithm>
+#include <cmath>
 
 #include "NicEntryDebug.h"
 #include "NicEntryDirect.h"
@@ -14,6 +16,9 @@
 static const NicEntryDirect cEmptyNicDirect(false);
 static const NicEntryDebug  cEmptyNicDebug(false);
 
+/** @brief Number of distances to the nics of a flat grid cell calculated at once.*/
+static const size_t DISTANCE_BLOCK = 64;
+
 BaseConnectionManager::BaseConnectionManager()
   : cSimpleModule()
   , nics()
@@ -25,6 +30,13 @@ BaseConnectionManager::BaseConnectionManager()
   , useTorus(false)
   , drawMIR(false)
   , nicGrid()
+  , gridType(GRID_MAP)
+  , updateHysteresis(0.0)
+  , batchPositionUpdates(false)
+  , pendingPositions()
+  , flushTimer(NULL)
+  , updateThreads(0)
+  , flatGrid()
   , findDistance()
   , gridDim()
 {}
@@ -58,6 +70,34 @@ void BaseConnectionManager::initialize(int stage)
 		else
 			sendDirect = false;
 
+		std::string gridTypeName = hasPar("gridType")
+									? par("gridType").stringValue() : "map";
+		if(gridTypeName == "map")
+			gridType = GRID_MAP;
+		else if(gridTypeName == "flat")
+			gridType = GRID_FLAT;
+		else
+			error("Unknown gridType \"%s\", use \"map\" or \"flat\".",
+				  gridTypeName.c_str());
+
+		updateHysteresis = hasPar("updateHysteresis")
+							? par("updateHysteresis").doubleValue() : 0.0;
+
+		batchPositionUpdates = hasPar("batchPositionUpdates")
+								? par("batchPositionUpdates").boolValue() : false;
+		if(batchPositionUpdates)
+			flushTimer = new cMessage("flushPositionUpdates");
+
+		updateThreads = hasPar("updateThreads") ? par("updateThreads").longValue() : 0;
+		if(updateThreads < 0)
+			error("Parameter updateThreads has to be >= 0.");
+#ifndef _OPENMP
+		if(updateThreads > 0) {
+			opp_warning("MiXiM was compiled without OpenMP support (make MIXIM_OPENMP=yes), connections are updated by the main thread only.");
+			updateThreads = 0;
+		}
+#endif
+
 		maxInterferenceDistance = calcInterfDist();
 		maxDistSquared = maxInterferenceDistance * maxInterferenceDistance;
 
@@ -84,29 +124,34 @@ void BaseConnectionManager::initialize(int stage)
 		}
 
 		//step 2 - initialize the matrix which represents our grid
-		NicEntries entries;
-		RowVector row;
-		NicMatrix matrix;
+		if(gridType == GRID_FLAT) {
+			flatGrid.resize(gridDim.x, gridDim.y, gridDim.z);
+		} else {
+			NicEntries entries;
+			RowVector row;
+			NicMatrix matrix;
 
-		for (int i = 0; i < gridDim.z; ++i) {
-			row.push_back(entries);			//copy empty NicEntries to RowVector
-		}
-		for (int i = 0; i < gridDim.y; ++i) {//fill the ColVector with copies of
-			matrix.push_back(row);			 //the RowVector.
-		}
-		for (int i = 0; i < gridDim.x; ++i) {	//fill the grid with copies of
-			nicGrid.push_back(matrix);			//the matrix.
+			for (int i = 0; i < gridDim.z; ++i) {
+				row.push_back(entries);			//copy empty NicEntries to RowVector
+			}
+			for (int i = 0; i < gridDim.y; ++i) {//fill the ColVector with copies of
+				matrix.push_back(row);			 //the RowVector.
+			}
+			for (int i = 0; i < gridDim.x; ++i) {	//fill the grid with copies of
+				nicGrid.push_back(matrix);			//the matrix.
+			}
 		}
 		ccEV << " using " << gridDim.x << "x" <<
 							 gridDim.y << "x" <<
-							 gridDim.z << " grid" << endl;
+							 gridDim.z << (gridType == GRID_FLAT ? " flat" : "")
+			 << " grid" << endl;
 
 		//step 3 -	calculate the factor which maps the coordinate of a node
 		//			to the grid cell
 		//if we use a 1x1 grid every coordinate is mapped to (0,0, 0)
-		findDistance = Coord(std::max(playgroundSize->x, maxInterferenceDistance),
-							 std::max(playgroundSize->y, maxInterferenceDistance),
-							 std::max(playgroundSize->z, maxInterferenceDistance));
+		findDistance = PlainCoord(std::max(playgroundSize->x, maxInterferenceDistance),
+								  std::max(playgroundSize->y, maxInterferenceDistance),
+								  std::max(playgroundSize->z, maxInterferenceDistance));
 		//otherwise we divide the playground into cells of size of the maximum
 		//interference distance
 		if (gridDim.x != 1)
@@ -121,7 +166,7 @@ void BaseConnectionManager::initialize(int stage)
 		//(the last) grid cell we do this by increasing the find distance
 		//by a small value.
 		//This also assures that findDistance is never zero.
-		findDistance += Coord(EPSILON, EPSILON, EPSILON);
+		findDistance = findDistance + PlainCoord(EPSILON, EPSILON, EPSILON);
 
 		//findDistance (equals cell size) has to be greater or equal
 		//maxInt-distance
@@ -133,7 +178,7 @@ void BaseConnectionManager::initialize(int stage)
 		assert(GridCoord(*playgroundSize, findDistance).x == gridDim.x - 1);
 		assert(GridCoord(*playgroundSize, findDistance).y == gridDim.y - 1);
 		assert(GridCoord(*playgroundSize, findDistance).z == gridDim.z - 1);
-		ccEV << "findDistance is " << findDistance.info() << endl;
+		ccEV << "findDistance is " << findDistance << endl;
 	}
 	else if (stage == 1)
 	{
@@ -142,7 +187,7 @@ void BaseConnectionManager::initialize(int stage)
 }
 
 BaseConnectionManager::GridCoord BaseConnectionManager
-	::getCellForCoordinate(const Coord& c) const
+	::getCellForCoordinate(const PlainCoord& c) const
 {
     return GridCoord(c, findDistance);
 }
@@ -172,8 +217,12 @@ void BaseConnectionManager::registerNicExt(NicEntry::t_nicid_cref nicID)
 	ccEV <<" registering (ext) nic at loc " << cell.info() << std::endl;
 
 	// add to matrix
-	NicEntries& cellEntries = getCellEntries(cell);
-    cellEntries[nicID] = nicEntry;
+	if(gridType == GRID_FLAT) {
+		flatGrid.getCell(getFlatIndex(cell)).insert(nicEntry);
+	} else {
+		NicEntries& cellEntries = getCellEntries(cell);
+		cellEntries[nicID] = nicEntry;
+	}
 }
 
 void BaseConnectionManager::checkGrid(BaseConnectionManager::GridCoord& oldCell,
@@ -185,18 +234,71 @@ void BaseConnectionManager::checkGrid(BaseConnectionManager::GridCoord& oldCell,
     // structure to find union of grid squares
     CoordSet gridUnion(74);
 
-    // find nic at old position
-    NicEntries&             oldCellEntries = getCellEntries(oldCell);
-    NicEntries::iterator    it  = oldCellEntries.find(id);
-    NicEntries::mapped_type nic = it->second;
+    NicEntries::mapped_type nic = moveInGrid(id, oldCell, newCell);
+
+    if(updateHysteresis > 0) {
+    	// a nic which stays in its cell can only get into range of nics in
+    	// the surrounding cells, so the hysteresis is only used then
+    	if(oldCell == newCell && nic->safeRadius >= 0) {
+    		const double moved = nic->pos.distance(nic->scanPos);
+
+    		// no connection of the nic can have changed
+    		if(moved < nic->safeRadius)
+    			return;
+
+    		// only connections to the boundary nics can have changed
+    		if(moved < updateHysteresis) {
+    			updateBoundaryConnections(nic, moved);
+    			return;
+    		}
+    	}
+    	clearBoundaryNics(nic);
+    	nic->scanPos    = nic->pos;
+    	nic->safeRadius = updateHysteresis;
+    }
+
+    fillUnionForMove(gridUnion, oldCell, newCell);
 
+    GridCoord* c = gridUnion.next();
+    while(c != 0) {
+		ccEV << "Update cons in [" << c->info() << "]" << endl;
+		if(gridType == GRID_FLAT)
+			updateNicConnections(flatGrid.getCell(getFlatIndex(*c)), nic);
+		else
+			updateNicConnections(getCellEntries(*c), nic);
+		c = gridUnion.next();
+    }
+}
 
-    // move nic to a new position in matrix
-    if(oldCell != newCell) {
-    	oldCellEntries.erase(it);
-    	getCellEntries(newCell)[id] = nic;
+BaseConnectionManager::NicEntries::mapped_type BaseConnectionManager::moveInGrid(NicEntry::t_nicid_cref id,
+                                                                                 const GridCoord&       oldCell,
+                                                                                 const GridCoord&       newCell)
+{
+    if(gridType == GRID_FLAT) {
+    	NicEntries::mapped_type nic = nics[id];
+    	// move nic to a new position in the flat grid, this also updates
+    	// the stored position if the cell did not change
+    	flatGrid.move(getFlatIndex(oldCell), getFlatIndex(newCell), nic);
+    	return nic;
     }
 
+	// find nic at old position
+	NicEntries&             oldCellEntries = getCellEntries(oldCell);
+	NicEntries::iterator    it             = oldCellEntries.find(id);
+	NicEntries::mapped_type nic            = it->second;
+
+	// move nic to a new position in matrix
+	if(oldCell != newCell) {
+		oldCellEntries.erase(it);
+		getCellEntries(newCell)[id] = nic;
+	}
+	return nic;
+}
+
+void BaseConnectionManager::fillUnionForMove(CoordSet&        gridUnion,
+                                             const GridCoord& oldCell,
+                                             const GridCoord& newCell) const
+{
 	if((gridDim.x == 1) && (gridDim.y == 1) && (gridDim.z == 1)) {
 		gridUnion.add(oldCell);
     } else {
@@ -209,13 +311,6 @@ void BaseConnectionManager::checkGrid(BaseConnectionManager::GridCoord& oldCell,
             fillUnionWithNeighbors(gridUnion, newCell);
         }
     }
-
-    GridCoord* c = gridUnion.next();
-    while(c != 0) {
-		ccEV << "Update cons in [" << c->info() << "]" << endl;
-		updateNicConnections(getCellEntries(*c), nic);
-		c = gridUnion.next();
-    }
 }
 
 int BaseConnectionManager::wrapIfTorus(int value, int max) const {
@@ -259,6 +354,11 @@ void BaseConnectionManager::fillUnionWithNeighbors(CoordSet&        gridUnion,
 	}
 }
 
+bool BaseConnectionManager::isInRange(BaseConnectionManager::NicEntries::mapped_type /*pFromNic*/, BaseConnectionManager::NicEntries::mapped_type /*pToNic*/, double dSqrDistance)
+{
+    return (dSqrDistance <= maxDistSquared);
+}
+
 bool BaseConnectionManager::isInRange(BaseConnectionManager::NicEntries::mapped_type pFromNic, BaseConnectionManager::NicEntries::mapped_type pToNic)
 {
 	double dDistance = 0.0;
@@ -268,10 +368,12 @@ bool BaseConnectionManager::isInRange(BaseConnectionManager::NicEntries::mapped_
     } else {
     	dDistance = pFromNic->pos.sqrdist(pToNic->pos);
     }
-    return (dDistance <= maxDistSquared);
+    return isInRange(pFromNic, pToNic, dDistance);
 }
 
-void BaseConnectionManager::updateNicConnections(NicEntries& nmap, BaseConnectionManager::NicEntries::mapped_type   nic)
+void BaseConnectionManager::updateNicConnections(NicEntries&                           nmap,
+                                                 NicEntries::mapped_type               nic,
+                                                 const std::vector<NicEntry::t_nicid>* skipIds)
 {
     NicEntry::t_nicid_cref id = nic->nicId;
 
@@ -281,28 +383,181 @@ void BaseConnectionManager::updateNicConnections(NicEntries& nmap, BaseConnectio
         // no recursive connections
         if ( nic_i->nicId == id ) continue;
 
-        bool inRange   = isInRange(nic, nic_i);
-        bool connected = nic->isConnected(nic_i);
+        // pair has already been checked
+        if ( skipIds && nic_i->nicId < id
+             && std::binary_search(skipIds->begin(), skipIds->end(), nic_i->nicId) ) continue;
 
-        if ( inRange && !connected ) {
-            // nodes within communication range: connect
-            // nodes within communication range && not yet connected
-            ccEV << "nic #" << id << " and #" << nic_i->nicId
-            	 << " are in range" << endl;
-            nic->connectTo( nic_i );
-            nic_i->connectTo( nic );
-        }
-        else if ( !inRange && connected ) {
-            // out of range: disconnect
-            // out of range, and still connected
-            ccEV << "nic #" << id << " and #" << nic_i->nicId
-            	 << " are NOT in range" << endl;
-            nic->disconnectFrom( nic_i );
-            nic_i->disconnectFrom( nic );
+        updatePairConnection(nic, nic_i, isInRange(nic, nic_i));
+
+        if(updateHysteresis > 0)
+        	trackBoundary(nic, nic_i);
+    }
+}
+
+void BaseConnectionManager::updateNicConnections(const FlatNicGrid::Cell&             cell,
+                                                 NicEntries::mapped_type               nic,
+                                                 const std::vector<NicEntry::t_nicid>* skipIds)
+{
+    NicEntry::t_nicid_cref id        = nic->nicId;
+    const size_t           n         = cell.size();
+    const PlainCoord       torusSize = useTorus ? PlainCoord(*playgroundSize) : PlainCoord();
+    double                 dDistances[DISTANCE_BLOCK];
+
+    for(size_t block = 0; block < n; block += DISTANCE_BLOCK) {
+        const size_t count = std::min<size_t>(n - block, DISTANCE_BLOCK);
+        cell.sqrdists(block, count, nic->pos, useTorus ? &torusSize : NULL, dDistances);
+
+        for(size_t i = block; i < block + count; ++i) {
+            // no recursive connections
+            if ( cell.ids[i] == id ) continue;
+
+            // pair has already been checked
+            if ( skipIds && cell.ids[i] < id
+                 && std::binary_search(skipIds->begin(), skipIds->end(), cell.ids[i]) ) continue;
+
+            NicEntries::mapped_type nic_i = cell.nics[i];
+            updatePairConnection(nic, nic_i, isInRange(nic, nic_i, dDistances[i - block]));
+
+            if(updateHysteresis > 0)
+            	trackBoundary(nic, nic_i);
         }
     }
 }
 
+double BaseConnectionManager::nicDistance(const PlainCoord& a, const PlainCoord& b) const
+{
+	if(useTorus)
+		return sqrt(a.sqrTorusDist(b, *playgroundSize));
+	return a.distance(b);
+}
+
+/**
+ * Two nics which stay within "moved" of their scan positions can only change
+ * their connection if the sum of their moved distances exceeds the margin
+ * between the distance of their scan positions and the interference
+ * distance. Every pair with a margin of at most twice the hysteresis is
+ * therefore stored as boundary pair and the margin is split between the
+ * safe radii of both nics. Since "nic" is at its scan position, "other" may
+ * use half of the margin while "nic" has to leave room for the distance
+ * "other" already moved.
+ */
+void BaseConnectionManager::trackBoundary(BaseConnectionManager::NicEntries::mapped_type nic,
+                                          BaseConnectionManager::NicEntries::mapped_type other)
+{
+	const double margin = fabs(nicDistance(nic->scanPos, other->scanPos) - maxInterferenceDistance);
+	if(margin > 2 * updateHysteresis)
+		return;
+
+	const double otherMoved = other->pos.distance(other->scanPos);
+	nic->safeRadius   = std::min(nic->safeRadius, std::min(margin / 2, margin - otherMoved));
+	other->safeRadius = std::min(other->safeRadius, margin / 2);
+
+	std::vector<NicEntry*>::iterator it;
+	it = std::lower_bound(nic->boundaryNics.begin(), nic->boundaryNics.end(),
+	                      other, NicEntry::NicEntryComparator());
+	if(it == nic->boundaryNics.end() || *it != other)
+		nic->boundaryNics.insert(it, other);
+
+	it = std::lower_bound(other->boundaryNics.begin(), other->boundaryNics.end(),
+	                      nic, NicEntry::NicEntryComparator());
+	if(it == other->boundaryNics.end() || *it != nic)
+		other->boundaryNics.insert(it, nic);
+}
+
+void BaseConnectionManager::updateBoundaryConnections(BaseConnectionManager::NicEntries::mapped_type nic,
+                                                      double                                         moved)
+{
+	ccEV << "Update cons of nic #" << nic->nicId << " to "
+		 << nic->boundaryNics.size() << " boundary nics" << endl;
+
+	for(std::vector<NicEntry*>::const_iterator it = nic->boundaryNics.begin();
+		it != nic->boundaryNics.end(); ++it)
+	{
+		NicEntries::mapped_type other = *it;
+
+		updatePairConnection(nic, other, isInRange(nic, other));
+
+		// "other" has to leave room for the distance "nic" moved, a negative
+		// safe radius forces a complete update at its next move
+		const double margin = fabs(nicDistance(nic->scanPos, other->scanPos) - maxInterferenceDistance);
+		other->safeRadius = std::min(other->safeRadius, margin - moved);
+	}
+
+	// the connections may differ from the ones at "scanPos" now, so moving
+	// back towards it has to re-check the boundary nics as well
+	nic->safeRadius = std::min(nic->safeRadius, 0.0);
+}
+
+void BaseConnectionManager::clearBoundaryNics(BaseConnectionManager::NicEntries::mapped_type nic)
+{
+	for(std::vector<NicEntry*>::const_iterator it = nic->boundaryNics.begin();
+		it != nic->boundaryNics.end(); ++it)
+	{
+		std::vector<NicEntry*>&          others = (*it)->boundaryNics;
+		std::vector<NicEntry*>::iterator pos    = std::lower_bound(others.begin(), others.end(),
+		                                                           nic, NicEntry::NicEntryComparator());
+		if(pos != others.end() && *pos == nic)
+			others.erase(pos);
+	}
+	nic->boundaryNics.clear();
+}
+
+void BaseConnectionManager::updatePairConnection(BaseConnectionManager::NicEntries::mapped_type nic,
+                                                 BaseConnectionManager::NicEntries::mapped_type nic_i,
+                                                 bool                                           inRange)
+{
+    bool connected = nic->isConnected(nic_i);
+
+    if ( inRange && !connected ) {
+        // nodes within communication range: connect
+        // nodes within communication range && not yet connected
+        ccEV << "nic #" << nic->nicId << " and #" << nic_i->nicId
+             << " are in range" << endl;
+        nic->connectTo( nic_i );
+        nic_i->connectTo( nic );
+    }
+    else if ( !inRange && connected ) {
+        // out of range: disconnect
+        // out of range, and still connected
+        ccEV << "nic #" << nic->nicId << " and #" << nic_i->nicId
+             << " are NOT in range" << endl;
+        nic->disconnectFrom( nic_i );
+        nic_i->disconnectFrom( nic );
+    }
+}
+
+void BaseConnectionManager::disconnectFromCell(const GridCoord& cell, BaseConnectionManager::NicEntries::mapped_type nicEntry)
+{
+	if(gridType == GRID_FLAT) {
+		const FlatNicGrid::Cell& cellEntries = flatGrid.getCell(getFlatIndex(cell));
+		for(size_t i = 0; i < cellEntries.size(); ++i) {
+			NicEntries::mapped_type other = cellEntries.nics[i];
+			if (other == nicEntry)
+				continue;
+			if (other->isConnected(nicEntry)) {
+				other->disconnectFrom(nicEntry);
+			}
+			if (nicEntry->isConnected(other)) {
+				nicEntry->disconnectFrom(other);
+			}
+		}
+		return;
+	}
+
+	NicEntries& nmap = getCellEntries(cell);
+	for(NicEntries::iterator i = nmap.begin(); i != nmap.end(); ++i) {
+		NicEntries::mapped_type other = i->second;
+		if (other == nicEntry)
+			continue;
+		if (other->isConnected(nicEntry)) {
+			other->disconnectFrom(nicEntry);
+		}
+		if (nicEntry->isConnected(other)) {
+			nicEntry->disconnectFrom(other);
+		}
+	}
+}
+
 bool BaseConnectionManager::registerNic(cModule*                 nic,
                                         ConnectionManagerAccess* chAccess,
                                         const Coord*             nicPos)
@@ -312,6 +567,8 @@ bool BaseConnectionManager::registerNic(cModule*                 nic,
 	const NicEntry::t_nicid nicID = nic->getId();
 	ccEV << " registering nic #" << nicID << endl;
 
+	flushPositionUpdates();
+
 	// create new NicEntry
 	NicEntries::mapped_type nicEntry;
 	cModule *const          pHostModule = FindModule<>::findHost(nic);
@@ -348,6 +605,8 @@ bool BaseConnectionManager::unregisterNic(cModule* nicModule)
 {
 	assert(nicModule != 0);
 
+	flushPositionUpdates();
+
 	// find nicEntry
 	const NicEntry::t_nicid nicID      = nicModule->getId();
 	NicEntries::iterator    nicEntryIt = nics.find(nicID);
@@ -373,24 +632,19 @@ bool BaseConnectionManager::unregisterNic(cModule* nicModule)
 	GridCoord* c = gridUnion.next();
 	while(c != 0) {
 		ccEV << "Update cons in [" << c->info() << "]" << endl;
-		NicEntries& nmap = getCellEntries(*c);
-		for(NicEntries::iterator i = nmap.begin(); i != nmap.end(); ++i) {
-			NicEntries::mapped_type other = i->second;
-			if (other == nicEntry)
-				continue;
-			if (other->isConnected(nicEntry)) {
-				other->disconnectFrom(nicEntry);
-			}
-			if (nicEntry->isConnected(other)) {
-				nicEntry->disconnectFrom(other);
-			}
-		}
+		disconnectFromCell(*c, nicEntry);
 		c = gridUnion.next();
 	}
 
 	// erase from grid
-	NicEntries& cellEntries = getCellEntries(cell);
-	cellEntries.erase(nicID);
+	if(gridType == GRID_FLAT) {
+		flatGrid.getCell(getFlatIndex(cell)).erase(nicID);
+	} else {
+		NicEntries& cellEntries = getCellEntries(cell);
+		cellEntries.erase(nicID);
+	}
+
+	clearBoundaryNics(nicEntry);
 
 	unregisterNicExt(nicID);
 
@@ -406,19 +660,235 @@ void BaseConnectionManager::unregisterNicExt(NicEntry::t_nicid_cref nicID)
 	(void)nicID;
 }
 
+void BaseConnectionManager::handleMessage(cMessage* msg)
+{
+	if(msg == flushTimer) {
+		flushPositionUpdates();
+	} else {
+		error("BaseConnectionManager does not handle messages of type %s.", msg->getClassName());
+	}
+}
+
 void BaseConnectionManager::updateNicPos(NicEntry::t_nicid_cref nicID, const Coord* newPos)
 {
+	if(batchPositionUpdates) {
+		Enter_Method_Silent();
+
+		// the updates of all nics moving at the same time are applied at
+		// once after the moves
+		pendingPositions[nicID] = *newPos;
+		if(!flushTimer->isScheduled())
+			scheduleAt(simTime(), flushTimer);
+		return;
+	}
+
 	NicEntries::iterator ItNic = nics.find(nicID);
 	if (ItNic == nics.end()) {
 		opp_warning("No nic with this ID (%d) is registered with this ConnectionManager, no position update done.", nicID);
 		return;
 	}
-	Coord oldPos = ItNic->second->pos;
+	const Coord oldPos = ItNic->second->pos.toCoord();
 	ItNic->second->pos = *newPos;
 
 	updateConnections(nicID, &oldPos, newPos);
 }
 
+void BaseConnectionManager::flushPositionUpdates()
+{
+	if(pendingPositions.empty())
+		return;
+
+	Enter_Method_Silent();
+
+	NicPositions positions;
+	positions.reserve(pendingPositions.size());
+	for(std::map<NicEntry::t_nicid, PlainCoord>::const_iterator it = pendingPositions.begin();
+		it != pendingPositions.end(); ++it)
+	{
+		positions.push_back(NicPosition(it->first, it->second));
+	}
+	pendingPositions.clear();
+	if(flushTimer->isScheduled())
+		cancelEvent(flushTimer);
+
+	updateNicPositions(positions);
+}
+
+void BaseConnectionManager::updateNicPositions(const NicPositions& positions)
+{
+	if(updateHysteresis > 0) {
+		// the safe radii assume that only one nic moves at a time
+		for(NicPositions::const_iterator it = positions.begin(); it != positions.end(); ++it) {
+			NicEntries::iterator ItNic = nics.find(it->nicId);
+			if (ItNic == nics.end()) {
+				opp_warning("No nic with this ID (%d) is registered with this ConnectionManager, no position update done.", it->nicId);
+				continue;
+			}
+			const Coord oldPos = ItNic->second->pos.toCoord();
+			const Coord newPos = it->pos.toCoord();
+			ItNic->second->pos = it->pos;
+
+			updateConnections(it->nicId, &oldPos, &newPos);
+		}
+		return;
+	}
+
+	// step 1 - store the new positions and move the nics inside the grid,
+	// for nics moved more than once the first old and the last new cell
+	// are used
+	typedef std::map<NicEntry::t_nicid, std::pair<GridCoord, GridCoord> > MovedNics;
+	MovedNics moved;
+
+	for(NicPositions::const_iterator it = positions.begin(); it != positions.end(); ++it) {
+		NicEntries::iterator ItNic = nics.find(it->nicId);
+		if (ItNic == nics.end()) {
+			opp_warning("No nic with this ID (%d) is registered with this ConnectionManager, no position update done.", it->nicId);
+			continue;
+		}
+		NicEntries::mapped_type nic     = ItNic->second;
+		const GridCoord         oldCell = getCellForCoordinate(nic->pos);
+
+		nic->pos = it->pos;
+		const GridCoord newCell = getCellForCoordinate(nic->pos);
+		moveInGrid(it->nicId, oldCell, newCell);
+
+		MovedNics::iterator m = moved.find(it->nicId);
+		if(m == moved.end())
+			moved.insert(std::make_pair(it->nicId, std::make_pair(oldCell, newCell)));
+		else
+			m->second.second = newCell;
+	}
+
+	// step 2 - update the connections of every moved nic in order of their
+	// ids, pairs of moved nics are only checked by the nic with the
+	// smaller id
+	std::vector<NicEntry::t_nicid> movedIds;
+	movedIds.reserve(moved.size());
+	for(MovedNics::const_iterator m = moved.begin(); m != moved.end(); ++m) {
+		movedIds.push_back(m->first);
+	}
+
+	std::vector<NicEntries::mapped_type> movedNics;
+	std::vector<GridCoord>               oldCells;
+	std::vector<GridCoord>               newCells;
+	movedNics.reserve(moved.size());
+	oldCells.reserve(moved.size());
+	newCells.reserve(moved.size());
+	for(MovedNics::const_iterator m = moved.begin(); m != moved.end(); ++m) {
+		movedNics.push_back(nics[m->first]);
+		oldCells.push_back(m->second.first);
+		newCells.push_back(m->second.second);
+	}
+
+	if(updateThreads > 0 && movedNics.size() > 1) {
+		// the in range decisions only depend on the (already updated)
+		// positions, so they are calculated in parallel and applied
+		// afterwards in exactly the order of the serial update
+		std::vector<PairUpdates> updates(movedNics.size());
+		const int                numMoved = static_cast<int>(movedNics.size());
+
+#ifdef _OPENMP
+		#pragma omp parallel for num_threads(updateThreads) schedule(dynamic, 16)
+#endif
+		for(int i = 0; i < numMoved; ++i) {
+			collectNicConnections(movedNics[i], oldCells[i], newCells[i], movedIds, updates[i]);
+		}
+
+		for(size_t i = 0; i < movedNics.size(); ++i) {
+			updateMovedPeerConnections(movedNics[i], movedIds);
+
+			const PairUpdates& u = updates[i];
+			for(PairUpdates::const_iterator it = u.begin(); it != u.end(); ++it) {
+				updatePairConnection(movedNics[i], it->first, it->second);
+			}
+		}
+		return;
+	}
+
+	for(size_t i = 0; i < movedNics.size(); ++i) {
+		NicEntries::mapped_type nic = movedNics[i];
+
+		updateMovedPeerConnections(nic, movedIds);
+
+		CoordSet gridUnion(74);
+		fillUnionForMove(gridUnion, oldCells[i], newCells[i]);
+
+		GridCoord* c = gridUnion.next();
+		while(c != 0) {
+			if(gridType == GRID_FLAT)
+				updateNicConnections(flatGrid.getCell(getFlatIndex(*c)), nic, &movedIds);
+			else
+				updateNicConnections(getCellEntries(*c), nic, &movedIds);
+			c = gridUnion.next();
+		}
+	}
+}
+
+void BaseConnectionManager::updateMovedPeerConnections(NicEntries::mapped_type               nic,
+                                                       const std::vector<NicEntry::t_nicid>& movedIds)
+{
+	// two moved nics may have left each others neighborhood, so their
+	// existing connection is checked directly
+	std::vector<NicEntries::mapped_type> movedPeers;
+	const NicEntry::GateList& conns = nic->getGateList();
+	for(NicEntry::GateList::const_iterator g = conns.begin(); g != conns.end(); ++g) {
+		if(g->first->nicId > nic->nicId
+		   && std::binary_search(movedIds.begin(), movedIds.end(), g->first->nicId))
+		{
+			movedPeers.push_back(nics[g->first->nicId]);
+		}
+	}
+	for(size_t i = 0; i < movedPeers.size(); ++i) {
+		updatePairConnection(nic, movedPeers[i], isInRange(nic, movedPeers[i]));
+	}
+}
+
+void BaseConnectionManager::collectNicConnections(NicEntries::mapped_type               nic,
+                                                  const GridCoord&                      oldCell,
+                                                  const GridCoord&                      newCell,
+                                                  const std::vector<NicEntry::t_nicid>& movedIds,
+                                                  PairUpdates&                          updates)
+{
+	NicEntry::t_nicid_cref id        = nic->nicId;
+	const PlainCoord       torusSize = useTorus ? PlainCoord(*playgroundSize) : PlainCoord();
+	double                 dDistances[DISTANCE_BLOCK];
+
+	CoordSet gridUnion(74);
+	fillUnionForMove(gridUnion, oldCell, newCell);
+
+	// has to visit the nics in the same order as "updateNicConnections()"
+	GridCoord* c = gridUnion.next();
+	while(c != 0) {
+		if(gridType == GRID_FLAT) {
+			const FlatNicGrid::Cell& cell = flatGrid.getCell(getFlatIndex(*c));
+			for(size_t block = 0; block < cell.size(); block += DISTANCE_BLOCK) {
+				const size_t count = std::min<size_t>(cell.size() - block, DISTANCE_BLOCK);
+				cell.sqrdists(block, count, nic->pos, useTorus ? &torusSize : NULL, dDistances);
+
+				for(size_t i = block; i < block + count; ++i) {
+					if ( cell.ids[i] == id ) continue;
+					if ( cell.ids[i] < id
+						 && std::binary_search(movedIds.begin(), movedIds.end(), cell.ids[i]) ) continue;
+
+					NicEntries::mapped_type nic_i = cell.nics[i];
+					updates.push_back(std::make_pair(nic_i, isInRange(nic, nic_i, dDistances[i - block])));
+				}
+			}
+		} else {
+			NicEntries& nmap = getCellEntries(*c);
+			for(NicEntries::iterator i = nmap.begin(); i != nmap.end(); ++i) {
+				NicEntries::mapped_type nic_i = i->second;
+				if ( nic_i->nicId == id ) continue;
+				if ( nic_i->nicId < id
+					 && std::binary_search(movedIds.begin(), movedIds.end(), nic_i->nicId) ) continue;
+
+				updates.push_back(std::make_pair(nic_i, isInRange(nic, nic_i)));
+			}
+		}
+		c = gridUnion.next();
+	}
+}
+
 const NicEntry::GateList& BaseConnectionManager::getGateList(NicEntry::t_nicid_cref nicID) const
 {
 	NicEntries::const_iterator ItNic = nics.find(nicID);
@@ -444,6 +914,8 @@ const cGate* BaseConnectionManager::getOutGateTo(const NicEntry* nic,
 
 BaseConnectionManager::~BaseConnectionManager()
 {
+	cancelAndDelete(flushTimer);
+
 	for (NicEntries::iterator ne = nics.begin(); ne != nics.end(); ++ne) {
 		delete ne->second;
 	}
@@ -7,6 +7,8 @@
 
 #include "MiXiMDefs.h"
 #include "NicEntry.h"
+#include "PlainCoord.h"
+#include "FlatNicGrid.h"
 
 class ConnectionManagerAccess;
 
@@ -18,6 +20,14 @@ class ConnectionManagerAccess;
  * nodes, and handles dynamic gate creation. BaseConnectionManager therefore
  * periodically communicates with the ConnectionManagerAccess modules
  *
+ * If the parameter "updateHysteresis" is greater than zero, every nic
+ * remembers its position at its last complete connection update and the
+ * distance it can move away from it without changing any of its
+ * connections ("safe radius"). Position updates inside the safe radius are
+ * skipped and position updates inside the hysteresis distance only check
+ * the nics whose distance is near the maximum interference distance. This
+ * assumes that "isInRange()" only depends on the distance of the nics.
+ *
  * You may not instantiate BaseConnectionManager!
  * Use ConnectionManager instead.
  *
@@ -33,7 +43,7 @@ private:
 	 * @brief Represents a position inside a grid.
 	 *
 	 * Internal helper class of BaseConnectionManager.
-	 * This class provides some converting functions from a Coord
+	 * This class provides some converting functions from a PlainCoord
 	 * to a GridCoord.
 	 */
 	class GridCoord
@@ -73,11 +83,11 @@ private:
 			:x(o.x), y(o.y), z(o.z) {};
 
 		/**
-		 * @brief Creates a GridCoord from a given Coord by dividing the
+		 * @brief Creates a GridCoord from a given PlainCoord by dividing the
 		 * x,y and z-values by "gridCellWidth".
-		 * The dimension of the GridCoord depends on the Coord.
+		 * The dimension of the GridCoord depends on the PlainCoord.
 		 */
-		GridCoord(const Coord& c, const Coord& gridCellSize = Coord(1.0,1.0,1.0))
+		GridCoord(const PlainCoord& c, const PlainCoord& gridCellSize = PlainCoord(1.0,1.0,1.0))
 			: x( static_cast<int>(c.x / gridCellSize.x) )
 			, y( static_cast<int>(c.y / gridCellSize.y) )
 			, z( static_cast<int>(c.z / gridCellSize.z) )
@@ -195,6 +205,31 @@ private:
 		unsigned getmaxSize() const { return maxSize; }
 	};
 
+public:
+	/** @brief Spatial index types which can be used to store the nic grid.*/
+	enum GridType {
+		/** @brief Every grid cell is a std::map from nic id to NicEntry.*/
+		GRID_MAP,
+		/** @brief Flat cell array with contiguous id and position arrays per
+		 * cell, see FlatNicGrid.*/
+		GRID_FLAT
+	};
+
+	/** @brief New position of a nic, used for batched position updates.*/
+	struct NicPosition {
+		/** @brief Id of the moved nic.*/
+		NicEntry::t_nicid nicId;
+		/** @brief New position of the nic.*/
+		PlainCoord        pos;
+
+		NicPosition(NicEntry::t_nicid_cref nicId, const PlainCoord& pos)
+			: nicId(nicId), pos(pos)
+		{}
+	};
+
+	/** @brief Type for a list of new nic positions.*/
+	typedef std::vector<NicPosition> NicPositions;
+
 protected:
 	/** @brief Type for map from nic-module id to nic-module pointer.*/
 	typedef std::map<NicEntry::t_nicid, NicEntry*> NicEntries;
@@ -240,6 +275,44 @@ protected:
      */
     NicCube nicGrid;
 
+    /** @brief Which spatial index is used for the grid of nics.*/
+    GridType gridType;
+
+    /**
+     * @brief Distance a nic can move before all nics around it are checked
+     * again, zero disables the connection update hysteresis.
+     */
+    double updateHysteresis;
+
+    /**
+     * @brief Should position updates be collected and applied together
+     * with "updateNicPositions()"?
+     */
+    bool batchPositionUpdates;
+
+    /** @brief Collected positions updates which are not applied yet.*/
+    std::map<NicEntry::t_nicid, PlainCoord> pendingPositions;
+
+    /** @brief Self message to apply the collected position updates.*/
+    cMessage* flushTimer;
+
+    /**
+     * @brief Number of threads used by "updateNicPositions()" to find the
+     * nics in range of the moved nics (0 uses the main thread only).
+     *
+     * Always 0 if MiXiM is compiled without OpenMP support (see the
+     * MIXIM_OPENMP option of src/makefrag). "isInRange()" is called
+     * concurrently otherwise and must not change any state.
+     */
+    int updateThreads;
+
+    /**
+     * @brief Register of all nics if "gridType" is GRID_FLAT.
+     *
+     * Used instead of "nicGrid" and gives the same connectivity results.
+     */
+    FlatNicGrid flatGrid;
+
     /**
      * @brief Distance that helps to find a node under a certain
      * position.
@@ -248,14 +321,112 @@ protected:
      * allow nodes to be placed into the same square if the playground
      * is too small for the grid speedup to work.
 	 */
-    Coord findDistance;
+    PlainCoord findDistance;
 
     /** @brief The size of the grid */
     GridCoord gridDim;
 
 private:
-	/** @brief Manages the connections of a registered nic. */
-    void updateNicConnections(NicEntries& nmap, NicEntries::mapped_type nic);
+	/**
+	 * @brief Manages the connections of a registered nic.
+	 *
+	 * If "skipIds" is not NULL it has to be sorted and nics in this list
+	 * with a smaller id than "nic" are skipped.
+	 */
+    void updateNicConnections(NicEntries& nmap, NicEntries::mapped_type nic,
+                              const std::vector<NicEntry::t_nicid>* skipIds = NULL);
+
+	/**
+	 * @brief Manages the connections of a registered nic to the nics of a
+	 * cell of the flat grid.
+	 *
+	 * The distances are calculated directly from the positions stored in
+	 * the cell, a block of nics at once, and passed to "isInRange()".
+	 */
+    void updateNicConnections(const FlatNicGrid::Cell& cell, NicEntries::mapped_type nic,
+                              const std::vector<NicEntry::t_nicid>* skipIds = NULL);
+
+	/** @brief Type for a list of nics together with their new in range state.*/
+	typedef std::vector<std::pair<NicEntries::mapped_type, bool> > PairUpdates;
+
+	/**
+	 * @brief Checks the existing connections of a nic to the other moved
+	 * nics with a bigger id.
+	 *
+	 * "movedIds" has to be sorted.
+	 */
+	void updateMovedPeerConnections(NicEntries::mapped_type nic,
+	                                const std::vector<NicEntry::t_nicid>& movedIds);
+
+	/**
+	 * @brief Stores for every nic around a moved nic whether it is in range
+	 * without changing any connection.
+	 *
+	 * The nics are stored in the order "updateNicConnections()" would visit
+	 * them. Can be called by several threads at once.
+	 */
+	void collectNicConnections(NicEntries::mapped_type nic,
+	                           const GridCoord& oldCell, const GridCoord& newCell,
+	                           const std::vector<NicEntry::t_nicid>& movedIds,
+	                           PairUpdates& updates);
+
+	/**
+	 * @brief Moves the nic with the passed id from the old to the new cell
+	 * of the grid.
+	 *
+	 * The position of the NicEntry has to be the new position already.
+	 */
+    NicEntries::mapped_type moveInGrid(NicEntry::t_nicid_cref id,
+                                       const GridCoord&       oldCell,
+                                       const GridCoord&       newCell);
+
+	/**
+	 * @brief Adds the cells around the old and the new cell of a moved nic
+	 * to a union of coords.
+	 */
+    void fillUnionForMove(CoordSet& gridUnion, const GridCoord& oldCell, const GridCoord& newCell) const;
+
+	/**
+	 * @brief Connects or disconnects the two passed nics depending on
+	 * whether they are in range or not.
+	 */
+    void updatePairConnection(NicEntries::mapped_type nic,
+                              NicEntries::mapped_type nic_i,
+                              bool                    inRange);
+
+	/** @brief Disconnects the passed nic from every nic in the passed cell.*/
+    void disconnectFromCell(const GridCoord& cell, NicEntries::mapped_type nic);
+
+	/**
+	 * @brief Returns the distance between the two passed positions, on a
+	 * torus if the playground is one.
+	 */
+    double nicDistance(const PlainCoord& a, const PlainCoord& b) const;
+
+	/**
+	 * @brief Updates the safe radius and the boundary nics of the two passed
+	 * nics after a complete connection update of "nic".
+	 */
+    void trackBoundary(NicEntries::mapped_type nic, NicEntries::mapped_type other);
+
+	/**
+	 * @brief Updates the connections of the passed nic to its boundary nics
+	 * only.
+	 *
+	 * Afterwards the safe radius of the nic is at most 0, so every further
+	 * move inside the hysteresis distance re-checks the boundary nics.
+	 *
+	 * @param nic the nic which moved
+	 * @param moved the distance of the nic to its position at its last
+	 * complete connection update
+	 */
+    void updateBoundaryConnections(NicEntries::mapped_type nic, double moved);
+
+	/**
+	 * @brief Removes the passed nic from the boundary nics of all of its
+	 * boundary nics and clears its own boundary nics.
+	 */
+    void clearBoundaryNics(NicEntries::mapped_type nic);
 
     /**
      * @brief Check connections of a nic in the grid
@@ -267,7 +438,7 @@ private:
     /**
      * @brief Calculates the corresponding cell of a coordinate.
      */
-    GridCoord getCellForCoordinate(const Coord& c) const;
+    GridCoord getCellForCoordinate(const PlainCoord& c) const;
 
     /**
      * @brief Returns the NicEntries of the cell with specified
@@ -275,6 +446,14 @@ private:
      */
     NicEntries& getCellEntries(const GridCoord& cell);
 
+    /**
+     * @brief Returns the index of the cell with the specified coordinate
+     * inside the flat grid.
+     */
+    size_t getFlatIndex(const GridCoord& cell) const {
+        return flatGrid.getIndex(cell.x, cell.y, cell.z);
+    }
+
 	/**
 	 * If the value is outside of its bounds (zero and max) this function
 	 * returns -1 if useTorus is false and the wrapped value if useTorus is true.
@@ -347,10 +526,27 @@ protected:
 	 * This function will be used to decide if two nic's shall be connected or not. It
 	 * is simple to overload this function to enhance the decision for connection or not.
 	 *
-	 * @param pFromNic Nic source point which should be checked.
-	 * @param pToNic   Nic target point which should be checked.
+	 * The flat grid calls this variant with the distances it calculated for
+	 * a whole block of nics, the other connection updates call the variant
+	 * without distance which calculates it and calls this one. So
+	 * subclasses should override this variant, a subclass which only
+	 * overrides the one without distance is ignored by the flat grid.
+	 *
+	 * @param pFromNic     Nic source point which should be checked.
+	 * @param pToNic       Nic target point which should be checked.
+	 * @param dSqrDistance Squared distance of the nics, on a torus the squared
+	 *                     torus distance.
 	 * @return true if the nic's are in range and can be connected, false if not.
 	 */
+	virtual bool isInRange(NicEntries::mapped_type pFromNic, NicEntries::mapped_type pToNic, double dSqrDistance);
+
+	/**
+	 * @brief Calculates the squared distance of the two nic's and checks with
+	 * it if they are in range.
+	 *
+	 * Still virtual for subclasses which overrode it before the variant
+	 * with distance existed, see there.
+	 */
 	virtual bool isInRange(NicEntries::mapped_type pFromNic, NicEntries::mapped_type pToNic);
 
 private:
@@ -398,9 +594,43 @@ public:
 	 */
 	bool unregisterNic(cModule* nic);
 
-	/** @brief Updates the position information of a registered nic.*/
+	/** @brief Applies collected position updates when the flush timer fires.*/
+	virtual void handleMessage(cMessage* msg);
+
+	/**
+	 * @brief Updates the position information of a registered nic.
+	 *
+	 * If "batchPositionUpdates" is set the update is only collected and
+	 * applied later by "flushPositionUpdates()".
+	 */
 	void updateNicPos(NicEntry::t_nicid_cref nicID, const Coord* newPos);
 
+	/**
+	 * @brief Updates the positions of several registered nics at once.
+	 *
+	 * All nics are moved inside the grid first and afterwards the
+	 * connections of every moved nic are checked once, pairs of moved nics
+	 * are only checked once. The resulting connections are the same as for
+	 * single position updates, but "updateConnections()" is not called.
+	 * If the connection update hysteresis is used the nics are updated one
+	 * after another.
+	 */
+	void updateNicPositions(const NicPositions& positions);
+
+	/**
+	 * @brief Applies all position updates collected since the last call.
+	 *
+	 * Called before the connections of a nic are used for sending, so
+	 * collected updates never delay a connection change.
+	 */
+	void flushPositionUpdates();
+
+	/**
+	 * @brief Returns the number of worker threads "updateNicPositions()"
+	 * uses, 0 if MiXiM was compiled without OpenMP.
+	 */
+	int getUpdateThreads() const { return updateThreads; }
+
 	/** @brief Returns the ingates of all nics in range*/
 	const NicEntry::GateList& getGateList(NicEntry::t_nicid_cref nicID) const;
 
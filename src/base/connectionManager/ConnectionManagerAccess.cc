@@ -74,6 +74,9 @@ void ConnectionManagerAccess::initialize( int stage )
 
 void ConnectionManagerAccess::sendToChannel(cPacket *msg)
 {
+    // connections have to reflect all moves done so far
+    cc->flushPositionUpdates();
+
     const NicEntry::GateList& gateList = cc->getGateList( getNic()->getId());
     NicEntry::GateList::const_iterator i = gateList.begin();
 
@@ -0,0 +1,85 @@
+/***************************************************************************
+ * file:        FlatNicGrid.cc
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ***************************************************************************
+ * part of:     framework implementation developed by tkn
+ * description: Flat, cache friendly spatial index of NicEntries for the
+ *              ConnectionManager module
+ **************************************************************************/
+
+#include "FlatNicGrid.h"
+
+#include <cassert>
+
+size_t FlatNicGrid::Cell::find(NicEntry::t_nicid_cref id) const
+{
+	std::vector<NicEntry::t_nicid>::const_iterator it = std::lower_bound(ids.begin(), ids.end(), id);
+	if (it == ids.end() || *it != id)
+		return size();
+	return it - ids.begin();
+}
+
+void FlatNicGrid::Cell::insert(NicEntry* nic)
+{
+	std::vector<NicEntry::t_nicid>::iterator it = std::lower_bound(ids.begin(), ids.end(), nic->nicId);
+	const size_t                             i  = it - ids.begin();
+
+	if (it != ids.end() && *it == nic->nicId) {
+		// already part of this cell, just update the entry
+		nics[i] = nic;
+		setPos(i, nic->pos);
+		return;
+	}
+
+	ids.insert(it, nic->nicId);
+	nics.insert(nics.begin() + i, nic);
+	xs.insert(xs.begin() + i, nic->pos.x);
+	ys.insert(ys.begin() + i, nic->pos.y);
+	zs.insert(zs.begin() + i, nic->pos.z);
+}
+
+void FlatNicGrid::Cell::erase(NicEntry::t_nicid_cref id)
+{
+	const size_t i = find(id);
+	if (i == size())
+		return;
+
+	ids.erase(ids.begin() + i);
+	nics.erase(nics.begin() + i);
+	xs.erase(xs.begin() + i);
+	ys.erase(ys.begin() + i);
+	zs.erase(zs.begin() + i);
+}
+
+void FlatNicGrid::resize(int x, int y, int z)
+{
+	assert(x > 0 && y > 0 && z > 0);
+
+	dimX = x;
+	dimY = y;
+	dimZ = z;
+
+	cells.clear();
+	cells.resize(static_cast<size_t>(x) * y * z);
+}
+
+void FlatNicGrid::move(size_t oldIdx, size_t newIdx, NicEntry* nic)
+{
+	if (oldIdx == newIdx) {
+		Cell&        cell = cells[oldIdx];
+		const size_t i    = cell.find(nic->nicId);
+
+		assert(i != cell.size());
+		cell.setPos(i, nic->pos);
+		return;
+	}
+	cells[oldIdx].erase(nic->nicId);
+	cells[newIdx].insert(nic);
+}
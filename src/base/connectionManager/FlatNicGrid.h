@@ -0,0 +1,176 @@
+/* -*- mode:c++ -*- ********************************************************
+ * file:        FlatNicGrid.h
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ***************************************************************************
+ * part of:     framework implementation developed by tkn
+ * description: Flat, cache friendly spatial index of NicEntries for the
+ *              ConnectionManager module
+ **************************************************************************/
+
+#ifndef FLATNICGRID_H
+#define FLATNICGRID_H
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+#include "MiXiMDefs.h"
+#include "NicEntry.h"
+#include "PlainCoord.h"
+#include "CoordKernels.h"
+
+/**
+ * @brief Flat spatial index of the registered nics used by
+ * BaseConnectionManager as alternative to its std::map based grid.
+ *
+ * All cells of the grid are stored in one contiguous array. Every cell
+ * stores the ids, the NicEntry pointers and the positions of its nics in
+ * separate contiguous arrays (structure of arrays). The arrays are kept
+ * sorted by nic id, so iterating over a cell visits the nics in the same
+ * order as the std::map based grid does. This keeps the order of the
+ * connect/disconnect calls (and therefore the gate creation) identical for
+ * both grid types.
+ *
+ * The positions stored in a cell are a copy of NicEntry::pos and have to be
+ * kept up to date with "setPos()" or "move()".
+ *
+ * @ingroup connectionManager
+ * @sa BaseConnectionManager
+ */
+class MIXIM_API FlatNicGrid
+{
+public:
+	/**
+	 * @brief Contents of a single grid cell.
+	 *
+	 * All arrays have the same length and are sorted by nic id.
+	 */
+	class Cell
+	{
+	public:
+		/** @brief Ids of the nics in this cell.*/
+		std::vector<NicEntry::t_nicid> ids;
+		/** @brief NicEntries of the nics in this cell.*/
+		std::vector<NicEntry*>         nics;
+		/** @name Positions of the nics in this cell.*/
+		/*@{*/
+		std::vector<double>            xs;
+		std::vector<double>            ys;
+		std::vector<double>            zs;
+		/*@}*/
+
+	public:
+		Cell()
+			: ids(), nics(), xs(), ys(), zs()
+		{}
+
+		/** @brief Returns the number of nics in this cell.*/
+		size_t size() const { return ids.size(); }
+
+		/** @brief Returns true if there is no nic in this cell.*/
+		bool empty() const { return ids.empty(); }
+
+		/**
+		 * @brief Returns the index of the nic with the passed id inside this
+		 * cell or size() if the nic is not part of this cell.
+		 */
+		size_t find(NicEntry::t_nicid_cref id) const;
+
+		/** @brief Inserts the passed nic (at its current position).*/
+		void insert(NicEntry* nic);
+
+		/** @brief Removes the nic with the passed id from this cell.*/
+		void erase(NicEntry::t_nicid_cref id);
+
+		/** @brief Updates the stored position of the nic at index i.*/
+		void setPos(size_t i, const PlainCoord& pos) {
+			xs[i] = pos.x;
+			ys[i] = pos.y;
+			zs[i] = pos.z;
+		}
+
+		/**
+		 * @brief Returns the squared distance between the passed position and
+		 * the nic at index i.
+		 */
+		double sqrdist(size_t i, const PlainCoord& pos) const {
+			return PlainCoord(xs[i], ys[i], zs[i]).sqrdist(pos);
+		}
+
+		/**
+		 * @brief Returns the squared distance on a torus between the passed
+		 * position and the nic at index i.
+		 *
+		 * Calculates exactly the same value as Coord::sqrTorusDist().
+		 */
+		double sqrTorusDist(size_t i, const PlainCoord& pos, const PlainCoord& size) const {
+			return PlainCoord(xs[i], ys[i], zs[i]).sqrTorusDist(pos, size);
+		}
+
+		/**
+		 * @brief Writes the squared distances between the passed position and
+		 * the "count" nics from index "begin" on to "out", on a torus of the
+		 * passed size if "torusSize" is not NULL.
+		 *
+		 * Calculates the same values as sqrdist() and sqrTorusDist(), with
+		 * CoordKernels.
+		 */
+		void sqrdists(size_t begin, size_t count, const PlainCoord& pos,
+		              const PlainCoord* torusSize, double* out) const {
+			if (count == 0)
+				return;
+			if (torusSize)
+				CoordKernels::sqrTorusDist(&xs[begin], &ys[begin], &zs[begin], count, pos, *torusSize, out);
+			else
+				CoordKernels::sqrdist(&xs[begin], &ys[begin], &zs[begin], count, pos, out);
+		}
+	};
+
+protected:
+	/** @brief The cells of the grid, x-major.*/
+	std::vector<Cell> cells;
+
+	/** @name Dimension of the grid.*/
+	/*@{*/
+	int dimX;
+	int dimY;
+	int dimZ;
+	/*@}*/
+
+public:
+	FlatNicGrid()
+		: cells(), dimX(0), dimY(0), dimZ(0)
+	{}
+
+	/** @brief Removes all nics and resizes the grid to the passed dimension.*/
+	void resize(int x, int y, int z);
+
+	/** @brief Returns the index of the cell with the passed grid coordinate.*/
+	size_t getIndex(int x, int y, int z) const {
+		return (static_cast<size_t>(x) * dimY + y) * dimZ + z;
+	}
+
+	/** @brief Returns the cell with the passed index.*/
+	Cell& getCell(size_t idx) { return cells[idx]; }
+
+	/** @brief Returns the cell with the passed index.*/
+	const Cell& getCell(size_t idx) const { return cells[idx]; }
+
+	/** @brief Returns the number of cells in the grid.*/
+	size_t getNumCells() const { return cells.size(); }
+
+	/**
+	 * @brief Moves the passed nic from the cell "oldIdx" to the cell "newIdx"
+	 * and updates its stored position to the nics current position.
+	 */
+	void move(size_t oldIdx, size_t newIdx, NicEntry* nic);
+};
+
+#endif
@@ -24,9 +24,10 @@
 
 #include <omnetpp.h>
 #include <map>
+#include <vector>
 
 #include "MiXiMDefs.h"
-#include "Coord.h"
+#include "PlainCoord.h"
 
 class ConnectionManagerAccess;
 
@@ -66,11 +67,29 @@ class MIXIM_API NicEntry : public cObject
     int hostId;
 
     /** @brief Geographic location of the nic*/
-    Coord pos;
+    PlainCoord pos;
 
     /** @brief Points to this nics ConnectionManagerAccess module */
     ConnectionManagerAccess* chAccess;
 
+    /** @name Connection update hysteresis
+     *
+     * Used by the ConnectionManager to skip connection updates which can not
+     * change any connection, see BaseConnectionManager::updateConnections().
+     */
+    /*@{*/
+    /** @brief Position at the last complete connection update of the nic.*/
+    PlainCoord scanPos;
+
+    /** @brief Distance the nic can move away from "scanPos" without changing
+     * any connection, negative if the nic was never updated completely.*/
+    double safeRadius;
+
+    /** @brief Nics whose distance is near the maximum interference distance,
+     * sorted by nic id.*/
+    std::vector<NicEntry*> boundaryNics;
+    /*@}*/
+
   protected:
     /** @brief Debug output switch*/
     bool coreDebug;
@@ -95,6 +114,9 @@ class MIXIM_API NicEntry : public cObject
       , hostId(0)
       , pos()
       , chAccess(NULL)
+      , scanPos()
+      , safeRadius(-1.0)
+      , boundaryNics()
       , coreDebug(debug)
       , outConns()
     { }
@@ -106,6 +128,9 @@ class MIXIM_API NicEntry : public cObject
       , hostId(o.hostId)
       , pos(o.pos)
       , chAccess(o.chAccess)
+      , scanPos(o.scanPos)
+      , safeRadius(o.safeRadius)
+      , boundaryNics(o.boundaryNics)
       , coreDebug(o.coreDebug)
       , outConns(o.outConns)
     { }
@@ -117,19 +142,25 @@ class MIXIM_API NicEntry : public cObject
     	std::swap(hostId, s.hostId);
     	std::swap(pos, s.pos);
     	std::swap(chAccess, s.chAccess);
+    	std::swap(scanPos, s.scanPos);
+    	std::swap(safeRadius, s.safeRadius);
+    	std::swap(boundaryNics, s.boundaryNics);
     	std::swap(coreDebug, s.coreDebug);
     	std::swap(outConns, s.outConns);
     }
 
     NicEntry& operator=(const NicEntry& o)
     {
-    	nicId     = o.nicId;
-    	nicPtr    = o.nicPtr;
-    	hostId    = o.hostId;
-    	pos       = o.pos;
-    	chAccess  = o.chAccess;
-    	coreDebug = o.coreDebug;
-    	outConns  = o.outConns;
+    	nicId        = o.nicId;
+    	nicPtr       = o.nicPtr;
+    	hostId       = o.hostId;
+    	pos          = o.pos;
+    	chAccess     = o.chAccess;
+    	scanPos      = o.scanPos;
+    	safeRadius   = o.safeRadius;
+    	boundaryNics = o.boundaryNics;
+    	coreDebug    = o.coreDebug;
+    	outConns     = o.outConns;
     	return *this;
     }
     /**
@@ -5,6 +5,7 @@
 #include "Coord.h"
 
 class MiximAirFrame;
+class LinkGainCache;
 
 /**
  * @brief Interface for the analogue models of the physical layer.
@@ -54,6 +55,16 @@ public:
 	 * @param receiverPos	The position of frame receiver.
 	 */
 	virtual void filterSignal(airframe_ptr_t frame, const Coord& sendersPos, const Coord& receiverPos) = 0;
+
+	/**
+	 * @brief Passes the link gain cache of the physical layer to the model.
+	 *
+	 * Models which calculate their attenuation only from the positions of
+	 * sender and receiver can store it there to reuse it for the next
+	 * AirFrame on the same link. The cache is valid as long as the model
+	 * exists. The default implementation does not use the cache.
+	 */
+	virtual void setLinkGainCache(LinkGainCache* /*cache*/) {}
 };
 
 #endif /*ANALOGUEMODEL_*/
@@ -12,6 +12,7 @@
 #include "MiXiMAirFrame.h"
 #include "PhyToMacControlInfo.h"
 #include "FWMath.h"
+#include "InterferenceTimeline.h"
 
 /** @brief Flag for channel sense (channel idle) handling.
  *
@@ -381,6 +382,29 @@ simtime_t BaseDecider::canAnswerCSR(const CSRInfo& requestInfo) const
 }
 
 BaseDecider::channel_sense_rssi_t BaseDecider::calcChannelSenseRSSI(simtime_t_cref start, simtime_t_cref end) const {
+	const InterferenceTimeline *const noiseFloor = phy->getNoiseFloor();
+	if(noiseFloor) {
+		// the phy layer keeps the sum of the receiving powers up to date,
+		// only the reception ends are taken from the AirFrames
+		AirFrameVector airFrames;
+		simtime_t      MaxReceptionEnd = notAgain;
+
+		getChannelInfo(start, end, airFrames);
+		for (AirFrameVector::const_iterator it = airFrames.begin(); it != airFrames.end(); ++it) {
+			const simtime_t& ReceptionEnd = (*it)->getSignal().getReceptionEnd();
+			if (ReceptionEnd > MaxReceptionEnd) {
+				MaxReceptionEnd = ReceptionEnd;
+			}
+		}
+
+		Mapping::argument_value_t rssi         = noiseFloor->getMax(start, end);
+		ConstMapping*             thermalNoise = phy->getThermalNoise(start, end);
+		if(thermalNoise) {
+			rssi += thermalNoise->getValue(Argument(start));
+		}
+		return std::make_pair(rssi, MaxReceptionEnd);
+	}
+
     rssi_mapping_t pairMapMaxEnd = calculateRSSIMapping(start, end);
 
 	// the sensed RSSI-value is the maximum value between (and including) the interval-borders
@@ -413,8 +437,10 @@ Mapping* BaseDecider::calculateSnrMapping(const airframe_ptr_t frame) const
 	simtime_t     start = signal.getReceptionStart();
 	simtime_t     end   = signal.getReceptionEnd();
 
+	// divide the product of the receiving power directly, so that the
+	// division of two time-only mappings works on their entries
 	Mapping*                  noiseMap     = calculateRSSIMapping(start, end, frame).first;
-	const ConstMapping *const recvPowerMap = signal.getReceivingPower();
+	const ConstMapping *const recvPowerMap = signal.getReceivingPower()->getProduct();
     assert(noiseMap);
 	assert(recvPowerMap);
 
@@ -452,15 +478,36 @@ BaseDecider::calculateRSSIMapping( simtime_t_cref       start,
 	// collect all AirFrames that intersect with [start, end]
 	getChannelInfo(start, end, airFrames);
 
+	ConstMapping* thermalNoise = phy->getThermalNoise(start, end);
+
+	// Time only mappings (the common case) are summed up by the reused
+	// interference accumulator, other domains need the generic (and
+	// allocating) element-wise operations of MappingUtils.
+	bool accumulate = !thermalNoise || InterferenceAccumulator::canAccumulate(*thermalNoise);
+	for (AirFrameVector::const_iterator it = airFrames.begin(); accumulate && it != airFrames.end(); ++it) {
+		const ConstMapping *const recvPowerMap = (*it)->getSignal().getReceivingPower()->getProduct();
+		accumulate = !recvPowerMap || InterferenceAccumulator::canAccumulate(*recvPowerMap);
+	}
+
 	// create an empty mapping
-	Mapping* resultMap = MappingUtils::createMapping(Argument::MappedZero, DimensionSet::timeDomain);
+	Mapping* resultMap = NULL;
+	if(accumulate) {
+		interference.reset();
+	}
+	else {
+		resultMap = MappingUtils::createMapping(Argument::MappedZero, DimensionSet::timeDomain);
+	}
 
 	//add thermal noise
-	ConstMapping* thermalNoise = phy->getThermalNoise(start, end);
 	if(thermalNoise) {
-		Mapping* tmp = resultMap;
-		resultMap = MappingUtils::add(*resultMap, *thermalNoise);
-		delete tmp;
+		if(accumulate) {
+			interference.add(*thermalNoise);
+		}
+		else {
+			Mapping* tmp = resultMap;
+			resultMap = MappingUtils::add(*resultMap, *thermalNoise);
+			delete tmp;
+		}
 	}
 
 	// otherwise, iterate over all AirFrames (except exclude)
@@ -482,13 +529,18 @@ BaseDecider::calculateRSSIMapping( simtime_t_cref       start,
 				// building up the NoiseMap i add the thermalNoise for the time and
 				// frequencies of this airframe. There's probably a better way to do it but
 				// i did it like this:
-				const ConstMapping *const recvPowerMap = (*it)->getSignal().getReceivingPower();
+				const ConstMapping *const recvPowerMap = (*it)->getSignal().getReceivingPower()->getProduct();
 
 				if (recvPowerMap) {
                     deciderEV << "Adding mapping of Airframe with ID " << (*it)->getId()
                               << ". Starts at "  << SIMTIME_STR((*it)->getSignal().getReceptionStart())
                               << " and ends at " << SIMTIME_STR((*it)->getSignal().getReceptionEnd()) << endl;
 
+					if(accumulate) {
+						interference.addDifference(*recvPowerMap, *thermalNoise);
+						continue;
+					}
+
 					Mapping* rcvPowerPlusThermalNoise = MappingUtils::add(      *recvPowerMap,             *thermalNoise );
 					Mapping* resultMapTmp             = MappingUtils::subtract( *rcvPowerPlusThermalNoise, *recvPowerMap );
 					Mapping* resultMapNew             = MappingUtils::add(      *resultMap,                *resultMapTmp );
@@ -507,19 +559,21 @@ BaseDecider::calculateRSSIMapping( simtime_t_cref       start,
 		// otherwise get the Signal and its receiving-power-mapping
 		Signal& signal = (*it)->getSignal();
 
-		// backup pointer to result map
-		// Mapping* resultMapOld = resultMap;
-
 		// add the Signal's receiving-power-mapping to resultMap in [start, end],
 		// the operation Mapping::add returns a pointer to a new Mapping
 
-		const ConstMapping *const recvPowerMap = signal.getReceivingPower();
+		const ConstMapping *const recvPowerMap = signal.getReceivingPower()->getProduct();
 		assert(recvPowerMap);
 
 		deciderEV << "Adding mapping of Airframe with ID " << (*it)->getId()
 		          << ". Starts at "  << SIMTIME_STR(signal.getReceptionStart())
 		          << " and ends at " << SIMTIME_STR(signal.getReceptionEnd()) << endl;
 
+		if(accumulate) {
+			interference.addTo(*recvPowerMap);
+			continue;
+		}
+
 		Mapping* resultMapNew = MappingUtils::add( *recvPowerMap, *resultMap, Argument::MappedZero );
 
 		// discard old mapping
@@ -528,6 +582,10 @@ BaseDecider::calculateRSSIMapping( simtime_t_cref       start,
 		resultMapNew = NULL;
 	}
 
+	if(accumulate) {
+		resultMap = interference.createMapping();
+	}
+
 	return std::make_pair(resultMap, MaxReceptionEnd);
 }
 
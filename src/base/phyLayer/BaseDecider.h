@@ -10,6 +10,7 @@
 
 #include "MiXiMDefs.h"
 #include "Decider.h"
+#include "InterferenceAccumulator.h"
 
 class Mapping;
 class DeciderResult;
@@ -203,6 +204,9 @@ protected:
 	/** @brief toggles display of debugging messages */
 	bool debug;
 
+	/** @brief Reused buffers to sum up the interference in "calculateRSSIMapping()". */
+	mutable InterferenceAccumulator interference;
+
 public:
 	/**
 	 * @brief Initializes the decider with the passed values.
@@ -226,6 +230,7 @@ public:
 		, currentChannelSenseRequest()
 		, myIndex(myIndex)
 		, debug(debug)
+		, interference()
 	{
 		currentChannelSenseRequest.clear();
 	}
@@ -35,9 +35,12 @@ BasePhyLayer::BasePhyLayer()
 	, sensitivity(0)
 	, recordStats(false)
 	, channelInfo()
+	, useNoiseFloor(false)
+	, noiseFloor()
 	, radio(NULL)
 	, decider(NULL)
 	, analogueModels()
+	, linkGains()
 	, upperLayerIn(-1)
 	, upperLayerOut(-1)
 	, upperControlOut(-1)
@@ -101,9 +104,11 @@ void BasePhyLayer::initialize(int stage) {
 		maxTXPower = par("maxTXPower").doubleValue();
 
 		recordStats = par("recordStats").boolValue();
+		useNoiseFloor = readPar("useNoiseFloor", false);
 
 		//	- initialize radio
 		radio = initializeRadio();
+		channelInfo.setCurrentChannel(radio->getCurrentChannel());
 
 		// get pointer to the world module
 		world = FindModule<BaseWorldUtility*>::findGlobalModule();
@@ -209,6 +214,21 @@ void BasePhyLayer::getParametersFromXML(cXMLElement* xmlData, ParameterMap& outp
 void BasePhyLayer::finish(){
 	// give decider the chance to do something
 	decider->finish();
+
+	if(linkGains.getHits() + linkGains.getMisses() > 0) {
+		recordScalar("linkGainCacheHits", linkGains.getHits());
+		recordScalar("linkGainCacheMisses", linkGains.getMisses());
+	}
+}
+
+void BasePhyLayer::receiveSignal(cComponent *source, simsignal_t signalID, cObject *obj)
+{
+	ConnectionManagerAccess::receiveSignal(source, signalID, obj);
+
+	// the position of the receiver is the same for all cached links
+	if(signalID == mobilityStateChangedSignal) {
+		linkGains.clear();
+	}
 }
 
 //-----Decider initialization----------------------
@@ -325,6 +345,7 @@ void BasePhyLayer::initializeAnalogueModels(cXMLElement* xmlConfig) {
 		}
 
 		// attach the new AnalogueModel to the AnalogueModelList
+		newAnalogueModel->setLinkGainCache(&linkGains);
 		analogueModels.push_back(newAnalogueModel);
 
 		coreEV << "AnalogueModel \"" << name << "\" loaded." << endl;
@@ -416,6 +437,10 @@ void BasePhyLayer::handleAirFrameStartReceive(airframe_ptr_t frame) {
 	frame->getSignal().setReceptionSenderInfo(frame);
 	filterSignal(frame);
 
+	if(useNoiseFloor) {
+		addToNoiseFloor(frame, simTime());
+	}
+
 	if(decider && isKnownProtocolId(frame->getProtocolId())) {
 		frame->setState(RECEIVING);
 
@@ -481,6 +506,7 @@ void BasePhyLayer::handleAirFrameEndReceive(airframe_ptr_t frame)
 	}
 
 	radio->cleanAnalogueModelUntil(earliestInfoPoint);
+	noiseFloor.removeBefore(earliestInfoPoint);
 }
 
 void BasePhyLayer::handleUpperMessage(cMessage* msg){
@@ -751,6 +777,7 @@ bool BasePhyLayer::isRadioInRX() const {
 void BasePhyLayer::finishRadioSwitching(bool bSendCtrlMsg /*= true*/)
 {
 	radio->endSwitch(simTime());
+	radioAttenuationChanged();
 	if (bSendCtrlMsg) {
 	    sendControlMsgToMac(new cMessage("Radio switching over", RADIO_SWITCHING_OVER));
 	}
@@ -770,6 +797,8 @@ simtime_t BasePhyLayer::setRadioState(int rs) {
 	if(switchTime < SIMTIME_ZERO)
 		return switchTime;
 
+	radioAttenuationChanged();
+
 	// if switching is done in exactly zero-time no extra self-message is scheduled
 	if (switchTime == SIMTIME_ZERO) {
 		// In case of zero-time-switch, send no control-message to MAC!
@@ -804,6 +833,8 @@ void BasePhyLayer::setCurrentRadioChannel(int newRadioChannel) {
 	}
 
 	radio->setCurrentChannel(newRadioChannel);
+	channelInfo.setCurrentChannel(newRadioChannel);
+	radioAttenuationChanged();
 	decider->channelChanged(newRadioChannel);
 	coreEV << "Switched radio to channel " << newRadioChannel << endl;
 }
@@ -823,20 +854,8 @@ void BasePhyLayer::getChannelInfo(simtime_t_cref from, simtime_t_cref to, AirFra
 		channelInfo.getAirFrames(from, to, out);
 	}
 	else {
-		// here we filter out all air frames which are not on current channel
-		struct airframe_filter_channel_fctr : public ChannelInfo::airframe_filter_fctr {
-			int iChNum;
-
-			airframe_filter_channel_fctr(int chNum) : ChannelInfo::airframe_filter_fctr(), iChNum(chNum)
-			{}
-
-			virtual bool pass(const ChannelInfo::airframe_ptr_t& a) const {
-				return a->getChannel() == iChNum;
-			}
-		};
-
-		airframe_filter_channel_fctr fctrFilterChannel(getCurrentRadioChannel());
-		channelInfo.getAirFrames(from, to, out, &fctrFilterChannel);
+		// only the air frames on the current channel
+		channelInfo.getChannelAirFrames(from, to, out);
 	}
 }
 
@@ -847,6 +866,55 @@ ConstMapping* BasePhyLayer::getThermalNoise(simtime_t_cref from, simtime_t_cref
 	return thermalNoise;
 }
 
+const InterferenceTimeline* BasePhyLayer::getNoiseFloor() const {
+	return useNoiseFloor ? &noiseFloor : NULL;
+}
+
+void BasePhyLayer::addToNoiseFloor(airframe_ptr_t frame, simtime_t_cref from) {
+	if(getNbRadioChannels() > 1 && frame->getChannel() != getCurrentRadioChannel())
+		return;
+
+	const Signal&             signal       = frame->getSignal();
+	const ConstMapping *const recvPowerMap = signal.getReceivingPower();
+	if(!recvPowerMap)
+		return;
+
+	if(!(recvPowerMap->getDimensionSet() == DimensionSet::timeDomain)) {
+		opp_error("The noise floor (parameter \"useNoiseFloor\") only supports receiving powers over time only.");
+	}
+
+	// the receiving power mappings are zero at the exact reception start
+	const simtime_t start = std::max(MappingUtils::post(signal.getReceptionStart()), from);
+	if(start < signal.getReceptionEnd()) {
+		noiseFloor.add(start, signal.getReceptionEnd(), recvPowerMap->getValue(Argument(start)));
+	}
+}
+
+void BasePhyLayer::radioAttenuationChanged() {
+	// the AirFrames of every channel are attenuated by the radio
+	AirFrameVector airFrames;
+	channelInfo.getAirFrames(simTime(), simTime(), airFrames);
+	for(AirFrameVector::const_iterator it = airFrames.begin(); it != airFrames.end(); ++it) {
+		(*it)->getSignal().attenuationChanged();
+	}
+
+	resampleNoiseFloor();
+}
+
+void BasePhyLayer::resampleNoiseFloor() {
+	if(!useNoiseFloor)
+		return;
+
+	const simtime_t now = simTime();
+	noiseFloor.truncate(now);
+
+	AirFrameVector airFrames;
+	getChannelInfo(now, now, airFrames);
+	for(AirFrameVector::const_iterator it = airFrames.begin(); it != airFrames.end(); ++it) {
+		addToNoiseFloor(*it, now);
+	}
+}
+
 void BasePhyLayer::sendControlMsgToMac(cMessage* msg) {
 	if(msg->getKind() == CHANNEL_SENSE_REQUEST) {
 		if(channelInfo.isRecording()) {
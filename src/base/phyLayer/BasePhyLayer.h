@@ -11,6 +11,8 @@
 #include "MacToPhyInterface.h"
 
 #include "ChannelInfo.h"
+#include "InterferenceTimeline.h"
+#include "LinkGainCache.h"
 
 class AnalogueModel;
 class Decider;
@@ -106,6 +108,15 @@ protected:
 	 */
 	ChannelInfo channelInfo;
 
+	/** @brief Stores if the sum of the receiving powers is tracked in "noiseFloor".*/
+	bool useNoiseFloor;
+
+	/**
+	 * @brief Sum of the receiving powers of the AirFrames on the current
+	 * channel, covers the same time span as "channelInfo".
+	 */
+	InterferenceTimeline noiseFloor;
+
 	/** @brief The state machine storing the current radio state (TX, RX, SLEEP).*/
 	MiximRadio* radio;
 
@@ -118,6 +129,12 @@ protected:
 	/** @brief List of the analogue models to use.*/
 	AnalogueModelList analogueModels;
 
+	/**
+	 * @brief Values the analogue models calculated from the positions of
+	 * sender and receiver, shared by all analogue models of this phy.
+	 */
+	LinkGainCache linkGains;
+
 	/** @brief The id of the in-data gate from the Mac layer */
 	int upperLayerIn;
 	/** @brief The id of the out-data gate to the Mac layer */
@@ -397,6 +414,34 @@ protected:
 	 */
 	virtual void finishRadioSwitching(bool bSendCtrlMsg = true);
 
+	/**
+	 * @brief Adds the receiving power the passed AirFrame has at the passed
+	 * point in time to the noise floor, from this point in time (or the
+	 * reception start if it is later) on until the reception end.
+	 *
+	 * AirFrames on other channels than the current one are ignored.
+	 */
+	virtual void addToNoiseFloor(airframe_ptr_t frame, simtime_t_cref from);
+
+	/**
+	 * @brief Adds the AirFrames on the channel again with the receiving power
+	 * they have from now on.
+	 *
+	 * Called whenever the radio state or channel changes, because both change
+	 * the receiving power (see RadioStateAnalogueModel) or the relevant
+	 * AirFrames from now on.
+	 */
+	virtual void resampleNoiseFloor();
+
+	/**
+	 * @brief Discards the calculated receiving powers of the AirFrames on the
+	 * channel and resamples the noise floor.
+	 *
+	 * Called whenever the radio state or channel changes, because both change
+	 * the attenuation of the RadioStateAnalogueModel from now on.
+	 */
+	virtual void radioAttenuationChanged();
+
 	/**
 	 * @brief Returns the identifier of the protocol this phy uses to send
 	 * messages.
@@ -438,9 +483,18 @@ public:
 	 */
 	virtual ~BasePhyLayer();
 
-	/** @brief Only calls the deciders finish method.*/
+	/**
+	 * @brief Calls the deciders finish method and records the hits and
+	 * misses of the link gain cache.
+	 */
 	virtual void finish();
 
+	/**
+	 * @brief Clears the link gain cache if the host moved, see
+	 * ConnectionManagerAccess::receiveSignal() for the rest.
+	 */
+	virtual void receiveSignal(cComponent *source, simsignal_t signalID, cObject *obj);
+
 	//---------MacToPhyInterface implementation-----------
 	/**
 	 * @name MacToPhyInterface implementation
@@ -527,6 +581,12 @@ public:
 	 */
 	virtual ConstMapping* getThermalNoise(simtime_t_cref from, simtime_t_cref to);
 
+	/**
+	 * @brief Returns the sum of the receiving powers on the current channel
+	 * if the "useNoiseFloor" parameter is set, otherwise NULL.
+	 */
+	virtual const InterferenceTimeline* getNoiseFloor() const;
+
 	/**
 	 * @brief Called by the Decider to send a control message to the MACLayer
 	 *
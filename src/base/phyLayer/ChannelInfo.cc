@@ -4,8 +4,33 @@
 #include <assert.h>
 
 const_simtime_t                   ChannelInfo::invalidSimTime(-1);
-const ChannelInfo::const_iterator ChannelInfo::cConstItEnd(NULL, SIMTIME_ZERO, SIMTIME_ZERO);
-const ChannelInfo::iterator       ChannelInfo::cItEnd(NULL, SIMTIME_ZERO, SIMTIME_ZERO);
+
+bool ChannelInfo::AirFrameMatrix::erase(simtime_t_cref startTime, simtime_t_cref endTime, airframe_ptr_t frame)
+{
+	const Entry       e(startTime, endTime, frame);
+	Entries::iterator itEnd = std::upper_bound(entries.begin(), entries.end(), e, EntryComparator());
+
+	for(Entries::iterator it = std::lower_bound(entries.begin(), entries.end(), e, EntryComparator()); it != itEnd; ++it) {
+		if(it->frame == frame || it->frame->getTreeId() == frame->getTreeId()) {
+			erase(static_cast<size_t>(it - entries.begin()));
+			return true;
+		}
+	}
+	return false;
+}
+
+simtime_t ChannelInfo::AirFrameMatrix::earliestStart(simtime_t_cref returnTimeIfEmpty) const
+{
+	if(entries.empty())
+		return returnTimeIfEmpty;
+
+	simtime_t earliest = entries.front().start;
+	for(Entries::const_iterator it = entries.begin() + 1; it != entries.end(); ++it) {
+		if(it->start < earliest)
+			earliest = it->start;
+	}
+	return earliest;
+}
 
 void ChannelInfo::addAirFrame(airframe_ptr_t frame, simtime_t_cref startTime)
 {
@@ -14,12 +39,8 @@ void ChannelInfo::addAirFrame(airframe_ptr_t frame, simtime_t_cref startTime)
 	//calculate endTime of AirFrame
 	simtime_t endTime = startTime + frame->getDuration();
 
-	AirFrameMatrix::iterator pos = activeAirFrames.lower_bound(endTime);
-	if(pos == activeAirFrames.end() || (activeAirFrames.key_comp()(endTime, pos->first))) {
-	    // key does not exists
-		pos = activeAirFrames.insert(pos, std::make_pair(endTime, AirFrameMatrix::mapped_type()));
-	}
-	pos->second.insert(std::make_pair(startTime, frame));
+	activeAirFrames.insert(startTime, endTime, frame);
+	channelAirFrames[frame->getChannel()].active.insert(startTime, endTime, frame);
 
 	//add to start time map
 	airFrameStarts[frame->getTreeId()] = startTime;
@@ -36,12 +57,8 @@ void ChannelInfo::addToInactives(airframe_ptr_t frame,
 	checkAndCleanInterval(startTime, endTime);
 
 	if(!canDiscardInterval(startTime, endTime)) {
-		AirFrameMatrix::iterator pos = inactiveAirFrames.lower_bound(endTime);
-		if(pos == inactiveAirFrames.end() || (inactiveAirFrames.key_comp()(endTime, pos->first))) {
-		    // key does not exists
-			pos = inactiveAirFrames.insert(pos, std::make_pair(endTime, AirFrameMatrix::mapped_type()));
-		}
-		pos->second.insert(std::make_pair(startTime, frame));
+		inactiveAirFrames.insert(startTime, endTime, frame);
+		channelAirFrames[frame->getChannel()].inactive.insert(startTime, endTime, frame);
 	}
 	else {
 		airFrameStarts.erase(frame->getTreeId());
@@ -51,18 +68,16 @@ void ChannelInfo::addToInactives(airframe_ptr_t frame,
 
 simtime_t ChannelInfo::findEarliestInfoPoint(simtime_t_cref returnTimeIfEmpty /*= invalidSimTime*/) const
 {
-	c_min_start_time_fctr fctrMin;
-
-	AirFrameMatrix::const_iterator itActivesMin   = std::min_element(activeAirFrames.begin()  , activeAirFrames.end()  , fctrMin);
-	AirFrameMatrix::const_iterator itInactivesMin = std::min_element(inactiveAirFrames.begin(), inactiveAirFrames.end(), fctrMin);
+	const simtime_t activesMin   = activeAirFrames.earliestStart(invalidSimTime);
+	const simtime_t inactivesMin = inactiveAirFrames.earliestStart(invalidSimTime);
 
-	if (itActivesMin != activeAirFrames.end() && itInactivesMin != inactiveAirFrames.end()) {
-		return std::min(itActivesMin->second.begin()->first, itInactivesMin->second.begin()->first);
+	if (activesMin != invalidSimTime && inactivesMin != invalidSimTime) {
+		return std::min(activesMin, inactivesMin);
 	}
-	if (itActivesMin != activeAirFrames.end())
-		return itActivesMin->second.begin()->first;
-	if (itInactivesMin != inactiveAirFrames.end())
-		return itInactivesMin->second.begin()->first;
+	if (activesMin != invalidSimTime)
+		return activesMin;
+	if (inactivesMin != invalidSimTime)
+		return inactivesMin;
 
 	return returnTimeIfEmpty;
 }
@@ -79,6 +94,7 @@ simtime_t ChannelInfo::removeAirFrame(airframe_ptr_t frame, simtime_t_cref retur
 
 	//remove this AirFrame from active AirFrames
 	deleteAirFrame(activeAirFrames, frame, startTime, endTime);
+	deleteAirFrame(channelAirFrames[frame->getChannel()].active, frame, startTime, endTime);
 
 	//add to inactive AirFrames
 	addToInactives(frame, startTime, endTime);
@@ -95,30 +111,22 @@ simtime_t ChannelInfo::removeAirFrame(airframe_ptr_t frame, simtime_t_cref retur
 void ChannelInfo::assertNoIntersections() const {
 	const bool bIsValidStartTime = recordStartTime >= SIMTIME_ZERO;
 
-	for(AirFrameMatrix::const_iterator it1 = inactiveAirFrames.begin(); it1 != inactiveAirFrames.end(); ++it1)
+	for(size_t i = 0; i < inactiveAirFrames.size(); ++i)
 	{
-		simtime_t_cref e0 = it1->first;
-		for(AirFrameMatrix::mapped_type::const_iterator it2 = it1->second.begin(); it2 != it1->second.end(); ++it2)
+		simtime_t_cref s0 = inactiveAirFrames[i].start;
+		simtime_t_cref e0 = inactiveAirFrames[i].end;
+
+		bool bIntersects = (bIsValidStartTime && recordStartTime <= e0);
+
+		for(size_t j = 0; j < activeAirFrames.size() && !bIntersects; ++j)
 		{
-			simtime_t_cref s0 = it2->first;
-
-			bool bIntersects = (bIsValidStartTime && recordStartTime <= e0);
-
-			for(AirFrameMatrix::const_iterator it3 = activeAirFrames.begin();
-				it3 != activeAirFrames.end() && !bIntersects; ++it3)
-			{
-				simtime_t_cref e1 = it3->first;
-				for(AirFrameMatrix::mapped_type::const_iterator it4 = it3->second.begin();
-					it4 != it3->second.end() && !bIntersects; ++it4)
-				{
-					simtime_t_cref s1 = it4->first;
-
-					if(e0 >= s1 && s0 <= e1)
-						bIntersects = true;
-				}
-			}
-			assert(bIntersects);
+			simtime_t_cref s1 = activeAirFrames[j].start;
+			simtime_t_cref e1 = activeAirFrames[j].end;
+
+			if(e0 >= s1 && s0 <= e1)
+				bIntersects = true;
 		}
+		assert(bIntersects);
 	}
 }
 
@@ -126,23 +134,8 @@ void ChannelInfo::deleteAirFrame(AirFrameMatrix& airFrames,
                                  airframe_ptr_t frame,
                                  simtime_t_cref startTime, simtime_t_cref endTime)
 {
-	AirFrameMatrix::iterator listIt = airFrames.find(endTime);
-
-	if (listIt != airFrames.end()) {
-		AirFrameMatrix::mapped_type&          startTimeList = listIt->second;
-		AirFrameMatrix::mapped_type::iterator itEnd         = startTimeList.upper_bound(startTime);
-
-		for(AirFrameMatrix::mapped_type::iterator it = startTimeList.lower_bound(startTime); it != itEnd; ++it) {
-			if(it->second == frame || it->second->getTreeId() == frame->getTreeId()) {
-				startTimeList.erase(it);
-				if(startTimeList.empty()) {
-					airFrames.erase(listIt);
-				}
-				return;
-			}
-		}
-	}
-	assert(false);
+	if (!airFrames.erase(startTime, endTime, frame))
+		assert(false);
 }
 
 bool ChannelInfo::canDiscardInterval(simtime_t_cref startTime,
@@ -161,20 +154,22 @@ void ChannelInfo::checkAndCleanInterval(simtime_t_cref startTime,
                                         simtime_t_cref endTime)
 {
 	// get through inactive AirFrame which intersected with the passed interval
-	iterator itInactiveFrames(&inactiveAirFrames, startTime, endTime);
-	iterator itEnd = end();
-	for (; itInactiveFrames != itEnd;) {
-		airframe_ptr_t pInactiveFrame = itInactiveFrames->second;
-		simtime_t      currentEnd     = itInactiveFrames->first + pInactiveFrame->getDuration();
-
-		if(canDiscardInterval(itInactiveFrames->first, currentEnd)) {
-			erase(itInactiveFrames++);
+	const simtime_t lastEnd = inactiveAirFrames.lastCandidateEnd(endTime);
+	for (size_t i = inactiveAirFrames.firstCandidate(startTime);
+	     i < inactiveAirFrames.size() && inactiveAirFrames[i].end <= lastEnd;)
+	{
+		const AirFrameMatrix::Entry& e = inactiveAirFrames[i];
+		if(e.start <= endTime && canDiscardInterval(e.start, e.end)) {
+			airframe_ptr_t pInactiveFrame = e.frame;
+			deleteAirFrame(channelAirFrames[pInactiveFrame->getChannel()].inactive,
+			               pInactiveFrame, e.start, e.end);
+			inactiveAirFrames.erase(i);
 
 			airFrameStarts.erase(pInactiveFrame->getTreeId());
 			delete pInactiveFrame;
 			continue;
 		}
-		++itInactiveFrames;
+		++i;
 	}
 }
 
@@ -182,8 +177,13 @@ bool ChannelInfo::isIntersecting( const AirFrameMatrix& airFrames
                                 , simtime_t_cref        from
                                 , simtime_t_cref        to)
 {
-	const_iterator it(&airFrames, from, to);
-	return (it != cConstItEnd);
+	const simtime_t lastEnd = airFrames.lastCandidateEnd(to);
+	const size_t    size    = airFrames.size();
+	for (size_t i = airFrames.firstCandidate(from); i < size && airFrames[i].end <= lastEnd; ++i) {
+		if (airFrames[i].start <= to)
+			return true;
+	}
+	return false;
 }
 
 
@@ -3,6 +3,8 @@
 
 #include <list>
 #include <map>
+#include <vector>
+#include <algorithm>
 #include <omnetpp.h>
 
 #include "MiXiMDefs.h"
@@ -65,254 +67,126 @@ public:
     };
 protected:
 	/**
-	 * The AirFrames are stored in a Matrix with start- and end time as
-	 * dimensions.
-	 */
-	typedef std::map<simtime_t, std::multimap<simtime_t, airframe_ptr_t> > AirFrameMatrix;
-
-	struct c_min_start_time_fctr {
-		bool operator() (const AirFrameMatrix::value_type& a, const AirFrameMatrix::value_type& b) {
-			return a.second.key_comp()(a.second.begin()->first, b.second.begin()->first);
-		}
-	};
-
-	/**
-	 * @brief Iterator for every intersection of a specific interval in a
-	 * AirFrameMatrix.
+	 * @brief Interval index of AirFrames with their start and end time.
+	 *
+	 * The AirFrames are stored in one array sorted by end time, then start
+	 * time and then insertion order. Together with the longest duration of
+	 * all stored AirFrames every AirFrame intersecting with an interval
+	 * "from" to "to" has to end inside [from, to + longest duration], so
+	 * intersection queries only look at this part of the array.
 	 *
 	 * A time interval A_start to A_end intersects with another interval B_start
 	 * to B_end iff the following two conditions are fulfilled:
 	 *
-	 * 		1. A_end >= B_start.
-	 * 		2. A_start <= B_end and
-	 *
-	 * Or the defined by the
-	 * opposite: The two intervals do not intersect iff A_end < B_start or
-	 * A_start > B_end.
-	 *
-	 * To iterate over a two dimensional (end-time x start-time) container
-	 * of AirFrames this class iterates over all AirFrame-lists whose end-time
-	 * is bigger or equal than the interval start (intersect condition 1) and in
-	 * each of these lists iterates over all entries but only stops at and
-	 * returns entries which start-time is smaller or equal than the interval
-	 * end (intersection condition 2).
+	 * 		1. A_end >= B_start and
+	 * 		2. A_start <= B_end.
 	 *
-	 * In template form to work as const- and non-const iterator.
+	 * The order of the AirFrames is the same as the one of the former
+	 * end-time x start-time map, so results of calculations summing up the
+	 * intersecting AirFrames do not change.
 	 */
-	template<typename C, typename ItMatrix = typename C::const_iterator, typename ItSubMatrix = typename C::mapped_type::const_iterator>
-	class BaseIntersectionIterator
+	class AirFrameMatrix
 	{
 	public:
-		typedef typename ItSubMatrix::value_type value_type;
-		typedef typename ItSubMatrix::reference  reference;
-		typedef typename ItSubMatrix::pointer    pointer;
+		/** @brief A stored AirFrame together with its start and end time.*/
+		struct Entry {
+			simtime_t      start;
+			simtime_t      end;
+			airframe_ptr_t frame;
 
-		typedef BaseIntersectionIterator<C, ItMatrix, ItSubMatrix> iterator;
+			Entry(simtime_t_cref start, simtime_t_cref end, airframe_ptr_t frame)
+				: start(start), end(end), frame(frame)
+			{}
+		};
 
-		typedef std::bidirectional_iterator_tag iterator_category;
-		typedef ptrdiff_t                       difference_type;
+		/** @brief Type for the sorted array of entries.*/
+		typedef std::vector<Entry> Entries;
 
 	protected:
-		friend class ChannelInfo;
-		typedef BaseIntersectionIterator<C, ItMatrix, ItSubMatrix> _Self;
-		//typedef _Rb_tree_node_base::_Const_Base_ptr _Base_ptr;
-		//typedef const _Rb_tree_node<_Tp>*           _Link_type;
-
-		/** @brief Pointer to the matrix holding the intervals.*/
-		C* intervals;
-
-		/** @brief Point in time to start iterating over intersections.*/
-		simtime_t_cref from;
-
-		/** @brief Point in time to end iterating over intersections.*/
-		simtime_t_cref to;
+		/** @brief Orders entries by end time and start time.*/
+		struct EntryComparator {
+			bool operator() (const Entry& a, const Entry& b) const {
+				return a.end < b.end || (a.end == b.end && a.start < b.start);
+			}
+		};
 
-		/** @brief Iterator over AirFrame end times.*/
-		ItMatrix endIt;
+		/** @brief Orders entries by end time only.*/
+		struct EndComparator {
+			bool operator() (const Entry& a, simtime_t_cref end) const {
+				return a.end < end;
+			}
+		};
 
-		/** @brief Iterator over AirFrame start times.*/
-		ItSubMatrix startIt;
-		ItSubMatrix startItEnd;
+		/** @brief The stored AirFrames.*/
+		Entries entries;
 
-		/** Jumps top next valid entry.
+		/**
+		 * @brief Upper bound for the duration of the stored AirFrames.
 		 *
-		 * ATTENTION: startIt and startItEnd must be set!
+		 * Only reset if the index becomes empty.
 		 */
-	    _Self& jumpToNextValid(ItMatrix endItEnd)
-	    {
-			for (; endIt != endItEnd; startIt = endIt->second.begin()) {
-				// while there are entries left at the current end-time
-				if (startIt != startItEnd) {
-					// check if this entry fulfills the intersection condition
-					// 2 (condition 1 is already fulfilled in the constructor by
-					// the start-value of the end-time-iterator)
-					return *this;
-				}
-				if (++endIt != endItEnd) {
-					startItEnd = endIt->second.upper_bound(to);
-				}
-			}
+		simtime_t maxDuration;
 
-			intervals = NULL;
-			return *this;
-	    }
 	public:
-		/**
-		 * @brief Creates an iterator for the specified interval at the
-		 * specified AirFrameMatrix.
-		 */
-		BaseIntersectionIterator(C* airFrames, simtime_t_cref from, simtime_t_cref to) :
-			intervals(airFrames), from(from), to(to), endIt(), startIt(), startItEnd()
-		{
-			// begin at the smallest end-time-entry fulfilling the intersection
-			// condition 1
-			if (intervals) {
-				endIt = intervals->lower_bound(from);
-				if(endIt != intervals->end()) {
-					startIt    = endIt->second.begin();
-					startItEnd = endIt->second.upper_bound(to);
-					jumpToNextValid(intervals->end());
-				}
-				else {
-					intervals = NULL;
-					startIt   = startItEnd;
-				}
-			}
-			else {
-				startIt = startItEnd;
-			}
-			//we are already pointing at the first unchecked interval
-		}
-		BaseIntersectionIterator(const iterator& __it) :
-			intervals(__it.intervals), from(__it.from), to(__it.to), endIt(__it.endIt), startIt(__it.startIt),  startItEnd(__it.startItEnd)
-		{ }
-
-		reference
-	    operator*() const
-		{
-			if(intervals == NULL || endIt == intervals->end() || startIt == startItEnd)
-				return NULL;
-			return startIt.operator*();
-		}
+		AirFrameMatrix()
+			: entries()
+			, maxDuration(SIMTIME_ZERO)
+		{}
 
-		pointer
-	    operator->() const
-		{
-			if(intervals == NULL || endIt == intervals->end() || startIt == startItEnd)
-				return NULL;
-			return startIt.operator->();
-		}
+		/** @brief Returns true if no AirFrame is stored.*/
+		bool empty() const { return entries.empty(); }
 
-		/**  @brief Increases the iterator to the next intersecting AirFrame.
-		 */
-		_Self&
-		operator++()
-		{
-			if (!intervals)
-				return *this;
-
-			const ItMatrix endItEnd = intervals->end();
-			if(endIt == endItEnd) {
-				intervals = NULL;
-				return *this;
-			}
+		/** @brief Returns the number of stored AirFrames.*/
+		size_t size() const { return entries.size(); }
 
-			if (startIt != startItEnd)
-				++startIt;
+		/** @brief Returns the entry at the passed index.*/
+		const Entry& operator[](size_t i) const { return entries[i]; }
 
-			return jumpToNextValid(endItEnd);
-		}
-
-		/**  @brief Increases the iterator to the next intersecting AirFrame.
-		 */
-		_Self
-		operator++(int)
-	    {
-			_Self __tmp = *this;
-			++(*this);
-			return __tmp;
-	    }
+		/** @brief Returns the end time of the last ending AirFrame.*/
+		simtime_t lastEnd() const { return entries.back().end; }
 
-		/**  @brief Compares two iterators for equality.
+		/**
+		 * @brief Returns the index of the first AirFrame which may intersect
+		 * with an interval starting at "from".
 		 */
-	    bool
-	    operator==(const _Self& __x) const
-	    {
-	    	if (intervals == NULL) {
-	    		if (__x.intervals == NULL)
-	    			return true;
-	    		return (__x.endIt == __x.intervals->end() || __x.startIt == __x.startItEnd); // we have no next element
-	    	}
-	    	if (__x.intervals == NULL) {
-	    		return (endIt == intervals->end() || startIt == endIt->second.end()); // we have no next element
-	    	}
-	    	if( (endIt == intervals->end() && __x.endIt == __x.intervals->end()) || (startIt == startItEnd && __x.startIt == __x.startItEnd) )
-	    		return true;
-	    	return intervals == __x.intervals && from == __x.from && to == __x.to && endIt == __x.endIt && startIt == __x.startIt && startItEnd == __x.startItEnd;
-	    }
+		size_t firstCandidate(simtime_t_cref from) const {
+			return std::lower_bound(entries.begin(), entries.end(), from, EndComparator()) - entries.begin();
+		}
 
-		/**  @brief Compares two iterators for inequality.
+		/**
+		 * @brief Returns the latest end time an AirFrame intersecting with an
+		 * interval ending at "to" can have.
 		 */
-	    bool
-	    operator!=(const _Self& __x) const
-	    { return !(*this == __x); }
-	};
+		simtime_t lastCandidateEnd(simtime_t_cref to) const {
+			return to + maxDuration;
+		}
 
-	/** @brief Type for a const-iterator over an AirFrame interval matrix.*/
-	typedef BaseIntersectionIterator<const AirFrameMatrix,
-									 AirFrameMatrix::const_iterator,
-									 AirFrameMatrix::mapped_type::const_iterator> const_iterator;
-
-	/** @brief The end iterator for the matrix.*/
-	const static const_iterator cConstItEnd;
-
-    /**
-     *  Returns a read-only (constant) iterator that points one past the last
-     *  pair in the AirFrameMatrix.  Iteration is done in ascending order according to
-     *  the end, and start time.
-     */
-	const_iterator end() const {
-		return cConstItEnd;
-	}
+		/** @brief Stores an AirFrame behind all AirFrames with the same times.*/
+		void insert(simtime_t_cref start, simtime_t_cref end, airframe_ptr_t frame) {
+			const Entry e(start, end, frame);
+			entries.insert(std::upper_bound(entries.begin(), entries.end(), e, EntryComparator()), e);
+			if(end - start > maxDuration)
+				maxDuration = end - start;
+		}
 
-	/** @brief Type for a iterator over an AirFrame interval matrix.*/
-	typedef BaseIntersectionIterator<AirFrameMatrix,
-									 AirFrameMatrix::iterator,
-									 AirFrameMatrix::mapped_type::iterator> iterator;
-
-	/** @brief The end iterator for the matrix.*/
-	const static iterator cItEnd;
-    /**
-     *  Returns a read/write iterator that points one past the last
-     *  pair in the AirFrameMatrix.  Iteration is done in ascending order according to
-     *  the end, and start time.
-     */
-	iterator end() {
-		return cItEnd;
-	}
+		/**
+		 * @brief Removes the passed AirFrame (or an AirFrame with the same
+		 * tree id) with the passed times.
+		 *
+		 * @return false if there is no such AirFrame
+		 */
+		bool erase(simtime_t_cref start, simtime_t_cref end, airframe_ptr_t frame);
 
-    /**
-     *  @brief Erases an element from a AirFrameMatrix.
-     *  @param  position  An iterator pointing to the element to be erased.
-     *
-     *  This function erases an element, pointed to by the given
-     *  iterator, from a AirFrameMatrix.  Note that this function only erases
-     *  the element, and that if the element is itself a pointer,
-     *  the pointed-to memory is not touched in any way.  Managing
-     *  the pointer is the user's responsibility.
-     */
-	void erase(const iterator& __position) {
-		assert(__position.endIt   != __position.intervals->end());
-		assert(__position.startIt != __position.startItEnd);
-
-		//erase AirFrame from list
-		__position.endIt->second.erase(__position.startIt);
-
-		//check if we deleted the only entry in the list
-		if(__position.endIt->second.empty()) {
-			__position.intervals->erase(__position.endIt); //delete list from map
+		/** @brief Removes the AirFrame at the passed index.*/
+		void erase(size_t i) {
+			entries.erase(entries.begin() + i);
+			if(entries.empty())
+				maxDuration = SIMTIME_ZERO;
 		}
-	}
+
+		/** @brief Returns the smallest start time of all stored AirFrames.*/
+		simtime_t earliestStart(simtime_t_cref returnTimeIfEmpty) const;
+	};
 
 	/**
 	 * @brief Stores the currently active AirFrames.
@@ -329,6 +203,32 @@ protected:
 	 */
 	AirFrameMatrix inactiveAirFrames;
 
+	/** @brief Active and inactive AirFrames of a single radio channel.*/
+	struct ChannelAirFrames {
+		AirFrameMatrix active;
+		AirFrameMatrix inactive;
+
+		ChannelAirFrames()
+			: active()
+			, inactive()
+		{}
+	};
+
+	/** @brief Type for a map of radio channels to their AirFrames.*/
+	typedef std::map<int, ChannelAirFrames> ChannelAirFramesMap;
+
+	/**
+	 * @brief Stores the active and inactive AirFrames again, partitioned by
+	 * their radio channel.
+	 *
+	 * Only used to answer "getChannelAirFrames()", the life time of the
+	 * AirFrames is managed by "activeAirFrames" and "inactiveAirFrames".
+	 */
+	ChannelAirFramesMap channelAirFrames;
+
+	/** @brief The radio channel "getChannelAirFrames()" returns AirFrames of.*/
+	int currentChannel;
+
 	/** @brief Type for a map of AirFrame pointers to their start time.*/
 	typedef std::map<long, simtime_t> AirFrameStartMap;
 
@@ -368,13 +268,17 @@ protected:
                                 , AirFrameVector&           outVector
                                 , airframe_filter_fctr *const fctrFilter = NULL)
 	{
-	    const_iterator itEnd = cConstItEnd;
-	    for (const_iterator it(&airFrames, from, to); it != itEnd; ++it) {
+	    const simtime_t lastEnd = airFrames.lastCandidateEnd(to);
+	    const size_t    size    = airFrames.size();
+	    for (size_t i = airFrames.firstCandidate(from); i < size && airFrames[i].end <= lastEnd; ++i) {
+	        const AirFrameMatrix::Entry& e = airFrames[i];
+	        if (e.start > to)
+	            continue;
 	        if (fctrFilter != NULL) {
-	            if (!fctrFilter->pass(it->second))
+	            if (!fctrFilter->pass(e.frame))
 	                continue;
 	        }
-	        outVector.push_back(it->second);
+	        outVector.push_back(e.frame);
 	    }
 	}
 
@@ -446,13 +350,15 @@ protected:
 			return;
 
 		//take last ended inactive airframe as end of interval
-		checkAndCleanInterval(start, inactiveAirFrames.rbegin()->first);
+		checkAndCleanInterval(start, inactiveAirFrames.lastEnd());
 	}
 
 public:
 	ChannelInfo()
 		: activeAirFrames()
 		, inactiveAirFrames()
+		, channelAirFrames()
+		, currentChannel(0)
 		, airFrameStarts()
 		, recordStartTime(invalidSimTime)
 	{}
@@ -501,6 +407,42 @@ public:
 	    getIntersections(activeAirFrames, from, to, out, fctrFilter);
 	}
 
+	/**
+	 * @brief Fills the passed AirFrameVector reference with the AirFrames on
+	 * the current radio channel which intersect with the given time interval.
+	 *
+	 * Returns the same AirFrames in the same order as "getAirFrames()" with a
+	 * filter for the current channel would, but only looks at the AirFrames
+	 * of the current channel.
+	 *
+	 * @see setCurrentChannel
+	 */
+	void getChannelAirFrames( simtime_t_cref            from
+                            , simtime_t_cref            to
+                            , AirFrameVector&           out
+                            , airframe_filter_fctr *const fctrFilter = NULL) const
+	{
+	    ChannelAirFramesMap::const_iterator it = channelAirFrames.find(currentChannel);
+	    if (it == channelAirFrames.end())
+	        return;
+
+	    getIntersections(it->second.inactive, from, to, out, fctrFilter);
+	    getIntersections(it->second.active, from, to, out, fctrFilter);
+	}
+
+	/**
+	 * @brief Sets the radio channel "getChannelAirFrames()" returns the
+	 * AirFrames of.
+	 */
+	void setCurrentChannel(int channel) {
+		currentChannel = channel;
+	}
+
+	/** @brief Returns the radio channel set by "setCurrentChannel()".*/
+	int getCurrentChannel() const {
+		return currentChannel;
+	}
+
 	/**
 	 * @brief Returns the current time-point from that information concerning
 	 * AirFrames is needed to be stored.
@@ -16,6 +16,7 @@
 class MiximAirFrame;
 class BaseWorldUtility;
 class ConstMapping;
+class InterferenceTimeline;
 
 /**
  * See Decider.h for definition of DeciderResult
@@ -156,6 +157,15 @@ public:
 	 * phy header for calculation of next air frame handle time.
 	 */
 	virtual long getPhyHeaderLength() const = 0;
+
+	/**
+	 * @brief Returns the incrementally updated sum of the receiving powers
+	 * on the current channel or NULL if the phy layer does not maintain it.
+	 *
+	 * If available, Deciders can use it to sense the channel instead of
+	 * building the RSSI mapping from the AirFrames on the channel.
+	 */
+	virtual const InterferenceTimeline* getNoiseFloor() const { return NULL; }
 };
 
 #endif /*DECIDER_TO_PHY_INTERFACE_H_*/
@@ -0,0 +1,131 @@
+/*
+ * InterferenceAccumulator.cc
+ *
+ *  Sums up the receiving power mappings of the AirFrames on the channel
+ *  into reused buffers.
+ */
+
+#include "InterferenceAccumulator.h"
+
+#include <cassert>
+#include <functional>
+
+#include "MappingUtils.h"
+
+template<class Operator>
+void InterferenceAccumulator::merge(ConstMappingIterator& it1, ConstMappingIterator& it2, Operator op, Buffer& out)
+{
+	out.clear();
+
+	const bool bIt1InRange = it1.inRange();
+	const bool bIt2InRange = it2.inRange();
+
+	if(!bIt1InRange && !bIt2InRange)
+		return;
+
+	if(bIt1InRange && (!bIt2InRange || it1.getPosition() < it2.getPosition())){
+		it2.jumpTo(it1.getPosition());
+	} else {
+		it1.jumpTo(it2.getPosition());
+	}
+
+	while(it1.inRange() || it2.inRange()) {
+		assert(it1.getPosition().isSamePosition(it2.getPosition()));
+
+		const simtime_t& pos = it1.getPosition().getTime();
+		const argument_value_t value = op(it1.getValue(), it2.getValue());
+
+		// same as setting the value through a mapping iterator: an entry at
+		// an already existing position is overwritten
+		if(!out.empty() && out.back().first == pos)
+			out.back().second = value;
+		else
+			out.push_back(std::make_pair(pos, value));
+
+		if(!iterateToNext(it1, it2))
+			break;
+	}
+}
+
+bool InterferenceAccumulator::iterateToNext(ConstMappingIterator& it1, ConstMappingIterator& it2)
+{
+	const bool it1HasNext = it1.hasNext();
+	const bool it2HasNext = it2.hasNext();
+
+	if(!it1HasNext && !it2HasNext)
+		return false;
+
+	if(it1HasNext && (!it2HasNext || it1.getNextPosition() < it2.getNextPosition())){
+		it1.next();
+		it2.iterateTo(it1.getPosition());
+	} else {
+		it2.next();
+		it1.iterateTo(it2.getPosition());
+	}
+	return true;
+}
+
+void InterferenceAccumulator::add(const ConstMapping& f)
+{
+	assert(canAccumulate(f));
+
+	BufferIterator        itSum(sum, interpolator(continueOutOfRange));
+	ConstMappingIterator* itF = f.createConstIterator();
+
+	merge(itSum, *itF, std::plus<argument_value_t>(), merged);
+	delete itF;
+
+	sum.swap(merged);
+	continueOutOfRange = true;
+}
+
+void InterferenceAccumulator::addTo(const ConstMapping& f)
+{
+	assert(canAccumulate(f));
+
+	ConstMappingIterator* itF = f.createConstIterator();
+	BufferIterator        itSum(sum, interpolator(continueOutOfRange));
+
+	merge(*itF, itSum, std::plus<argument_value_t>(), merged);
+	delete itF;
+
+	sum.swap(merged);
+	continueOutOfRange = false;
+}
+
+void InterferenceAccumulator::addDifference(const ConstMapping& f, const ConstMapping& g)
+{
+	assert(canAccumulate(f) && canAccumulate(g));
+
+	// f + g
+	ConstMappingIterator* itF = f.createConstIterator();
+	ConstMappingIterator* itG = g.createConstIterator();
+	merge(*itF, *itG, std::plus<argument_value_t>(), termSum);
+	delete itF;
+	delete itG;
+
+	// (f + g) - f
+	BufferIterator itTermSum(termSum, continuing);
+	itF = f.createConstIterator();
+	merge(itTermSum, *itF, std::minus<argument_value_t>(), termDiff);
+	delete itF;
+
+	// sum + ((f + g) - f)
+	BufferIterator itSum(sum, interpolator(continueOutOfRange));
+	BufferIterator itTermDiff(termDiff, continuing);
+	merge(itSum, itTermDiff, std::plus<argument_value_t>(), merged);
+
+	sum.swap(merged);
+	continueOutOfRange = true;
+}
+
+Mapping* InterferenceAccumulator::createMapping() const
+{
+	Mapping* result = continueOutOfRange ? MappingUtils::createMapping(DimensionSet::timeDomain)
+	                                     : MappingUtils::createMapping(Argument::MappedZero, DimensionSet::timeDomain);
+
+	for(Buffer::const_iterator it = sum.begin(); it != sum.end(); ++it) {
+		result->appendValue(Argument(it->first), it->second);
+	}
+	return result;
+}
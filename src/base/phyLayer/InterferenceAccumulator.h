@@ -0,0 +1,225 @@
+/*
+ * InterferenceAccumulator.h
+ *
+ *  Sums up the receiving power mappings of the AirFrames on the channel
+ *  into reused buffers.
+ */
+
+#ifndef INTERFERENCEACCUMULATOR_H_
+#define INTERFERENCEACCUMULATOR_H_
+
+#include <vector>
+#include <utility>
+#include <omnetpp.h>
+
+#include "MiXiMDefs.h"
+#include "MappingBase.h"
+#include "Interpolation.h"
+
+/**
+ * @brief Sums up time-only mappings (receiving powers, thermal noise) into
+ * a single piecewise linear function without creating a new Mapping for
+ * every summand.
+ *
+ * BaseDecider::calculateRSSIMapping() used to add every AirFrame with
+ * MappingUtils::add() to the previous result, which creates and fills a new
+ * TimeMapping (a std::map) for every interferer and deletes the old one. The
+ * accumulator instead merges every summand in a single sweep over the sorted
+ * key entries of the current sum and of the summand into a second buffer and
+ * then swaps the buffers. The buffers are plain sorted vectors which keep
+ * their capacity between calls, so after a few receptions no allocation is
+ * needed anymore. Only the final result is copied into a new Mapping by
+ * "createMapping()".
+ *
+ * The sweep visits the same positions in the same order as
+ * MappingUtils::applyElementWiseOperator() does and the intermediate sums are
+ * interpolated with the same Linear interpolator (and the same out of range
+ * behavior) a TimeMapping<Linear> uses, so the result is exactly the one
+ * the chain of MappingUtils::add() calls would produce.
+ *
+ * Only mappings with DimensionSet::timeDomain can be accumulated.
+ *
+ * @ingroup phyLayer
+ * @sa BaseDecider::calculateRSSIMapping
+ */
+class MIXIM_API InterferenceAccumulator
+{
+public:
+	/** @brief Type of the values of the accumulated function.*/
+	typedef Argument::mapped_type      argument_value_t;
+	typedef Argument::mapped_type_cref argument_value_cref_t;
+
+	/**
+	 * @brief Sorted key entries of a piecewise linear function of time.
+	 *
+	 * Provides the key_type and mapped_type members the interpolators of
+	 * Interpolation.h expect from their container.
+	 */
+	class Buffer : public std::vector< std::pair<simtime_t, argument_value_t> >
+	{
+	public:
+		typedef simtime_t        key_type;
+		typedef argument_value_t mapped_type;
+	};
+
+protected:
+	/** @brief Linear interpolator used to read a Buffer.*/
+	typedef Linear<Buffer> interpolator_type;
+
+	/**
+	 * @brief Iterates over a Buffer like a TimeMappingIterator iterates over
+	 * a TimeMapping<Linear>.
+	 */
+	class BufferIterator : public ConstMappingIterator
+	{
+	protected:
+		/** @brief Iterator type which does the actual interpolation.*/
+		typedef ConstInterpolateableIterator<interpolator_type> iterator;
+
+		/** @brief Interpolating iterator over the buffer.*/
+		iterator valueIt;
+		/** @brief The current position as Argument.*/
+		Argument position;
+		/** @brief The position a call to "next()" would iterate to.*/
+		Argument nextPosition;
+
+	protected:
+		void updatePositions() {
+			position.setTime(valueIt.getPosition());
+			nextPosition.setTime(valueIt.getNextPosition());
+		}
+
+	public:
+		BufferIterator(const Buffer& buffer, const interpolator_type& intpl)
+			: ConstMappingIterator()
+			, valueIt(buffer.begin(), buffer.end(), intpl)
+			, position()
+			, nextPosition()
+		{
+			updatePositions();
+		}
+
+		virtual void jumpTo(const Argument& pos) {
+			valueIt.jumpTo(pos.getTime());
+			updatePositions();
+		}
+		virtual void iterateTo(const Argument& pos) {
+			valueIt.iterateTo(pos.getTime());
+			updatePositions();
+		}
+		virtual void next() {
+			valueIt.next();
+			updatePositions();
+		}
+		virtual void jumpToBegin() {
+			valueIt.jumpToBegin();
+			updatePositions();
+		}
+
+		virtual bool inRange() const                     { return valueIt.inRange(); }
+		virtual bool hasNext() const                     { return valueIt.hasNext(); }
+		virtual const Argument& getPosition() const      { return position; }
+		virtual const Argument& getNextPosition() const  { return nextPosition; }
+		virtual argument_value_t getValue() const        { return *valueIt.getValue(); }
+	};
+
+protected:
+	/** @brief The current sum.*/
+	Buffer sum;
+	/** @brief Buffer the next sum is written to before it is swapped with "sum".*/
+	Buffer merged;
+	/** @name Scratch buffers for the terms of "addDifference()".*/
+	/*@{*/
+	Buffer termSum;
+	Buffer termDiff;
+	/*@}*/
+
+	/** @brief Interpolator which continues the first/last entry out of range.*/
+	interpolator_type continuing;
+	/** @brief Interpolator which returns zero out of range.*/
+	interpolator_type zeroOutOfRange;
+
+	/** @brief True if the current sum continues its first/last value out of range.*/
+	bool continueOutOfRange;
+
+protected:
+	/**
+	 * @brief Writes the element-wise result of "op" of the functions the
+	 * passed iterators iterate over to "out".
+	 *
+	 * Visits the same positions as MappingUtils::applyElementWiseOperator().
+	 */
+	template<class Operator>
+	static void merge(ConstMappingIterator& it1, ConstMappingIterator& it2, Operator op, Buffer& out);
+
+	/** @brief Mirrors MappingUtils::iterateToNext().*/
+	static bool iterateToNext(ConstMappingIterator& it1, ConstMappingIterator& it2);
+
+	/** @brief Returns the interpolator for the passed out of range behavior.*/
+	const interpolator_type& interpolator(bool continues) const {
+		return continues ? continuing : zeroOutOfRange;
+	}
+
+public:
+	InterferenceAccumulator()
+		: sum()
+		, merged()
+		, termSum()
+		, termDiff()
+		, continuing()
+		, zeroOutOfRange(Argument::MappedZero)
+		, continueOutOfRange(false)
+	{}
+
+	/**
+	 * @brief Resets the sum to an empty function which is zero everywhere.
+	 *
+	 * Corresponds to MappingUtils::createMapping(Argument::MappedZero,
+	 * DimensionSet::timeDomain).
+	 */
+	void reset() {
+		sum.clear();
+		continueOutOfRange = false;
+	}
+
+	/**
+	 * @brief Returns true if the passed mapping can be accumulated.
+	 */
+	static bool canAccumulate(const ConstMapping& f) {
+		return f.getDimensionSet() == DimensionSet::timeDomain;
+	}
+
+	/**
+	 * @brief Adds the passed mapping to the current sum.
+	 *
+	 * Corresponds to "sum = MappingUtils::add(sum, f)", the sum continues
+	 * out of range afterwards.
+	 */
+	void add(const ConstMapping& f);
+
+	/**
+	 * @brief Adds the current sum to the passed mapping.
+	 *
+	 * Corresponds to "sum = MappingUtils::add(f, sum, Argument::MappedZero)",
+	 * the sum is zero out of range afterwards.
+	 */
+	void addTo(const ConstMapping& f);
+
+	/**
+	 * @brief Adds the difference "(f + g) - f" to the current sum.
+	 *
+	 * Corresponds to "sum = MappingUtils::add(sum, MappingUtils::subtract(
+	 * MappingUtils::add(f, g), f))", the sum continues out of range
+	 * afterwards.
+	 */
+	void addDifference(const ConstMapping& f, const ConstMapping& g);
+
+	/**
+	 * @brief Returns a new Mapping with the current sum.
+	 *
+	 * The caller has to delete the returned Mapping.
+	 */
+	Mapping* createMapping() const;
+};
+
+#endif /* INTERFERENCEACCUMULATOR_H_ */
@@ -0,0 +1,96 @@
+/*
+ * InterferenceTimeline.cc
+ *
+ *  Incrementally updated, piecewise constant sum of the receiving powers
+ *  on the channel.
+ */
+
+#include "InterferenceTimeline.h"
+
+#include <cassert>
+#include <algorithm>
+
+InterferenceTimeline::StepMap::iterator InterferenceTimeline::split(simtime_t_cref t)
+{
+	StepMap::iterator it = steps.lower_bound(t);
+	if(it != steps.end() && it->first == t)
+		return it;
+
+	// the new step keeps the power of the step before it (if any)
+	const power_t power = (it == steps.begin()) ? 0.0 : (--StepMap::iterator(it))->second;
+	return steps.insert(it, std::make_pair(t, power));
+}
+
+InterferenceTimeline::StepMap::const_iterator InterferenceTimeline::stepAt(simtime_t_cref t) const
+{
+	StepMap::const_iterator it = steps.upper_bound(t);
+	if(it == steps.begin())
+		return steps.end();
+	return --it;
+}
+
+void InterferenceTimeline::add(simtime_t_cref from, simtime_t_cref to, power_t power)
+{
+	if(!(from < to))
+		return;
+
+	// split at the end first, splitting at "from" does not invalidate "last"
+	StepMap::iterator last = split(to);
+	for(StepMap::iterator it = split(from); it != last; ++it) {
+		it->second += power;
+	}
+}
+
+void InterferenceTimeline::truncate(simtime_t_cref t)
+{
+	StepMap::iterator it = steps.lower_bound(t);
+	if(it == steps.end() && (it == steps.begin() || (--StepMap::iterator(it))->second == 0.0))
+		return;
+
+	steps.erase(it, steps.end());
+	steps.insert(steps.end(), std::make_pair(t, 0.0));
+}
+
+void InterferenceTimeline::removeBefore(simtime_t_cref t)
+{
+	StepMap::iterator it = steps.lower_bound(t);
+	if(it == steps.begin())
+		return;
+
+	if(it == steps.end() || it->first != t) {
+		it = split(t);
+	}
+	steps.erase(steps.begin(), it);
+
+	// a leading zero step does not carry any information
+	if(!steps.empty() && steps.begin()->second == 0.0)
+		steps.erase(steps.begin());
+}
+
+InterferenceTimeline::power_t InterferenceTimeline::getValue(simtime_t_cref t) const
+{
+	StepMap::const_iterator it = stepAt(t);
+	return (it == steps.end()) ? 0.0 : it->second;
+}
+
+InterferenceTimeline::power_t InterferenceTimeline::getMax(simtime_t_cref from, simtime_t_cref to) const
+{
+	assert(from <= to);
+
+	power_t result = getValue(from);
+	for(StepMap::const_iterator it = steps.upper_bound(from); it != steps.end() && !(to < it->first); ++it) {
+		result = std::max(result, it->second);
+	}
+	return result;
+}
+
+InterferenceTimeline::power_t InterferenceTimeline::getMin(simtime_t_cref from, simtime_t_cref to) const
+{
+	assert(from <= to);
+
+	power_t result = getValue(from);
+	for(StepMap::const_iterator it = steps.upper_bound(from); it != steps.end() && !(to < it->first); ++it) {
+		result = std::min(result, it->second);
+	}
+	return result;
+}
@@ -0,0 +1,107 @@
+/*
+ * InterferenceTimeline.h
+ *
+ *  Incrementally updated, piecewise constant sum of the receiving powers
+ *  on the channel.
+ */
+
+#ifndef INTERFERENCETIMELINE_H_
+#define INTERFERENCETIMELINE_H_
+
+#include <map>
+#include <omnetpp.h>
+
+#include "MiXiMDefs.h"
+
+/**
+ * @brief Piecewise constant sum of the receiving powers of the AirFrames on
+ * the channel (the noise floor without thermal noise).
+ *
+ * Every AirFrame adds its power as a rectangle over the time it is received.
+ * The timeline stores the summed power as steps: the power at a key holds
+ * from this key until the next key, before the first key the power is zero.
+ * Adding a rectangle splits the steps at its borders and adds the power to
+ * every step in between. Nothing is ever subtracted: the step at the end of
+ * a rectangle keeps the power which was there before the rectangle was
+ * added, so the steps do not accumulate rounding errors.
+ *
+ * Used by BasePhyLayer to answer channel sense requests without building
+ * the RSSI mapping from all AirFrames again for every request. Finding the
+ * step at the start of a window is logarithmic in the number of steps, the
+ * rest of a window query is linear in the number of steps inside the window.
+ *
+ * @ingroup phyLayer
+ * @sa BasePhyLayer, BaseDecider::calcChannelSenseRSSI
+ */
+class MIXIM_API InterferenceTimeline
+{
+public:
+	/** @brief Type of the power values.*/
+	typedef double power_t;
+
+protected:
+	/** @brief Maps the start of every step to the summed power of this step.*/
+	typedef std::map<simtime_t, power_t> StepMap;
+
+	/** @brief The steps of the timeline.*/
+	StepMap steps;
+
+protected:
+	/**
+	 * @brief Returns the step starting at the passed time, creates it with
+	 * the power at this time if there is no step starting there.
+	 */
+	StepMap::iterator split(simtime_t_cref t);
+
+	/**
+	 * @brief Returns the step which holds at the passed time or steps.end()
+	 * if the passed time is before the first step.
+	 */
+	StepMap::const_iterator stepAt(simtime_t_cref t) const;
+
+public:
+	InterferenceTimeline()
+		: steps()
+	{}
+
+	/**
+	 * @brief Adds the passed power to the timeline for the interval
+	 * [from, to).
+	 */
+	void add(simtime_t_cref from, simtime_t_cref to, power_t power);
+
+	/**
+	 * @brief Discards every step from the passed time on and lets the power
+	 * be zero from then on.
+	 *
+	 * Used to add the AirFrames again which are on the channel at this time,
+	 * for example with their new power after a radio state change.
+	 */
+	void truncate(simtime_t_cref t);
+
+	/**
+	 * @brief Discards the steps before the passed time, the power at and
+	 * after the passed time stays the same.
+	 */
+	void removeBefore(simtime_t_cref t);
+
+	/** @brief Removes every step from the timeline.*/
+	void clear() { steps.clear(); }
+
+	/** @brief Returns true if the power is zero everywhere.*/
+	bool empty() const { return steps.empty(); }
+
+	/** @brief Returns the number of steps in the timeline.*/
+	size_t size() const { return steps.size(); }
+
+	/** @brief Returns the summed power at the passed time.*/
+	power_t getValue(simtime_t_cref t) const;
+
+	/** @brief Returns the maximum summed power in the interval [from, to].*/
+	power_t getMax(simtime_t_cref from, simtime_t_cref to) const;
+
+	/** @brief Returns the minimum summed power in the interval [from, to].*/
+	power_t getMin(simtime_t_cref from, simtime_t_cref to) const;
+};
+
+#endif /* INTERFERENCETIMELINE_H_ */
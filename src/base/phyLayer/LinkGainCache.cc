@@ -0,0 +1,34 @@
+/*
+ * LinkGainCache.cc
+ *
+ *  Per physical layer cache of the distance dependent attenuation of the
+ *  links to the senders.
+ */
+
+#include "LinkGainCache.h"
+
+bool LinkGainCache::lookup(const AnalogueModel* model, int senderId,
+						   const Coord& sendersPos, const Coord& receiverPos, double& value)
+{
+	EntryMap::const_iterator it = entries.find(Key(model, senderId));
+	if(it == entries.end()
+	   || !samePosition(it->second.sendersPos, sendersPos)
+	   || !samePosition(it->second.receiverPos, receiverPos))
+	{
+		++misses;
+		return false;
+	}
+
+	++hits;
+	value = it->second.value;
+	return true;
+}
+
+void LinkGainCache::store(const AnalogueModel* model, int senderId,
+						  const Coord& sendersPos, const Coord& receiverPos, double value)
+{
+	Entry& entry      = entries[Key(model, senderId)];
+	entry.sendersPos  = sendersPos;
+	entry.receiverPos = receiverPos;
+	entry.value       = value;
+}
@@ -0,0 +1,114 @@
+/*
+ * LinkGainCache.h
+ *
+ *  Per physical layer cache of the distance dependent attenuation of the
+ *  links to the senders.
+ */
+
+#ifndef LINKGAINCACHE_H_
+#define LINKGAINCACHE_H_
+
+#include <map>
+#include <utility>
+
+#include "MiXiMDefs.h"
+#include "Coord.h"
+
+class AnalogueModel;
+
+/**
+ * @brief Caches the values analogue models calculate from the positions of
+ * sender and receiver of an AirFrame, like the distance dependent part of a
+ * pathloss.
+ *
+ * Every physical layer owns one cache and passes it to its analogue models
+ * with AnalogueModel::setLinkGainCache(). A value is stored per analogue
+ * model and sender together with the positions it was calculated for and is
+ * only returned again if both positions are still exactly the same. So a
+ * cached value is always the value the model would calculate, in stationary
+ * networks (or for stationary pairs of hosts) it is calculated only once per
+ * link.
+ *
+ * Since the position of the receiver is the same for all entries, the
+ * physical layer clears the whole cache when its host moves (see
+ * BasePhyLayer::receiveSignal()). Entries of moving senders are replaced
+ * on their next lookup.
+ *
+ * The numbers of hits and misses are recorded as scalars by the physical
+ * layer.
+ *
+ * @ingroup phyLayer
+ * @ingroup analogueModels
+ * @sa SimplePathlossModel, BreakpointPathlossModel
+ */
+class MIXIM_API LinkGainCache
+{
+protected:
+	/** @brief A cached value together with the positions it belongs to.*/
+	struct Entry {
+		Coord  sendersPos;
+		Coord  receiverPos;
+		double value;
+	};
+
+	/** @brief Identifies a link of an analogue model by the model and the
+	 * id of the sending module.*/
+	typedef std::pair<const AnalogueModel*, int> Key;
+	typedef std::map<Key, Entry>                 EntryMap;
+
+	/** @brief The cached values.*/
+	EntryMap entries;
+
+	/** @brief Number of lookups which returned a cached value.*/
+	long hits;
+	/** @brief Number of lookups which did not find a valid value.*/
+	long misses;
+
+protected:
+	/** @brief Returns true if both positions are exactly the same.*/
+	static bool samePosition(const Coord& a, const Coord& b) {
+		return a.x == b.x && a.y == b.y && a.z == b.z;
+	}
+
+public:
+	LinkGainCache()
+		: entries()
+		, hits(0)
+		, misses(0)
+	{}
+
+	/**
+	 * @brief Looks up the value the passed model stored for the link from
+	 * the passed sender.
+	 *
+	 * @param model			The analogue model which stored the value.
+	 * @param senderId		The id of the module which sent the AirFrame.
+	 * @param sendersPos	The current position of the sender.
+	 * @param receiverPos	The current position of the receiver.
+	 * @param value			Set to the cached value if there is one.
+	 * @return true if a value for the passed positions has been found.
+	 */
+	bool lookup(const AnalogueModel* model, int senderId,
+				const Coord& sendersPos, const Coord& receiverPos, double& value);
+
+	/**
+	 * @brief Stores the value the passed model calculated for the link from
+	 * the passed sender at the passed positions.
+	 */
+	void store(const AnalogueModel* model, int senderId,
+			   const Coord& sendersPos, const Coord& receiverPos, double value);
+
+	/** @brief Removes all cached values, the counters are kept.*/
+	void clear() { entries.clear(); }
+
+	/** @brief Returns the number of cached values.*/
+	size_t size() const { return entries.size(); }
+
+	/** @brief Returns the number of lookups which returned a cached value.*/
+	long getHits() const { return hits; }
+
+	/** @brief Returns the number of lookups which did not find a valid value.*/
+	long getMisses() const { return misses; }
+};
+
+#endif /* LINKGAINCACHE_H_ */
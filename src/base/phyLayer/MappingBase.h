@@ -5,6 +5,8 @@
 #include <map>
 #include <set>
 #include <string>
+#include <iterator>
+#include <utility>
 #include <algorithm>
 #include <cassert>
 #include <sstream>
@@ -72,9 +74,17 @@ protected:
 	/** @brief The unique id of the dimension this instance represents.*/
 	DimensionIdType id;
 
+	friend class DimensionSet;
+
 protected:
 
 public:
+	/**
+	 * @brief Maximum number of dimensions (including time) which can be
+	 * registered, the ids are used as bit positions by DimensionSet.
+	 */
+	enum { MAX_DIMENSIONS = 64 };
+
 	/** @brief Shortcut to the time Dimension, same as 'Dimension("time")',
 	 * but spares the parsing of a string.*/
 	static const Dimension time;
@@ -164,10 +174,10 @@ public:
  * @brief Represents a set of dimensions which is used to define over which
  * dimensions a mapping is defined (the domain of the mapping).
  *
- * This class actually public extends from std::set<Dimension>. So any method
- * provided by std::set can be also used.
- *
- * The dimensions are stored ordered by their ids.
+ * The set is stored as a bitmask over the dimension ids, so copying,
+ * comparing and the set operations don't allocate memory and take
+ * constant time. The interface is the one of a std::set<Dimension>,
+ * iterating the set yields the dimensions ordered by their ids.
  *
  * Note: Unlike Arguments and Mappings, a DimensionSet does not contain "time"
  * as dimension per default. You'll have to add it like any other dimension.
@@ -175,19 +185,135 @@ public:
  * @author Karl Wessel
  * @ingroup mapping
  */
-class MIXIM_API DimensionSet /*:public std::set<Dimension>*/ {
+class MIXIM_API DimensionSet {
+public:
+	class const_iterator;
+	friend class const_iterator;
 protected:
-	typedef std::set<Dimension> _Base;
+	/** @brief Type of the bitmask, bit i is set if the dimension with id i is in the set.*/
+	typedef unsigned long long mask_type;
+
+	/** @brief The dimensions of this set.*/
+	mask_type bits;
+
+	/** @brief Returns the bit of the passed Dimension.*/
+	static mask_type bitOf(const Dimension& d) {
+		assert(d.getID() >= 0 && d.getID() < Dimension::MAX_DIMENSIONS);
+		return mask_type(1) << d.getID();
+	}
+
+	/** @brief Returns the id of the lowest bit set in the passed (non zero) mask.*/
+	static int lowestID(mask_type mask) {
+#ifdef __GNUC__
+		return __builtin_ctzll(mask);
+#else
+		int id = 0;
+		for(; !(mask & 1); mask >>= 1) ++id;
+		return id;
+#endif
+	}
+
+	/** @brief Returns the id of the highest bit set in the passed (non zero) mask.*/
+	static int highestID(mask_type mask) {
+#ifdef __GNUC__
+		return Dimension::MAX_DIMENSIONS - 1 - __builtin_clzll(mask);
+#else
+		int id = 0;
+		for(; mask >>= 1; ) ++id;
+		return id;
+#endif
+	}
+
+	/**
+	 * @brief Returns the id of the first dimension of the set with an id
+	 * greater or equal to "from", Dimension::MAX_DIMENSIONS if there is none.
+	 */
+	int nextID(int from) const {
+		if(from >= Dimension::MAX_DIMENSIONS)
+			return Dimension::MAX_DIMENSIONS;
+		const mask_type rest = bits & (~mask_type(0) << from);
+		return rest ? lowestID(rest) : Dimension::MAX_DIMENSIONS;
+	}
+
+	/**
+	 * @brief Returns the id of the last dimension of the set with an id
+	 * smaller than "before", Dimension::MAX_DIMENSIONS if there is none.
+	 */
+	int prevID(int before) const {
+		const mask_type rest = (before >= Dimension::MAX_DIMENSIONS) ? bits : bits & ((mask_type(1) << before) - 1);
+		return rest ? highestID(rest) : Dimension::MAX_DIMENSIONS;
+	}
+
+	/**
+	 * @brief Returns a Dimension instance for every possible id.
+	 *
+	 * The iterators return references into this table, so the references
+	 * stay valid when the iterator is moved on.
+	 */
+	static const Dimension& dimensionOf(int id) {
+		//use "construct-on-first-use" idiom to ensure correct order of
+		//static initialization
+		static const Dimension* table = createDimensionTable();
+		return table[id];
+	}
+
+	/** @brief Creates the table used by dimensionOf().*/
+	static const Dimension* createDimensionTable();
 
-	_Base Storage;
 public:
-	typedef _Base::value_type       value_type;
-	typedef _Base::iterator         iterator;
-	typedef _Base::reverse_iterator reverse_iterator;
-	typedef _Base::reverse_iterator const_reverse_iterator;
-	typedef _Base::const_iterator   const_iterator;
-	typedef _Base::size_type        size_type;
-	typedef _Base::const_reference  const_reference;
+	/**
+	 * @brief Bidirectional iterator over the dimensions of a DimensionSet,
+	 * ordered by their ids.
+	 *
+	 * Like the iterators of std::set it stays valid if dimensions are added
+	 * to the set and decrementing begin() stays at begin().
+	 */
+	class const_iterator : public std::iterator< std::bidirectional_iterator_tag
+	                                           , Dimension, std::ptrdiff_t
+	                                           , const Dimension*, const Dimension& > {
+	protected:
+		const DimensionSet* set;
+		/** @brief Id of the current dimension, Dimension::MAX_DIMENSIONS for end().*/
+		int                 id;
+
+	public:
+		const_iterator() : set(NULL), id(Dimension::MAX_DIMENSIONS) {}
+		const_iterator(const DimensionSet* set, int id) : set(set), id(id) {}
+
+		reference operator*() const  { return dimensionOf(id); }
+		pointer   operator->() const { return &dimensionOf(id); }
+
+		const_iterator& operator++() {
+			id = set->nextID(id + 1);
+			return *this;
+		}
+		const_iterator operator++(int) {
+			const_iterator tmp(*this);
+			++(*this);
+			return tmp;
+		}
+		const_iterator& operator--() {
+			const int prev = set->prevID(id);
+			if(prev != Dimension::MAX_DIMENSIONS)
+				id = prev;
+			return *this;
+		}
+		const_iterator operator--(int) {
+			const_iterator tmp(*this);
+			--(*this);
+			return tmp;
+		}
+
+		bool operator==(const const_iterator& o) const { return id == o.id; }
+		bool operator!=(const const_iterator& o) const { return id != o.id; }
+	};
+
+	typedef Dimension                             value_type;
+	typedef const_iterator                        iterator;
+	typedef std::reverse_iterator<const_iterator> reverse_iterator;
+	typedef reverse_iterator                      const_reverse_iterator;
+	typedef size_t                                size_type;
+	typedef const Dimension&                      const_reference;
 
 	/** @brief Shortcut to a DimensionSet which only contains time. */
 	static const DimensionSet timeDomain;
@@ -198,68 +324,56 @@ public:
 	/**
 	 * @brief Default constructor creates an empty DimensionSet
 	 */
-	DimensionSet() : Storage() {}
+	DimensionSet() : bits(0) {}
 
 	/**
 	 * @brief Copy constructor.
 	 */
-	DimensionSet(const DimensionSet& o) : Storage(o.Storage)
+	DimensionSet(const DimensionSet& o) : bits(o.bits)
 	{}
 
 	/**
 	 *  @brief  %DimensionSet assignment operator.
-	 *  @param  copy  A %DimensionSet of identical element and allocator types.
+	 *  @param  copy  A %DimensionSet.
 	 *
 	 *  All the elements of @a copy are copied.
 	 */
 	DimensionSet& operator=(DimensionSet const& copy)
 	{
-		DimensionSet tmp(copy); // All resource all allocation happens here.
-	                            // If this fails the copy will throw an exception
-	                            // and 'this' object is unaffected by the exception.
-		swap(tmp);
+		bits = copy.bits;
 		return *this;
 	}
 
 	/**
 	 *  @brief  Swaps data with another %DimensionSet.
-	 *  @param  s  A %DimensionSet of the same element and allocator types.
+	 *  @param  s  A %DimensionSet.
 	 *
 	 *  This exchanges the elements between two DimensionSet's in constant time.
-	 *  Note that the global std::swap() function is specialized such that
-	 *  std::swap(s1,s2) will feed to this function.
 	 */
 	void swap(DimensionSet& s)
 	{
-		// X::swap(s); // swap the base class members
-		/* Swap all D members */
-		std::swap(Storage, s.Storage);
+		std::swap(bits, s.bits);
 	}
 
 	/**
 	 * @brief Creates a new DimensionSet with the passed Dimension as
 	 * initial Dimension
 	 */
-	DimensionSet(const DimensionSet::value_type& d) : Storage() {
-		Storage.insert(d);
-	}
+	DimensionSet(const DimensionSet::value_type& d) : bits(bitOf(d)) {}
 	/**
 	 * @brief Creates a new DimensionSet with the passed Dimensions as
 	 * initial Dimensions (convenience method)
 	 */
-	DimensionSet(const DimensionSet::value_type& d1, const DimensionSet::value_type& d2) : Storage() {
-		Storage.insert(d1);
-		Storage.insert(d2);
-	}
+	DimensionSet(const DimensionSet::value_type& d1, const DimensionSet::value_type& d2)
+		: bits(bitOf(d1) | bitOf(d2))
+	{}
 	/**
 	 * @brief Creates a new DimensionSet with the passed Dimensions as
 	 * initial Dimensions (convenience method)
 	 */
-	DimensionSet(const DimensionSet::value_type& d1, const DimensionSet::value_type& d2, const DimensionSet::value_type& d3) : Storage() {
-		Storage.insert(d1);
-		Storage.insert(d2);
-		Storage.insert(d3);
-	}
+	DimensionSet(const DimensionSet::value_type& d1, const DimensionSet::value_type& d2, const DimensionSet::value_type& d3)
+		: bits(bitOf(d1) | bitOf(d2) | bitOf(d3))
+	{}
 
 	/**
 	 * @brief Returns true if the passed DimensionSet is a subset
@@ -270,10 +384,7 @@ public:
 	 * DimensionSet.
 	 */
 	bool isSubSet(const DimensionSet& other) const{
-		if(Storage.size() < other.Storage.size())
-			return false;
-
-		return std::includes(Storage.begin(), Storage.end(), other.Storage.begin(), other.Storage.end());
+		return (other.bits & ~bits) == 0;
 	}
 
 	/**
@@ -286,118 +397,90 @@ public:
 	 * which isn't in the other set.
 	 */
 	bool isRealSubSet(const DimensionSet& other) const{
-		if(size() <= other.size())
-			return false;
-
-		return std::includes(begin(), end(), other.begin(), other.end());
+		return isSubSet(other) && bits != other.bits;
 	}
 
 	/**
 	 * @brief Adds the passed dimension to the DimensionSet.
 	 */
 	void addDimension(const DimensionSet::value_type& d) {
-		Storage.insert(d);
+		bits |= bitOf(d);
 	}
 
 	/**
 	 * @brief Returns true if the passed Dimension is inside this DimensionSet.
 	 */
 	bool hasDimension(const DimensionSet::value_type& d) const{
-		return Storage.count(d) > 0;
+		return (bits & bitOf(d)) != 0;
 	}
 
 	/**
 	 * @brief Returns true if the dimensions of both sets are equal.
 	 */
 	bool operator==(const DimensionSet& o) const {
-		if(size() != o.size())
-			return false;
-
-		return std::equal(begin(), end(), o.begin());
-	}
-
-	iterator begin() {
-		return Storage.begin();
-	}
-
-	iterator end() {
-		return Storage.end();
+		return bits == o.bits;
 	}
 
 	const_iterator begin() const {
-		return Storage.begin();
+		return const_iterator(this, nextID(0));
 	}
 
 	const_iterator end() const {
-		return Storage.end();
-	}
-
-	reverse_iterator rbegin() {
-		return Storage.rbegin();
-	}
-
-	reverse_iterator rend() {
-		return Storage.rend();
+		return const_iterator(this, Dimension::MAX_DIMENSIONS);
 	}
 
 	const_reverse_iterator rbegin() const {
-		return Storage.rbegin();
+		return const_reverse_iterator(end());
 	}
 
 	const_reverse_iterator rend() const {
-		return Storage.rend();
+		return const_reverse_iterator(begin());
 	}
 
 	const_iterator find(const value_type& __x) const {
-		return Storage.find(__x);
+		return hasDimension(__x) ? const_iterator(this, __x.getID()) : end();
 	}
 
 	///  Returns the size of the %DimensionSet.
 	size_type size() const {
-		return Storage.size();
+#ifdef __GNUC__
+		return __builtin_popcountll(bits);
+#else
+		size_type n = 0;
+		for(mask_type rest = bits; rest; rest &= rest - 1) ++n;
+		return n;
+#endif
 	}
 
 	/**
-	 *  @brief A template function that attempts to insert a range
-	 *  of elements.
+	 *  @brief A template function that inserts a range of elements.
 	 *  @param  first  Iterator pointing to the start of the range to be
 	 *                 inserted.
 	 *  @param  last  Iterator pointing to the end of the range.
-	 *
-	 *  Complexity similar to that of the range constructor.
 	 */
 	template<typename _InputIterator>
 	void
 	insert(_InputIterator __first, _InputIterator __last)
-	{ Storage.insert(__first, __last); }
+	{
+		for(; __first != __last; ++__first)
+			addDimension(*__first);
+	}
 
 	/**
-	 *  @brief Attempts to insert an element into the %DimensionSet.
-	 *  @param  position  An iterator that serves as a hint as to where the
-	 *                    element should be inserted.
+	 *  @brief Inserts an element into the %DimensionSet.
+	 *  @param  position  Ignored, only there for compatibility with std::set.
 	 *  @param  x  Element to be inserted.
-	 *  @return  An iterator that points to the element with key of @a x (may
-	 *           or may not be the element passed in).
-	 *
-	 *  This function is not concerned about whether the insertion took place,
-	 *  and thus does not return a boolean like the single-argument insert()
-	 *  does.  Note that the first parameter is only a hint and can
-	 *  potentially improve the performance of the insertion process.  A bad
-	 *  hint would cause no gains in efficiency.
-	 *
-	 *  For more on @a hinting, see:
-	 *  http://gcc.gnu.org/onlinedocs/libstdc++/manual/bk01pt07ch17.html
-	 *
-	 *  Insertion requires logarithmic time (if the hint is not taken).
+	 *  @return  An iterator that points to the element with key of @a x.
 	 */
 	iterator
-	insert(const_iterator __position, const value_type& __x) {
-		return Storage.insert(__position, __x);
+	insert(const_iterator /*__position*/, const value_type& __x) {
+		addDimension(__x);
+		return const_iterator(this, __x.getID());
 	}
 
 	///  Returns true if the %DimensionSet is empty.
 	bool empty() const {
-		return Storage.empty();
+		return bits == 0;
 	}
 };
 
@@ -407,6 +490,10 @@ public:
  * Defines values for a specified set of dimensions, but at
  * least for the time dimension.
  *
+ * The values of the other dimensions are stored inside the Argument in an
+ * array sorted by dimension, so creating and copying Arguments doesn't
+ * allocate memory.
+ *
  * Note: Currently an Argument can be maximal defined over ten Dimensions
  * plus the time dimension!
  *
@@ -423,20 +510,25 @@ public:
 	const static mapped_type         MappedZero;
 	/** @brief One value of a Argument value. */
 	const static mapped_type         MappedOne;
+
+	/** @brief Maximum number of dimensions besides time an Argument can be defined over. */
+	enum { MAX_VALUES = 10 };
 protected:
-	typedef std::map<key_type, mapped_type> container_type;
-	typedef container_type::value_type      value_type;
+	typedef std::pair<key_type, mapped_type> value_type;
 	/** @brief Stores the time dimension in Omnet's time type */
 	simtime_t      time;
 
-	/** @brief Maps the dimensions of this Argument to their values. */
-	container_type values;
+	/** @brief Number of used entries in "values". */
+	size_t         count;
+
+	/** @brief The dimensions of this Argument and their values, sorted by dimension. */
+	value_type     values[MAX_VALUES];
 
 public:
 	/** @brief Iterator type for this set.*/
-	typedef container_type::iterator       iterator;
+	typedef value_type*       iterator;
 	/** @brief Const-iterator type for this set.*/
-	typedef container_type::const_iterator const_iterator;
+	typedef const value_type* const_iterator;
 
 protected:
 	/**
@@ -454,24 +546,12 @@ protected:
 	 */
 	inline iterator insertValue(iterator pos, const Argument::value_type& valPair, iterator& itEnd, bool ignoreUnknown = false);
 
-	template<typename IteratorType>
-	class key_iterator : public IteratorType
-	{
-	public:
-	    typedef typename IteratorType::value_type::first_type& reference;
-	    typedef typename IteratorType::value_type::first_type* pointer;
-
-	    key_iterator(const IteratorType& other) : IteratorType(other) {} ;
-
-	    const reference operator *() const
-	    {
-	        return IteratorType::operator*().first;
-	    }
-	    pointer operator ->() const
-	    {
-	        return &IteratorType::operator->()->first;
-	    }
-	};
+	/**
+	 * @brief Inserts the passed value in front of "pos" and moves the
+	 * following values one position back.
+	 */
+	iterator insertAt(iterator pos, const Argument::value_type& valPair);
+
 public:
 	/**
 	 * @brief Initialize this argument with the passed value for
@@ -486,6 +566,11 @@ public:
 	 */
 	Argument(const DimensionSet& dims, simtime_t_cref timeVal = SIMTIME_ZERO);
 
+	/**
+	 * @brief Copy constructor, copies only the used values.
+	 */
+	Argument(const Argument& o);
+
 	/**
 	 * @brief Returns the time value of this argument.
 	 */
@@ -597,12 +682,11 @@ public:
 	 * dimensions inside this Argument.
 	 */
 	DimensionSet getDimensions() const {
-		typedef key_iterator<const_iterator> key_const_iterator;
-
 		DimensionSet res(Dimension::time);
 
-		res.insert(key_const_iterator(values.begin()), key_const_iterator(values.end()));
-
+		for (const_iterator it = begin(); it != end(); ++it) {
+			res.addDimension(it->first);
+		}
 		return res;
 	}
 
@@ -631,21 +715,21 @@ public:
 	/**
 	 * @brief Returns an iterator to the first argument value in this Argument.
 	 */
-	iterator begin() { return values.begin(); }
+	iterator begin() { return values; }
 	/**
 	 * @brief Returns an iterator to the first argument value in this Argument.
 	 */
-	const_iterator begin() const { return values.begin(); }
+	const_iterator begin() const { return values; }
 
 
 	/**
 	 * @brief Returns an iterator to the value behind the last argument value.
 	 */
-	iterator end() { return values.end(); }
+	iterator end() { return values + count; }
 	/**
 	 * @brief Returns an iterator to the value behind the last argument value.
 	 */
-	const_iterator end() const { return values.end(); }
+	const_iterator end() const { return values + count; }
 
 	/**
 	 * @brief Returns an iterator to the Argument value for the passed Dimension.
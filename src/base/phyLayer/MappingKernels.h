@@ -0,0 +1,158 @@
+/*
+ * MappingKernels.h
+ *
+ *  Vectorised minimum/maximum searches over the values of mappings.
+ */
+
+#ifndef MAPPINGKERNELS_H_
+#define MAPPINGKERNELS_H_
+
+#include <cstddef>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "MiXiMDefs.h"
+
+/**
+ * @brief Vectorised minimum and maximum searches for MappingUtils::findMin()
+ * and MappingUtils::findMax() on TimeSeriesMappings.
+ *
+ * The searches work on the values of the key entries of a mapping. Since
+ * TimeSeriesMapping stores every value together with its position, the
+ * values are read with a stride.
+ *
+ * Which instruction set is used is decided at compile time: AVX2 if MiXiM
+ * is compiled with -mavx2 (or -march=native on such a machine), SSE2 on
+ * every x86-64 compiler and a scalar loop otherwise. Like the scalar search
+ * every lane replaces its current extreme value only by a more extreme one,
+ * so all variants find the same value. Only the sign of a zero result can
+ * differ, since the lanes compare the values in a different order.
+ *
+ * The element-wise operators of MappingUtils are not vectorised: sampling
+ * both operands at the merged key positions costs far more than the
+ * arithmetic, and writing the samples into buffers first made
+ * TimeSeriesMapping::applyElementWiseOperator() slower.
+ *
+ * @ingroup mapping
+ * @sa TimeSeriesMapping
+ */
+class MappingKernels
+{
+protected:
+#if defined(__AVX2__)
+	/** @brief Number of doubles processed at once.*/
+	enum { WIDTH = 4 };
+	typedef __m256d vector_t;
+
+	static vector_t load(const double* p, size_t s)     { return _mm256_set_pd(p[3 * s], p[2 * s], p[s], p[0]); }
+	static void     store(double* p, vector_t v)        { _mm256_storeu_pd(p, v); }
+	static vector_t broadcast(double v)                 { return _mm256_set1_pd(v); }
+	// (v > acc) ? v : acc like the scalar search, NaN values are skipped
+	static vector_t max(vector_t v, vector_t acc)       { return _mm256_max_pd(v, acc); }
+	static vector_t min(vector_t v, vector_t acc)       { return _mm256_min_pd(v, acc); }
+#elif defined(__SSE2__)
+	/** @brief Number of doubles processed at once.*/
+	enum { WIDTH = 2 };
+	typedef __m128d vector_t;
+
+	static vector_t load(const double* p, size_t s)     { return _mm_set_pd(p[s], p[0]); }
+	static void     store(double* p, vector_t v)        { _mm_storeu_pd(p, v); }
+	static vector_t broadcast(double v)                 { return _mm_set1_pd(v); }
+	// (v > acc) ? v : acc like the scalar search, NaN values are skipped
+	static vector_t max(vector_t v, vector_t acc)       { return _mm_max_pd(v, acc); }
+	static vector_t min(vector_t v, vector_t acc)       { return _mm_min_pd(v, acc); }
+#endif
+
+#if defined(__AVX2__) || defined(__SSE2__)
+	/** @brief Stores the lanes of the passed vector in "out".*/
+	static void lanes(vector_t v, double* out) { store(out, v); }
+#endif
+
+public:
+	/** @brief Returns the name of the instruction set the kernels use.*/
+	static const char* instructionSet() {
+#if defined(__AVX2__)
+		return "AVX2";
+#elif defined(__SSE2__)
+		return "SSE2";
+#else
+		return "scalar";
+#endif
+	}
+
+	/**
+	 * @brief Returns the maximum of "init" and the values v[0], v[stride],
+	 * ..., v[(n - 1) * stride].
+	 *
+	 * A value replaces the current maximum only if it is bigger, so NaN
+	 * values are skipped and a NaN "init" is returned unchanged.
+	 */
+	static double max(const double* v, size_t n, size_t stride, double init) {
+		size_t i   = 0;
+		double res = init;
+#if defined(__AVX2__) || defined(__SSE2__)
+		if(n >= 2 * WIDTH && res == res) {
+			// two accumulators hide the latency of the comparison
+			vector_t acc1 = broadcast(res);
+			vector_t acc2 = acc1;
+			for(; i + 2 * WIDTH <= n; i += 2 * WIDTH) {
+				acc1 = max(load(v + i * stride, stride), acc1);
+				acc2 = max(load(v + (i + WIDTH) * stride, stride), acc2);
+			}
+			double l[2 * WIDTH];
+			lanes(acc1, l);
+			lanes(acc2, l + WIDTH);
+			for(int j = 0; j < 2 * WIDTH; ++j) {
+				if(l[j] > res)
+					res = l[j];
+			}
+		}
+#endif
+		for(; i < n; ++i) {
+			if(v[i * stride] > res)
+				res = v[i * stride];
+		}
+		return res;
+	}
+
+	/**
+	 * @brief Returns the minimum of "init" and the values v[0], v[stride],
+	 * ..., v[(n - 1) * stride].
+	 *
+	 * A value replaces the current minimum only if it is smaller, so NaN
+	 * values are skipped and a NaN "init" is returned unchanged.
+	 */
+	static double min(const double* v, size_t n, size_t stride, double init) {
+		size_t i   = 0;
+		double res = init;
+#if defined(__AVX2__) || defined(__SSE2__)
+		if(n >= 2 * WIDTH && res == res) {
+			// two accumulators hide the latency of the comparison
+			vector_t acc1 = broadcast(res);
+			vector_t acc2 = acc1;
+			for(; i + 2 * WIDTH <= n; i += 2 * WIDTH) {
+				acc1 = min(load(v + i * stride, stride), acc1);
+				acc2 = min(load(v + (i + WIDTH) * stride, stride), acc2);
+			}
+			double l[2 * WIDTH];
+			lanes(acc1, l);
+			lanes(acc2, l + WIDTH);
+			for(int j = 0; j < 2 * WIDTH; ++j) {
+				if(l[j] < res)
+					res = l[j];
+			}
+		}
+#endif
+		for(; i < n; ++i) {
+			if(v[i * stride] < res)
+				res = v[i * stride];
+		}
+		return res;
+	}
+};
+
+#endif /* MAPPINGKERNELS_H_ */
@@ -14,6 +14,16 @@ FilledUpMappingIterator::FilledUpMappingIterator(FilledUpMapping& mapping):
 FilledUpMappingIterator::FilledUpMappingIterator(FilledUpMapping& mapping, const Argument& pos):
 	MultiDimMappingIterator<Linear>(mapping, pos) {}
 
+MappingIterator* TimeSeriesMapping::createIterator() {
+	return new TimeSeriesMappingIterator(*this);
+}
+
+MappingIterator* TimeSeriesMapping::createIterator(const Argument& pos) {
+	TimeSeriesMappingIterator* it = new TimeSeriesMappingIterator(*this);
+	it->jumpTo(pos);
+	return it;
+}
+
 const Argument::mapped_type MappingUtils::cMinNotFound =  std::numeric_limits<Argument::mapped_type>::infinity();
 const Argument::mapped_type MappingUtils::cMaxNotFound = -std::numeric_limits<Argument::mapped_type>::infinity();
 
@@ -86,7 +96,7 @@ Mapping* MappingUtils::createMapping(const DimensionSet& domain, Mapping::Interp
 	if(domain.size() == 1){
 		switch(intpl){
 		case Mapping::LINEAR:
-			return new TimeMapping<Linear>();
+			return new TimeSeriesMapping();
 			break;
 		case Mapping::NEAREST:
 			return new TimeMapping<Nearest>();
@@ -118,7 +128,7 @@ Mapping* MappingUtils::createMapping(Mapping::argument_value_cref_t outOfRangeVa
 	if(domain.size() == 1){
 		switch(intpl){
 		case Mapping::LINEAR:
-			return new TimeMapping<Linear>(outOfRangeVal);
+			return new TimeSeriesMapping(outOfRangeVal);
 			break;
 		case Mapping::NEAREST:
 			return new TimeMapping<Nearest>(outOfRangeVal);
@@ -204,6 +214,9 @@ Mapping* operator-(const ConstMapping& f1,const  ConstMapping& f2) {
 
 
 Mapping::argument_value_t MappingUtils::findMax(const ConstMapping& m, Argument::mapped_type_cref cRetNotFound /*= cMaxNotFound*/) {
+	if(const TimeSeriesMapping* ts = dynamic_cast<const TimeSeriesMapping*>(&m))
+		return ts->findMax(cRetNotFound);
+
 	ConstMappingIterator*     it       = m.createConstIterator();
 	bool                      bIsFirst = true;
 	Mapping::argument_value_t res;
@@ -236,6 +249,9 @@ Mapping::argument_value_t MappingUtils::findMax(const ConstMapping& m, const Arg
 	assert(pRangeFrom.getDimensions().isSubSet(rDimSet));
 	assert(pRangeTo.getDimensions().isSubSet(rDimSet));
 
+	if(const TimeSeriesMapping* ts = dynamic_cast<const TimeSeriesMapping*>(&m))
+		return ts->findMax(pRangeFrom.getTime(), pRangeTo.getTime(), cRetNotFound);
+
 	ConstMappingIterator*     it       = m.createConstIterator(pRangeFrom);
 	bool                      bIsFirst = true;
 	Mapping::argument_value_t res;
@@ -287,6 +303,9 @@ Mapping::argument_value_t MappingUtils::findMax(const ConstMapping& m, const Arg
 }
 
 Mapping::argument_value_t MappingUtils::findMin(const ConstMapping& m, Argument::mapped_type_cref cRetNotFound /*= cMinNotFound*/) {
+	if(const TimeSeriesMapping* ts = dynamic_cast<const TimeSeriesMapping*>(&m))
+		return ts->findMin(cRetNotFound);
+
 	ConstMappingIterator*     it       = m.createConstIterator();
 	bool                      bIsFirst = true;
 	Mapping::argument_value_t res;
@@ -319,6 +338,9 @@ Mapping::argument_value_t MappingUtils::findMin(const ConstMapping& m, const Arg
 	assert(pRangeFrom.getDimensions().isSubSet(rDimSet));
 	assert(pRangeTo.getDimensions().isSubSet(rDimSet));
 
+	if(const TimeSeriesMapping* ts = dynamic_cast<const TimeSeriesMapping*>(&m))
+		return ts->findMin(pRangeFrom.getTime(), pRangeTo.getTime(), cRetNotFound);
+
 	Mapping::argument_value_t res;
 	bool                      bIsFirst = true;
 	ConstMappingIterator*     it       = m.createConstIterator(pRangeFrom);
@@ -8,8 +8,13 @@
 #ifndef SIGNALINTERFACES_H_
 #define SIGNALINTERFACES_H_
 
+#include <vector>
+#include <utility>
+#include <functional>
+
 #include "MiXiMDefs.h"
 #include "MappingBase.h"
+#include "MappingKernels.h"
 
 class FilledUpMapping;
 
@@ -391,6 +396,509 @@ public:
 	}
 };
 
+/**
+ * @brief Implements the Mapping-interface for functions over time only with
+ * linear interpolation on top of a sorted array of key entries.
+ *
+ * Behaves exactly like a TimeMapping<Linear> (same interpolation, same out of
+ * range behavior, same positions visited by its iterators) but stores its
+ * key entries in one contiguous array instead of a std::map. Appending
+ * entries in order, searching positions and iterating are therefore cheap.
+ *
+ * MappingUtils::createMapping() returns this mapping for linear
+ * interpolated mappings with only time as domain. The element-wise
+ * operations (add, multiply, ...) and findMin()/findMax() of MappingUtils
+ * detect it and work directly on the arrays instead of using the virtual
+ * ConstMappingIterator interface.
+ *
+ * @ingroup mapping
+ */
+class MIXIM_API TimeSeriesMapping:public Mapping {
+public:
+	/**
+	 * @brief Sorted key entries of a TimeSeriesMapping.
+	 *
+	 * Provides the key_type and mapped_type members the interpolators of
+	 * Interpolation.h expect from their container.
+	 */
+	class Storage : public std::vector< std::pair<simtime_t, argument_value_t> > {
+	public:
+		typedef simtime_t        key_type;
+		typedef argument_value_t mapped_type;
+	};
+
+	/** @brief The interpolator used to calculate values between the entries.*/
+	typedef Linear<Storage> interpolator_type;
+
+	/**
+	 * @brief Non virtual read only iterator over a TimeSeriesMapping.
+	 *
+	 * Moves exactly like the iterator of a TimeMapping<Linear>, but uses an
+	 * index into the key entries and plain simtime_t positions.
+	 */
+	class Cursor {
+	protected:
+		/** @brief The mapping to iterate over.*/
+		const TimeSeriesMapping* mapping;
+		/** @brief Index of the first entry after the current position.*/
+		size_t                   right;
+		/** @brief The current position.*/
+		simtime_t                position;
+
+	public:
+		Cursor(const TimeSeriesMapping& m)
+			: mapping(&m)
+			, right(0)
+			, position()
+		{
+			jumpToBegin();
+		}
+
+		/** @brief Moves the cursor to the first entry.*/
+		void jumpToBegin() {
+			const Storage& entries = mapping->entries;
+			right = 0;
+			if(right < entries.size()) {
+				position = entries[right].first;
+				++right;
+			} else {
+				position = simtime_t();
+			}
+		}
+
+		/** @brief Moves the cursor to an arbitrary position.*/
+		void jumpTo(simtime_t_cref pos) {
+			if(pos == position)
+				return;
+
+			const Storage& entries = mapping->entries;
+			if(!entries.empty())
+				right = std::upper_bound(entries.begin(), entries.end(), pos, mapping->interpolate.comp) - entries.begin();
+			position = pos;
+		}
+
+		/** @brief Moves the cursor forward to a position near the current one.*/
+		void iterateTo(simtime_t_cref pos) {
+			if(pos == position)
+				return;
+
+			const Storage& entries = mapping->entries;
+			while(right < entries.size() && !(pos < entries[right].first))
+				++right;
+			position = pos;
+		}
+
+		/** @brief Moves the cursor to the next entry.*/
+		void next() {
+			if(hasNext()) {
+				position = mapping->entries[right].first;
+				++right;
+			} else
+				position += 1;
+		}
+
+		/** @brief Returns the position a call to "next()" would move to.*/
+		simtime_t getNextPosition() const {
+			if(hasNext())
+				return mapping->entries[right].first;
+			return position + 1;
+		}
+
+		/** @brief Returns true if the position is between the first and the last entry.*/
+		bool inRange() const {
+			const Storage& entries = mapping->entries;
+			return !entries.empty() && !(position < entries.front().first) && !(entries.back().first < position);
+		}
+
+		/** @brief Returns true if there is an entry after the current position.*/
+		bool hasNext() const {
+			return right < mapping->entries.size();
+		}
+
+		/** @brief Returns the current position.*/
+		simtime_t_cref getPosition() const {
+			return position;
+		}
+
+		/** @brief Returns the index of the first entry after the current position.*/
+		size_t getRightIndex() const {
+			return right;
+		}
+
+		/**
+		 * @brief Lets the cursor skip an entry which was inserted directly
+		 * before the entry right of its position.
+		 */
+		void skipInserted() {
+			++right;
+		}
+
+		/** @brief Returns the (interpolated) value at the current position.*/
+		argument_value_t getValue() const {
+			const Storage& entries = mapping->entries;
+			return *mapping->interpolate(entries.begin(), entries.end(), position, entries.begin() + right);
+		}
+	};
+
+protected:
+	/** @brief Stores the key-entries defining the function.*/
+	Storage           entries;
+
+	/** @brief Interpolates the values between the key entries.*/
+	interpolator_type interpolate;
+
+	friend class Cursor;
+	friend class TimeSeriesMappingIterator;
+
+protected:
+	/** @brief Selects the maximum search of MappingKernels.*/
+	struct Bigger {
+		bool operator()(argument_value_cref_t a, argument_value_cref_t b) const { return a > b; }
+		static argument_value_t reduce(const argument_value_t* v, size_t n, size_t stride, argument_value_cref_t init) {
+			return MappingKernels::max(v, n, stride, init);
+		}
+	};
+
+	/** @brief Selects the minimum search of MappingKernels.*/
+	struct Smaller {
+		bool operator()(argument_value_cref_t a, argument_value_cref_t b) const { return a < b; }
+		static argument_value_t reduce(const argument_value_t* v, size_t n, size_t stride, argument_value_cref_t init) {
+			return MappingKernels::min(v, n, stride, init);
+		}
+	};
+
+	/** @brief Returns the distance of two consecutive values of "entries", counted in values.*/
+	static size_t valueStride() {
+		assert(sizeof(Storage::value_type) % sizeof(argument_value_t) == 0);
+		return sizeof(Storage::value_type) / sizeof(argument_value_t);
+	}
+
+	/**
+	 * @brief Returns the extreme value of the function inside [from, to],
+	 * "Compare" decides which of two values is the more extreme one.
+	 *
+	 * Considers the same values as MappingUtils::findMin/findMax(m, from, to),
+	 * the values of the key entries between "from" and "to" are searched by
+	 * MappingKernels.
+	 */
+	template<class Compare>
+	argument_value_t findExtremum(simtime_t_cref from, simtime_t_cref to, argument_value_cref_t notFound) const {
+		Compare          better;
+		Cursor           it(*this);
+		bool             bIsFirst = true;
+		argument_value_t res      = notFound;
+
+		it.jumpTo(from);
+		if(it.inRange()) {
+			res      = it.getValue();
+			bIsFirst = false;
+		}
+
+		// the key entries after "from" and before "to"
+		size_t       first = it.getRightIndex();
+		const size_t last  = std::max(first, static_cast<size_t>(
+		                         std::lower_bound(entries.begin(), entries.end(), to, interpolate.comp) - entries.begin()));
+		if(first < last) {
+			if(bIsFirst) {
+				res      = entries[first].second;
+				bIsFirst = false;
+				++first;
+			}
+			if(first < last)
+				res = Compare::reduce(&entries[first].second, last - first, valueStride(), res);
+		}
+
+		it.iterateTo(to);
+		if(it.inRange()) {
+			const argument_value_t val = it.getValue();
+			if(bIsFirst || better(val, res)) {
+				res      = val;
+				bIsFirst = false;
+			}
+		}
+		return bIsFirst ? notFound : res;
+	}
+
+	/**
+	 * @brief Returns the extreme value of all key entries, "Compare" decides
+	 * which of two values is the more extreme one.
+	 */
+	template<class Compare>
+	argument_value_t findExtremum(argument_value_cref_t notFound) const {
+		if(entries.empty())
+			return notFound;
+		if(entries.size() == 1)
+			return entries.front().second;
+
+		return Compare::reduce(&entries[1].second, entries.size() - 1, valueStride(), entries.front().second);
+	}
+
+public:
+	/**
+	 * @brief Initializes the Mapping, it continues its first and last value
+	 * out of range.
+	 */
+	TimeSeriesMapping():
+		Mapping(), entries(), interpolate() {}
+
+	/**
+	 * @brief Initializes the Mapping with the passed value for positions out
+	 * of range.
+	 */
+	TimeSeriesMapping(argument_value_cref_t outOfRangeVal):
+		Mapping(), entries(), interpolate(outOfRangeVal) {}
+
+	TimeSeriesMapping(const TimeSeriesMapping& o):
+		Mapping(o), entries(o.entries), interpolate(o.interpolate) {}
+
+	virtual ~TimeSeriesMapping() {}
+
+	/**
+	 * @brief returns a deep copy of this mapping instance.
+	 */
+	virtual Mapping* clone() const { return new TimeSeriesMapping(*this); }
+
+	/**
+	 * @brief Returns the value of this Function at the position specified
+	 * by the passed Argument.
+	 *
+	 * This method has logarithmic complexity.
+	 */
+	virtual argument_value_t getValue(const Argument& pos) const {
+		simtime_t_cref t = pos.getTime();
+		return *interpolate(entries.begin(), entries.end(), t,
+		                    std::upper_bound(entries.begin(), entries.end(), t, interpolate.comp));
+	}
+
+	/**
+	 * @brief Changes the value of the function at the specified
+	 * position.
+	 *
+	 * Logarithmic complexity plus the moving of the later entries.
+	 */
+	virtual void setValue(const Argument& pos, argument_value_cref_t value) {
+		simtime_t_cref    t  = pos.getTime();
+		Storage::iterator it = std::lower_bound(entries.begin(), entries.end(), t, interpolate.comp);
+		if(it != entries.end() && it->first == t)
+			it->second = value;
+		else
+			entries.insert(it, std::make_pair(t, value));
+	}
+
+	/**
+	 * @brief Appends the passed entry, constant complexity if the position
+	 * is after the last entry.
+	 */
+	virtual void appendValue(const Argument& pos, argument_value_cref_t value) {
+		if(entries.empty() || entries.back().first < pos.getTime())
+			entries.push_back(std::make_pair(pos.getTime(), value));
+		else
+			setValue(pos, value);
+	}
+
+	/**
+	 * @brief Returns a pointer of a new Iterator which is able to iterate
+	 * over the function and can change the value the iterator points to.
+	 *
+	 * Note: The caller of this method has to delete the returned Iterator
+	 * pointer if it isn't used anymore.
+	 */
+	virtual MappingIterator* createIterator();
+
+	/**
+	 * @brief Returns a pointer of a new Iterator which is able to iterate
+	 * over the function and can change the value the iterator points to.
+	 *
+	 * Note: The caller of this method has to delete the returned Iterator
+	 * pointer if it isn't used anymore.
+	 */
+	virtual MappingIterator* createIterator(const Argument& pos);
+
+	/** @brief Returns the sorted key entries of this mapping.*/
+	const Storage& getEntries() const { return entries; }
+
+	/** @brief Reserves space for the passed number of key entries.*/
+	void reserve(size_t n) { entries.reserve(n); }
+
+	/** @brief Returns true if the first/last value is continued out of range.*/
+	bool continueAtOutOfRange() const { return interpolate.continueAtOutOfRange(); }
+
+	/** @brief Returns the maximum value inside [from, to], see MappingUtils::findMax().*/
+	argument_value_t findMax(simtime_t_cref from, simtime_t_cref to, argument_value_cref_t notFound) const {
+		return findExtremum<Bigger>(from, to, notFound);
+	}
+
+	/** @brief Returns the minimum value inside [from, to], see MappingUtils::findMin().*/
+	argument_value_t findMin(simtime_t_cref from, simtime_t_cref to, argument_value_cref_t notFound) const {
+		return findExtremum<Smaller>(from, to, notFound);
+	}
+
+	/** @brief Returns the maximum value of all key entries, see MappingUtils::findMax().*/
+	argument_value_t findMax(argument_value_cref_t notFound) const {
+		return findExtremum<Bigger>(notFound);
+	}
+
+	/** @brief Returns the minimum value of all key entries, see MappingUtils::findMin().*/
+	argument_value_t findMin(argument_value_cref_t notFound) const {
+		return findExtremum<Smaller>(notFound);
+	}
+
+	/**
+	 * @brief Returns a new TimeSeriesMapping with the element-wise result of
+	 * "op" applied to f1 and f2.
+	 *
+	 * Calculates exactly the same entries as
+	 * MappingUtils::applyElementWiseOperator() does for the generic mappings.
+	 */
+	template<class Operator>
+	static TimeSeriesMapping* applyElementWiseOperator(const TimeSeriesMapping& f1, const TimeSeriesMapping& f2, Operator op,
+	                                                   argument_value_cref_t outOfRangeVal, bool contOutOfRange) {
+		TimeSeriesMapping *const result = contOutOfRange ? new TimeSeriesMapping() : new TimeSeriesMapping(outOfRangeVal);
+
+		Cursor     itF1(f1);
+		Cursor     itF2(f2);
+		const bool bF1InRange = itF1.inRange();
+		const bool bF2InRange = itF2.inRange();
+
+		if(!bF1InRange && !bF2InRange)
+			return result;
+
+		if(bF1InRange && (!bF2InRange || itF1.getPosition() < itF2.getPosition())){
+			itF2.jumpTo(itF1.getPosition());
+		} else {
+			itF1.jumpTo(itF2.getPosition());
+		}
+
+		Storage& out = result->entries;
+		out.reserve(f1.entries.size() + f2.entries.size());
+
+		while(itF1.inRange() || itF2.inRange()) {
+			assert(itF1.getPosition() == itF2.getPosition());
+
+			const argument_value_t value = op(itF1.getValue(), itF2.getValue());
+			if(!out.empty() && out.back().first == itF1.getPosition())
+				out.back().second = value;
+			else
+				out.push_back(std::make_pair(itF1.getPosition(), value));
+
+			const bool it1HasNext = itF1.hasNext();
+			const bool it2HasNext = itF2.hasNext();
+			if(!it1HasNext && !it2HasNext)
+				break;
+
+			if(it1HasNext && (!it2HasNext || itF1.getNextPosition() < itF2.getNextPosition())){
+				itF1.next();
+				itF2.iterateTo(itF1.getPosition());
+			} else {
+				itF2.next();
+				itF1.iterateTo(itF2.getPosition());
+			}
+		}
+
+		return result;
+	}
+};
+
+/**
+ * @brief Iterator of a TimeSeriesMapping which is able to change the
+ * mapping.
+ *
+ * Moves exactly like the iterator of a TimeMapping<Linear>.
+ *
+ * @ingroup mapping
+ */
+class MIXIM_API TimeSeriesMappingIterator:public MappingIterator {
+protected:
+	/** @brief The mapping this iterator changes.*/
+	TimeSeriesMapping*         mapping;
+
+	/** @brief Does the actual iteration.*/
+	TimeSeriesMapping::Cursor  cursor;
+
+	/** @brief Stores the current position of the iterator.*/
+	Argument                   position;
+
+	/** @brief Stores the next position a call of "next()" would jump to.*/
+	Argument                   nextPosition;
+
+protected:
+	void updatePositions() {
+		position.setTime(cursor.getPosition());
+		nextPosition.setTime(cursor.getNextPosition());
+	}
+
+public:
+	TimeSeriesMappingIterator(TimeSeriesMapping& m)
+		: MappingIterator()
+		, mapping(&m)
+		, cursor(m)
+		, position()
+		, nextPosition()
+	{
+		updatePositions();
+	}
+
+	virtual ~TimeSeriesMappingIterator() {}
+
+	virtual void jumpTo(const Argument& pos) {
+		cursor.jumpTo(pos.getTime());
+		updatePositions();
+	}
+
+	virtual void iterateTo(const Argument& pos) {
+		cursor.iterateTo(pos.getTime());
+		updatePositions();
+	}
+
+	virtual void next() {
+		cursor.next();
+		updatePositions();
+	}
+
+	virtual bool inRange() const {
+		return cursor.inRange();
+	}
+
+	virtual const Argument& getPosition() const {
+		return position;
+	}
+
+	virtual const Argument& getNextPosition() const {
+		return nextPosition;
+	}
+
+	virtual argument_value_t getValue() const {
+		return cursor.getValue();
+	}
+
+	virtual void jumpToBegin() {
+		cursor.jumpToBegin();
+		updatePositions();
+	}
+
+	virtual bool hasNext() const {
+		return cursor.hasNext();
+	}
+
+	/**
+	 * @brief Changes (and adds if necessary) the entry at the current
+	 * position.
+	 */
+	virtual void setValue(argument_value_cref_t value) {
+		TimeSeriesMapping::Storage& entries = mapping->entries;
+		const size_t                right   = cursor.getRightIndex();
+
+		if(right > 0 && entries[right - 1].first == cursor.getPosition()) {
+			entries[right - 1].second = value;
+			return;
+		}
+		// the new entry is inserted directly before the entry right of the
+		// cursor, the cursor has to keep pointing to the old entry
+		entries.insert(entries.begin() + right, std::make_pair(cursor.getPosition(), value));
+		cursor.skipInserted();
+	}
+};
+
 
 /**
  * @brief Helper-class for the MultiDimMapping which provides an Iterator
@@ -1851,6 +2359,12 @@ public:
 
 		using std::operator<<;
 
+		// time-only linear mappings are combined directly on their entries
+		const TimeSeriesMapping *const ts1 = dynamic_cast<const TimeSeriesMapping*>(&f1);
+		const TimeSeriesMapping *const ts2 = dynamic_cast<const TimeSeriesMapping*>(&f2);
+		if(ts1 && ts2)
+			return TimeSeriesMapping::applyElementWiseOperator(*ts1, *ts2, op, outOfRangeVal, contOutOfRange);
+
 		const ConstMapping *const f2Comp = createCompatibleMapping(f2, f1);
 		const ConstMapping *const f1Comp = createCompatibleMapping(f1, f2);
 
@@ -12,6 +12,18 @@ void RadioStateAnalogueModel::filterSignal(airframe_ptr_t frame, const Coord& /*
 	signal.addAttenuation(attMapping);
 }
 
+void RadioStateAnalogueModel::Timeline::grow()
+{
+	std::vector<ListEntry> newBuffer(2 * buffer.size());
+	const size_t           newMask = newBuffer.size() - 1;
+
+	for (size_t pos = first; pos != last; ++pos)
+	{
+		newBuffer[pos & newMask] = at(pos);
+	}
+	buffer.swap(newBuffer);
+}
+
 void RadioStateAnalogueModel::cleanUpUntil(simtime_t_cref t)
 {
 	// assert that list is not empty
@@ -313,9 +325,8 @@ void RSAMConstMappingIterator::iterateToOverZeroSwitches(simtime_t_cref t)
     RadioStateAnalogueModel::time_attenuation_collection_type::const_iterator itEnd = rsam->radioStateAttenuation.end();
 	if( it != itEnd && !(t < it->getTime()) )
 	{
-		// and go over (ignore) all zero-time-switches, to the next greater entry (time)
-		while( it != itEnd && !(t < it->getTime()) )
-			++it;
+		// go over (ignore) all zero-time-switches, to the next greater entry (time)
+		it = upper_bound(it, itEnd, t);
 
 		// go back one step, here the iterator 'it' is placed right
 		--it;
@@ -353,3 +364,30 @@ ConstMappingIterator* RSAMMapping::createConstIterator(const Argument& pos) cons
 
 	return rsamCMI;
 }
+
+void* RSAMMapping::freeList = NULL;
+
+void* RSAMMapping::operator new(size_t size)
+{
+	// derived classes have a different size and use the heap
+	if (size != sizeof(RSAMMapping) || freeList == NULL)
+		return ::operator new(size);
+
+	void* p  = freeList;
+	freeList = *static_cast<void**>(p);
+	return p;
+}
+
+void RSAMMapping::operator delete(void* p, size_t size)
+{
+	if (p == NULL)
+		return;
+
+	if (size != sizeof(RSAMMapping))
+	{
+		::operator delete(p);
+		return;
+	}
+	*static_cast<void**>(p) = freeList;
+	freeList                = p;
+}
@@ -2,7 +2,8 @@
 #define PHYUTILS_H_
 
 #include <cassert>
-#include <list>
+#include <iterator>
+#include <vector>
 #include <omnetpp.h>
 
 #include "MiXiMDefs.h"
@@ -51,35 +52,41 @@ protected:
 	class ListEntry
 	{
 	protected:
-		/** @brief The pair representing the time stamp.*/
-		std::pair<simtime_t, Argument::mapped_type> basicTimestamp;
+		/** @brief The time of the time stamp.*/
+		simtime_t             time;
+		/** @brief The attenuation from this time on.*/
+		Argument::mapped_type value;
 
 	public:
+		ListEntry()
+			: time()
+			, value(Argument::MappedZero)
+		{}
+
 		/** @brief Initializes the entry with the passed values.*/
 		ListEntry(simtime_t_cref time, Argument::mapped_type_cref value)
-			: basicTimestamp(time, value)
+			: time(time)
+			, value(value)
 		{}
 
-		virtual ~ListEntry() {}
-
 		/** @brief Returns the time of the entry.*/
 		simtime_t_cref getTime() const {
-			return basicTimestamp.first;
+			return time;
 		}
 
 		/** @brief Sets the time of the entry.*/
 		void setTime(simtime_t_cref time) {
-			basicTimestamp.first = time;
+			this->time = time;
 		}
 
 		/** @brief Returns the value of the entry.*/
 		Argument::mapped_type_cref getValue() const {
-			return basicTimestamp.second;
+			return value;
 		}
 
 		/** @brief Sets the value of the entry.*/
 		void setValue(Argument::mapped_type_cref value) {
-			basicTimestamp.second = value;
+			this->value = value;
 		}
 
 		/**
@@ -107,6 +114,128 @@ protected:
 		}
 	};
 
+	/**
+	 * @brief Ring buffer holding the ListEntries ordered by time.
+	 *
+	 * The entries are stored contiguously in a buffer whose size is a power
+	 * of two and which doubles when it is full. Entries are only appended at
+	 * the back and removed from the front.
+	 *
+	 * The random access iterators address an entry by its absolute position
+	 * (the number of entries appended before it), so they stay valid when
+	 * entries are appended or the buffer grows. "lower_bound" and
+	 * "upper_bound" are logarithmic.
+	 */
+	class Timeline
+	{
+	protected:
+		/** @brief Iterator implementation for const and non-const entries.*/
+		template<class Entry, class Owner>
+		class Iterator : public std::iterator<std::random_access_iterator_tag, ListEntry, std::ptrdiff_t, Entry*, Entry&>
+		{
+		protected:
+			typedef std::iterator<std::random_access_iterator_tag, ListEntry, std::ptrdiff_t, Entry*, Entry&> base_type;
+
+			Owner* owner;
+			/** @brief Absolute position of the entry.*/
+			size_t pos;
+
+			template<class E, class O> friend class Iterator;
+			friend class Timeline;
+
+		public:
+			typedef typename base_type::difference_type difference_type;
+			typedef typename base_type::reference       reference;
+			typedef typename base_type::pointer         pointer;
+
+			Iterator() : owner(NULL), pos(0) {}
+			Iterator(Owner* owner, size_t pos) : owner(owner), pos(pos) {}
+
+			/** @brief Converts an iterator into a const_iterator.*/
+			template<class E, class O>
+			Iterator(const Iterator<E, O>& o) : owner(o.owner), pos(o.pos) {}
+
+			reference operator*() const                  { return owner->at(pos); }
+			pointer   operator->() const                 { return &owner->at(pos); }
+			reference operator[](difference_type n) const { return owner->at(pos + n); }
+
+			Iterator& operator++()                  { ++pos; return *this; }
+			Iterator  operator++(int)               { Iterator tmp(*this); ++pos; return tmp; }
+			Iterator& operator--()                  { --pos; return *this; }
+			Iterator  operator--(int)               { Iterator tmp(*this); --pos; return tmp; }
+			Iterator& operator+=(difference_type n) { pos += n; return *this; }
+			Iterator& operator-=(difference_type n) { pos -= n; return *this; }
+			Iterator  operator+(difference_type n) const { return Iterator(owner, pos + n); }
+			Iterator  operator-(difference_type n) const { return Iterator(owner, pos - n); }
+
+			difference_type operator-(const Iterator& o) const {
+				return static_cast<difference_type>(pos) - static_cast<difference_type>(o.pos);
+			}
+
+			bool operator==(const Iterator& o) const { return pos == o.pos; }
+			bool operator!=(const Iterator& o) const { return pos != o.pos; }
+			bool operator<(const Iterator& o) const  { return pos <  o.pos; }
+			bool operator>(const Iterator& o) const  { return pos >  o.pos; }
+			bool operator<=(const Iterator& o) const { return pos <= o.pos; }
+			bool operator>=(const Iterator& o) const { return pos >= o.pos; }
+		};
+
+		/** @brief The buffer, its size is always a power of two.*/
+		std::vector<ListEntry> buffer;
+		/** @brief Absolute position of the first entry.*/
+		size_t                 first;
+		/** @brief Absolute position behind the last entry.*/
+		size_t                 last;
+
+		/** @brief Returns the entry at the passed absolute position.*/
+		ListEntry&       at(size_t pos)       { return buffer[pos & (buffer.size() - 1)]; }
+		const ListEntry& at(size_t pos) const { return buffer[pos & (buffer.size() - 1)]; }
+
+		/** @brief Doubles the size of the buffer.*/
+		void grow();
+
+	public:
+		typedef ListEntry                                     value_type;
+		typedef Iterator<ListEntry, Timeline>                 iterator;
+		typedef Iterator<const ListEntry, const Timeline>     const_iterator;
+		typedef size_t                                        size_type;
+
+		Timeline()
+			: buffer(16)
+			, first(0)
+			, last(0)
+		{}
+
+		iterator       begin()       { return iterator(this, first); }
+		const_iterator begin() const { return const_iterator(this, first); }
+		iterator       end()         { return iterator(this, last); }
+		const_iterator end() const   { return const_iterator(this, last); }
+
+		size_type size() const { return last - first; }
+		bool      empty() const { return first == last; }
+
+		ListEntry&       front()       { return at(first); }
+		const ListEntry& front() const { return at(first); }
+		ListEntry&       back()        { return at(last - 1); }
+		const ListEntry& back() const  { return at(last - 1); }
+
+		/** @brief Appends the passed entry.*/
+		void push_back(const ListEntry& entry) {
+			if(size() == buffer.size())
+				grow();
+			at(last++) = entry;
+		}
+
+		/**
+		 * @brief Removes the entries in [from, to), "from" has to be begin()
+		 * since entries can only be removed from the front.
+		 */
+		iterator erase(iterator from, iterator to) {
+			assert(from == begin() && to <= end());
+			first = to.pos;
+			return to;
+		}
+	};
 
 	/**
 	 * @brief Indicator variable whether we are currently tracking changes
@@ -115,7 +244,7 @@ protected:
 
 public:
 	/** @brief The type to hold the attenuation's over time. */
-	typedef std::list<ListEntry> time_attenuation_collection_type;
+	typedef Timeline time_attenuation_collection_type;
 	/** @brief Data structure to track the Radios attenuation over time.*/
 	time_attenuation_collection_type radioStateAttenuation;
 
@@ -578,6 +707,13 @@ public:
 class MIXIM_API RSAMMapping : public ConstMapping
 {
 protected:
+	/**
+	 * @brief Memory of deleted RSAMMappings which is reused for new ones.
+	 *
+	 * Every received AirFrame gets its own RSAMMapping, so they are
+	 * allocated from this free list instead of the heap.
+	 */
+	static void* freeList;
 
 	/** @brief Pointer to the RSAM module.*/
 	const RadioStateAnalogueModel* rsam;
@@ -644,6 +780,12 @@ public:
 
 	virtual ~RSAMMapping() {}
 
+	/** @brief Takes the memory from the free list if possible.*/
+	static void* operator new(size_t size);
+
+	/** @brief Puts the memory to the free list.*/
+	static void operator delete(void* p, size_t size);
+
 	/**
 	 * @brief Returns the value of this Function at position specified
 	 * by the passed Argument. Zero-time-switches are ignored here,
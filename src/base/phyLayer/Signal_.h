@@ -2,6 +2,7 @@
 #define SIGNAL_H_
 
 #include <list>
+#include <algorithm>
 #include <omnetpp.h>
 
 #include "MiXiMDefs.h"
@@ -28,6 +29,12 @@
  * The RX-power Mapping is calculated on demand by multiplying the
  * TX-power Mapping with every attenuation Mapping of the signal.
  *
+ * The channel sends a copy of the AirFrame to every receiver in range. The
+ * copies of a Signal share the TX-power and the bitrate Mapping set by the
+ * sender, only the propagation delay and the attenuations belong to every
+ * copy. Setting a new TX-power or bitrate Mapping therefore only changes
+ * the copy it is set on, the shared Mappings themselves must not be changed.
+ *
  * @ingroup phyLayer
  */
 class MIXIM_API Signal {
@@ -41,6 +48,148 @@ public:
 	/** @brief Shortcut type for a list of ConstMappings.*/
 	typedef std::list<ConstMapping*> ConstMappingList;
 
+	/**
+	 * @brief Receiving power mapping which keeps the product of the
+	 * transmission power and the attenuations.
+	 *
+	 * Every iterator of a MultipliedMapping multiplies all of its Mappings
+	 * again. The receiving power instead calculates the product once (for
+	 * time-only signals as a TimeSeriesMapping) and lets every iterator
+	 * iterate over this product until another attenuation is added or the
+	 * Signal is told that an attenuation changed. Single values are still
+	 * calculated from the Mappings directly.
+	 *
+	 * Iterators are only valid as long as the product does not change.
+	 */
+	class ReceivingPowerMapping : public MultipliedMapping {
+	protected:
+		/** @brief The product of all Mappings, NULL if not calculated yet.*/
+		mutable Mapping* product;
+
+	private:
+		/** @brief Copy constructor is not allowed.*/
+		ReceivingPowerMapping(const ReceivingPowerMapping&);
+		/** @brief Assignment operator is not allowed.*/
+		ReceivingPowerMapping& operator=(const ReceivingPowerMapping&);
+
+	public:
+		/**
+		 * @brief Initializes with the passed transmission power and the
+		 * attenuations defined by the passed iterator.
+		 */
+		template<class Iterator>
+		ReceivingPowerMapping(ConstMapping* power, Iterator first, Iterator last):
+			MultipliedMapping(power, first, last, false, Argument::MappedZero),
+			product(NULL) {}
+
+		virtual ~ReceivingPowerMapping() {
+			if(product)
+				delete product;
+		}
+
+		/** @brief Adds another attenuation and discards the product.*/
+		void addMapping(ConstMapping* m) {
+			MultipliedMapping::addMapping(m);
+			if(product) {
+				delete product;
+				product = NULL;
+			}
+		}
+
+		/**
+		 * @brief Returns the product of the transmission power and the
+		 * attenuations, calculates it if necessary.
+		 *
+		 * Ownership of the returned mapping stays with this mapping.
+		 */
+		const ConstMapping* getProduct() const {
+			if(mappings.empty())
+				return refMapping;
+
+			if(!product)
+				product = createConcatenatedMapping();
+			return product;
+		}
+
+		virtual ConstMappingIterator* createConstIterator() const {
+			return getProduct()->createConstIterator();
+		}
+
+		virtual ConstMappingIterator* createConstIterator(const Argument& pos) const {
+			return getProduct()->createConstIterator(pos);
+		}
+	};
+
+protected:
+	/**
+	 * @brief Reference counted pointer to a Mapping shared by the copies
+	 * of a Signal.
+	 *
+	 * The Mapping is deleted together with the last pointer to it. The
+	 * reference count is not thread safe, signals are only copied by the
+	 * simulation thread.
+	 */
+	template<class M>
+	class SharedMapping {
+	protected:
+		/** @brief The shared Mapping and the number of pointers to it.*/
+		struct Holder {
+			M*           mapping;
+			unsigned int refs;
+
+			Holder(M* mapping): mapping(mapping), refs(1) {}
+			~Holder() { delete mapping; }
+		};
+
+		/** @brief The shared holder, NULL if no Mapping is set.*/
+		Holder* holder;
+
+	public:
+		SharedMapping(): holder(NULL) {}
+
+		/** @brief Takes the ownership of the passed Mapping.*/
+		explicit SharedMapping(M* mapping):
+			holder(mapping ? new Holder(mapping) : NULL) {}
+
+		SharedMapping(const SharedMapping& o):
+			holder(o.holder)
+		{
+			if(holder)
+				++holder->refs;
+		}
+
+		~SharedMapping() {
+			if(holder && --holder->refs == 0)
+				delete holder;
+		}
+
+		SharedMapping& operator=(const SharedMapping& o) {
+			SharedMapping tmp(o);
+			swap(tmp);
+			return *this;
+		}
+
+		void swap(SharedMapping& s) {
+			std::swap(holder, s.holder);
+		}
+
+		/** @brief Releases the current Mapping and takes the ownership of the passed one.*/
+		void reset(M* mapping = NULL) {
+			SharedMapping tmp(mapping);
+			swap(tmp);
+		}
+
+		/** @brief Returns the shared Mapping or NULL if none is set.*/
+		M* get() const {
+			return holder ? holder->mapping : NULL;
+		}
+
+		/** @brief Returns the number of signals sharing the Mapping.*/
+		unsigned int useCount() const {
+			return holder ? holder->refs : 0;
+		}
+	};
+
 protected:
 	/** @brief Sender module id, additional definition here because BasePhyLayer will do some selfMessages with AirFrame. */
 	int senderModuleID;
@@ -57,14 +206,14 @@ protected:
 	/** @brief The propagation delay of the transmission. */
 	simtime_t propagationDelay;
 
-	/** @brief Stores the function which describes the power of the signal*/
-	ConstMapping* power;
+	/** @brief Stores the function which describes the power of the signal (shared by all copies)*/
+	SharedMapping<ConstMapping> power;
 
-	/** @brief Stores the function which describes the bitrate of the signal*/
-	Mapping* bitrate;
+	/** @brief Stores the undelayed function which describes the bitrate of the signal (shared by all copies)*/
+	SharedMapping<Mapping> bitrate;
 
-	/** @brief If propagation delay is not zero this stores the undelayed bitrate*/
-	Mapping* txBitrate;
+	/** @brief If propagation delay is not zero this stores the delayed bitrate of this copy*/
+	Mapping* delayedBitrate;
 
 	/** @brief Stores the functions describing the attenuations of the signal*/
 	ConstMappingList attenuations;
@@ -73,19 +222,20 @@ protected:
 	 *
 	 * Will be only calculated on access (thats why it is mutable).
 	 */
-	mutable MultipliedMapping* rcvPower;
+	mutable ReceivingPowerMapping* rcvPower;
 
 protected:
 	/**
 	 * @brief Deletes the rcvPower mapping member because it became
 	 * out-dated.
 	 *
-	 * This happens when transmission power or propagation delay changes.
+	 * This happens when transmission power or propagation delay changes
+	 * or when an attenuation changed its values.
 	 */
 	void markRcvPowerOutdated() {
 		if(rcvPower){
 			if(propagationDelay != 0) {
-				assert(rcvPower->getRefMapping() != power);
+				assert(rcvPower->getRefMapping() != power.get());
 				delete rcvPower->getRefMapping();
 			}
 			delete rcvPower;
@@ -101,13 +251,15 @@ public:
 
 	/**
 	 * @brief Overwrites the copy constructor to make sure that the
-	 * mappings are cloned correct.
+	 * transmission power and bitrate are shared and the attenuations
+	 * are cloned correct.
 	 */
 	Signal(const Signal& o);
 
 	/**
 	 * @brief Overwrites the copy operator to make sure that the
-	 * mappings are cloned correct.
+	 * transmission power and bitrate are shared and the attenuations
+	 * are cloned correct.
 	 */
 	Signal& operator=(const Signal& o);
 
@@ -171,14 +323,17 @@ public:
 	 * @brief Sets the function representing the transmission power
 	 * of the signal.
 	 *
-	 * The ownership of the passed pointer goes to the signal.
+	 * The ownership of the passed pointer goes to the signal. The
+	 * transmission power of the other copies of this signal is not
+	 * changed.
 	 */
 	void setTransmissionPower(ConstMapping* power);
 
 	/**
 	 * @brief Sets the function representing the bitrate of the signal.
 	 *
-	 * The ownership of the passed pointer goes to the signal.
+	 * The ownership of the passed pointer goes to the signal. The
+	 * bitrate of the other copies of this signal is not changed.
 	 */
 	void setBitrate(Mapping* bitrate);
 
@@ -197,15 +352,27 @@ public:
 			rcvPower->addMapping(att);
 	}
 
+	/**
+	 * @brief Tells the signal that the values of one of its attenuations
+	 * changed, the receiving power is calculated again on the next access.
+	 *
+	 * The attenuation of the RadioStateAnalogueModel for example changes
+	 * with every radio state or channel switch during the reception.
+	 */
+	void attenuationChanged() {
+		markRcvPowerOutdated();
+	}
+
 	/**
 	 * @brief Returns the function representing the transmission power
 	 * of the signal.
 	 *
 	 * Be aware that the transmission power mapping is not yet affected
-	 * by the propagation delay!
+	 * by the propagation delay! The mapping is shared with the other
+	 * copies of this signal, use setTransmissionPower() to change it.
 	 */
 	ConstMapping* getTransmissionPower() {
-		return power;
+		return power.get();
 	}
 
 	/**
@@ -216,7 +383,7 @@ public:
 	 * by the propagation delay!
 	 */
 	const ConstMapping* getTransmissionPower() const {
-		return power;
+		return power.get();
 	}
 
 	/**
@@ -224,7 +391,7 @@ public:
 	 * signal.
 	 */
 	const Mapping* getBitrate() const {
-		return bitrate;
+		return delayedBitrate ? delayedBitrate : bitrate.get();
 	}
 
 	/**
@@ -241,21 +408,21 @@ public:
 	 *
 	 * The receiving power is calculated by multiplying the transmission
 	 * power with the attenuation of every receiving phys AnalogueModel.
+	 * The product is calculated once and reused by every iterator over
+	 * the returned mapping, see ReceivingPowerMapping::getProduct().
 	 */
-	const MultipliedMapping* getReceivingPower() const {
+	const ReceivingPowerMapping* getReceivingPower() const {
 		if(!rcvPower)
 		{
-			ConstMapping* tmp = power;
+			ConstMapping* tmp = power.get();
 			if(propagationDelay != 0) {
-				tmp = new ConstDelayedMapping(power, propagationDelay);
+				tmp = new ConstDelayedMapping(power.get(), propagationDelay);
 				// tmp will be deleted in ~Signal(), where rcvPower->getRefMapping()
 				// will be used for accessing this pointer
 			}
-			rcvPower = new MultipliedMapping( tmp
-			                                , attenuations.begin()
-			                                , attenuations.end()
-			                                , false
-			                                , Argument::MappedZero );
+			rcvPower = new ReceivingPowerMapping( tmp
+			                                    , attenuations.begin()
+			                                    , attenuations.end() );
 		}
 
 		return rcvPower;
@@ -0,0 +1,183 @@
+/* -*- mode:c++ -*- ********************************************************
+ * file:        CoordKernels.h
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ***************************************************************************
+ * description: vectorised distance calculations over arrays of positions
+ **************************************************************************/
+
+#ifndef COORDKERNELS_H
+#define COORDKERNELS_H
+
+#include <cstddef>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "MiXiMDefs.h"
+#include "PlainCoord.h"
+
+/**
+ * @brief Vectorised squared distances between one position and an array of
+ * positions, in the plane and on a torus.
+ *
+ * The positions are passed as separate arrays of x, y and z values
+ * (structure of arrays), like FlatNicGrid stores them, so that consecutive
+ * positions fill the lanes of a vector without shuffling.
+ *
+ * Which instruction set is used is decided at compile time: AVX2 if MiXiM
+ * is compiled with -mavx2 (or -march=native on such a machine), SSE2 on
+ * every x86-64 compiler and a scalar loop otherwise. Every lane does the
+ * same operations in the same order as PlainCoord::sqrdist() and
+ * PlainCoord::sqrTorusDist(), so all variants calculate the same values
+ * as Coord (as long as the compiler does not contract the scalar code to
+ * fused multiply-adds).
+ *
+ * @ingroup baseUtils
+ * @ingroup utils
+ * @sa PlainCoord
+ */
+class CoordKernels
+{
+protected:
+#if defined(__AVX2__)
+	/** @brief Number of doubles processed at once.*/
+	enum { WIDTH = 4 };
+	typedef __m256d vector_t;
+
+	static vector_t load(const double* p)              { return _mm256_loadu_pd(p); }
+	static void     store(double* p, vector_t v)       { _mm256_storeu_pd(p, v); }
+	static vector_t broadcast(double v)                { return _mm256_set1_pd(v); }
+	static vector_t add(vector_t a, vector_t b)        { return _mm256_add_pd(a, b); }
+	static vector_t sub(vector_t a, vector_t b)        { return _mm256_sub_pd(a, b); }
+	static vector_t mul(vector_t a, vector_t b)        { return _mm256_mul_pd(a, b); }
+	static vector_t div(vector_t a, vector_t b)        { return _mm256_div_pd(a, b); }
+	// (a < b) ? a : b like std::min(b, a)
+	static vector_t min(vector_t a, vector_t b)        { return _mm256_min_pd(a, b); }
+	static vector_t abs(vector_t v)                    { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), v); }
+	static vector_t floor(vector_t v)                  { return _mm256_floor_pd(v); }
+	/** @brief Sets the lanes of "v" to zero where "c" is zero.*/
+	static vector_t zeroWhereZero(vector_t c, vector_t v) {
+		return _mm256_andnot_pd(_mm256_cmp_pd(c, _mm256_setzero_pd(), _CMP_EQ_OQ), v);
+	}
+#elif defined(__SSE2__)
+	/** @brief Number of doubles processed at once.*/
+	enum { WIDTH = 2 };
+	typedef __m128d vector_t;
+
+	static vector_t load(const double* p)              { return _mm_loadu_pd(p); }
+	static void     store(double* p, vector_t v)       { _mm_storeu_pd(p, v); }
+	static vector_t broadcast(double v)                { return _mm_set1_pd(v); }
+	static vector_t add(vector_t a, vector_t b)        { return _mm_add_pd(a, b); }
+	static vector_t sub(vector_t a, vector_t b)        { return _mm_sub_pd(a, b); }
+	static vector_t mul(vector_t a, vector_t b)        { return _mm_mul_pd(a, b); }
+	static vector_t div(vector_t a, vector_t b)        { return _mm_div_pd(a, b); }
+	// (a < b) ? a : b like std::min(b, a)
+	static vector_t min(vector_t a, vector_t b)        { return _mm_min_pd(a, b); }
+	static vector_t abs(vector_t v)                    { return _mm_andnot_pd(_mm_set1_pd(-0.0), v); }
+	/**
+	 * @brief Rounds the non negative lanes of "v" down.
+	 *
+	 * SSE2 has no rounding instruction: adding and subtracting 2^52 rounds
+	 * to the nearest integer, which is corrected by one if it is bigger.
+	 * Values from 2^52 on are integers already.
+	 */
+	static vector_t floor(vector_t v) {
+		const vector_t big     = _mm_set1_pd(4503599627370496.0); // 2^52
+		const vector_t rounded = _mm_sub_pd(_mm_add_pd(v, big), big);
+		const vector_t down    = _mm_sub_pd(rounded, _mm_and_pd(_mm_cmpgt_pd(rounded, v), _mm_set1_pd(1.0)));
+		const vector_t isBig   = _mm_cmpge_pd(v, big);
+		return _mm_or_pd(_mm_and_pd(isBig, v), _mm_andnot_pd(isBig, down));
+	}
+	/** @brief Sets the lanes of "v" to zero where "c" is zero.*/
+	static vector_t zeroWhereZero(vector_t c, vector_t v) {
+		return _mm_andnot_pd(_mm_cmpeq_pd(c, _mm_setzero_pd()), v);
+	}
+#endif
+
+#if defined(__AVX2__) || defined(__SSE2__)
+	/**
+	 * @brief Distance on a circle of the passed size between the lanes of
+	 * "a" and "b", like PlainCoord::torusDist().
+	 */
+	static vector_t torusDist(vector_t a, vector_t b, vector_t size) {
+		const vector_t difference = abs(sub(a, b));
+		// FWMath::modulo(difference, size)
+		const vector_t dist       = sub(difference, mul(size, floor(div(difference, size))));
+		// the distance is zero for equal values, even if size is zero
+		return zeroWhereZero(difference, min(sub(size, dist), dist));
+	}
+#endif
+
+public:
+	/** @brief Returns the name of the instruction set the kernels use.*/
+	static const char* instructionSet() {
+#if defined(__AVX2__)
+		return "AVX2";
+#elif defined(__SSE2__)
+		return "SSE2";
+#else
+		return "scalar";
+#endif
+	}
+
+	/**
+	 * @brief Writes the squared distances between "pos" and the n positions
+	 * (xs[i], ys[i], zs[i]) to "out".
+	 */
+	static void sqrdist(const double* xs, const double* ys, const double* zs, size_t n,
+	                    const PlainCoord& pos, double* out) {
+		size_t i = 0;
+#if defined(__AVX2__) || defined(__SSE2__)
+		const vector_t px = broadcast(pos.x);
+		const vector_t py = broadcast(pos.y);
+		const vector_t pz = broadcast(pos.z);
+		for(; i + WIDTH <= n; i += WIDTH) {
+			const vector_t dx = sub(load(xs + i), px);
+			const vector_t dy = sub(load(ys + i), py);
+			const vector_t dz = sub(load(zs + i), pz);
+			store(out + i, add(add(mul(dx, dx), mul(dy, dy)), mul(dz, dz)));
+		}
+#endif
+		for(; i < n; ++i) {
+			out[i] = PlainCoord(xs[i], ys[i], zs[i]).sqrdist(pos);
+		}
+	}
+
+	/**
+	 * @brief Writes the squared distances on a torus of the passed size
+	 * between "pos" and the n positions (xs[i], ys[i], zs[i]) to "out".
+	 */
+	static void sqrTorusDist(const double* xs, const double* ys, const double* zs, size_t n,
+	                         const PlainCoord& pos, const PlainCoord& size, double* out) {
+		size_t i = 0;
+#if defined(__AVX2__) || defined(__SSE2__)
+		const vector_t px = broadcast(pos.x);
+		const vector_t py = broadcast(pos.y);
+		const vector_t pz = broadcast(pos.z);
+		const vector_t sx = broadcast(size.x);
+		const vector_t sy = broadcast(size.y);
+		const vector_t sz = broadcast(size.z);
+		for(; i + WIDTH <= n; i += WIDTH) {
+			const vector_t dx = torusDist(load(xs + i), px, sx);
+			const vector_t dy = torusDist(load(ys + i), py, sy);
+			const vector_t dz = torusDist(load(zs + i), pz, sz);
+			store(out + i, add(add(mul(dx, dx), mul(dy, dy)), mul(dz, dz)));
+		}
+#endif
+		for(; i < n; ++i) {
+			out[i] = PlainCoord(xs[i], ys[i], zs[i]).sqrTorusDist(pos, size);
+		}
+	}
+};
+
+#endif
@@ -0,0 +1,137 @@
+/* -*- mode:c++ -*- ********************************************************
+ * file:        PlainCoord.h
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ***************************************************************************
+ * description: plain 3D coordinate without cObject overhead for internal
+ *              hot paths
+ **************************************************************************/
+
+#ifndef PLAINCOORD_H
+#define PLAINCOORD_H
+
+#include <cmath>
+#include <algorithm>
+#include <cassert>
+
+#include "MiXiMDefs.h"
+#include "Coord.h"
+#include "FWMath.h"
+
+/**
+ * @brief Plain 3D coordinate for the internal hot paths of MiXiM.
+ *
+ * Unlike Coord it is not a cObject: it has no virtual functions and
+ * consists of exactly three doubles, so it can be copied with memcpy and
+ * stored densely in arrays. A Coord converts implicitly to a PlainCoord,
+ * "toCoord()" converts back where a module interface expects a Coord.
+ *
+ * The distance functions calculate exactly the same values as the ones of
+ * Coord. CoordKernels calculates them for whole arrays of positions.
+ *
+ * @ingroup baseUtils
+ * @ingroup utils
+ * @sa CoordKernels
+ */
+class PlainCoord
+{
+public:
+	/** @name x, y and z coordinate of the position.*/
+	/*@{*/
+	double x;
+	double y;
+	double z;
+	/*@}*/
+
+public:
+	/** @brief Initializes the origin.*/
+	PlainCoord()
+		: x(0.0), y(0.0), z(0.0)
+	{}
+
+	/** @brief Initializes a coordinate.*/
+	PlainCoord(double x, double y, double z = 0.0)
+		: x(x), y(y), z(z)
+	{}
+
+	/** @brief Converts a Coord.*/
+	PlainCoord(const Coord& c)
+		: x(c.x), y(c.y), z(c.z)
+	{}
+
+	/** @brief Returns the coordinate as Coord.*/
+	Coord toCoord() const { return Coord(x, y, z); }
+
+	/** @brief Subtracts two coordinate vectors.*/
+	friend PlainCoord operator-(const PlainCoord& a, const PlainCoord& b) {
+		return PlainCoord(a.x - b.x, a.y - b.y, a.z - b.z);
+	}
+
+	/** @brief Adds two coordinate vectors.*/
+	friend PlainCoord operator+(const PlainCoord& a, const PlainCoord& b) {
+		return PlainCoord(a.x + b.x, a.y + b.y, a.z + b.z);
+	}
+
+	/**
+	 * @brief Tests whether two coordinate vectors are equal, through the
+	 * FWMath::close function like Coord.
+	 */
+	friend bool operator==(const PlainCoord& a, const PlainCoord& b) {
+		return FWMath::close(a.x, b.x) && FWMath::close(a.y, b.y) && FWMath::close(a.z, b.z);
+	}
+
+	/** @brief Negation of the operator==.*/
+	friend bool operator!=(const PlainCoord& a, const PlainCoord& b) {
+		return !(a == b);
+	}
+
+	/** @brief Returns the square of the length of the position vector.*/
+	double squareLength() const { return x * x + y * y + z * z; }
+
+	/** @brief Returns the length of the position vector.*/
+	double length() const { return sqrt(squareLength()); }
+
+	/** @brief Returns the distance to "a".*/
+	double distance(const PlainCoord& a) const { return (*this - a).length(); }
+
+	/** @brief Returns distance^2 to "a" (omits calling square root).*/
+	double sqrdist(const PlainCoord& a) const { return (*this - a).squareLength(); }
+
+	/**
+	 * @brief Returns the squared distance on a torus of the passed size to
+	 * "b" (omits calling square root).
+	 */
+	double sqrTorusDist(const PlainCoord& b, const PlainCoord& size) const {
+		const double xDist = torusDist(x, b.x, size.x);
+		const double yDist = torusDist(y, b.y, size.y);
+		const double zDist = torusDist(z, b.z, size.z);
+		return xDist * xDist + yDist * yDist + zDist * zDist;
+	}
+
+	/**
+	 * @brief Returns the distance between two values on a circle of the
+	 * passed size, like Coord::sqrTorusDist() does for every axis.
+	 */
+	static double torusDist(double a, double b, double size) {
+		const double difference = fabs(a - b);
+		if (difference == 0)
+			// NOTE: even if size is zero
+			return 0;
+		assert(size != 0);
+		const double dist = FWMath::modulo(difference, size);
+		return std::min(dist, size - dist);
+	}
+};
+
+inline std::ostream& operator<<(std::ostream& os, const PlainCoord& coord)
+{
+	return os << "(" << coord.x << "," << coord.y << "," << coord.z << ")";
+}
+
+#endif
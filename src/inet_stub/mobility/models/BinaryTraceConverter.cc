@@ -0,0 +1,188 @@
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+
+#include "BinaryTraceConverter.h"
+#include "BonnMotionFileCache.h"
+#include "Ns2MotionFileCache.h"
+
+
+Define_Module(BinaryTraceConverter);
+
+
+static double distance(double x1, double y1, double z1, double x2, double y2, double z2)
+{
+    return sqrt((x2 - x1) * (x2 - x1) + (y2 - y1) * (y2 - y1) + (z2 - z1) * (z2 - z1));
+}
+
+namespace {
+struct Position
+{
+    double x, y;
+};
+}
+
+static cXMLElement *firstChildWithTag(cXMLElement *node, const char *tagname)
+{
+    cXMLElement *child = node->getFirstChildWithTag(tagname);
+    if (!child)
+        throw cRuntimeError("Element <%s> has no <%s> child at %s",
+                node->getTagName(), tagname, node->getSourceLocation());
+    return child;
+}
+
+void BinaryTraceConverter::initialize()
+{
+    std::string format = par("inputFormat").stdstringValue();
+    const char *outputFile = par("outputFile");
+
+    BinaryTraceWriter writer;
+    if (format == "ns2")
+        convertNs2(par("traceFile"), writer, par("scrollX"), par("scrollY"));
+    else if (format == "bonnmotion")
+        convertBonnMotion(par("traceFile"), par("is3D").boolValue(), writer);
+    else if (format == "ansim")
+        convertANSim(par("ansimTrace").xmlValue(), writer);
+    else
+        error("Unknown inputFormat '%s', use 'ns2', 'bonnmotion' or 'ansim'", format.c_str());
+
+    writer.write(outputFile, par("chunkSize").longValue());
+    EV << "wrote " << writer.getNumRecords() << " records to binary trace " << outputFile << endl;
+}
+
+void BinaryTraceConverter::convertNs2(const char *filename, BinaryTraceWriter& writer, double scrollX, double scrollY)
+{
+    Ns2MotionFileCache *cache = Ns2MotionFileCache::acquireInstance();
+    const Ns2MotionFile *node;
+    for (int nodeId = 0; (node = cache->getFile(filename, nodeId)) != NULL; nodeId++)
+    {
+        if (node->initial[0] == -1 || node->initial[1] == -1 || node->initial[2] == -1)
+            continue;
+
+        // like Ns2MotionMobility: Z_ is ignored and the setdest commands
+        // are executed in the order of the file, each one when its time has
+        // come and the destination of the previous one is reached
+        double x = node->initial[0] + scrollX, y = node->initial[1] + scrollY;
+        double t = 0;
+        writer.addRecord(nodeId, 0, x, y, 0, 0);
+
+        const Ns2MotionFile::WaypointList& waypoints = node->getWaypoints();
+        for (size_t i = 0; i < waypoints.size(); i++)
+        {
+            const Ns2MotionFile::Waypoint& w = waypoints[i];
+            t = std::max(t, w.time);
+
+            // a setdest with speed 0 keeps the node where it is until the
+            // next one
+            if (w.speed <= 0)
+                continue;
+
+            double tx = w.x + scrollX, ty = w.y + scrollY;
+            double d = distance(x, y, 0, tx, ty, 0);
+            if (d == 0)
+                continue;
+            writer.addRecord(nodeId, t, tx, ty, 0, w.speed);
+            t += d / w.speed;
+            x = tx;
+            y = ty;
+        }
+    }
+    Ns2MotionFileCache::releaseInstance();
+}
+
+void BinaryTraceConverter::convertBonnMotion(const char *filename, bool is3D, BinaryTraceWriter& writer)
+{
+    const BonnMotionFile *bmFile = BonnMotionFileCache::acquireInstance()->getFile(filename);
+    size_t tupleSize = is3D ? 4 : 3;
+    for (int nodeId = 0; nodeId < bmFile->getNumLines(); nodeId++)
+    {
+        const BonnMotionFile::Line& vec = *bmFile->getLine(nodeId);
+        if (vec.size() < tupleSize)
+            continue;
+
+        // the node reaches (xk, yk, zk) at tk
+        double t = vec[0], x = vec[1], y = vec[2], z = is3D ? vec[3] : 0;
+        writer.addRecord(nodeId, t, x, y, z, 0);
+        for (size_t k = tupleSize; k + tupleSize <= vec.size(); k += tupleSize)
+        {
+            double nt = vec[k], nx = vec[k + 1], ny = vec[k + 2], nz = is3D ? vec[k + 3] : 0;
+            double d = distance(x, y, z, nx, ny, nz);
+            if (d > 0 && nt > t)
+                writer.addRecord(nodeId, t, nx, ny, nz, d / (nt - t));
+            else if (d > 0)
+                writer.addRecord(nodeId, nt, nx, ny, nz, 0);
+            t = nt;
+            x = nx;
+            y = ny;
+            z = nz;
+        }
+    }
+    BonnMotionFileCache::releaseInstance();
+}
+
+void BinaryTraceConverter::convertANSim(cXMLElement *rootElem, BinaryTraceWriter& writer)
+{
+    if (strcmp(rootElem->getTagName(), "simulation") != 0)
+        throw cRuntimeError("<simulation> is expected as root element not <%s> at %s",
+              rootElem->getTagName(), rootElem->getSourceLocation());
+    cXMLElement *mobility = firstChildWithTag(rootElem, "mobility");
+
+    // last destination of every node seen so far
+    std::map<int, Position> positions;
+
+    cXMLElementList changes = mobility->getChildrenByTagName("position_change");
+    for (cXMLElementList::const_iterator it = changes.begin(); it != changes.end(); ++it)
+    {
+        cXMLElement *change = *it;
+        const char *nodeIdStr = firstChildWithTag(change, "node_id")->getNodeValue();
+        const char *startTimeStr = firstChildWithTag(change, "start_time")->getNodeValue();
+        const char *endTimeStr = firstChildWithTag(change, "end_time")->getNodeValue();
+        cXMLElement *destElem = firstChildWithTag(change, "destination");
+        const char *xStr = firstChildWithTag(destElem, "xpos")->getNodeValue();
+        const char *yStr = firstChildWithTag(destElem, "ypos")->getNodeValue();
+        if (!nodeIdStr || !startTimeStr || !endTimeStr || !xStr || !yStr)
+            throw cRuntimeError("No content in <node_id>, <start_time>, <end_time>, <destination>/<xpos> or <ypos> element at %s",
+                  change->getSourceLocation());
+
+        int nodeId = atoi(nodeIdStr);
+        double startTime = atof(startTimeStr);
+        double endTime = atof(endTimeStr);
+        Position dest;
+        dest.x = atof(xStr);
+        dest.y = atof(yStr);
+
+        std::map<int, Position>::iterator pos = positions.find(nodeId);
+        if (pos == positions.end())
+        {
+            // like ANSimMobility the first destination is the initial position
+            writer.addRecord(nodeId, 0, dest.x, dest.y, 0, 0);
+            positions[nodeId] = dest;
+            continue;
+        }
+
+        double d = distance(pos->second.x, pos->second.y, 0, dest.x, dest.y, 0);
+        if (d > 0 && endTime > startTime)
+            writer.addRecord(nodeId, startTime, dest.x, dest.y, 0, d / (endTime - startTime));
+        else if (d > 0)
+            writer.addRecord(nodeId, endTime, dest.x, dest.y, 0, 0);
+        pos->second = dest;
+    }
+}
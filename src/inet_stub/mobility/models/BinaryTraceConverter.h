@@ -0,0 +1,56 @@
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef BINARY_TRACE_CONVERTER_H
+#define BINARY_TRACE_CONVERTER_H
+
+#include "INETDefs.h"
+
+#include "BinaryTraceFile.h"
+
+
+/**
+ * @brief Converts a ns2 motion, BonnMotion or ANSim trace into a binary
+ * trace for BinaryTraceMobility. See NED file for more info.
+ *
+ * @ingroup mobility
+ */
+class INET_API BinaryTraceConverter : public cSimpleModule
+{
+  protected:
+    virtual void initialize();
+    virtual void handleMessage(cMessage *msg) { delete msg; }
+
+  public:
+    /**
+     * Adds the records of all nodes of a ns2 motion file, moved by
+     * scrollX/scrollY like in Ns2MotionMobility.
+     */
+    static void convertNs2(const char *filename, BinaryTraceWriter& writer, double scrollX = 0, double scrollY = 0);
+
+    /**
+     * Adds the records of all nodes of a BonnMotion file.
+     */
+    static void convertBonnMotion(const char *filename, bool is3D, BinaryTraceWriter& writer);
+
+    /**
+     * Adds the records of all nodes of an ANSim trace, the given element
+     * has to be its <simulation> root element.
+     */
+    static void convertANSim(cXMLElement *rootElem, BinaryTraceWriter& writer);
+};
+
+#endif
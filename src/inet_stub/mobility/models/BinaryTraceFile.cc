@@ -0,0 +1,342 @@
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+
+// 64 bit off_t for fseeko() and ftello() on 32 bit systems, has to precede
+// all includes
+#ifndef _FILE_OFFSET_BITS
+#define _FILE_OFFSET_BITS 64
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+#include "BinaryTraceFile.h"
+
+
+static const char BINARY_TRACE_MAGIC[8] = { 'M', 'X', 'M', 'T', 'R', 'A', 'C', 'E' };
+
+// fseek() and ftell() use a long, which has 32 bits on Windows and on 32 bit
+// systems, so traces larger than 2 GB need the 64 bit variants
+static int seekTo(FILE *f, uint64 offset)
+{
+#if defined(_MSC_VER) || defined(__MINGW32__)
+    return _fseeki64(f, (__int64)offset, SEEK_SET);
+#else
+    return fseeko(f, (off_t)offset, SEEK_SET);
+#endif
+}
+
+static uint64 tellOffset(FILE *f, const char *filename)
+{
+#if defined(_MSC_VER) || defined(__MINGW32__)
+    __int64 offset = _ftelli64(f);
+#else
+    off_t offset = ftello(f);
+#endif
+    if (offset < 0)
+        throw cRuntimeError("Cannot write binary trace '%s'", filename);
+    return (uint64)offset;
+}
+
+void BinaryTraceWriter::addRecord(int nodeId, double time, double x, double y, double z, double speed)
+{
+    if (nodeId < 0)
+        throw cRuntimeError("Invalid node id %d in mobility trace", nodeId);
+    Entry entry;
+    entry.nodeId = nodeId;
+    entry.time = time;
+    entry.x = x;
+    entry.y = y;
+    entry.z = z;
+    entry.speed = speed;
+    records.push_back(entry);
+}
+
+template<class T>
+static void writeColumn(FILE *f, const std::vector<T>& column, const char *filename)
+{
+    if (!column.empty() && fwrite(&column[0], sizeof(T), column.size(), f) != column.size())
+        throw cRuntimeError("Cannot write binary trace '%s'", filename);
+}
+
+void BinaryTraceWriter::write(const char *filename, unsigned int chunkSize)
+{
+    if (chunkSize == 0)
+        throw cRuntimeError("The chunk size of a binary trace has to be positive");
+
+    std::stable_sort(records.begin(), records.end(), compareTime);
+
+    int numNodes = 0;
+    for (size_t i = 0; i < records.size(); i++)
+        numNodes = std::max(numNodes, records[i].nodeId + 1);
+
+    // time of the next record of the same node
+    std::vector<double> nextTimes(records.size());
+    std::vector<double> lastTimes(numNodes, -1);
+    for (size_t i = records.size(); i-- > 0; )
+    {
+        nextTimes[i] = lastTimes[records[i].nodeId];
+        lastTimes[records[i].nodeId] = records[i].time;
+    }
+
+    std::vector<BinaryTraceNodeEntry> nodeTable(numNodes);
+    for (int n = 0; n < numNodes; n++)
+    {
+        nodeTable[n].firstTime = -1;
+        nodeTable[n].x = nodeTable[n].y = nodeTable[n].z = 0;
+        nodeTable[n].reserved = 0;
+    }
+    for (size_t i = records.size(); i-- > 0; )
+    {
+        BinaryTraceNodeEntry& node = nodeTable[records[i].nodeId];
+        node.firstTime = records[i].time;
+        node.x = records[i].x;
+        node.y = records[i].y;
+        node.z = records[i].z;
+    }
+
+    FILE *f = fopen(filename, "wb");
+    if (!f)
+        throw cRuntimeError("Cannot open file '%s' for writing", filename);
+
+    BinaryTraceHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, BINARY_TRACE_MAGIC, sizeof(header.magic));
+    header.byteOrder = BinaryTraceHeader::BYTE_ORDER_MARK;
+    header.version = BinaryTraceHeader::VERSION;
+    header.numNodes = numNodes;
+    header.chunkSize = chunkSize;
+    header.numRecords = records.size();
+    header.numChunks = (records.size() + chunkSize - 1) / chunkSize;
+    header.startTime = records.empty() ? 0 : records.front().time;
+    header.endTime = records.empty() ? 0 : records.back().time;
+
+    // the header is written again once the offsets are known
+    if (fwrite(&header, sizeof(header), 1, f) != 1)
+        throw cRuntimeError("Cannot write binary trace '%s'", filename);
+
+    std::vector<BinaryTraceChunkEntry> chunkIndex;
+    std::vector<double> times, nexts;
+    std::vector<int32> ids;
+    std::vector<float> xs, ys, zs, speeds;
+    for (size_t begin = 0; begin < records.size(); begin += chunkSize)
+    {
+        size_t end = std::min(records.size(), begin + chunkSize);
+
+        BinaryTraceChunkEntry chunk;
+        chunk.offset = tellOffset(f, filename);
+        chunk.numRecords = end - begin;
+        chunk.reserved = 0;
+        chunk.firstTime = records[begin].time;
+        chunk.lastTime = records[end - 1].time;
+        chunkIndex.push_back(chunk);
+
+        times.clear(); nexts.clear(); ids.clear();
+        xs.clear(); ys.clear(); zs.clear(); speeds.clear();
+        for (size_t i = begin; i < end; i++)
+        {
+            times.push_back(records[i].time);
+            nexts.push_back(nextTimes[i]);
+            ids.push_back(records[i].nodeId);
+            xs.push_back(records[i].x);
+            ys.push_back(records[i].y);
+            zs.push_back(records[i].z);
+            speeds.push_back(records[i].speed);
+        }
+        writeColumn(f, times, filename);
+        writeColumn(f, nexts, filename);
+        writeColumn(f, ids, filename);
+        writeColumn(f, xs, filename);
+        writeColumn(f, ys, filename);
+        writeColumn(f, zs, filename);
+        writeColumn(f, speeds, filename);
+    }
+
+    header.nodeTableOffset = tellOffset(f, filename);
+    writeColumn(f, nodeTable, filename);
+    header.chunkIndexOffset = tellOffset(f, filename);
+    writeColumn(f, chunkIndex, filename);
+
+    if (seekTo(f, 0) != 0 || fwrite(&header, sizeof(header), 1, f) != 1)
+        throw cRuntimeError("Cannot write binary trace '%s'", filename);
+    if (fclose(f) != 0)
+        throw cRuntimeError("Cannot write binary trace '%s'", filename);
+}
+
+
+BinaryTraceReader::ReaderMap BinaryTraceReader::readers;
+
+BinaryTraceReader *BinaryTraceReader::open(const char *filename)
+{
+    ReaderMap::iterator it = readers.find(filename);
+    if (it == readers.end())
+        it = readers.insert(std::make_pair(std::string(filename), new BinaryTraceReader(filename))).first;
+    it->second->refs++;
+    return it->second;
+}
+
+void BinaryTraceReader::release(BinaryTraceReader *reader)
+{
+    if (reader && --reader->refs == 0)
+    {
+        readers.erase(reader->filename);
+        delete reader;
+    }
+}
+
+BinaryTraceReader::BinaryTraceReader(const char *filename) :
+    filename(filename), refs(0), nextChunk(0), numPending(0)
+{
+    file = fopen(filename, "rb");
+    if (!file)
+        throw cRuntimeError("Cannot open file '%s'", filename);
+
+    if (fread(&header, sizeof(header), 1, file) != 1
+            || memcmp(header.magic, BINARY_TRACE_MAGIC, sizeof(header.magic)) != 0)
+    {
+        fclose(file);
+        throw cRuntimeError("'%s' is not a binary mobility trace", filename);
+    }
+    if (header.byteOrder != BinaryTraceHeader::BYTE_ORDER_MARK || header.version != BinaryTraceHeader::VERSION)
+    {
+        fclose(file);
+        throw cRuntimeError("Binary mobility trace '%s' has a different byte order or version", filename);
+    }
+
+    chunks.resize(header.numChunks);
+    if (!chunks.empty())
+    {
+        if (seekTo(file, header.chunkIndexOffset) != 0
+                || fread(&chunks[0], sizeof(BinaryTraceChunkEntry), chunks.size(), file) != chunks.size())
+        {
+            fclose(file);
+            throw cRuntimeError("Cannot read the chunk index of binary mobility trace '%s'", filename);
+        }
+    }
+    nodes.resize(header.numNodes, NULL);
+}
+
+BinaryTraceReader::~BinaryTraceReader()
+{
+    for (size_t i = 0; i < nodes.size(); i++)
+        delete nodes[i];
+    fclose(file);
+}
+
+void BinaryTraceReader::read(void *buffer, size_t size, size_t count)
+{
+    if (count > 0 && fread(buffer, size, count, file) != count)
+        throw cRuntimeError("Cannot read binary mobility trace '%s'", filename.c_str());
+}
+
+bool BinaryTraceReader::registerNode(int nodeId, Record& first)
+{
+    if (nodeId < 0 || nodeId >= (int)nodes.size())
+        return false;
+
+    BinaryTraceNodeEntry entry;
+    if (seekTo(file, header.nodeTableOffset + (uint64)nodeId * sizeof(entry)) != 0)
+        throw cRuntimeError("Cannot read binary mobility trace '%s'", filename.c_str());
+    read(&entry, sizeof(entry), 1);
+    if (entry.firstTime < 0)
+        return false;
+
+    if (!nodes[nodeId])
+    {
+        nodes[nodeId] = new NodeState;
+        nodes[nodeId]->next = 0;
+    }
+    first.time = first.nextTime = entry.firstTime;
+    first.x = entry.x;
+    first.y = entry.y;
+    first.z = entry.z;
+    first.speed = 0;
+    return true;
+}
+
+void BinaryTraceReader::readChunk(const BinaryTraceChunkEntry& chunk)
+{
+    size_t n = chunk.numRecords;
+    times.resize(n);
+    nextTimes.resize(n);
+    nodeIds.resize(n);
+    xs.resize(n);
+    ys.resize(n);
+    zs.resize(n);
+    speeds.resize(n);
+    if (n == 0)
+        return;
+
+    if (seekTo(file, chunk.offset) != 0)
+        throw cRuntimeError("Cannot read binary mobility trace '%s'", filename.c_str());
+    read(&times[0], sizeof(double), n);
+    read(&nextTimes[0], sizeof(double), n);
+    read(&nodeIds[0], sizeof(int32), n);
+    read(&xs[0], sizeof(float), n);
+    read(&ys[0], sizeof(float), n);
+    read(&zs[0], sizeof(float), n);
+    read(&speeds[0], sizeof(float), n);
+
+    for (size_t i = 0; i < n; i++)
+    {
+        int nodeId = nodeIds[i];
+        if (nodeId < 0 || nodeId >= (int)nodes.size() || !nodes[nodeId])
+            continue;
+        NodeState *node = nodes[nodeId];
+        if (node->next > 0)
+        {
+            // drop the consumed records before appending new ones
+            node->pending.erase(node->pending.begin(), node->pending.begin() + node->next);
+            node->next = 0;
+        }
+        Record record;
+        record.time = times[i];
+        record.nextTime = nextTimes[i];
+        record.x = xs[i];
+        record.y = ys[i];
+        record.z = zs[i];
+        record.speed = speeds[i];
+        node->pending.push_back(record);
+        numPending++;
+    }
+}
+
+void BinaryTraceReader::advanceTo(simtime_t time)
+{
+    while (nextChunk < chunks.size() && simtime_t(chunks[nextChunk].firstTime) <= time)
+        readChunk(chunks[nextChunk++]);
+}
+
+const BinaryTraceReader::Record *BinaryTraceReader::peekRecord(int nodeId) const
+{
+    const NodeState *node = nodes[nodeId];
+    if (!node || node->next == node->pending.size())
+        return NULL;
+    return &node->pending[node->next];
+}
+
+void BinaryTraceReader::popRecord(int nodeId)
+{
+    NodeState *node = nodes[nodeId];
+    ASSERT(node && node->next < node->pending.size());
+    numPending--;
+    // the consumed records are dropped at once when all are consumed
+    if (++node->next == node->pending.size())
+    {
+        node->pending.clear();
+        node->next = 0;
+    }
+}
@@ -0,0 +1,237 @@
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef BINARY_TRACE_FILE_H
+#define BINARY_TRACE_FILE_H
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "INETDefs.h"
+
+
+/**
+ * On-disk layout of a binary mobility trace, see BinaryTraceWriter.
+ *
+ * A trace consists of a header, the chunks, the node table and the chunk
+ * index, in this order. All values are stored in the byte order of the
+ * machine that wrote the trace, the header holds a marker to detect a
+ * different byte order.
+ *
+ * A record means: at the given time the node starts to move from its
+ * current position towards x/y/z with the given speed and stops there.
+ * A speed of 0 places the node at x/y/z without moving. Every record also
+ * holds the time of the next record of the same node (-1 if it is the last
+ * one), so a node never has to look ahead in the trace.
+ *
+ * The records are sorted by time (records with the same time keep the
+ * order they were added in) and split into chunks of at most "chunkSize"
+ * records. A chunk stores every field in its own column: time and next
+ * time as double, node id as int32, x, y, z and speed as float.
+ */
+struct BinaryTraceHeader
+{
+    char magic[8];            // "MXMTRACE"
+    uint32 byteOrder;         // BYTE_ORDER_MARK in the byte order of the writer
+    uint32 version;           // VERSION
+    uint32 numNodes;          // highest node id plus one
+    uint32 chunkSize;         // maximum number of records per chunk
+    uint64 numRecords;
+    uint64 numChunks;
+    uint64 nodeTableOffset;   // offset of numNodes BinaryTraceNodeEntry
+    uint64 chunkIndexOffset;  // offset of numChunks BinaryTraceChunkEntry
+    double startTime;         // time of the first record
+    double endTime;           // time of the last record
+
+    enum { BYTE_ORDER_MARK = 0x01020304, VERSION = 1 };
+};
+
+/**
+ * First record of a node, firstTime is -1 if the node has no records.
+ */
+struct BinaryTraceNodeEntry
+{
+    double firstTime;
+    float x, y, z;
+    float reserved;
+};
+
+/**
+ * Position and time span of a chunk.
+ */
+struct BinaryTraceChunkEntry
+{
+    uint64 offset;
+    uint32 numRecords;
+    uint32 reserved;
+    double firstTime;
+    double lastTime;
+};
+
+
+/**
+ * Collects the records of a mobility trace and writes them as a binary
+ * trace. Used by BinaryTraceConverter.
+ *
+ * @ingroup mobility
+ */
+class INET_API BinaryTraceWriter
+{
+  protected:
+    struct Entry
+    {
+        int nodeId;
+        double time;
+        double x, y, z;
+        double speed;
+    };
+    std::vector<Entry> records;
+
+    static bool compareTime(const Entry& a, const Entry& b) { return a.time < b.time; }
+
+  public:
+    /**
+     * Adds a record, see BinaryTraceHeader for its meaning.
+     */
+    void addRecord(int nodeId, double time, double x, double y, double z, double speed);
+
+    /**
+     * Returns the number of records added so far.
+     */
+    size_t getNumRecords() const { return records.size(); }
+
+    /**
+     * Sorts the records by time and writes them to the given file, throws
+     * cRuntimeError if this fails.
+     */
+    void write(const char *filename, unsigned int chunkSize);
+};
+
+
+/**
+ * Plays a binary trace back for the nodes of a simulation. Used by
+ * BinaryTraceMobility.
+ *
+ * The nodes of all mobility modules using the same trace share one
+ * reader, see open(). Only the header, the chunk index and the first
+ * record of the registered nodes are read at startup. Chunks are read
+ * one after the other when the simulation time reaches them and their
+ * records are handed to the registered nodes, the records of other nodes
+ * are dropped. A node consumes its records when their time is reached,
+ * so the reader only holds the records between the current simulation
+ * time and the end of the last chunk read, its memory does not grow
+ * with the length of the trace.
+ *
+ * @ingroup mobility
+ */
+class INET_API BinaryTraceReader
+{
+  public:
+    /** A record of a node, see BinaryTraceHeader. */
+    struct Record
+    {
+        double time;
+        double nextTime;
+        double x, y, z;
+        double speed;
+    };
+
+  protected:
+    struct NodeState
+    {
+        std::vector<Record> pending;
+        size_t next;
+    };
+
+    typedef std::map<std::string, BinaryTraceReader *> ReaderMap;
+    static ReaderMap readers;
+
+    std::string filename;
+    FILE *file;
+    int refs;
+    BinaryTraceHeader header;
+    std::vector<BinaryTraceChunkEntry> chunks;
+    size_t nextChunk;
+    /** Registered nodes by id, NULL for all others. */
+    std::vector<NodeState *> nodes;
+    size_t numPending;
+
+    // columns of the last chunk read
+    std::vector<double> times;
+    std::vector<double> nextTimes;
+    std::vector<int32> nodeIds;
+    std::vector<float> xs, ys, zs, speeds;
+
+  protected:
+    BinaryTraceReader(const char *filename);
+    virtual ~BinaryTraceReader();
+
+    void read(void *buffer, size_t size, size_t count);
+    void readChunk(const BinaryTraceChunkEntry& chunk);
+
+  private:
+    BinaryTraceReader(const BinaryTraceReader&);
+    BinaryTraceReader& operator=(const BinaryTraceReader&);
+
+  public:
+    /**
+     * Returns the reader of the given trace, opens it if it is not open
+     * yet. Throws cRuntimeError if it is not a valid binary trace.
+     */
+    static BinaryTraceReader *open(const char *filename);
+
+    /**
+     * Releases a reader returned by open(), the last release closes it.
+     */
+    static void release(BinaryTraceReader *reader);
+
+    /**
+     * Plays the records of the given node back from now on. Returns false
+     * if the trace has no records for it, otherwise its first record is
+     * stored in first (only time and position are set).
+     */
+    bool registerNode(int nodeId, Record& first);
+
+    /**
+     * Reads all chunks which start at or before the given time, so every
+     * record up to it is handed to its node.
+     */
+    void advanceTo(simtime_t time);
+
+    /**
+     * Returns the next record of the given node which was read so far,
+     * NULL if there is none.
+     */
+    const Record *peekRecord(int nodeId) const;
+
+    /**
+     * Removes the record returned by peekRecord().
+     */
+    void popRecord(int nodeId);
+
+    /** Returns the header of the trace. */
+    const BinaryTraceHeader& getHeader() const { return header; }
+
+    /** Returns the number of chunks read so far. */
+    size_t getNumChunksRead() const { return nextChunk; }
+
+    /** Returns the number of records read but not consumed yet. */
+    size_t getNumPendingRecords() const { return numPending; }
+};
+
+#endif
@@ -0,0 +1,136 @@
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include "BinaryTraceMobility.h"
+#include "FWMath.h"
+
+
+Define_Module(BinaryTraceMobility);
+
+
+BinaryTraceMobility::BinaryTraceMobility()
+{
+    nodeId = -1;
+    trace = NULL;
+    speed = 0;
+    nextRecordTime = -1;
+}
+
+BinaryTraceMobility::~BinaryTraceMobility()
+{
+    BinaryTraceReader::release(trace);
+}
+
+void BinaryTraceMobility::initialize(int stage)
+{
+    LineSegmentsMobilityBase::initialize(stage);
+    EV << "initializing BinaryTraceMobility stage " << stage << endl;
+    if (stage == 0)
+    {
+        nodeId = par("nodeId");
+        if (nodeId == -1)
+            nodeId = getParentModule()->getIndex();
+        const char *fname = par("traceFile");
+        trace = BinaryTraceReader::open(fname);
+        BinaryTraceReader::Record first;
+        if (!trace->registerNode(nodeId, first))
+            throw cRuntimeError("Invalid nodeId %d -- no records in binary trace '%s'", nodeId, fname);
+        initialPosition = Coord(first.x, first.y, first.z);
+        nextRecordTime = first.time;
+        WATCH(nodeId);
+    }
+}
+
+void BinaryTraceMobility::initializePosition()
+{
+    lastPosition = initialPosition;
+}
+
+void BinaryTraceMobility::setTargetPosition()
+{
+    simtime_t now = simTime();
+
+    // apply the records which are due
+    if (nextRecordTime != -1 && nextRecordTime <= now)
+    {
+        trace->advanceTo(now);
+        const BinaryTraceReader::Record *record;
+        while ((record = trace->peekRecord(nodeId)) != NULL && simtime_t(record->time) <= now)
+        {
+            if (record->speed > 0)
+            {
+                destination = Coord(record->x, record->y, record->z);
+                speed = record->speed;
+            }
+            else
+            {
+                lastPosition = Coord(record->x, record->y, record->z);
+                speed = 0;
+            }
+            nextRecordTime = record->nextTime < 0 ? simtime_t(-1) : simtime_t(record->nextTime);
+            trace->popRecord(nodeId);
+        }
+        if (nextRecordTime != -1 && nextRecordTime <= now)
+            throw cRuntimeError("Binary trace misses a record of node %d at t=%s", nodeId, SIMTIME_STR(nextRecordTime));
+    }
+
+    bool moving = false;
+    if (speed > 0)
+    {
+        simtime_t arrival = now + lastPosition.distance(destination) / speed;
+        if (arrival <= now)
+        {
+            // already there
+            lastPosition = destination;
+            speed = 0;
+        }
+        else if (nextRecordTime == -1 || arrival <= nextRecordTime)
+        {
+            targetPosition = destination;
+            nextChange = arrival;
+            speed = 0;
+            moving = true;
+        }
+        else
+        {
+            // the next record interrupts the movement
+            double f = (nextRecordTime - now) / (arrival - now);
+            targetPosition = lastPosition + (destination - lastPosition) * f;
+            nextChange = nextRecordTime;
+            moving = true;
+        }
+    }
+
+    if (!moving)
+    {
+        // wait for the next record
+        targetPosition = lastPosition;
+        if (nextRecordTime == -1)
+        {
+            nextChange = -1;
+            stationary = true;
+        }
+        else
+            nextChange = nextRecordTime;
+    }
+    EV << "TARGET: t=" << nextChange << " (" << targetPosition.x << "," << targetPosition.y << "," << targetPosition.z << ")\n";
+}
+
+void BinaryTraceMobility::move()
+{
+    LineSegmentsMobilityBase::move();
+    raiseErrorIfOutside();
+}
@@ -0,0 +1,67 @@
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef BINARY_TRACE_MOBILITY_H
+#define BINARY_TRACE_MOBILITY_H
+
+#include "INETDefs.h"
+
+#include "LineSegmentsMobilityBase.h"
+#include "BinaryTraceFile.h"
+
+
+/**
+ * @brief Plays a binary trace written by BinaryTraceConverter back. See
+ * NED file for more info.
+ *
+ * @ingroup mobility
+ */
+class INET_API BinaryTraceMobility : public LineSegmentsMobilityBase
+{
+  protected:
+    // configuration
+    int nodeId;
+    BinaryTraceReader *trace;
+
+    // state
+    /** @brief Position of the first record of the node. */
+    Coord initialPosition;
+    /** @brief Destination of the current record. */
+    Coord destination;
+    /** @brief Speed of the current record, 0 if the node does not move. */
+    double speed;
+    /** @brief Time of the next record of the node, -1 if there is none. */
+    simtime_t nextRecordTime;
+
+  protected:
+    /** @brief Initializes mobility model parameters. */
+    virtual void initialize(int stage);
+
+    /** @brief Initializes the position according to the mobility model. */
+    virtual void initializePosition();
+
+    /** @brief Overridden from LineSegmentsMobilityBase. */
+    virtual void setTargetPosition();
+
+    /** @brief Overridden from LineSegmentsMobilityBase. */
+    virtual void move();
+
+  public:
+    BinaryTraceMobility();
+
+    virtual ~BinaryTraceMobility();
+};
+
+#endif
@@ -16,32 +16,34 @@
 //
 
 
-#include <fstream>
-#include <sstream>
+#include <cstdlib>
 
 #include "BonnMotionFileCache.h"
+#include "TraceFileBuffer.h"
 
 
 const BonnMotionFile::Line *BonnMotionFile::getLine(int nodeId) const
 {
-    LineList::const_iterator it = lines.begin();
-    for (int i=0; i<nodeId && it!=lines.end(); i++) it++;
-    return (it==lines.end()) ? NULL : &(*it);
+    if (nodeId < 0 || nodeId >= (int)lines.size())
+        return NULL;
+    return &lines[nodeId];
 }
 
 
 BonnMotionFileCache *BonnMotionFileCache::inst;
+int BonnMotionFileCache::refs;
 
-BonnMotionFileCache *BonnMotionFileCache::getInstance()
+BonnMotionFileCache *BonnMotionFileCache::acquireInstance()
 {
     if (!inst)
         inst = new BonnMotionFileCache;
+    refs++;
     return inst;
 }
 
-void BonnMotionFileCache::deleteInstance()
+void BonnMotionFileCache::releaseInstance()
 {
-    if (inst)
+    if (inst && --refs == 0)
     {
         delete inst;
         inst = NULL;
@@ -63,20 +65,26 @@ const BonnMotionFile *BonnMotionFileCache::getFile(const char *filename)
 
 void BonnMotionFileCache::parseFile(const char *filename, BonnMotionFile& bmFile)
 {
-    std::ifstream in(filename, std::ios::in);
-    if (in.fail())
-        throw cRuntimeError("Cannot open file '%s'", filename);
+    TraceFileBuffer in(filename);
+
+    // reserve all lines up front, so they are never copied
+    bmFile.lines.reserve(in.countLines());
 
     std::string line;
-    while (std::getline(in, line))
+    BonnMotionFile::Line values;
+    size_t pos = 0;
+    while (in.getLine(pos, line))
     {
-        bmFile.lines.push_back(BonnMotionFile::Line());
-        BonnMotionFile::Line& vec = bmFile.lines.back();
+        values.clear();
+        const char *s = line.c_str();
+        char *end;
+        for (double d = strtod(s, &end); end != s; d = strtod(s, &end))
+        {
+            values.push_back(d);
+            s = end;
+        }
 
-        std::stringstream linestream(line);
-        double d;
-        while (linestream >> d)
-            vec.push_back(d);
+        // the copy is allocated with the exact size
+        bmFile.lines.push_back(values);
     }
-    in.close();
 }
@@ -19,7 +19,8 @@
 #ifndef BONN_MOTION_FILE_CACHE_H
 #define BONN_MOTION_FILE_CACHE_H
 
-#include <list>
+#include <map>
+#include <string>
 #include <vector>
 
 #include "INETDefs.h"
@@ -28,7 +29,9 @@
 class BonnMotionFileCache;
 
 /**
- * Represents a BonnMotion file's contents.
+ * Represents a BonnMotion file's contents. Every line holds the waypoints
+ * of one node in a contiguous array and is found by the node id in
+ * constant time.
  * @see BonnMotionFileCache, BonnMotionMobility
  */
 class INET_API BonnMotionFile
@@ -37,17 +40,30 @@ class INET_API BonnMotionFile
     typedef std::vector<double> Line;
   protected:
     friend class BonnMotionFileCache;
-    typedef std::list<Line> LineList;
+    typedef std::vector<Line> LineList;
     LineList lines;
   public:
+    /**
+     * Returns the line of the given node, NULL if there is no such line.
+     */
     const Line *getLine(int nodeId) const;
+
+    /**
+     * Returns the number of lines.
+     */
+    int getNumLines() const { return lines.size(); }
 };
 
 
 /**
  * Singleton object to read and store BonnMotion files. Used within
  * BonnMotionMobility.  Needed because otherwise every node would
- * have to open and read the file independently.
+ * have to open and read the file independently. Every file is read
+ * once with TraceFileBuffer and parsed in a single pass.
+ *
+ * The instance is reference counted: every user acquires it once and
+ * releases it when it does not need the returned files any more, the last
+ * release deletes it together with all files.
  *
  * @ingroup mobility
  * @author Andras Varga
@@ -58,20 +74,23 @@ class INET_API BonnMotionFileCache
     typedef std::map<std::string,BonnMotionFile> BMFileMap;
     BMFileMap cache;
     static BonnMotionFileCache *inst;
+    static int refs;
     void parseFile(const char *filename, BonnMotionFile& bmFile);
     BonnMotionFileCache() {}
     virtual ~BonnMotionFileCache() {}
 
   public:
     /**
-     * Returns the singleton instance.
+     * Returns the singleton instance, creates it if it does not exist yet.
+     * Has to be paired with releaseInstance().
      */
-    static BonnMotionFileCache *getInstance();
+    static BonnMotionFileCache *acquireInstance();
 
     /**
-     * Deletes the singleton instance.
+     * Releases the instance returned by acquireInstance(), the last release
+     * deletes it and invalidates all files returned by it.
      */
-    static void deleteInstance();
+    static void releaseInstance();
 
     /**
      * Returns the given document.
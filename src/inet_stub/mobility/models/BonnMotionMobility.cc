@@ -27,13 +27,16 @@ Define_Module(BonnMotionMobility);
 BonnMotionMobility::BonnMotionMobility()
 {
     is3D = false;
+    bmCache = NULL;
     lines = NULL;
     currentLine = -1;
 }
 
 BonnMotionMobility::~BonnMotionMobility()
 {
-    BonnMotionFileCache::deleteInstance();
+    // the other nodes may still use the files of the cache
+    if (bmCache)
+        BonnMotionFileCache::releaseInstance();
 }
 
 void BonnMotionMobility::initialize(int stage)
@@ -47,7 +50,8 @@ void BonnMotionMobility::initialize(int stage)
         if (nodeId == -1)
             nodeId = getParentModule()->getIndex();
         const char *fname = par("traceFile");
-        const BonnMotionFile *bmFile = BonnMotionFileCache::getInstance()->getFile(fname);
+        bmCache = BonnMotionFileCache::acquireInstance();
+        const BonnMotionFile *bmFile = bmCache->getFile(fname);
         lines = bmFile->getLine(nodeId);
         if (!lines)
             throw cRuntimeError("Invalid nodeId %d -- no such line in file '%s'", nodeId, fname);
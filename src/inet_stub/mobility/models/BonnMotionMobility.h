@@ -35,6 +35,7 @@ class INET_API BonnMotionMobility : public LineSegmentsMobilityBase
   protected:
     // state
     bool is3D;
+    BonnMotionFileCache *bmCache;
     const BonnMotionFile::Line *lines;
     int currentLine;
 
@@ -0,0 +1,134 @@
+//
+// Copyright (C) 2005 Andras Varga
+// Copyright (C) 2008 Alfonso Ariza
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+//
+
+
+#include <cstdlib>
+#include <cstring>
+
+#include "Ns2MotionFileCache.h"
+#include "TraceFileBuffer.h"
+
+
+Ns2MotionFileCache *Ns2MotionFileCache::inst;
+int Ns2MotionFileCache::refs;
+
+Ns2MotionFileCache *Ns2MotionFileCache::acquireInstance()
+{
+    if (!inst)
+        inst = new Ns2MotionFileCache;
+    refs++;
+    return inst;
+}
+
+void Ns2MotionFileCache::releaseInstance()
+{
+    if (inst && --refs == 0)
+    {
+        delete inst;
+        inst = NULL;
+    }
+}
+
+const Ns2MotionFile *Ns2MotionFileCache::getFile(const char *filename, int nodeId)
+{
+    NS2FileMap::iterator it = cache.find(std::string(filename));
+    if (it == cache.end())
+    {
+        // load and store in cache
+        it = cache.insert(std::make_pair(std::string(filename), NodeList())).first;
+        parseFile(filename, it->second);
+    }
+
+    const NodeList& nodes = it->second;
+    if (nodeId < 0 || nodeId >= (int)nodes.size())
+        return NULL;
+    return &nodes[nodeId];
+}
+
+void Ns2MotionFileCache::parseFile(const char *filename, NodeList& nodes)
+{
+    TraceFileBuffer in(filename);
+
+    std::string line;
+    size_t pos = 0;
+    int lineNumber = 0;
+    while (in.getLine(pos, line))
+    {
+        lineNumber++;
+
+        // '#' line
+        const char *s = line.c_str();
+        if (s[0] == '#')
+            continue;
+        const char *found = strstr(s, "$node_");
+        if (!found)
+            continue;
+
+        // Node Id
+        const char *pos1 = strchr(s, '(');
+        const char *pos2 = strchr(s, ')');
+        if (!pos1 || !pos2 || pos2 - pos1 <= 1)
+            continue;
+        int nodeId = atoi(pos1 + 1);
+        if (nodeId < 0)
+            continue;
+        if (nodeId >= (int)nodes.size())
+            nodes.resize(nodeId + 1);
+        Ns2MotionFile& node = nodes[nodeId];
+
+        // Initial position
+        if (strstr(s, "set "))
+        {
+            if ((found = strstr(s, "X_")) != NULL)
+                node.initial[0] = atof(found + 3);
+            if ((found = strstr(s, "Y_")) != NULL)
+                node.initial[1] = atof(found + 3);
+            if ((found = strstr(s, "Z_")) != NULL)
+                node.initial[2] = atof(found + 3);
+        }
+
+        if ((found = strstr(s, "setdest ")) != NULL)
+        {
+            Ns2MotionFile::Waypoint waypoint;
+            // initial time
+            const char *at = strstr(s, "at");
+            if (!at || at > found)
+                throw cRuntimeError("Invalid setdest command in line %d of ns2 motion file '%s'", lineNumber, filename);
+            waypoint.time = atof(at + 3);
+
+            // destination and speed
+            double values[3];
+            const char *p = found + 8;
+            char *end;
+            int n = 0;
+            for (; n < 3; n++, p = end)
+            {
+                values[n] = strtod(p, &end);
+                if (end == p)
+                    break;
+            }
+            if (n < 3)
+                throw cRuntimeError("Invalid setdest command in line %d of ns2 motion file '%s'", lineNumber, filename);
+            waypoint.x = values[0];
+            waypoint.y = values[1];
+            waypoint.speed = values[2];
+            node.waypoints.push_back(waypoint);
+        }
+    }
+}
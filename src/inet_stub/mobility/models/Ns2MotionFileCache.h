@@ -0,0 +1,111 @@
+//
+// Copyright (C) 2005 Andras Varga
+// Copyright (C) 2008 Alfonso Ariza
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+//
+
+
+#ifndef NS2_MOTION_FILE_CACHE_H
+#define NS2_MOTION_FILE_CACHE_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "INETDefs.h"
+
+
+/**
+ * Represents the part of a ns2 motion file's contents which belongs to
+ * one node: its initial position and its setdest commands.
+ * @see Ns2MotionFileCache, Ns2MotionMobility
+ */
+class INET_API Ns2MotionFile
+{
+  public:
+    /**
+     * A setdest command: at the given time the node starts to move to the
+     * given position with the given speed.
+     */
+    struct Waypoint
+    {
+        double time;
+        double x;
+        double y;
+        double speed;
+    };
+    typedef std::vector<Waypoint> WaypointList;
+
+    /** Initial x, y and z position, -1 if not set in the file. */
+    double initial[3];
+  protected:
+    friend class Ns2MotionFileCache;
+    WaypointList waypoints;
+  public:
+    Ns2MotionFile() { initial[0] = initial[1] = initial[2] = -1; }
+
+    /**
+     * Returns the setdest commands of the node in the order of the file.
+     */
+    const WaypointList& getWaypoints() const { return waypoints; }
+};
+
+
+/**
+ * Singleton object to read and store ns2 motion files. Used within
+ * Ns2MotionMobility. Every file is read once with TraceFileBuffer and
+ * parsed in a single pass, the commands are sorted by node id, so every
+ * node finds its part in constant time.
+ *
+ * The instance is reference counted: every user acquires it once and
+ * releases it when it does not need the returned files any more, the last
+ * release deletes it together with all files.
+ *
+ * @ingroup mobility
+ */
+class INET_API Ns2MotionFileCache
+{
+  protected:
+    typedef std::vector<Ns2MotionFile> NodeList;
+    typedef std::map<std::string,NodeList> NS2FileMap;
+    NS2FileMap cache;
+    static Ns2MotionFileCache *inst;
+    static int refs;
+    void parseFile(const char *filename, NodeList& nodes);
+    Ns2MotionFileCache() {}
+    virtual ~Ns2MotionFileCache() {}
+
+  public:
+    /**
+     * Returns the singleton instance, creates it if it does not exist yet.
+     * Has to be paired with releaseInstance().
+     */
+    static Ns2MotionFileCache *acquireInstance();
+
+    /**
+     * Releases the instance returned by acquireInstance(), the last release
+     * deletes it and invalidates all files returned by it.
+     */
+    static void releaseInstance();
+
+    /**
+     * Returns the part of the given file which belongs to the given node,
+     * NULL if the node does not appear in the file.
+     */
+    virtual const Ns2MotionFile *getFile(const char *filename, int nodeId);
+};
+
+#endif
@@ -18,17 +18,9 @@
 //
 
 
-#include <fstream>
-#include <sstream>
-#include <string>
-
 #include "Ns2MotionMobility.h"
 #include "FWMath.h"
 
-#ifndef atoi
-#include <cstdlib>
-#endif
-
 
 Define_Module(Ns2MotionMobility);
 
@@ -36,6 +28,7 @@ Define_Module(Ns2MotionMobility);
 Ns2MotionMobility::Ns2MotionMobility()
 {
     vecpos = 0;
+    ns2Cache = NULL;
     ns2File = NULL;
     nodeId = 0;
     scrollX = 0;
@@ -44,86 +37,9 @@ Ns2MotionMobility::Ns2MotionMobility()
 
 Ns2MotionMobility::~Ns2MotionMobility()
 {
-    if (ns2File)
-        delete ns2File;
-}
-
-void Ns2MotionMobility::parseFile(const char *filename)
-{
-
-    std::ifstream in(filename, std::ios::in);
-
-    if (in.fail())
-        throw cRuntimeError("Cannot open file '%s'", filename);
-    ns2File->initial[0] = ns2File->initial[1] = ns2File->initial[2] = -1;
-    std::string line;
-    std::string subline;
-
-    while (std::getline(in, line))
-    {
-        // '#' line
-        int num_node;
-        std::string::size_type found = line.find('#');
-        if (found == 0)
-            continue;
-        if (found != std::string::npos)
-            subline = line;
-        else
-            subline = line.substr(0, found);
-        found = subline.find("$node_");
-        if (found == std::string::npos)
-            continue;
-        // Node Id
-        std::string::size_type pos1 = subline.find('(');
-        std::string::size_type pos2 = subline.find(')');
-        if (pos2-pos1>1)
-            num_node = std::atoi(subline.substr(pos1+1, pos2-1).c_str());
-        if (num_node!=nodeId)
-            continue;
-        // Initial position
-        found = subline.find("set ");
-        if (found!=std::string::npos)
-        {
-            // Initial position
-            found = subline.find("X_");
-            if (found!=std::string::npos)
-            {
-                ns2File->initial[0] = std::atof(subline.substr(found+3, std::string::npos).c_str());
-            }
-            found = subline.find("Y_");
-            if (found!=std::string::npos)
-            {
-                ns2File->initial[1] = std::atof(subline.substr(found+3, std::string::npos).c_str());
-            }
-
-            found = subline.find("Z_");
-            if (found!=std::string::npos)
-            {
-                ns2File->initial[2] = std::atof(subline.substr(found+3, std::string::npos).c_str());
-            }
-        }
-        found = subline.find("setdest");
-        if (found!=std::string::npos)
-        {
-            ns2File->lines.push_back(Ns2MotionFile::Line());
-            Ns2MotionFile::Line& vec = ns2File->lines.back();
-            // initial time
-            found = subline.find("at");
-            vec.push_back(std::atof(subline.substr(found+3).c_str()));
-
-            std::string parameters = subline.substr(subline.find("setdest ")+8, std::string::npos);
-
-            std::stringstream linestream(parameters);
-            double d;
-            while (linestream >> d)
-                vec.push_back(d);
-        }
-    }
-    in.close();
-    // exist data?
-    if (ns2File->initial[0]==-1 || ns2File->initial[1]==-1 || ns2File->initial[2]==-1)
-        throw cRuntimeError("node '%d' Error ns2 motion file '%s'", nodeId, filename);
-
+    // the other nodes may still use the files of the cache
+    if (ns2Cache)
+        Ns2MotionFileCache::releaseInstance();
 }
 
 void Ns2MotionMobility::initialize(int stage)
@@ -138,8 +54,11 @@ void Ns2MotionMobility::initialize(int stage)
         if (nodeId == -1)
             nodeId = getParentModule()->getIndex();
         const char *fname = par("traceFile");
-        ns2File = new Ns2MotionFile;
-        parseFile(fname);
+        ns2Cache = Ns2MotionFileCache::acquireInstance();
+        ns2File = ns2Cache->getFile(fname, nodeId);
+        // exist data?
+        if (!ns2File || ns2File->initial[0]==-1 || ns2File->initial[1]==-1 || ns2File->initial[2]==-1)
+            throw cRuntimeError("node '%d' Error ns2 motion file '%s'", nodeId, fname);
         vecpos = 0;
         WATCH(nodeId);
     }
@@ -154,27 +73,19 @@ void Ns2MotionMobility::initializePosition()
 void Ns2MotionMobility::setTargetPosition()
 {
 
-    if (ns2File->lines.size()==0)
-    {
-        stationary = true;
-        return;
-    }
-
-    if (vecpos >= ns2File->lines.size())
-    {
-        stationary = true;
-        return;
-    }
-
-
-    if (ns2File->lines.begin()+vecpos == ns2File->lines.end())
+    const Ns2MotionFile::WaypointList& waypoints = ns2File->getWaypoints();
+    if (vecpos >= waypoints.size())
     {
+        // stop for good, otherwise the update is rescheduled at the time
+        // of the last arrival again and again
+        nextChange = -1;
         stationary = true;
+        targetPosition = lastPosition;
         return;
     }
 
-    const Ns2MotionFile::Line& vec = ns2File->lines[vecpos];
-    double time = vec[0];
+    const Ns2MotionFile::Waypoint& vec = waypoints[vecpos];
+    double time = vec.time;
     simtime_t now = simTime();
     // TODO: this code is dubious at best
     if (now < time)
@@ -182,19 +93,28 @@ void Ns2MotionMobility::setTargetPosition()
         nextChange = time;
         targetPosition = lastPosition;
     }
-    else if (vec[3] == 0) // the node is stopped
+    else if (vec.speed == 0) // the node is stopped
     {
-        const Ns2MotionFile::Line& vec = ns2File->lines[vecpos+1];
-        double time = vec[0];
+        if (vecpos + 1 == waypoints.size())
+        {
+            // the last setdest stops the node for good
+            nextChange = -1;
+            stationary = true;
+            targetPosition = lastPosition;
+            vecpos++;
+            return;
+        }
+        const Ns2MotionFile::Waypoint& vec = waypoints[vecpos+1];
+        double time = vec.time;
         nextChange = time;
         targetPosition = lastPosition;
         vecpos++;
     }
     else
     {
-        targetPosition.x = vec[1]+scrollX;
-        targetPosition.y = vec[2]+scrollY;
-        double speed = vec[3];
+        targetPosition.x = vec.x+scrollX;
+        targetPosition.y = vec.y+scrollY;
+        double speed = vec.speed;
         double distance = lastPosition.distance(targetPosition);
         double travelTime = distance / speed;
         nextChange = now + travelTime;
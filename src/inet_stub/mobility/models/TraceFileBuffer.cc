@@ -0,0 +1,109 @@
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include <cstdio>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "TraceFileBuffer.h"
+
+
+TraceFileBuffer::TraceFileBuffer(const char *filename)
+{
+    data = NULL;
+    size = 0;
+    mappedSize = 0;
+
+#ifndef _WIN32
+    int fd = open(filename, O_RDONLY);
+    if (fd != -1)
+    {
+        struct stat st;
+        off_t fileSize = fstat(fd, &st) == 0 ? st.st_size : -1;
+        if (fileSize > 0)
+        {
+            void *p = mmap(NULL, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED)
+            {
+                data = static_cast<const char *>(p);
+                size = mappedSize = fileSize;
+#ifdef POSIX_MADV_SEQUENTIAL
+                posix_madvise(p, mappedSize, POSIX_MADV_SEQUENTIAL);
+#endif
+            }
+        }
+        close(fd);
+        if (data || fileSize == 0)
+            return;
+    }
+#endif
+
+    // fall back to reading the whole file at once
+    FILE *f = fopen(filename, "rb");
+    if (!f)
+        throw cRuntimeError("Cannot open file '%s'", filename);
+    char chunk[65536];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0)
+        buffer.insert(buffer.end(), chunk, chunk + n);
+    fclose(f);
+    data = buffer.empty() ? NULL : &buffer[0];
+    size = buffer.size();
+}
+
+TraceFileBuffer::~TraceFileBuffer()
+{
+#ifndef _WIN32
+    if (mappedSize > 0)
+        munmap(const_cast<char *>(data), mappedSize);
+#endif
+}
+
+size_t TraceFileBuffer::countLines() const
+{
+    size_t count = 0;
+    const char *p = data;
+    const char *end = data + size;
+    while (p < end)
+    {
+        const char *eol = static_cast<const char *>(memchr(p, '\n', end - p));
+        count++;
+        if (!eol)
+            break;
+        p = eol + 1;
+    }
+    return count;
+}
+
+bool TraceFileBuffer::getLine(size_t& pos, std::string& line) const
+{
+    if (pos >= size)
+        return false;
+    const char *begin = data + pos;
+    const char *eol = static_cast<const char *>(memchr(begin, '\n', size - pos));
+    const char *end = eol ? eol : data + size;
+    pos = eol ? (eol - data) + 1 : size;
+    if (end > begin && end[-1] == '\r')
+        end--;
+    line.assign(begin, end);
+    return true;
+}
@@ -0,0 +1,73 @@
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef TRACE_FILE_BUFFER_H
+#define TRACE_FILE_BUFFER_H
+
+#include <string>
+#include <vector>
+
+#include "INETDefs.h"
+
+
+/**
+ * Holds the whole contents of a mobility trace file in memory so that it
+ * can be parsed in a single pass. Used by BonnMotionFileCache and
+ * Ns2MotionFileCache.
+ *
+ * On POSIX systems the file is mapped into memory read-only, elsewhere (or
+ * if mapping fails) it is read with a single call.
+ *
+ * @ingroup mobility
+ */
+class INET_API TraceFileBuffer
+{
+  protected:
+    const char *data;
+    size_t size;
+    size_t mappedSize;
+    std::vector<char> buffer;
+
+  private:
+    TraceFileBuffer(const TraceFileBuffer&);
+    TraceFileBuffer& operator=(const TraceFileBuffer&);
+
+  public:
+    /**
+     * Loads the given file, throws cRuntimeError if it cannot be opened.
+     */
+    explicit TraceFileBuffer(const char *filename);
+
+    /**
+     * Unmaps or frees the contents.
+     */
+    ~TraceFileBuffer();
+
+    /**
+     * Returns the number of lines, the last one may miss the newline.
+     */
+    size_t countLines() const;
+
+    /**
+     * Copies the line starting at pos without its end of line characters
+     * into line and advances pos to the next line. Returns false if pos
+     * is at the end of the file. The copy is NUL terminated, so it can be
+     * parsed with the C library functions.
+     */
+    bool getLine(size_t& pos, std::string& line) const;
+};
+
+#endif
@@ -1,6 +1,7 @@
 #include "BreakpointPathlossModel.h"
 
 #include "MiXiMAirFrame.h"
+#include "LinkGainCache.h"
 
 #define debugEV (ev.isDisabled()||!debug) ? ev : ev << "PhyLayer(BreakpointPathlossModel): "
 
@@ -93,9 +94,7 @@ bool BreakpointPathlossModel::initFromMap(const ParameterMap& params) {
     return AnalogueModel::initFromMap(params) && bInitSuccess;
 }
 
-void BreakpointPathlossModel::filterSignal(airframe_ptr_t frame, const Coord& sendersPos, const Coord& receiverPos) {
-	Signal& signal = frame->getSignal();
-
+double BreakpointPathlossModel::calcAttenuation(const Coord& receiverPos, const Coord& sendersPos) {
 	/** Calculate the distance factor */
 	double distance = useTorus ? receiverPos.sqrTorusDist(sendersPos, playgroundSize)
 								  : receiverPos.sqrdist(sendersPos);
@@ -104,7 +103,7 @@ void BreakpointPathlossModel::filterSignal(airframe_ptr_t frame, const Coord& se
 
 	if(distance <= 1.0) {
 		//attenuation is negligible
-		return;
+		return -1.0;
 	}
 
 	double attenuation = 1;
@@ -120,7 +119,25 @@ void BreakpointPathlossModel::filterSignal(airframe_ptr_t frame, const Coord& se
 		attenuation = attenuation * PL02_real;
 		attenuation = attenuation * pow(distance/breakpointDistance, alpha2);
 	}
-	attenuation = 1/attenuation;
+	return 1/attenuation;
+}
+
+void BreakpointPathlossModel::filterSignal(airframe_ptr_t frame, const Coord& sendersPos, const Coord& receiverPos) {
+	Signal& signal = frame->getSignal();
+
+	/** Calculate the attenuation (or take it from the cache) */
+	double attenuation;
+	if(!linkGains || !linkGains->lookup(this, frame->getSenderModuleId(), sendersPos, receiverPos, attenuation)) {
+		attenuation = calcAttenuation(receiverPos, sendersPos);
+		if(linkGains) {
+			linkGains->store(this, frame->getSenderModuleId(), sendersPos, receiverPos, attenuation);
+		}
+	}
+
+	if(attenuation < 0.0) {
+		//attenuation is negligible
+		return;
+	}
 	debugEV << "attenuation is: " << attenuation << endl;
 
 	if(debug) {
@@ -6,6 +6,8 @@
 #include "MiXiMDefs.h"
 #include "AnalogueModel.h"
 
+class LinkGainCache;
+
 /**
  * @brief Basic implementation of a BreakpointPathlossModel.
  * This class can be used to implement the ieee802154 path loss model.
@@ -47,6 +49,16 @@ protected:
     /** logs computed pathlosses. */
     cOutVector pathlosses;
 
+    /** @brief Caches the attenuations of the links, NULL if not used.*/
+    LinkGainCache* linkGains;
+
+protected:
+    /**
+     * @brief Returns the attenuation of the link between sender and
+     * receiver or a negative value if the attenuation is negligible.
+     */
+    double calcAttenuation(const Coord& receiverPos, const Coord& sendersPos);
+
 public:
 	/**
 	 * @brief Initializes the analogue model. playgroundSize
@@ -76,6 +88,7 @@ public:
 		, playgroundSize(playgroundSize)
 		, debug(debug)
 		, pathlosses()
+		, linkGains(NULL)
 	{
 		pathlosses.setName("pathlosses");
 	}
@@ -96,6 +109,12 @@ public:
 	 */
 	virtual void filterSignal(airframe_ptr_t, const Coord&, const Coord&);
 
+	/**
+	 * @brief Stores the attenuations in the passed cache, they are
+	 * calculated again only if sender or receiver moved.
+	 */
+	virtual void setLinkGainCache(LinkGainCache* cache) { linkGains = cache; }
+
 	virtual bool isActiveAtDestination() { return true; }
 
 	virtual bool isActiveAtOrigin() { return false; }
@@ -0,0 +1,281 @@
+#include "CorrelatedShadowing.h"
+
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+
+#include "Mapping.h"
+#include "MiXiMAirFrame.h"
+#include "LinkGainCache.h"
+
+ShadowingField::ShadowingField(double sizeX, double sizeY, double resolution, double correlationDistance,
+                               bool useTorus)
+	: sizeX(sizeX)
+	, sizeY(sizeY)
+	, correlationDistance(correlationDistance)
+	, useTorus(useTorus)
+	// on a torus the last grid point is the neighbour of the first one
+	, columns(std::max(2u, static_cast<unsigned>(ceil(sizeX / resolution)) + (useTorus ? 0 : 1)))
+	, rows(std::max(2u, static_cast<unsigned>(ceil(sizeY / resolution)) + (useTorus ? 0 : 1)))
+	, resolutionX(useTorus ? sizeX / columns : resolution)
+	, resolutionY(useTorus ? sizeY / rows : resolution)
+	, neighbourCorrelationX(getAxisCorrelation(resolutionX, sizeX))
+	, neighbourCorrelationY(getAxisCorrelation(resolutionY, sizeY))
+	, values(static_cast<size_t>(columns) * rows)
+{
+	if(useTorus) {
+		// the cyclic process has to be filtered as a whole, so the complete
+		// field is kept in double precision until it is done
+		std::vector<double> field(values.size());
+		for(size_t i = 0; i < field.size(); ++i)
+			field[i] = normal(0.0, 1.0);
+
+		const double aX = exp(-resolutionX / correlationDistance);
+		const double aY = exp(-resolutionY / correlationDistance);
+		for(unsigned r = 0; r < rows; ++r)
+			filterCyclic(&field[static_cast<size_t>(r) * columns], columns, 1, aX);
+		for(unsigned c = 0; c < columns; ++c)
+			filterCyclic(&field[c], rows, columns, aY);
+
+		std::copy(field.begin(), field.end(), values.begin());
+		return;
+	}
+
+	// correlation of neighbouring grid points and the weight of the innovation
+	const double a = neighbourCorrelationX;
+	const double b = sqrt(1.0 - a * a);
+
+	// the recursion is done in double precision, only the result is stored as float
+	std::vector<double> prev(columns);
+	std::vector<double> cur(columns);
+	for(unsigned r = 0; r < rows; ++r) {
+		for(unsigned c = 0; c < columns; ++c) {
+			const double w = normal(0.0, 1.0);
+			if(r == 0 && c == 0)
+				cur[c] = w;
+			else if(r == 0)
+				cur[c] = a * cur[c - 1] + b * w;
+			else if(c == 0)
+				cur[c] = a * prev[c] + b * w;
+			else
+				cur[c] = a * prev[c] + a * cur[c - 1] - a * a * prev[c - 1] + b * b * w;
+
+			values[static_cast<size_t>(r) * columns + c] = static_cast<float>(cur[c]);
+		}
+		prev.swap(cur);
+	}
+}
+
+void ShadowingField::filterCyclic(double* p, unsigned count, size_t stride, double a)
+{
+	// x[i] = a * x[i - 1] + b * w[i] with x[-1] = x[count - 1] is solved by
+	// x[0] = b * sum(a^k * w[-k]) / (1 - a^count), the other values follow by
+	// the recursion
+	const double b  = sqrt(1.0 - a * a);
+	const double aN = pow(a, static_cast<double>(count));
+
+	double first = p[0];
+	double ak    = 1.0;
+	for(unsigned k = 1; k < count; ++k) {
+		ak    *= a;
+		first += ak * p[(count - k) * stride];
+	}
+
+	// the variance of the cyclic process is (1 + a^count) / (1 - a^count)
+	const double scale = sqrt((1.0 - aN) / (1.0 + aN));
+	double x = b * first / (1.0 - aN);
+	p[0] = x * scale;
+	for(unsigned i = 1; i < count; ++i) {
+		x = a * x + b * p[i * stride];
+		p[i * stride] = x * scale;
+	}
+}
+
+double ShadowingField::getAxisCorrelation(double d, double size) const
+{
+	if(!useTorus)
+		return exp(-fabs(d) / correlationDistance);
+
+	d = fmod(fabs(d), size);
+	return (exp(-d / correlationDistance) + exp(-(size - d) / correlationDistance))
+	       / (1.0 + exp(-size / correlationDistance));
+}
+
+double ShadowingField::getValue(double x, double y) const
+{
+	double u = x / resolutionX;
+	double v = y / resolutionY;
+	if(useTorus) {
+		u = fmod(u, static_cast<double>(columns));
+		v = fmod(v, static_cast<double>(rows));
+		if(u < 0) u += columns;
+		if(v < 0) v += rows;
+	}
+	else {
+		u = std::min(std::max(u, 0.0), columns - 1.0);
+		v = std::min(std::max(v, 0.0), rows - 1.0);
+	}
+	const unsigned lastColumn = useTorus ? columns - 1 : columns - 2;
+	const unsigned lastRow    = useTorus ? rows - 1    : rows - 2;
+	const unsigned c  = std::min(static_cast<unsigned>(u), lastColumn);
+	const unsigned r  = std::min(static_cast<unsigned>(v), lastRow);
+	const double   fu = u - c;
+	const double   fv = v - r;
+	// the right and lower neighbours, on a torus the ones of the last grid
+	// points are the first ones
+	const unsigned c1 = (c + 1) % columns;
+	const unsigned r1 = (r + 1) % rows;
+
+	const float* const p0 = &values[static_cast<size_t>(r)  * columns];
+	const float* const p1 = &values[static_cast<size_t>(r1) * columns];
+	const double value = (1.0 - fv) * ((1.0 - fu) * p0[c] + fu * p0[c1])
+	                   +        fv  * ((1.0 - fu) * p1[c] + fu * p1[c1]);
+
+	// the interpolation between correlated grid points reduces the variance
+	// to varX * varY, scale it back to one
+	const double aX   = neighbourCorrelationX;
+	const double aY   = neighbourCorrelationY;
+	const double varX = (1.0 - fu) * (1.0 - fu) + fu * fu + 2.0 * aX * fu * (1.0 - fu);
+	const double varY = (1.0 - fv) * (1.0 - fv) + fv * fv + 2.0 * aY * fv * (1.0 - fv);
+	return value / sqrt(varX * varY);
+}
+
+double ShadowingField::getCorrelation(double dx, double dy) const
+{
+	return getAxisCorrelation(dx, sizeX) * getAxisCorrelation(dy, sizeY);
+}
+
+CorrelatedShadowing::FieldMap CorrelatedShadowing::fields;
+
+CorrelatedShadowing::CorrelatedShadowing()
+	: AnalogueModel()
+	, mean(0)
+	, stdDev(0)
+	, correlationDistance(0)
+	, resolution(0)
+	, playgroundSize()
+	, useTorus(false)
+	, fieldKey()
+	, field(NULL)
+	, linkGains(NULL)
+{ }
+
+bool CorrelatedShadowing::initFromMap(const ParameterMap& params) {
+    ParameterMap::const_iterator it;
+    bool                         bInitSuccess = true;
+
+    if ((it = params.find("mean")) != params.end()) {
+        mean = ParameterMap::mapped_type(it->second).doubleValue();
+    }
+    else {
+        bInitSuccess = false;
+        opp_warning("No mean defined in config.xml for CorrelatedShadowing!");
+    }
+    if ((it = params.find("stdDev")) != params.end()) {
+        stdDev = ParameterMap::mapped_type(it->second).doubleValue();
+    }
+    else {
+        bInitSuccess = false;
+        opp_warning("No stdDev defined in config.xml for CorrelatedShadowing!");
+    }
+    if ((it = params.find("correlationDistance")) != params.end()) {
+        correlationDistance = ParameterMap::mapped_type(it->second).doubleValue();
+        if (correlationDistance <= 0) {
+            bInitSuccess = false;
+            opp_warning("The correlationDistance defined in config.xml for CorrelatedShadowing has to be positive!");
+        }
+    }
+    else {
+        bInitSuccess = false;
+        opp_warning("No correlationDistance defined in config.xml for CorrelatedShadowing!");
+    }
+    if ((it = params.find("resolution")) != params.end()) {
+        resolution = ParameterMap::mapped_type(it->second).doubleValue();
+        if (resolution <= 0) {
+            bInitSuccess = false;
+            opp_warning("The resolution defined in config.xml for CorrelatedShadowing has to be positive!");
+        }
+    }
+    else {
+        resolution = correlationDistance / 4;
+    }
+    if ((it = params.find("useTorus")) != params.end()) {
+        useTorus = ParameterMap::mapped_type(it->second).boolValue();
+    }
+    else {
+        bInitSuccess = false;
+        opp_warning("No useTorus defined in config.xml for CorrelatedShadowing!");
+    }
+    if ((it = params.find("PgsX")) != params.end()) {
+        playgroundSize.x = ParameterMap::mapped_type(it->second).doubleValue();
+    }
+    else {
+        bInitSuccess = false;
+        opp_warning("No PgsX defined in config.xml for CorrelatedShadowing!");
+    }
+    if ((it = params.find("PgsY")) != params.end()) {
+        playgroundSize.y = ParameterMap::mapped_type(it->second).doubleValue();
+    }
+    else {
+        bInitSuccess = false;
+        opp_warning("No PgsY defined in config.xml for CorrelatedShadowing!");
+    }
+
+    if (bInitSuccess && field == NULL) {
+        fieldKey.push_back(playgroundSize.x);
+        fieldKey.push_back(playgroundSize.y);
+        fieldKey.push_back(correlationDistance);
+        fieldKey.push_back(resolution);
+        fieldKey.push_back(useTorus ? 1.0 : 0.0);
+
+        FieldMap::iterator itField = fields.find(fieldKey);
+        if (itField == fields.end()) {
+            SharedField shared;
+            shared.field = new ShadowingField(playgroundSize.x, playgroundSize.y, resolution,
+                                              correlationDistance, useTorus);
+            shared.refs  = 0;
+            itField = fields.insert(std::make_pair(fieldKey, shared)).first;
+        }
+        ++itField->second.refs;
+        field = itField->second.field;
+    }
+
+    return AnalogueModel::initFromMap(params) && bInitSuccess;
+}
+
+CorrelatedShadowing::~CorrelatedShadowing() {
+	if (field == NULL)
+		return;
+
+	FieldMap::iterator it = fields.find(fieldKey);
+	assert(it != fields.end());
+	if (--it->second.refs == 0) {
+		delete it->second.field;
+		fields.erase(it);
+	}
+}
+
+double CorrelatedShadowing::calcGain(const Coord& sendersPos, const Coord& receiverPos) const {
+	const double fs  = field->getValue(sendersPos.x, sendersPos.y);
+	const double fr  = field->getValue(receiverPos.x, receiverPos.y);
+	// correlation of the field at both ends, normalizes the variance of the sum
+	const double rho = field->getCorrelation(sendersPos.x - receiverPos.x, sendersPos.y - receiverPos.y);
+
+	return FWMath::dBm2mW(-1.0 * (mean + stdDev * (fs + fr) / sqrt(2.0 * (1.0 + rho))));
+}
+
+void CorrelatedShadowing::filterSignal(airframe_ptr_t frame, const Coord& sendersPos, const Coord& receiverPos) {
+	Signal& signal = frame->getSignal();
+
+	double gain;
+	if (!linkGains || !linkGains->lookup(this, frame->getSenderModuleId(), sendersPos, receiverPos, gain)) {
+		gain = calcGain(sendersPos, receiverPos);
+		if (linkGains) {
+			linkGains->store(this, frame->getSenderModuleId(), sendersPos, receiverPos, gain);
+		}
+	}
+
+	signal.addAttenuation(new ConstantSimpleConstMapping(DimensionSet::timeDomain,
+	                                                     Argument(signal.getReceptionStart()),
+	                                                     gain));
+}
@@ -0,0 +1,219 @@
+#ifndef CORRELATEDSHADOWING_H_
+#define CORRELATEDSHADOWING_H_
+
+#include <map>
+#include <vector>
+
+#include "MiXiMDefs.h"
+#include "AnalogueModel.h"
+
+class LinkGainCache;
+
+/**
+ * @brief Spatially correlated gaussian random field over the playground,
+ * used by CorrelatedShadowing.
+ *
+ * The field is stored as a grid with "resolution" meters between the grid
+ * points and is interpolated bilinearly in between. Its values have zero
+ * mean and unit variance, the correlation between two grid points is
+ * exp(-(|dx| + |dy|) / correlationDistance). Interpolated values are scaled
+ * to unit variance as well. The grid is generated once by a separable two
+ * dimensional first order autoregressive process, so creating it is linear
+ * in the number of grid points.
+ *
+ * The z coordinate is ignored. In the plane positions outside of the
+ * playground get the value of the nearest point at its border. On a torus
+ * the field is periodic: the grid points are spread evenly over the
+ * playground, so "resolution" is rounded down to a divisor of its size, and
+ * the process is generated cyclically along both axes. The correlation along
+ * an axis of length L then is
+ * (exp(-d / correlationDistance) + exp(-(L - d) / correlationDistance))
+ * / (1 + exp(-L / correlationDistance)) for a distance d, see getCorrelation().
+ *
+ * @ingroup analogueModels
+ */
+class MIXIM_API ShadowingField
+{
+protected:
+	/** @brief Size of the playground in meters.*/
+	double sizeX, sizeY;
+	/** @brief Distance at which the correlation dropped to 1/e in meters.*/
+	double correlationDistance;
+	/** @brief Whether the field wraps around at the playground borders.*/
+	bool useTorus;
+	/** @brief Number of grid points along the x-axis.*/
+	unsigned columns;
+	/** @brief Number of grid points along the y-axis.*/
+	unsigned rows;
+	/** @brief Distance between two grid points along the x- and y-axis in meters.*/
+	double resolutionX, resolutionY;
+	/** @brief Correlation of two neighbouring grid points along the x- and y-axis.*/
+	double neighbourCorrelationX, neighbourCorrelationY;
+	/** @brief The values at the grid points, row by row.*/
+	std::vector<float> values;
+
+protected:
+	/**
+	 * @brief Filters "count" independent standard normal values, "stride"
+	 * apart, in place by a cyclic first order autoregressive process with
+	 * the passed correlation of neighbours and scales them to unit variance.
+	 */
+	static void filterCyclic(double* p, unsigned count, size_t stride, double a);
+
+	/** @brief Returns the correlation along an axis of the passed length.*/
+	double getAxisCorrelation(double d, double size) const;
+
+public:
+	/**
+	 * @brief Generates the field for a playground of the passed size with
+	 * the random number generator of the current context module.
+	 */
+	ShadowingField(double sizeX, double sizeY, double resolution, double correlationDistance,
+	               bool useTorus = false);
+
+	/** @brief Returns the bilinearly interpolated value at the passed position.*/
+	double getValue(double x, double y) const;
+
+	/**
+	 * @brief Returns the correlation of the field at two positions which are
+	 * "dx" and "dy" meters apart.
+	 */
+	double getCorrelation(double dx, double dy) const;
+};
+
+/**
+ * @brief Log-normal shadowing which is correlated in space and constant in
+ * time, as an alternative to LogNormalShadowing for static deployments.
+ *
+ * The attenuation of a link in dB is
+ *   mean + stdDev * (F(s) + F(r)) / sqrt(2 (1 + rho(s, r)))
+ * where F is a ShadowingField shared by all physical layers, s and r are the
+ * positions of sender and receiver and rho is the correlation of the field
+ * at these positions. So the attenuation of every link is normally
+ * distributed with "mean" and "stdDev" like for LogNormalShadowing, it is the
+ * same in both directions and links whose ends are close to each other have
+ * a similar attenuation.
+ *
+ * The field is generated when the first model is initialized and shared by
+ * all models with the same playground, "correlationDistance" and
+ * "resolution". Filtering a frame only reads four grid points at both
+ * positions, the attenuation of a link is cached in the link gain cache of
+ * the physical layer as long as neither end moves.
+ *
+ * "resolution" should be well below "correlationDistance", otherwise the
+ * correlation between grid points deviates noticeably from the exponential
+ * correlation.
+ *
+ * If the world uses a torus the field wraps around at the playground
+ * borders, so links across a border are correlated like the ones inside of
+ * the playground.
+ *
+ * An example config.xml for this AnalogueModel can be the following:
+ * @verbatim
+	<AnalogueModel type="CorrelatedShadowing">
+		<!-- Mean attenuation in dB -->
+		<parameter name="mean" type="double" value="0.5"/>
+
+		<!-- Standart deviation of the attenuation in dB -->
+		<parameter name="stdDev" type="double" value="4"/>
+
+		<!-- Distance in meters at which the correlation of the field
+			 dropped to 1/e -->
+		<parameter name="correlationDistance" type="double" value="20"/>
+
+		<!-- Distance of the grid points of the field in meters
+			 If ommited a quarter of the correlationDistance is used -->
+		<parameter name="resolution" type="double" value="5"/>
+	</AnalogueModel>
+   @endverbatim
+ *
+ * @ingroup analogueModels
+ * @sa LogNormalShadowing
+ */
+class MIXIM_API CorrelatedShadowing: public AnalogueModel {
+protected:
+	/** @brief Identifies a field by the playground size, correlation
+	 * distance, resolution and whether it is a torus.*/
+	typedef std::vector<double> FieldKey;
+
+	/** @brief A shared field and the number of models using it.*/
+	struct SharedField {
+		ShadowingField* field;
+		unsigned        refs;
+	};
+	typedef std::map<FieldKey, SharedField> FieldMap;
+
+	/** @brief The fields of all models.*/
+	static FieldMap fields;
+
+protected:
+	/** @brief Mean of the attenuation in dB */
+	double mean;
+
+	/** @brief Standart deviation of the attenuation in dB */
+	double stdDev;
+
+	/** @brief Distance at which the correlation dropped to 1/e in meters */
+	double correlationDistance;
+
+	/** @brief Distance of the grid points of the field in meters */
+	double resolution;
+
+	/** @brief The size of the playground.*/
+	Coord playgroundSize;
+
+	/** @brief Whether the playground is a torus.*/
+	bool useTorus;
+
+	/** @brief Key of the field in "fields", empty if no field is used.*/
+	FieldKey fieldKey;
+
+	/** @brief The shared field.*/
+	const ShadowingField* field;
+
+	/** @brief Caches the gains of the links, NULL if not used.*/
+	LinkGainCache* linkGains;
+
+protected:
+	/** @brief Returns the gain of the link between the passed positions.*/
+	double calcGain(const Coord& sendersPos, const Coord& receiverPos) const;
+
+private:
+	/** @brief Copy constructor is not allowed.
+	 */
+	CorrelatedShadowing(const CorrelatedShadowing&);
+	/** @brief Assignment operator is not allowed.
+	 */
+	CorrelatedShadowing& operator=(const CorrelatedShadowing&);
+
+public:
+	CorrelatedShadowing();
+
+	/** @brief Initialize the analog model from XML map data.
+	 *
+	 * Generates the field if no other model uses a field with the same
+	 * parameters.
+	 *
+	 * @param params The parameter map which was filled by XML reader.
+	 *
+	 * @return true if the initialization was successfully.
+	 */
+	virtual bool initFromMap(const ParameterMap&);
+
+	/** @brief Releases the field, the last model using it deletes it.*/
+	virtual ~CorrelatedShadowing();
+
+	/**
+	 * @brief Adds the constant attenuation of the link from the sender to
+	 * the receiver to the signal.
+	 */
+	virtual void filterSignal(airframe_ptr_t, const Coord&, const Coord&);
+
+	/**
+	 * @brief Stores the gains in the passed cache, they are read from the
+	 * field again only if sender or receiver moved.
+	 */
+	virtual void setLinkGainCache(LinkGainCache* cache) { linkGains = cache; }
+};
+
+#endif /* CORRELATEDSHADOWING_H_ */
@@ -15,6 +15,8 @@
 
 #include "JakesFading.h"
 
+#include <algorithm>
+
 #include "BaseWorldUtility.h"
 #include "MiXiMAirFrame.h"
 #include "connectionManager/ConnectionManagerAccess.h"
@@ -22,55 +24,120 @@
 DimensionSet JakesFadingMapping::dimensions(Dimension::time);
 
 double JakesFadingMapping::getValue(const Argument& pos) const {
-	double    f    = model->carrierFrequency;
-	double    v    = relSpeed;
-	simtime_t t    = pos.getTime();
-	double    re_h = 0;
-	double    im_h = 0;
+	const double t = SIMTIME_DBL(pos.getTime());
+	double       h = 0;
+
+	model->evaluate(relSpeed, &t, 1, &h);
+	return h;
+}
+
+void JakesFadingMapping::getValues(const double* times, size_t n, double* out) const {
+	model->evaluate(relSpeed, times, n, out);
+}
+
+void JakesFading::evaluate(double relSpeed, const double* times, size_t n, double* out) const {
+	double f = carrierFrequency;
+	double v = relSpeed;
+
+	if (fadingPaths <= 0) {
+		std::fill(out, out + n, 0.0);
+		return;
+	}
 
 	// Compute Doppler shift.
 	double doppler_shift = v * f / BaseWorldUtility::speedOfLight;
 
-	for (int i = 0; i < model->fadingPaths; i++) {
-		// Some math for complex numbers:
-		//
-		// Cartesian form: z = a + ib
-		// Polar form:     z = p * e^i(phi)
-		//
-		// a = p * cos(phi)
-		// b = p * sin(phi)
-		// z1 * z2 = p1 * p2 * e^i(phi1 + phi2)
-
-		// Phase shift due to Doppler => t-selectivity.
-		double phi_d = model->angleOfArrival[i] * doppler_shift;
-		// Phase shift due to delay spread => f-selectivity.
-		double phi_i = SIMTIME_DBL(model->delay[i]) * f;
-		// Calculate resulting phase due to t-selective and f-selective fading.
-		double phi   = 2.00 * M_PI * (phi_d * SIMTIME_DBL(t) - phi_i);
-
-		// One ring model/Clarke's model plus f-selectivity according to Cavers:
-		// Due to isotropic antenna gain pattern on all paths only a^2 can be received on all paths.
-		// Since we are interested in attenuation a:=1, attenuation per path is then:
-		double attenuation = (1.00 / sqrt(static_cast<double>(model->fadingPaths)));
+	// One ring model/Clarke's model plus f-selectivity according to Cavers:
+	// Due to isotropic antenna gain pattern on all paths only a^2 can be received on all paths.
+	// Since we are interested in attenuation a:=1, attenuation per path is then:
+	double attenuation = (1.00 / sqrt(static_cast<double>(fadingPaths)));
+
+	// the paths of all points in time are processed one after another in
+	// blocks of BLOCK phases
+	enum { BLOCK = 256 };
+	double phase[BLOCK];
+	double cos_phi[BLOCK];
+	double sin_phi[BLOCK];
+
+	const size_t paths = fadingPaths;
+	const size_t total = n * paths;
+	size_t       k     = 0;	// point in time of the next accumulated path
+	size_t       i     = 0;	// next accumulated path
+	double       re_h  = 0;
+	double       im_h  = 0;
+
+	for (size_t first = 0; first < total; first += BLOCK) {
+		const size_t len = std::min<size_t>(BLOCK, total - first);
+
+		size_t t = k;
+		size_t p = i;
+		for (size_t j = 0; j < len; ++j) {
+			// Some math for complex numbers:
+			//
+			// Cartesian form: z = a + ib
+			// Polar form:     z = p * e^i(phi)
+			//
+			// a = p * cos(phi)
+			// b = p * sin(phi)
+			// z1 * z2 = p1 * p2 * e^i(phi1 + phi2)
+
+			// Phase shift due to Doppler => t-selectivity.
+			double phi_d = angleOfArrival[p] * doppler_shift;
+			// Resulting phase (in cycles) due to t-selective and f-selective fading.
+			phase[j] = phi_d * times[t] - delayPhase[p];
+
+			if (++p == paths) {
+				p = 0;
+				++t;
+			}
+		}
+
+		switch (evaluation) {
+		case TABULATED:
+			sineTable.sincos(phase, len, sin_phi, cos_phi);
+			break;
+		case VECTORISED:
+			for (size_t j = 0; j < len; ++j) {
+				phase[j] = 2.00 * M_PI * phase[j];
+			}
+			SinCosKernels::sincos(phase, len, sin_phi, cos_phi);
+			break;
+		default:
+			for (size_t j = 0; j < len; ++j) {
+				double phi = 2.00 * M_PI * phase[j];
+				cos_phi[j] = cos(phi);
+				sin_phi[j] = sin(phi);
+			}
+			break;
+		}
 
 		// Convert to cartesian form and aggregate {Re, Im} over all fading paths.
-		re_h = re_h + attenuation * cos(phi);
-		im_h = im_h - attenuation * sin(phi);
+		for (size_t j = 0; j < len; ++j) {
+			re_h = re_h + attenuation * cos_phi[j];
+			im_h = im_h - attenuation * sin_phi[j];
+
+			if (++i == paths) {
+				// Output: |H_f|^2 = absolute channel impulse response due to fading.
+				// Note that this may be >1 due to constructive interference.
+				out[k++] = re_h * re_h + im_h * im_h;
+				i    = 0;
+				re_h = 0;
+				im_h = 0;
+			}
+		}
 	}
-
-	// Output: |H_f|^2 = absolute channel impulse response due to fading.
-	// Note that this may be >1 due to constructive interference.
-	return re_h * re_h + im_h * im_h;
 }
 
-
 JakesFading::JakesFading()
 	: AnalogueModel()
 	, fadingPaths(0)
 	, angleOfArrival(NULL)
 	, delay(NULL)
+	, delayPhase(NULL)
 	, carrierFrequency(0)
 	, interval()
+	, evaluation(EXACT)
+	, sineTable()
 {
 }
 
@@ -78,6 +145,7 @@ bool JakesFading::initFromMap(const ParameterMap& params) {
     ParameterMap::const_iterator it;
     bool                         bInitSuccess = true;
     double                       delayRMS     = 0.0;
+    long                         tableSize    = 4096;
 
     if ((it = params.find("seed")) != params.end()) {
         srand( ParameterMap::mapped_type(it->second).longValue() );
@@ -110,13 +178,43 @@ bool JakesFading::initFromMap(const ParameterMap& params) {
         bInitSuccess = false;
         opp_warning("No carrierFrequency defined in config.xml for JakesFading!");
     }
+    if ((it = params.find("evaluation")) != params.end()) {
+        const std::string sEvaluation = ParameterMap::mapped_type(it->second).stringValue();
+        if (sEvaluation == "exact") {
+            evaluation = EXACT;
+        }
+        else if (sEvaluation == "vectorised") {
+            evaluation = VECTORISED;
+        }
+        else if (sEvaluation == "tabulated") {
+            evaluation = TABULATED;
+        }
+        else {
+            bInitSuccess = false;
+            opp_warning("Unknown evaluation \"%s\" defined in config.xml for JakesFading!", sEvaluation.c_str());
+        }
+    }
+    if ((it = params.find("tableSize")) != params.end()) {
+        tableSize = ParameterMap::mapped_type(it->second).longValue();
+        if (tableSize <= 0 || tableSize % 4 != 0) {
+            bInitSuccess = false;
+            opp_warning("The tableSize defined in config.xml for JakesFading has to be a positive multiple of 4!");
+        }
+    }
     if (bInitSuccess) {
 	angleOfArrival = new double[fadingPaths];
 	delay = new simtime_t[fadingPaths];
+	delayPhase = new double[fadingPaths];
 
 	for (int i = 0; i < fadingPaths; ++i) {
 		angleOfArrival[i] = cos(uniform(0, M_PI));
 		delay[i] = exponential(delayRMS);
+		// Phase shift due to delay spread => f-selectivity.
+		delayPhase[i] = SIMTIME_DBL(delay[i]) * carrierFrequency;
+	}
+
+	if (evaluation == TABULATED) {
+		sineTable.resize(tableSize);
 	}
     }
     return AnalogueModel::initFromMap(params) && bInitSuccess;
@@ -127,6 +225,8 @@ JakesFading::~JakesFading() {
 	delete[] delay;
     if (angleOfArrival != NULL)
 	delete[] angleOfArrival;
+    if (delayPhase != NULL)
+	delete[] delayPhase;
 }
 
 void JakesFading::filterSignal(airframe_ptr_t frame, const Coord& /*sendersPos*/, const Coord& /*receiverPos*/)
@@ -19,6 +19,7 @@
 #include "MiXiMDefs.h"
 #include "AnalogueModel.h"
 #include "Mapping.h"
+#include "SinCosKernels.h"
 
 class JakesFading;
 
@@ -67,6 +68,12 @@ public:
 
 	virtual double getValue(const Argument& pos) const;
 
+	/**
+	 * @brief Calculates the attenuation at the n passed points in time (in
+	 * seconds) at once, see JakesFading::evaluate().
+	 */
+	void getValues(const double* times, size_t n, double* out) const;
+
 	/**
 	 * @brief creates a clone of this mapping.
 	 *
@@ -100,6 +107,17 @@ public:
 
 		<!-- Interval in which to define attenuation for in seconds -->
 		<parameter name="interval" type="double" value="0.001"/>
+
+		<!-- How sine and cosine of the path phases are calculated:
+			 "exact" (std::sin/std::cos, default), "vectorised"
+			 (SinCosKernels, may differ in the last bits) or
+			 "tabulated" (SinCosKernels::SineTable) -->
+		<parameter name="evaluation" type="string" value="exact"/>
+
+		<!-- Entries per cycle of the sine table for "tabulated",
+			 the error of sine and cosine is at most (pi/tableSize)^2/2
+			 (2.9e-7 for the default of 4096) -->
+		<parameter name="tableSize" type="long" value="4096"/>
 	</AnalogueModel>
    @endverbatim
  *
@@ -107,6 +125,17 @@ public:
  * @author Hermann S. Lichte, Karl Wessel (port for MiXiM)
  */
 class MIXIM_API JakesFading: public AnalogueModel {
+public:
+	/** @brief How sine and cosine of the path phases are calculated. */
+	enum Evaluation {
+		/** @brief std::sin() and std::cos().*/
+		EXACT,
+		/** @brief SinCosKernels::sincos().*/
+		VECTORISED,
+		/** @brief SinCosKernels::SineTable.*/
+		TABULATED
+	};
+
 private:
 	/** @brief Copy constructor is not allowed.
 	 */
@@ -129,12 +158,21 @@ protected:
 	/** @brief Delay on a fading path. */
 	simtime_t* delay;
 
+	/** @brief Phase shift (in cycles) due to the delay on a fading path. */
+	double* delayPhase;
+
 	/** @brief Carrier frequency to be used. */
 	double carrierFrequency;
 
 	/** @brief The interval to set attenuation entries in. */
 	Argument interval;
 
+	/** @brief How sine and cosine of the path phases are calculated. */
+	Evaluation evaluation;
+
+	/** @brief Sine table for the TABULATED evaluation. */
+	SinCosKernels::SineTable sineTable;
+
 public:
 	/**
 	 * @brief Default constructor for the model, the initialization will be done in initFromMap.
@@ -154,6 +192,17 @@ public:
 	virtual ~JakesFading();
 
 	virtual void filterSignal(airframe_ptr_t, const Coord&, const Coord&);
+
+	/**
+	 * @brief Calculates the attenuation |H|^2 for the passed relative speed
+	 * at the n passed points in time (in seconds) and stores it in "out".
+	 *
+	 * The phases of all paths at all points in time are calculated in
+	 * blocks, so sine and cosine of a block can be evaluated at once as
+	 * configured by "evaluation". With the "exact" evaluation the result is
+	 * the same as calculating every path on its own.
+	 */
+	void evaluate(double relSpeed, const double* times, size_t n, double* out) const;
 };
 
 #endif /* JAKESFADING_H_ */
@@ -1,6 +1,7 @@
 #include "SimplePathlossModel.h"
 
 #include "MiXiMAirFrame.h"
+#include "LinkGainCache.h"
 
 #define splmEV (ev.isDisabled()||!debug) ? ev : ev << "PhyLayer(SimplePathlossModel): "
 
@@ -90,17 +91,35 @@ bool SimplePathlossModel::initFromMap(const ParameterMap& params) {
     return AnalogueModel::initFromMap(params) && bInitSuccess;
 }
 
-void SimplePathlossModel::filterSignal(airframe_ptr_t frame, const Coord& sendersPos, const Coord& receiverPos)
+double SimplePathlossModel::calcDistFactor(const Coord& receiverPos, const Coord& sendersPos)
 {
-	Signal& signal = frame->getSignal();
-
-	/** Calculate the distance factor */
 	double sqrDistance = useTorus ? receiverPos.sqrTorusDist(sendersPos, playgroundSize)
 								  : receiverPos.sqrdist(sendersPos);
 
 	splmEV << "sqrdistance is: " << sqrDistance << endl;
 
 	if(sqrDistance <= 1.0) {
+		//attenuation is negligible
+		return -1.0;
+	}
+
+	return pow(sqrDistance, -pathLossAlphaHalf) / (16.0 * M_PI * M_PI);
+}
+
+void SimplePathlossModel::filterSignal(airframe_ptr_t frame, const Coord& sendersPos, const Coord& receiverPos)
+{
+	Signal& signal = frame->getSignal();
+
+	/** Calculate the distance factor (or take it from the cache) */
+	double distFactor;
+	if(!linkGains || !linkGains->lookup(this, frame->getSenderModuleId(), sendersPos, receiverPos, distFactor)) {
+		distFactor = calcDistFactor(receiverPos, sendersPos);
+		if(linkGains) {
+			linkGains->store(this, frame->getSenderModuleId(), sendersPos, receiverPos, distFactor);
+		}
+	}
+
+	if(distFactor < 0.0) {
 		//attenuation is negligible
 		return;
 	}
@@ -112,7 +131,6 @@ void SimplePathlossModel::filterSignal(airframe_ptr_t frame, const Coord& sender
 	splmEV << "wavelength is: " << wavelength << endl;
 
 	// the part of the attenuation only depending on the distance
-	double distFactor = pow(sqrDistance, -pathLossAlphaHalf) / (16.0 * M_PI * M_PI);
 	splmEV << "distance factor is: " << distFactor << endl;
 
 	//is our signal to attenuate defined over frequency?
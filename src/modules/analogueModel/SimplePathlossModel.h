@@ -9,6 +9,7 @@
 #include "BaseWorldUtility.h"
 
 class SimplePathlossModel;
+class LinkGainCache;
 
 /**
  * @brief Mapping that represents a Pathloss-function.
@@ -110,6 +111,17 @@ protected:
 	/** @brief Whether debug messages should be displayed. */
 	bool debug;
 
+	/** @brief Caches the distance factors of the links, NULL if not used.*/
+	LinkGainCache* linkGains;
+
+protected:
+	/**
+	 * @brief Returns the part of the attenuation which only depends on the
+	 * distance between sender and receiver or a negative value if the
+	 * attenuation is negligible.
+	 */
+	double calcDistFactor(const Coord& receiverPos, const Coord& sendersPos);
+
 public:
 	/**
 	 * @brief Initializes the analogue model. playgroundSize
@@ -132,6 +144,7 @@ public:
 	    , useTorus(false)
 	    , playgroundSize()
 	    , debug(false)
+	    , linkGains(NULL)
 	{ }
 
 	/** @brief Initialize the analog model from XML map data.
@@ -150,6 +163,12 @@ public:
 	 */
 	virtual void filterSignal(airframe_ptr_t, const Coord&, const Coord&);
 
+	/**
+	 * @brief Stores the distance factors in the passed cache, they are
+	 * calculated again only if sender or receiver moved.
+	 */
+	virtual void setLinkGainCache(LinkGainCache* cache) { linkGains = cache; }
+
 	/**
 	 * @brief Method to calculate the attenuation value for pathloss.
 	 *
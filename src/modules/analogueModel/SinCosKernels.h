@@ -0,0 +1,323 @@
+/*
+ * SinCosKernels.h
+ *
+ *  Vectorised and tabulated sine and cosine of arrays of phases.
+ */
+
+#ifndef SINCOSKERNELS_H_
+#define SINCOSKERNELS_H_
+
+#include <cstddef>
+#include <cmath>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "MiXiMDefs.h"
+
+/**
+ * @brief Sine and cosine of arrays of phases for the analogue models which
+ * sum up the paths of a multipath channel, like JakesFading.
+ *
+ * sincos() uses the polynomial approximations of the Cephes library: the
+ * phase is reduced to [-pi/4, pi/4] in three steps (Cody-Waite) and sine
+ * and cosine of the reduced phase are approximated by polynomials of degree
+ * 13 and 14. The result is about as exact as std::sin() and std::cos() (a
+ * few units in the last place), but may differ from them in the last bits.
+ * Phases with an absolute value bigger than maxPhase() can not be reduced
+ * exactly this way, they (and NaN) are passed to std::sin() and std::cos().
+ *
+ * Which instruction set is used is decided at compile time like for
+ * MappingKernels: AVX2 if MiXiM is compiled with -mavx2, SSE2 on every x86-64
+ * compiler and a scalar loop otherwise. All variants do the same operations,
+ * so they calculate the same values.
+ *
+ * SineTable interpolates sine and cosine linearly between tabulated values.
+ * This is faster but less exact, the error is bounded by
+ * SineTable::maxError().
+ *
+ * @ingroup analogueModels
+ * @sa JakesFading
+ */
+class SinCosKernels
+{
+public:
+	/** @brief Biggest absolute phase which is reduced by the kernels.*/
+	static double maxPhase() { return 1.0e9; }
+
+protected:
+	/** @brief 4 / pi.*/
+	static double fopi() { return 1.27323954473516268615; }
+	/** @brief pi / 4 split into three parts for an exact reduction.*/
+	static double dp1()  { return 7.85398125648498535156E-1; }
+	static double dp2()  { return 3.77489470793079817668E-8; }
+	static double dp3()  { return 2.69515142907905952645E-15; }
+
+	/** @brief Returns sin(z) - z for z in [-pi/4, pi/4].*/
+	template<class T>
+	static T sinPoly(T z, T zz) {
+		T p = 1.58962301576546568060E-10;
+		p = p * zz + -2.50507477628578072866E-8;
+		p = p * zz + 2.75573136213857245213E-6;
+		p = p * zz + -1.98412698295895385996E-4;
+		p = p * zz + 8.33333333332211858878E-3;
+		p = p * zz + -1.66666666666666307295E-1;
+		return z * zz * p;
+	}
+
+	/** @brief Returns cos(z) - 1 + z^2 / 2 for z in [-pi/4, pi/4].*/
+	template<class T>
+	static T cosPoly(T zz) {
+		T p = -1.13585365213876817300E-11;
+		p = p * zz + 2.08757008419747316778E-9;
+		p = p * zz + -2.75573141792967388112E-7;
+		p = p * zz + 2.48015872888517045348E-5;
+		p = p * zz + -1.38888888888730564116E-3;
+		p = p * zz + 4.16666666666665929218E-2;
+		return zz * zz * p;
+	}
+
+#if defined(__AVX2__)
+	/** @brief Number of doubles processed at once.*/
+	enum { WIDTH = 4 };
+
+	/** @brief A vector of doubles which supports the arithmetic operators
+	 * needed by sinPoly() and cosPoly().*/
+	struct vector_t {
+		__m256d v;
+		vector_t(__m256d v): v(v) {}
+		vector_t(double d): v(_mm256_set1_pd(d)) {}
+		vector_t operator+(vector_t o) const { return _mm256_add_pd(v, o.v); }
+		vector_t operator-(vector_t o) const { return _mm256_sub_pd(v, o.v); }
+		vector_t operator*(vector_t o) const { return _mm256_mul_pd(v, o.v); }
+	};
+	typedef __m256d mask_t;
+
+	static vector_t load(const double* p)            { return _mm256_loadu_pd(p); }
+	static void     store(double* p, vector_t v)     { _mm256_storeu_pd(p, v.v); }
+	static vector_t bitAnd(vector_t a, mask_t m)     { return _mm256_and_pd(a.v, m); }
+	static vector_t bitAndNot(mask_t m, vector_t a)  { return _mm256_andnot_pd(m, a.v); }
+	static vector_t bitXor(vector_t a, vector_t b)   { return _mm256_xor_pd(a.v, b.v); }
+	static vector_t select(mask_t m, vector_t a, vector_t b) { return _mm256_blendv_pd(b.v, a.v, m); }
+	// true for phases which can not be reduced and for NaN
+	static int      outOfRange(vector_t a)           { return _mm256_movemask_pd(_mm256_cmp_pd(a.v, _mm256_set1_pd(maxPhase()), _CMP_NLE_UQ)); }
+
+	/**
+	 * @brief Calculates the even octant j of every lane of the passed
+	 * absolute phases, returns j as double and the masks selecting the lanes
+	 * where sine and cosine have to be swapped or negated.
+	 */
+	static vector_t octant(vector_t x, mask_t& swap, mask_t& sinNeg, mask_t& cosNeg) {
+		__m128i j = _mm256_cvttpd_epi32((x * fopi()).v);
+		j = _mm_and_si128(_mm_add_epi32(j, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+		const __m256i j64 = _mm256_cvtepi32_epi64(j);
+		const __m256i two = _mm256_set1_epi64x(2);
+		const __m256i four = _mm256_set1_epi64x(4);
+		swap   = _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(j64, two), two));
+		sinNeg = _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(j64, four), four));
+		cosNeg = _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(_mm256_add_epi64(j64, two), four), four));
+		return _mm256_cvtepi32_pd(j);
+	}
+#elif defined(__SSE2__)
+	/** @brief Number of doubles processed at once.*/
+	enum { WIDTH = 2 };
+
+	/** @brief A vector of doubles which supports the arithmetic operators
+	 * needed by sinPoly() and cosPoly().*/
+	struct vector_t {
+		__m128d v;
+		vector_t(__m128d v): v(v) {}
+		vector_t(double d): v(_mm_set1_pd(d)) {}
+		vector_t operator+(vector_t o) const { return _mm_add_pd(v, o.v); }
+		vector_t operator-(vector_t o) const { return _mm_sub_pd(v, o.v); }
+		vector_t operator*(vector_t o) const { return _mm_mul_pd(v, o.v); }
+	};
+	typedef __m128d mask_t;
+
+	static vector_t load(const double* p)            { return _mm_loadu_pd(p); }
+	static void     store(double* p, vector_t v)     { _mm_storeu_pd(p, v.v); }
+	static vector_t bitAnd(vector_t a, mask_t m)     { return _mm_and_pd(a.v, m); }
+	static vector_t bitAndNot(mask_t m, vector_t a)  { return _mm_andnot_pd(m, a.v); }
+	static vector_t bitXor(vector_t a, vector_t b)   { return _mm_xor_pd(a.v, b.v); }
+	static vector_t select(mask_t m, vector_t a, vector_t b) { return _mm_or_pd(_mm_and_pd(m, a.v), _mm_andnot_pd(m, b.v)); }
+	// true for phases which can not be reduced and for NaN
+	static int      outOfRange(vector_t a)           { return _mm_movemask_pd(_mm_cmpnle_pd(a.v, _mm_set1_pd(maxPhase()))); }
+
+	/**
+	 * @brief Calculates the even octant j of every lane of the passed
+	 * absolute phases, returns j as double and the masks selecting the lanes
+	 * where sine and cosine have to be swapped or negated.
+	 */
+	static vector_t octant(vector_t x, mask_t& swap, mask_t& sinNeg, mask_t& cosNeg) {
+		__m128i j = _mm_cvttpd_epi32((x * fopi()).v);
+		j = _mm_and_si128(_mm_add_epi32(j, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+		// copy the octant of every lane into both halves of its 64 bits
+		const __m128i j64  = _mm_shuffle_epi32(j, _MM_SHUFFLE(1, 1, 0, 0));
+		const __m128i two  = _mm_set1_epi32(2);
+		const __m128i four = _mm_set1_epi32(4);
+		swap   = _mm_castsi128_pd(_mm_cmpeq_epi32(_mm_and_si128(j64, two), two));
+		sinNeg = _mm_castsi128_pd(_mm_cmpeq_epi32(_mm_and_si128(j64, four), four));
+		cosNeg = _mm_castsi128_pd(_mm_cmpeq_epi32(_mm_and_si128(_mm_add_epi32(j64, two), four), four));
+		return _mm_cvtepi32_pd(j);
+	}
+#endif
+
+#if defined(__AVX2__) || defined(__SSE2__)
+	/** @brief Calculates sine and cosine of WIDTH phases.*/
+	static void sincos(vector_t x, vector_t& s, vector_t& c) {
+		const mask_t signBit = vector_t(-0.0).v;
+
+		// sin(-x) = -sin(x), cos(-x) = cos(x)
+		const vector_t sign = bitAnd(x, signBit);
+		x = bitAndNot(signBit, x);
+
+		mask_t swap, sinNeg, cosNeg;
+		const vector_t y  = octant(x, swap, sinNeg, cosNeg);
+		const vector_t z  = ((x - y * dp1()) - y * dp2()) - y * dp3();
+		const vector_t zz = z * z;
+
+		const vector_t ps = z + sinPoly(z, zz);
+		const vector_t pc = (vector_t(1.0) - zz * 0.5) + cosPoly(zz);
+
+		s = bitXor(bitXor(select(swap, pc, ps), bitAnd(signBit, sinNeg)), sign);
+		c = bitXor(select(swap, ps, pc), bitAnd(signBit, cosNeg));
+	}
+#endif
+
+public:
+	/** @brief Returns the name of the instruction set the kernels use.*/
+	static const char* instructionSet() {
+#if defined(__AVX2__)
+		return "AVX2";
+#elif defined(__SSE2__)
+		return "SSE2";
+#else
+		return "scalar";
+#endif
+	}
+
+	/** @brief Calculates sine and cosine of a single phase.*/
+	static void sincos(double x, double& s, double& c) {
+		const double a = std::fabs(x);
+		if(!(a <= maxPhase())) {
+			s = std::sin(x);
+			c = std::cos(x);
+			return;
+		}
+
+		// the same operations as in the vector variants
+		int j = static_cast<int>(a * fopi());
+		j = (j + 1) & ~1;
+		const double y  = j;
+		const double z  = ((a - y * dp1()) - y * dp2()) - y * dp3();
+		const double zz = z * z;
+
+		const double ps = z + sinPoly(z, zz);
+		const double pc = (1.0 - zz * 0.5) + cosPoly(zz);
+
+		s = (j & 2) ? pc : ps;
+		c = (j & 2) ? ps : pc;
+		if(j & 4)
+			s = -s;
+		if((j + 2) & 4)
+			c = -c;
+		if(x < 0)
+			s = -s;
+	}
+
+	/**
+	 * @brief Calculates s[i] = sin(x[i]) and c[i] = cos(x[i]) for the n
+	 * passed phases.
+	 */
+	static void sincos(const double* x, size_t n, double* s, double* c) {
+		size_t i = 0;
+#if defined(__AVX2__) || defined(__SSE2__)
+		for(; i + WIDTH <= n; i += WIDTH) {
+			const vector_t v = load(x + i);
+			vector_t vs(0.0), vc(0.0);
+			sincos(v, vs, vc);
+			store(s + i, vs);
+			store(c + i, vc);
+
+			if(outOfRange(bitAndNot(vector_t(-0.0).v, v))) {
+				for(size_t j = i; j < i + WIDTH; ++j) {
+					sincos(x[j], s[j], c[j]);
+				}
+			}
+		}
+#endif
+		for(; i < n; ++i) {
+			sincos(x[i], s[i], c[i]);
+		}
+	}
+
+	/**
+	 * @brief Tabulated sine and cosine of phases given in cycles (the phase
+	 * divided by 2 pi).
+	 *
+	 * The table stores the sine of "size" equidistant phases of one cycle
+	 * (plus a quarter cycle for the cosine), the values in between are
+	 * interpolated linearly.
+	 */
+	class SineTable
+	{
+	protected:
+		/** @brief sin(2 pi k / size) for k = 0, ..., size + size / 4.*/
+		std::vector<double> values;
+		/** @brief Number of table entries per cycle.*/
+		unsigned            size;
+
+	public:
+		/** @brief Creates an empty table, see resize().*/
+		SineTable(): values(), size(0) {}
+
+		/**
+		 * @brief Fills the table with "size" entries per cycle, "size" has
+		 * to be a multiple of four.
+		 */
+		void resize(unsigned size) {
+			this->size = size;
+			values.resize(size + size / 4 + 1);
+			for(unsigned k = 0; k < values.size(); ++k) {
+				values[k] = std::sin(2.0 * M_PI * k / size);
+			}
+		}
+
+		/** @brief Returns the number of table entries per cycle.*/
+		unsigned getSize() const { return size; }
+
+		/**
+		 * @brief Returns the maximum absolute difference between a
+		 * tabulated and the exact sine or cosine: (pi / size)^2 / 2.
+		 *
+		 * For phases of millions of cycles the rounding error of the
+		 * phase itself (about 2 pi times its last place) adds to this.
+		 */
+		double maxError() const { return 0.5 * (M_PI / size) * (M_PI / size); }
+
+		/**
+		 * @brief Calculates s[i] = sin(2 pi x[i]) and c[i] = cos(2 pi x[i])
+		 * for the n passed phases in cycles.
+		 */
+		void sincos(const double* x, size_t n, double* s, double* c) const {
+			const double* const v       = &values[0];
+			const unsigned      quarter = size / 4;
+			for(size_t i = 0; i < n; ++i) {
+				const double u = (x[i] - std::floor(x[i])) * size;
+				unsigned     k = static_cast<unsigned>(u);
+				// x[i] slightly below an integer can round up to a full cycle
+				if(k >= size)
+					k = size - 1;
+				const double r = u - k;
+				s[i] = v[k] + r * (v[k + 1] - v[k]);
+				c[i] = v[k + quarter] + r * (v[k + quarter + 1] - v[k + quarter]);
+			}
+		}
+	};
+};
+
+#endif /* SINCOSKERNELS_H_ */
@@ -20,7 +20,6 @@
 
 #include "UWBIRIEEE802154APathlossModel.h"
 
-#include <map>
 #include <limits>
 
 #include "IEEE802154A.h"
@@ -220,35 +219,23 @@ void UWBIRIEEE802154APathlossModel::filterSignal(airframe_ptr_t frame, const Coo
     Signal& signal = frame->getSignal();
     // We create a new "fake" txPower to add multipath taps
     // and then attenuation is applied to all pulses.
+    const PulseTrainMapping* txPower = dynamic_cast<const PulseTrainMapping*>(signal.getTransmissionPower());
+    if (txPower == NULL) {
+        opp_error("UWBIRIEEE802154APathlossModel requires a transmission power generated by IEEE802154A.");
+    }
 
     // (1) Power Delay Profile realization
     using std::max;
 
-    txPower    = signal.getTransmissionPower();
-    newTxPower = new TimeMapping<Linear>(); //dynamic_cast<TimeMapping<Linear>*> (txPower->clone()); // create working copy
-    pulsesIter = newTxPower->createIterator(); // create an iterator that we will use many times in addEchoes
     // generate number of clusters for this channel (channel coherence time > packet air time)
     L = max(1, poisson(cfg.Lmean));
     // Choose block shadowing
     S = powf(10.,(normal(0, cfg.sigma_s)/10.));
 
-    // Loop on each value of the original mapping and generate multipath echoes
-    ConstMappingIterator* iter = txPower->createConstIterator();
-
-    while (iter->inRange()) {
-        // generate echoes for each non zero value
-        if (iter->getValue() != 0) {
-        	// give the pulse start position
-            addEchoes(iter->getPosition().getTime() - IEEE802154A::mandatory_pulse/2);
-        }
-        if (!iter->hasNext()) {
-            break;
-        }
-        iter->next();
-    }
-    delete iter;
-    delete pulsesIter;
-    signal.setTransmissionPower(newTxPower);
+    // the echoes of every pulse are the taps of the channel
+    PulseTrainMapping::TapList taps;
+    generateTaps(txPower->getPeak(), taps);
+    signal.setTransmissionPower(new PulseTrainMapping(*txPower, taps));
 
 
     // Total radiated power Prx at that distance  [W]
@@ -265,8 +252,7 @@ void UWBIRIEEE802154APathlossModel::filterSignal(airframe_ptr_t frame, const Coo
 
 }
 
-void UWBIRIEEE802154APathlossModel::addEchoes(simtime_t_cref pulseStart) {
-    using std::map;
+void UWBIRIEEE802154APathlossModel::generateTaps(double pulsePeak, PulseTrainMapping::TapList& taps) {
     using std::numeric_limits;
 
     // statistics
@@ -274,8 +260,7 @@ void UWBIRIEEE802154APathlossModel::addEchoes(simtime_t_cref pulseStart) {
     double power = 0;
     // loop control variables
     bool moreTaps = true;
-    arg.setTime(pulseStart + IEEE802154A::mandatory_pulse/2);
-    double pulseEnergy = txPower->getValue(arg);
+    double pulseEnergy = pulsePeak;
     if(doShadowing) {
     	pulseEnergy = pulseEnergy - S;
     }
@@ -292,23 +277,8 @@ void UWBIRIEEE802154APathlossModel::addEchoes(simtime_t_cref pulseStart) {
     //double mfactor = 0;
     //double mmean = 0, msigma = 0;
     //bool firstTap = true;
-    simtime_t echoEnd = SIMTIME_ZERO;
     for (int cluster = 0; cluster < L; cluster++) {
         while (moreTaps) {
-            // modify newTxPower
-            // we add three points for linear interpolation
-        	// we set the start and end point before adding the new values for correct interpolation
-            double pValueStart = newTxPower->getValue(arg);
-            double pValueEnd = newTxPower->getValue(arg);
-            simtime_t echoStart = pulseStart + clusterStart + tau_kl;
-            echoEnd = pulseStart + clusterStart + tau_kl + IEEE802154A::mandatory_pulse;
-            simtime_t echoPeak = pulseStart + clusterStart + tau_kl + IEEE802154A::mandatory_pulse/2;
-            arg.setTime(echoEnd);
-            newTxPower->setValue(arg, pValueEnd);
-            arg.setTime(echoStart);
-            newTxPower->setValue(arg, pValueStart);
-            bool raising = true;
-
             /*if(!firstTap) {
             	mfactor = cfg.m_0;
             } else {
@@ -326,55 +296,10 @@ void UWBIRIEEE802154APathlossModel::addEchoes(simtime_t_cref pulseStart) {
             */
             double finalTapEnergy = tapEnergy * pulseEnergy;
 
-            // We cannot add intermediate points "online" as we need the interpolated
-            // values of the signal before adding this echo pulse.
-            map<simtime_t, double> intermediatePoints;
-            // We need to evaluate all points of the mapping already stored that intersect
-            // with this pulse.
-            pulsesIter->jumpTo(arg);
-            simtime_t currentPoint = echoStart;
-            while(currentPoint < echoEnd) {
-            	if(raising && pulsesIter->getNextPosition().getTime() < echoPeak) {
-            		// there is a point in the first half of the echo
-            		// retrieve its value
-            		pulsesIter->next();
-            		double oldValue = pulsesIter->getValue();
-            		currentPoint = pulsesIter->getPosition().getTime();
-            		// interpolate current echo point
-            		double echoValue = SIMTIME_DBL((currentPoint - echoStart)/(0.5*IEEE802154A::mandatory_pulse));
-            		echoValue = echoValue * finalTapEnergy;
-            		intermediatePoints[currentPoint] = echoValue + oldValue;
-            	} else if(raising && pulsesIter->getNextPosition().getTime() >= echoPeak) {
-					// We reached the peak of the pulse.
-            		currentPoint = echoPeak;
-            		arg.setTime(currentPoint);
-            		pulsesIter->jumpTo(arg);
-            		double oldValue = pulsesIter->getValue();
-            		intermediatePoints[currentPoint] = oldValue + finalTapEnergy;
-					raising = false;
-            	} else if(!raising && pulsesIter->getNextPosition().getTime() < echoEnd) {
-            		// there is a point in the second half of the echo
-            		// retrieve its value
-            		pulsesIter->next();
-            		double oldValue = pulsesIter->getValue();
-            		currentPoint = pulsesIter->getPosition().getTime();
-            		// interpolate current echo point
-            		double echoValue = 1 - SIMTIME_DBL((currentPoint - echoPeak)/(0.5*IEEE802154A::mandatory_pulse));
-            		echoValue = echoValue * finalTapEnergy;
-            		intermediatePoints[currentPoint] = echoValue + oldValue;
-            	} else if (!raising && pulsesIter->getNextPosition().getTime() >= echoEnd) {
-            		currentPoint = echoEnd; // nothing to do, we already set this point
-            	}
-            }
-
-            // Add all points stored in intermediatePoints.
-            map<simtime_t, double>::iterator newPointsIter;
-            newPointsIter = intermediatePoints.begin();
-            while(newPointsIter != intermediatePoints.end()) {
-            	arg.setTime(newPointsIter->first);
-            	newTxPower->setValue(arg, newPointsIter->second);
-            	newPointsIter++;
-            }
+            // The echo has the peak finalTapEnergy, the gain of the tap scales
+            // the pulses of the train, whose peak is pulsePeak.
+            PulseTrainMapping::Tap tap = { clusterStart + tau_kl, finalTapEnergy / pulsePeak };
+            taps.push_back(tap);
 
             power = power + finalTapEnergy; // statistics
 
@@ -413,8 +338,6 @@ void UWBIRIEEE802154APathlossModel::addEchoes(simtime_t_cref pulseStart) {
           }
         }
     }
-    arg.setTime(echoEnd);
-    newTxPower->setValue(arg, 0);
     averagePower = averagePower + power;
     averagePowers.record( averagePower / ((double) nbCalls));
 }
@@ -24,6 +24,7 @@
 #include "MiXiMDefs.h"
 #include "AnalogueModel.h"
 #include "SimpleTimeConstMapping.h"
+#include "PulseTrainMapping.h"
 
 /**
  * @brief This class implements the IEEE 802.15.4A Channel Model[1] in the MiXiM
@@ -75,10 +76,6 @@ public:
 		, tapThreshold(0)
 		, doShadowing(false)
  		, doSmallScaleShadowing(false)
-		, newTxPower(NULL)
-		, txPower(NULL)
-		, arg()
-		, pulsesIter(NULL)
 		, L(0)
 		, S(0)
 		, clusterStart()
@@ -108,6 +105,10 @@ public:
 
     /*
      * @brief Applies the model to an incoming AirFrame's Signal.
+     *
+     * Draws one realization of the channel per frame (channel coherence
+     * time > packet air time) and echoes the whole pulse train of the
+     * transmission power by its taps.
      */
     void filterSignal(airframe_ptr_t, const Coord&, const Coord&);
 
@@ -186,10 +187,6 @@ protected:
     static const double ntx;
     static const double nrx;
 
-    TimeMapping<Linear>* newTxPower;
-    ConstMapping* txPower;
-    Argument arg;
-    MappingIterator* pulsesIter;
     // number of clusters
     double L;
     // block shadowing
@@ -207,9 +204,10 @@ protected:
     cOutVector pathlosses;  // outputs computed pathlosses. Allows to compute Eb = Epulse*pathloss for Eb/N0 computations. (N0 is the noise sampled by the receiver)
 
     /*
-     * Generates taps for the considered pulse, with the current channel parameters
+     * Generates the taps of the channel with the current channel parameters
+     * for pulses of the passed peak energy
      */
-    void addEchoes(simtime_t_cref pulseStart);
+    void generateTaps(double pulsePeak, PulseTrainMapping::TapList& taps);
 
     /*
      * @brief Computes the pathloss as a function of center frequency and bandwidth given in MHz
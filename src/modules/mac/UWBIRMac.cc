@@ -56,6 +56,7 @@ void UWBIRMac::initialize(int stage) {
 		trace = par("trace").boolValue();
 		prf   = par("PRF");
 		assert(prf == 4 || prf == 16);
+		context = &IEEE802154A::getContext(prf == 4 ? IEEE802154A::cfg_mandatory_4M : IEEE802154A::cfg_mandatory_16M);
 		packetsAlwaysValid = par("packetsAlwaysValid");
 		rsDecoder          = par("RSDecoder").boolValue();
 		phy = FindModule<MacToPhyInterface*>::findSubModule( this->getNic() );
@@ -110,13 +111,7 @@ void UWBIRMac::prepareData(UWBIRMacPkt* packet, IEEE802154A::config /*cfg*/) {
 	// generate signal
 	//int nbSymbols = packet->getByteLength() * 8 + 92; // to move to ieee802154a.h
 	debugEV << "prepare Data for a packet with " << packet->getByteLength() << " data bytes." << endl;
-	if(prf == 4) {
-	  IEEE802154A::setConfig(IEEE802154A::cfg_mandatory_4M);
-	} else if (prf == 16) {
-		IEEE802154A::setConfig(IEEE802154A::cfg_mandatory_16M);
-	}
-	IEEE802154A::setPSDULength(packet->getByteLength());
-	IEEE802154A::signalAndData res = IEEE802154A::generateIEEE802154AUWBSignal(simTime());
+	IEEE802154A::signalAndData res = context->generateIEEE802154AUWBSignal(simTime(), packet->getByteLength());
 	Signal* theSignal = res.first;
 	vector<bool>* data = res.second;
 	int nbSymbols = data->size();
@@ -146,7 +141,7 @@ void UWBIRMac::prepareData(UWBIRMacPkt* packet, IEEE802154A::config /*cfg*/) {
 	packet->setNbSymbols(nbSymbols);
 
 	// attach control info
-	MacToUWBIRPhyControlInfo::setControlInfo(packet, theSignal, IEEE802154A::getConfig());
+	MacToUWBIRPhyControlInfo::setControlInfo(packet, theSignal, context->getConfig());
 }
 
 bool UWBIRMac::validatePacket(UWBIRMacPkt *mac) {
@@ -76,6 +76,7 @@ public:
     	, phy(NULL)
     	, packet(100)
     	, prf(0)
+    	, context(NULL)
     	, packetsBER()
     	, dataLengths()
     	, erroneousSymbols()
@@ -102,6 +103,8 @@ protected:
     MacToPhyInterface* phy;
     Packet packet;
     int prf; // pulse repetition frequency
+    /** @brief The shared IEEE 802.15.4A context of the PRF.*/
+    const IEEE802154A::Context* context;
     cOutVector packetsBER;
     cOutVector dataLengths;
     cOutVector erroneousSymbols;
@@ -59,12 +59,18 @@ void Flood::initialize(int stage) {
 			hasPar("bcDelTime") ? bcDelTime = par("bcDelTime").doubleValue() : bcDelTime = 3.0;
 			EV <<"bcMaxEntries = "<<bcMaxEntries
 			<<" bcDelTime = "<<bcDelTime<<endl;
+
+			if (bcMaxEntries == 0) {
+				error("bcMaxEntries has to be positive");
+			}
+			bcMsgs.setMaxEntries(bcMaxEntries);
 		}
 	}
 }
 
 void Flood::finish() {
 	if (plainFlooding) {
+		bcMsgs.recordScalars(this);
 		bcMsgs.clear();
 	}
 	recordScalar("nbDataPacketsReceived", nbDataPacketsReceived);
@@ -85,7 +91,7 @@ void Flood::finish() {
  * message is flooded (i.e. has to be send to all neighbors)
  *
  * In the case of plain flooding the message sequence number and
- * source address has also be stored in the bcMsgs list, so that this
+ * source address has also be stored in the bcMsgs cache, so that this
  * message will not be rebroadcasted, if a copy will be flooded back
  * from the neigbouring nodes.
  *
@@ -102,24 +108,8 @@ void Flood::handleUpperMsg(cMessage* m) {
 	msg->setTtl(defaultTtl);
 
 	if (plainFlooding) {
-		if (bcMsgs.size() >= bcMaxEntries) {
-			cBroadcastList::iterator it;
-
-			//serach the broadcast list of outdated entries and delete them
-			for (it = bcMsgs.begin(); it != bcMsgs.end(); ++it) {
-				if (it->delTime < simTime()) {
-					bcMsgs.erase(it);
-					it--;
-					break;
-				}
-			}
-			//delete oldest entry if max size is reached
-			if (bcMsgs.size() >= bcMaxEntries) {
-				EV<<"bcMsgs is full, delete oldest entry"<<endl;
-				bcMsgs.pop_front();
-			}
-		}
-		bcMsgs.push_back(Bcast(msg->getSeqNum(), msg->getSrcAddr(), simTime() +bcDelTime));
+		//outdated entries are deleted, if max size is reached the oldest one
+		bcMsgs.insert(msg->getSrcAddr(), msg->getSeqNum(), simTime() + bcDelTime, simTime());
     }
 				//there is no routing so all messages are broadacst for the mac layer
 
@@ -137,7 +127,7 @@ void Flood::handleUpperMsg(cMessage* m) {
 			 * account for this hop.
 			 *
 			 * In the case of plain flooding the message will only be processed if
-			 * there is no corresponding entry in the bcMsgs list (@ref
+			 * there is no corresponding entry in the bcMsgs cache (@ref
 			 * notBroadcasted). Otherwise the message will be deleted.
 			 **/
 void Flood::handleLowerMsg(cMessage* m) {
@@ -202,43 +192,21 @@ void Flood::handleLowerMsg(cMessage* m) {
 }
 
 /**
- * The bcMsgs list is searched for the arrived message. If the message
- * is in the list, it was already broadcasted and the function returns
+ * The bcMsgs cache is searched for the arrived message. If the message
+ * is in the cache, it was already broadcasted and the function returns
  * false.
  *
  * Concurrently all outdated (older than bcDelTime) are deleted. If
- * the list is full and a new message has to be entered, the oldest
+ * the cache is full and a new message has to be entered, the oldest
  * entry is deleted.
  **/
 bool Flood::notBroadcasted(netwpkt_ptr_t msg) {
 	if (!plainFlooding)
 		return true;
 
-	cBroadcastList::iterator it;
-
-	//serach the broadcast list of outdated entries and delete them
-	for (it = bcMsgs.begin(); it != bcMsgs.end(); it++) {
-		if (it->delTime < simTime()) {
-			bcMsgs.erase(it);
-			it--;
-		}
-		//message was already broadcasted
-		if ((it->srcAddr == msg->getSrcAddr()) && (it->seqNum
-				== msg->getSeqNum())) {
-			// update entry
-			it->delTime = simTime() + bcDelTime;
-			return false;
-		}
-	}
-
-	//delete oldest entry if max size is reached
-	if (bcMsgs.size() >= bcMaxEntries) {
-		EV<<"bcMsgs is full, delete oldest entry\n";
-		bcMsgs.pop_front();
-	}
-
-	bcMsgs.push_back(Bcast(msg->getSeqNum(), msg->getSrcAddr(), simTime() +bcDelTime));
-    return true;
+	//outdated entries are deleted, if max size is reached the oldest one.
+	//If the message was already broadcasted its entry is updated.
+	return bcMsgs.insert(msg->getSrcAddr(), msg->getSeqNum(), simTime() + bcDelTime, simTime());
 }
 
 Flood::netwpkt_ptr_t Flood::encapsMsg(cPacket *appPkt) {
@@ -23,17 +23,16 @@
 #ifndef _FLOOD_H_
 #define _FLOOD_H_
 
-#include <list>
-
 #include "MiXiMDefs.h"
 #include "BaseNetwLayer.h"
 #include "SimpleAddress.h"
+#include "DuplicateCache.h"
 
 /**
  * @brief A simple flooding protocol
  *
  * This implementation uses plain flooding, i.e. it "remembers"
- * (stores) already broadcasted messages in a list and does not
+ * (stores) already broadcasted messages in a DuplicateCache and does not
  * rebroadcast them again, if it gets another copy of that message.
  *
  * The maximum number of entires for that list can be defined in the
@@ -60,21 +59,9 @@ protected:
     /** @brief Defines whether to use plain flooding or not*/
     bool plainFlooding;
 
-    class Bcast {
-    public:
-        unsigned long    seqNum;
-        LAddress::L3Type srcAddr;
-        simtime_t        delTime;
-    public:
-        Bcast(unsigned long n=0, const LAddress::L3Type& s = LAddress::L3NULL,  simtime_t_cref d=SIMTIME_ZERO) :
-            seqNum(n), srcAddr(s), delTime(d) {
-        }
-    };
-
-    typedef std::list<Bcast> cBroadcastList;
-
-    /** @brief List of already broadcasted messages*/
-    cBroadcastList bcMsgs;
+    /** @brief Source addresses and sequence numbers of already
+     * broadcasted messages*/
+    DuplicateCache bcMsgs;
 
     /**
      * @brief Max number of entries in the list of already broadcasted
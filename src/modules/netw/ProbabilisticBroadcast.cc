@@ -32,6 +32,10 @@ void ProbabilisticBroadcast::initialize(int stage)
 	    headerLength = par("headerLength");
 	    timeInQueueAfterDeath = par("timeInQueueAfterDeath");
 	    timeToLive = par("timeToLive");
+	    if (par("knownMsgsInitialEntries").longValue() <= 0) {
+	        error("knownMsgsInitialEntries has to be positive");
+	    }
+	    knownMsgIds.setMaxEntries(par("knownMsgsInitialEntries").longValue());
 	    broadcastTimer = new cMessage("broadcastTimer");
 	    maxFirstBcastBackoff = par("maxFirstBcastBackoff");
 	    oneHopLatencies.setName("oneHopLatencies");
@@ -218,16 +222,14 @@ void ProbabilisticBroadcast::finish()
 		} else {
 		  recordScalar("meanNbHops", 0);
 		}
+		knownMsgIds.recordScalars(this);
 	}
 	BaseNetwLayer::finish();
 }
 
 bool ProbabilisticBroadcast::messageKnown(unsigned int msgId)
 {
-	MsgIdSet::iterator pos;
-
-	pos = knownMsgIds.find(msgId);
-	return pos != knownMsgIds.end();
+	return knownMsgIds.contains(0, msgId, simTime());
 }
 
 bool ProbabilisticBroadcast::debugMessageKnown(unsigned int msgId)
@@ -246,8 +248,13 @@ void ProbabilisticBroadcast::insertMessage(simtime_t_cref bcastDelay, tMsgDesc*
 	EV << "PBr: " << simTime() << " n"  << myNetwAddr << "         insertMessage() bcastDelay = " << bcastDelay << " Msg ID = " << msgDesc->pkt->getId() << endl;
 	// update TTL field of the message to the value it will have when taken out of the list
 	msgDesc->pkt->setAppTtl(msgDesc->pkt->getAppTtl() - bcastDelay);
-	// insert message ID in ID list.
-	knownMsgIds.insert(msgDesc->pkt->getId());
+	// insert message ID in ID list, it is removed again when the message is popped.
+	// The cache must not evict the ID of another queued message, otherwise a
+	// copy of it would be queued and broadcasted again, so it grows instead.
+	if (knownMsgIds.size() >= knownMsgIds.getMaxEntries()) {
+		knownMsgIds.grow(2 * knownMsgIds.getMaxEntries());
+	}
+	knownMsgIds.insert(0, msgDesc->pkt->getId(), bcastTime, simTime());
 	// insert key value pair <broadcast time, pointer to message> in message queue.
 	pos = msgQueue.insert(make_pair(bcastTime, msgDesc));
 	// if the message has been inserted in the front of the list, it means that it
@@ -271,7 +278,7 @@ ProbabilisticBroadcast::tMsgDesc* ProbabilisticBroadcast::popFirstMessageUpdateQ
 	msgDesc = pos->second;
 	// remove first message from message queue and from ID list
 	msgQueue.erase(pos);
-	knownMsgIds.erase(msgDesc->pkt->getId());
+	knownMsgIds.erase(0, msgDesc->pkt->getId());
 	EV << "PBr: " << simTime() << " n"  << myNetwAddr << "         pop(): just popped msg " << msgDesc->pkt->getId() << endl;
 	if (!msgQueue.empty()) {
 		// schedule broadcast of new first message
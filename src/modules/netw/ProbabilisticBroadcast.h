@@ -14,6 +14,7 @@
 #include "MiXiMDefs.h"
 #include "ProbabilisticBroadcastPkt_m.h"
 #include "BaseNetwLayer.h"
+#include "DuplicateCache.h"
 
 /**
  * @brief This class offers a data dissemination service using
@@ -197,11 +198,12 @@ protected:
     // perform broadcast attempt for the first message in the list each time it expires
     cMessage* broadcastTimer;
 
-    // we use two containers: a set which stores the ID's of the messages which are kept
+    // we use two containers: a cache which stores the ID's of the messages which are kept
     // in memory and a multimap which stores a pair <Key, Value> where Key is the next
     // broadcasting attempt time of the message and Value is a pointer to the message
-    // (see typedef's above).
-    MsgIdSet knownMsgIds;
+    // (see typedef's above). The ID's are stored with source 0 since they are unique.
+    // The cache grows with the queue, the ID of a queued message is never evicted.
+    DuplicateCache knownMsgIds;
     TimeMsgMap msgQueue;
     MsgIdSet debugMsgIdSet;
 
@@ -60,6 +60,14 @@ void WiseRoute::initialize(int stage)
 		rssiThreshold = par("rssiThreshold").doubleValue();
 		rssiThreshold = FWMath::dBm2mW(rssiThreshold);
 		routeFloodsInterval = par("routeFloodsInterval");
+		floodTableDelTime = par("floodTableDelTime");
+		if (par("floodTableMaxEntries").longValue() < 0) {
+			error("floodTableMaxEntries must not be negative");
+		}
+		// without a maximum the table starts small and grows like the
+		// unbounded table WiseRoute used before
+		floodTableBounded = par("floodTableMaxEntries").longValue() > 0;
+		floodTable.setMaxEntries(floodTableBounded ? par("floodTableMaxEntries").longValue() : 64);
 
 		stats = par("stats");
 		trace = par("trace");
@@ -128,7 +136,7 @@ void WiseRoute::handleSelfMsg(cMessage* msg)
 		pkt->setSrcAddr(myNetwAddr);
 		pkt->setDestAddr(LAddress::L3BROADCAST);
 		pkt->setNbHops(0);
-		floodTable.insert(make_pair(myNetwAddr, floodSeqNumber));
+		insertFlood(myNetwAddr, floodSeqNumber);
 		pkt->setSeqNum(floodSeqNumber);
 		floodSeqNumber++;
 		pkt->setIsFlood(1);
@@ -272,7 +280,7 @@ void WiseRoute::handleUpperMsg(cMessage* msg)
 		pkt->setIsFlood(1);
 		nbFloodsSent++;
 		// record flood in flood table
-		floodTable.insert(make_pair(myNetwAddr, floodSeqNumber));
+		insertFlood(myNetwAddr, floodSeqNumber);
 		pkt->setSeqNum(floodSeqNumber);
 		floodSeqNumber++;
 		nbGetRouteFailures++;
@@ -305,6 +313,7 @@ void WiseRoute::finish()
 		recordScalar("nbGetRouteFailures", nbGetRouteFailures);
 		recordScalar("nbRoutesRecorded", nbRoutesRecorded);
 		recordScalar("meanNbHops", (double) nbHops / (double) nbDataPacketsReceived);
+		floodTable.recordScalars(this);
 	}
 	BaseNetwLayer::finish();
 }
@@ -365,18 +374,24 @@ cMessage* WiseRoute::decapsMsg(WiseRoutePkt *msg)
 	return m;
 }
 
-WiseRoute::floodTypes WiseRoute::updateFloodTable(bool isFlood, const tFloodTable::key_type& srcAddr, const tFloodTable::key_type& destAddr, unsigned long seqNum)
+simtime_t WiseRoute::getFloodExpiry() const
 {
-	if (isFlood) {
-		tFloodTable::iterator pos = floodTable.lower_bound(srcAddr);
-		tFloodTable::iterator posEnd = floodTable.upper_bound(srcAddr);
+	return floodTableDelTime > SIMTIME_ZERO ? simTime() + floodTableDelTime : MAXTIME;
+}
 
-		while (pos != posEnd) {
-			if (seqNum == pos->second)
-				return DUPLICATE;  // this flood is known, don't forward it.
-			++pos;
-		}
-		floodTable.insert(make_pair(srcAddr, seqNum));
+bool WiseRoute::insertFlood(const LAddress::L3Type& srcAddr, unsigned long seqNum)
+{
+	if (!floodTableBounded && floodTable.size() >= floodTable.getMaxEntries()) {
+		floodTable.grow(2 * floodTable.getMaxEntries());
+	}
+	return floodTable.insert(srcAddr, seqNum, getFloodExpiry(), simTime());
+}
+
+WiseRoute::floodTypes WiseRoute::updateFloodTable(bool isFlood, const tRouteTable::key_type& srcAddr, const tRouteTable::key_type& destAddr, unsigned long seqNum)
+{
+	if (isFlood) {
+		if (!insertFlood(srcAddr, seqNum))
+			return DUPLICATE;  // this flood is known, don't forward it.
 		if (destAddr == myNetwAddr)
 			return FORME;
 		else
@@ -386,7 +401,7 @@ WiseRoute::floodTypes WiseRoute::updateFloodTable(bool isFlood, const tFloodTabl
 		return NOTAFLOOD;
 }
 
-WiseRoute::tFloodTable::key_type WiseRoute::getRoute(const tFloodTable::key_type& destAddr, bool /*iAmOrigin*/) const
+WiseRoute::tRouteTable::key_type WiseRoute::getRoute(const tRouteTable::key_type& destAddr, bool /*iAmOrigin*/) const
 {
 	// Find a route to dest address. As in the embedded code, if no route exists, indicate
 	// final destination as next hop. If we'are lucky, final destination is one hop away...
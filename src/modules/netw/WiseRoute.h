@@ -32,6 +32,7 @@
 #include "MiXiMDefs.h"
 #include "BaseNetwLayer.h"
 #include "SimpleAddress.h"
+#include "DuplicateCache.h"
 
 class SimTracer;
 class WiseRoutePkt;
@@ -65,6 +66,8 @@ public:
 		: BaseNetwLayer()
 		, routeTable()
 		, floodTable()
+		, floodTableDelTime()
+		, floodTableBounded(false)
 		, headerLength(0)
 		, macaddress()
 		, sinkAddress()
@@ -124,10 +127,15 @@ protected:
 	} tRouteTableEntry;
 
 	typedef std::map<LAddress::L3Type, tRouteTableEntry>        tRouteTable;
-	typedef std::multimap<tRouteTable::key_type, unsigned long> tFloodTable;
 
 	tRouteTable routeTable;
-	tFloodTable floodTable;
+	/** @brief Source addresses and sequence numbers of the known floods.*/
+	DuplicateCache floodTable;
+	/** @brief Time after which a flood is forgotten, never if zero.*/
+	simtime_t floodTableDelTime;
+	/** @brief Whether the oldest flood is forgotten if the flood table is
+	 * full, otherwise the table grows.*/
+	bool floodTableBounded;
 
     /**
      * @brief Length of the NetwPkt header
@@ -217,10 +225,16 @@ protected:
     /** @brief update flood table. returns detected flood type (general or unicast flood to forward,
      *         duplicate flood to delete, unicast flood to me
      */
-    floodTypes updateFloodTable(bool isFlood, const tFloodTable::key_type& srcAddr, const tFloodTable::key_type& destAddr, unsigned long seqNum);
+    floodTypes updateFloodTable(bool isFlood, const tRouteTable::key_type& srcAddr, const tRouteTable::key_type& destAddr, unsigned long seqNum);
+
+    /** @brief Returns the time until which a flood sent or received now is remembered. */
+    simtime_t getFloodExpiry() const;
+
+    /** @brief Remembers the passed flood, returns false if it is already known. */
+    bool insertFlood(const LAddress::L3Type& srcAddr, unsigned long seqNum);
 
     /** @brief find a route to destination address. */
-    tFloodTable::key_type getRoute(const tFloodTable::key_type& destAddr, bool iAmOrigin = false) const;
+    tRouteTable::key_type getRoute(const tRouteTable::key_type& destAddr, bool iAmOrigin = false) const;
 };
 
 #endif
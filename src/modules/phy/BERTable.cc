@@ -0,0 +1,103 @@
+/*
+ * BERTable.cc
+ *
+ *  Precomputed mapping from the SNR to the bit error rate of a modulation.
+ */
+
+#include "BERTable.h"
+
+#include <cassert>
+#include <algorithm>
+
+namespace {
+	/** @brief Smallest tabulated bit error rate, avoids the logarithm of zero.*/
+	const double minBER = 1e-300;
+
+	/** @brief Smallest bit error rate whose relative error is checked.*/
+	const double minCheckedBER = 1e-250;
+
+	/** @brief Tables are not refined beyond this number of entries.*/
+	const size_t maxEntries = 1 << 20;
+}
+
+BERTable::BERTable()
+	: function(NULL)
+	, parameter(0)
+	, minExponent(0)
+	, perOctave(0)
+	, lastPos(0)
+	, saturated(false)
+	, maxError(0)
+	, logBER()
+{ }
+
+double BERTable::getSNR(double pos) const
+{
+	const double octave = floor(pos / perOctave);
+	return ldexp(0.5 + 0.5 * (pos / perOctave - octave), minExponent + static_cast<int>(octave));
+}
+
+bool BERTable::build(ber_function_t function, double parameter,
+                     double minSnrDB, double maxSnrDB,
+                     double resolution, double maxRelError)
+{
+	assert(function != NULL);
+	assert(resolution > 0 && maxSnrDB > minSnrDB);
+
+	this->function  = function;
+	this->parameter = parameter;
+
+	// the table starts and ends at octave boundaries around the passed range
+	int maxExponent;
+	frexp(pow(10.0, minSnrDB / 10.0), &minExponent);
+	frexp(pow(10.0, maxSnrDB / 10.0), &maxExponent);
+	const size_t octaves = static_cast<size_t>(maxExponent - minExponent + 1);
+
+	// the entries are farthest apart (in dB) at the beginning of an octave
+	perOctave = ceil(1.0 / (pow(10.0, resolution / 10.0) - 1.0));
+
+	while(true) {
+		const size_t n = octaves * static_cast<size_t>(perOctave) + 1;
+		lastPos = static_cast<double>(n - 1);
+
+		logBER.resize(n);
+		for(size_t i = 0; i < n; ++i) {
+			const double ber = function(getSNR(i), parameter);
+			// also catches negative values and NaN caused by cancellation in the closed form
+			const double value = ber > minBER ? log(ber) : log(minBER);
+			// rounding errors of the closed form must not let the rate grow with the SNR
+			logBER[i] = (i == 0) ? value : std::min(value, logBER[i - 1]);
+		}
+		saturated = logBER.back() <= log(minCheckedBER);
+
+		// the interpolation error is largest at the middle between two entries
+		maxError = 0;
+		for(size_t i = 0; i + 1 < n; ++i) {
+			const double exact = function(getSNR(i + 0.5), parameter);
+			if(!(exact >= minCheckedBER))
+				continue;
+			const double approx = exp(0.5 * (logBER[i] + logBER[i + 1]));
+			maxError = std::max(maxError, fabs(approx - exact) / exact);
+		}
+
+		if(maxRelError <= 0 || maxError <= maxRelError)
+			return true;
+		if(2 * n > maxEntries)
+			return false;
+		perOctave *= 2;
+	}
+}
+
+double BERTable::validate(double fromDB, double toDB, size_t samples) const
+{
+	double error = 0;
+	for(size_t i = 0; i < samples; ++i) {
+		const double snrDB = samples > 1 ? fromDB + i * (toDB - fromDB) / (samples - 1) : fromDB;
+		const double snr   = pow(10.0, snrDB / 10.0);
+		const double exact = getExactBER(snr);
+		if(!(exact >= minCheckedBER))
+			continue;
+		error = std::max(error, fabs(getBER(snr) - exact) / exact);
+	}
+	return error;
+}
@@ -0,0 +1,136 @@
+/*
+ * BERTable.h
+ *
+ *  Precomputed mapping from the SNR to the bit error rate of a modulation.
+ */
+
+#ifndef BERTABLE_H_
+#define BERTABLE_H_
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+
+#include "MiXiMDefs.h"
+
+/**
+ * @brief Tabulates the closed form bit error rate of a modulation over the
+ * SNR, so that deciders do not have to evaluate it per frame.
+ *
+ * The table holds the natural logarithm of the bit error rate and
+ * interpolates it linearly. Every octave of the SNR (a factor of two) is
+ * split into the same number of equally spaced points, so the position of
+ * an SNR in the table follows from its binary exponent and mantissa without
+ * evaluating a logarithm, and the points are spaced nearly equally in dB.
+ * Since the error rates of the supported modulations fall exponentially
+ * with the SNR the logarithm is almost linear between two points and the
+ * interpolation is much more exact than interpolating the rate itself. The
+ * tabulated values are forced to be non-increasing, so the interpolated bit
+ * error rate never grows with the SNR.
+ *
+ * On build() the number of points per octave is chosen so that two points
+ * are at most the passed resolution (in dB) apart and is doubled until the
+ * relative error at the middle between every two points, where it is
+ * largest, is below the passed bound. Bit error rates below 1e-250 are not
+ * checked, they are zero for all practical purposes.
+ *
+ * SNR values below the table are passed to the closed form. Above the table
+ * the last value is returned if the bit error rate is zero for all practical
+ * purposes there, otherwise the closed form is used as well.
+ *
+ * @ingroup decider
+ */
+class MIXIM_API BERTable
+{
+public:
+	/** @brief A closed form bit error rate for the passed (linear) SNR and
+	 * parameter of the modulation, like the bitrate.*/
+	typedef double (*ber_function_t)(double snr, double parameter);
+
+protected:
+	/** @brief The closed form, NULL if the table was not built.*/
+	ber_function_t function;
+	/** @brief The parameter passed to the closed form.*/
+	double parameter;
+	/** @brief Binary exponent of the first table entry, its SNR is
+	 * 0.5 * 2^minExponent.*/
+	int    minExponent;
+	/** @brief Number of table entries per octave.*/
+	double perOctave;
+	/** @brief Index of the last entry.*/
+	double lastPos;
+	/** @brief True if the bit error rate at the last entry is zero for
+	 * all practical purposes.*/
+	bool   saturated;
+	/** @brief Largest relative error found at the midpoints on build().*/
+	double maxError;
+	/** @brief Natural logarithm of the bit error rate at the table entries.*/
+	std::vector<double> logBER;
+
+	/** @brief Returns the linear SNR at the passed (fractional) table index.*/
+	double getSNR(double pos) const;
+
+public:
+	BERTable();
+
+	/**
+	 * @brief Tabulates the passed closed form for SNR values between
+	 * "minSnrDB" and "maxSnrDB" dB.
+	 *
+	 * Starts with entries at most "resolution" dB apart and doubles their
+	 * number until the relative error of the interpolation is at most
+	 * "maxRelError" (if positive). Returns false if the bound could not be
+	 * reached with a table of reasonable size, the table is usable anyway.
+	 */
+	bool build(ber_function_t function, double parameter,
+	           double minSnrDB, double maxSnrDB,
+	           double resolution, double maxRelError);
+
+	/** @brief Returns true if build() was called.*/
+	bool isBuilt() const { return function != NULL; }
+
+	/** @brief Returns the bit error rate at the passed linear SNR.
+	 *
+	 * The table has to be built before.
+	 */
+	double getBER(double snr) const {
+		if(snr > 0) {
+			int          exponent;
+			const double mantissa = frexp(snr, &exponent);
+			const double pos      = ((exponent - minExponent) + (2.0 * mantissa - 1.0)) * perOctave;
+			if(pos >= 0) {
+				if(pos < lastPos) {
+					const size_t i = static_cast<size_t>(pos);
+					return exp(logBER[i] + (pos - i) * (logBER[i + 1] - logBER[i]));
+				}
+				if(saturated) {
+					return exp(logBER.back());
+				}
+			}
+		}
+		return function(snr, parameter);
+	}
+
+	/** @brief Returns the bit error rate of the closed form.*/
+	double getExactBER(double snr) const { return function(snr, parameter); }
+
+	/**
+	 * @brief Compares the table with the closed form at "samples" SNR
+	 * values equally spaced between "fromDB" and "toDB" dB and returns the
+	 * largest relative error.
+	 *
+	 * Bit error rates below 1e-250 are skipped.
+	 */
+	double validate(double fromDB, double toDB, size_t samples) const;
+
+	/** @brief Returns the largest relative error found on build().*/
+	double getMaxError() const { return maxError; }
+
+	/** @brief Returns the largest distance of two entries in dB.*/
+	double getResolution() const { return perOctave > 0 ? 10.0 * log10(1.0 + 1.0 / perOctave) : 0; }
+
+	/** @brief Returns the number of entries.*/
+	size_t size() const { return logBER.size(); }
+};
+
+#endif /* BERTABLE_H_ */
@@ -30,6 +30,7 @@ Decider80211::Decider80211( DeciderToPhyInterface* phy
     : BaseDecider(phy, sensitivity, myIndex, debug)
     , snrThreshold(0)
     , centerFrequency(0)
+    , payloadBERTables()
 {
 	assert(1                             <= phy->getCurrentRadioChannel());
 	assert(phy->getCurrentRadioChannel() <= 14);
@@ -46,6 +47,42 @@ bool Decider80211::initFromMap(const ParameterMap& params) {
         bInitSuccess = false;
         opp_warning("No threshold defined in config.xml for Decider80211!");
     }
+
+    double berTableResolution = 0;
+    double berTableMaxError   = 1e-3;
+    double berTableMinSNR     = -20;
+    double berTableMaxSNR     = 40;
+    if((it = params.find("berTableResolution")) != params.end()) {
+        berTableResolution = ParameterMap::mapped_type(it->second).doubleValue();
+    }
+    if((it = params.find("berTableMaxError")) != params.end()) {
+        berTableMaxError = ParameterMap::mapped_type(it->second).doubleValue();
+    }
+    if((it = params.find("berTableMinSNR")) != params.end()) {
+        berTableMinSNR = ParameterMap::mapped_type(it->second).doubleValue();
+    }
+    if((it = params.find("berTableMaxSNR")) != params.end()) {
+        berTableMaxSNR = ParameterMap::mapped_type(it->second).doubleValue();
+    }
+    payloadBERTables.clear();
+    if(berTableResolution > 0) {
+        if(berTableMaxSNR <= berTableMinSNR) {
+            bInitSuccess = false;
+            opp_warning("The berTableMaxSNR defined in config.xml for Decider80211 has to be greater than berTableMinSNR!");
+        }
+        else {
+            bool         bExact     = true;
+            const double bitrates[] = { 5.5E+6, 11E+6 };
+            for(size_t i = 0; i < sizeof(bitrates) / sizeof(bitrates[0]); ++i) {
+                bExact = payloadBERTables[bitrates[i]].build(getBERFunction(bitrates[i]), bitrates[i],
+                                                             berTableMinSNR, berTableMaxSNR,
+                                                             berTableResolution, berTableMaxError) && bExact;
+            }
+            if(!bExact) {
+                opp_warning("The bit error rate tables of Decider80211 exceed the berTableMaxError!");
+            }
+        }
+    }
     return BaseDecider::initFromMap(params) && bInitSuccess;
 }
 
@@ -124,18 +161,8 @@ bool Decider80211::packetOk(double snirMin, int lengthMPDU, double bitrate) cons
 {
     double berHeader, berMPDU;
 
-    berHeader = 0.5 * exp(-snirMin * BANDWIDTH / BITRATE_HEADER);
-    //if PSK modulation
-    if (bitrate == 1E+6 || bitrate == 2E+6) {
-        berMPDU = 0.5 * exp(-snirMin * BANDWIDTH / bitrate);
-    }
-    //if CCK modulation (modeled with 16-QAM)
-    else if (bitrate == 5.5E+6) {
-        berMPDU = 2.0 * (1.0 - 1.0 / sqrt(pow(2.0, 4))) * ERFC(sqrt(2.0*snirMin * BANDWIDTH / bitrate));
-    }
-    else {                       // CCK, modelled with 256-QAM
-        berMPDU = 2.0 * (1.0 - 1.0 / sqrt(pow(2.0, 8))) * ERFC(sqrt(2.0*snirMin * BANDWIDTH / bitrate));
-    }
+    berHeader = calcBERDBPSK(snirMin, BITRATE_HEADER);
+    berMPDU   = getPayloadBER(snirMin, bitrate);
 
     //probability of no bit error in the PLCP header
     double headerNoError = pow(1.0 - berHeader, HEADER_WITHOUT_PREAMBLE);
@@ -160,3 +187,38 @@ bool Decider80211::packetOk(double snirMin, int lengthMPDU, double bitrate) cons
             return (true);
     }
 }
+
+double Decider80211::getPayloadBER(double snr, double bitrate) const
+{
+	BERTableMap::const_iterator it = payloadBERTables.find(bitrate);
+	if(it != payloadBERTables.end())
+		return it->second.getBER(snr);
+	return getBERFunction(bitrate)(snr, bitrate);
+}
+
+BERTable::ber_function_t Decider80211::getBERFunction(double bitrate)
+{
+	//if PSK modulation
+	if (bitrate == 1E+6 || bitrate == 2E+6)
+		return &calcBERDBPSK;
+	//if CCK modulation (modeled with 16-QAM)
+	if (bitrate == 5.5E+6)
+		return &calcBERCCK16;
+	// CCK, modelled with 256-QAM
+	return &calcBERCCK256;
+}
+
+double Decider80211::calcBERDBPSK(double snr, double bitrate)
+{
+	return 0.5 * exp(-snr * BANDWIDTH / bitrate);
+}
+
+double Decider80211::calcBERCCK16(double snr, double bitrate)
+{
+	return 2.0 * (1.0 - 1.0 / sqrt(pow(2.0, 4))) * ERFC(sqrt(2.0*snr * BANDWIDTH / bitrate));
+}
+
+double Decider80211::calcBERCCK256(double snr, double bitrate)
+{
+	return 2.0 * (1.0 - 1.0 / sqrt(pow(2.0, 8))) * ERFC(sqrt(2.0*snr * BANDWIDTH / bitrate));
+}
@@ -11,6 +11,9 @@
 #include "MiXiMDefs.h"
 #include "BaseDecider.h"
 #include "MappingBase.h"
+#include "BERTable.h"
+
+#include <map>
 
 /**
  * @brief Decider for the 802.11 modules
@@ -44,6 +47,14 @@ protected:
 	/** @brief The center frequency on which the decider listens for signals */
 	double centerFrequency;
 
+	/** @brief Bit error rate tables for the payload bitrates.*/
+	typedef std::map<double, BERTable> BERTableMap;
+
+	/** @brief Bit error rate of the MPDU over the SNR for the CCK bitrates,
+	 * empty if "berTableResolution" is not positive. The DBPSK bit error rate
+	 * is a single exponential function and cheaper to evaluate directly.*/
+	BERTableMap payloadBERTables;
+
 protected:
 	/** @brief The lower band frequency at given time point.
 	 */
@@ -83,6 +94,10 @@ protected:
 	/** @brief computes if packet is ok or has errors*/
 	virtual bool packetOk(double snirMin, int lengthMPDU, double bitrate) const;
 
+	/** @brief Returns the bit error rate of the MPDU at the passed SNR and
+	 * bitrate.*/
+	double getPayloadBER(double snr, double bitrate) const;
+
 	/**
 	 * @brief Calculates the RSSI value for the passed interval.
 	 *
@@ -107,6 +122,11 @@ public:
 	 *
 	 * This method should be defined for generic decider initialization.
 	 *
+	 * Builds the bit error rate tables of the CCK bitrates from the optional parameters "berTableResolution" (dB,
+	 * defaults to 0, the closed forms are evaluated per frame if not
+	 * positive), "berTableMaxError" (relative, defaults to 1e-3),
+	 * "berTableMinSNR" and "berTableMaxSNR" (dB, default to -20 and 40).
+	 *
 	 * @param params The parameter map which was filled by XML reader.
 	 *
 	 * @return true if the initialization was successfully.
@@ -114,6 +134,21 @@ public:
 	virtual bool initFromMap(const ParameterMap& params);
 
 	virtual ~Decider80211() {};
+
+	/** @brief Returns the closed form bit error rate of the MPDU for the
+	 * passed bitrate, the bitrate has to be passed to it as parameter.*/
+	static BERTable::ber_function_t getBERFunction(double bitrate);
+
+	/** @brief Closed form bit error rate of DBPSK (header, 1 and 2 Mbit/s).*/
+	static double calcBERDBPSK(double snr, double bitrate);
+
+	/** @brief Closed form bit error rate of CCK at 5.5 Mbit/s, modeled as
+	 * 16-QAM.*/
+	static double calcBERCCK16(double snr, double bitrate);
+
+	/** @brief Closed form bit error rate of CCK at 11 Mbit/s (and all other
+	 * bitrates), modeled as 256-QAM.*/
+	static double calcBERCCK256(double snr, double bitrate);
 };
 
 #endif /* DECIDER80211_H_ */
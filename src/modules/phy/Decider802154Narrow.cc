@@ -45,7 +45,11 @@ bool Decider802154Narrow::initFromMap(const ParameterMap& params) {
     }
     it = params.find("modulation");
     if(it != params.end()) {
-        modulation = ParameterMap::mapped_type(it->second).stringValue();
+        modulation = getModulation(ParameterMap::mapped_type(it->second).stringValue());
+        if(modulation == UNKNOWN_MODULATION) {
+            bInitSuccess = false;
+            opp_warning("The modulation defined in config.xml for Decider802154Narrow is not supported!");
+        }
     }
     else {
         bInitSuccess = false;
@@ -55,6 +59,34 @@ bool Decider802154Narrow::initFromMap(const ParameterMap& params) {
     if(it != params.end()) {
         recordStats = ParameterMap::mapped_type(it->second).boolValue();
     }
+
+    double berTableResolution = 0;
+    double berTableMaxError   = 1e-3;
+    double berTableMinSNR     = -20;
+    double berTableMaxSNR     = 40;
+    if((it = params.find("berTableResolution")) != params.end()) {
+        berTableResolution = ParameterMap::mapped_type(it->second).doubleValue();
+    }
+    if((it = params.find("berTableMaxError")) != params.end()) {
+        berTableMaxError = ParameterMap::mapped_type(it->second).doubleValue();
+    }
+    if((it = params.find("berTableMinSNR")) != params.end()) {
+        berTableMinSNR = ParameterMap::mapped_type(it->second).doubleValue();
+    }
+    if((it = params.find("berTableMaxSNR")) != params.end()) {
+        berTableMaxSNR = ParameterMap::mapped_type(it->second).doubleValue();
+    }
+    if(berTableResolution > 0 && modulation != UNKNOWN_MODULATION) {
+        if(berTableMaxSNR <= berTableMinSNR) {
+            bInitSuccess = false;
+            opp_warning("The berTableMaxSNR defined in config.xml for Decider802154Narrow has to be greater than berTableMinSNR!");
+        }
+        else if(!berTable.build(getBERFunction(modulation), 0, berTableMinSNR, berTableMaxSNR,
+                                berTableResolution, berTableMaxError)) {
+            opp_warning("The bit error rate table of Decider802154Narrow exceeds the berTableMaxError (%g > %g)!",
+                        berTable.getMaxError(), berTableMaxError);
+        }
+    }
     return BaseDecider::initFromMap(params) && bInitSuccess;
 }
 
@@ -211,47 +243,81 @@ double Decider802154Narrow::n_choose_k(int n, int k) {
 	return dRes;
 }
 
+Decider802154Narrow::Modulation Decider802154Narrow::getModulation(const std::string& name) {
+	if(name == "msk")
+		return MSK;
+	if(name == "oqpsk16")
+		return OQPSK16;
+	if(name == "gfsk")
+		return GFSK;
+	return UNKNOWN_MODULATION;
+}
+
+BERTable::ber_function_t Decider802154Narrow::getBERFunction(Modulation modulation) {
+	switch(modulation) {
+		case MSK:     return &calcBERMSK;
+		case OQPSK16: return &calcBEROQPSK16;
+		case GFSK:    return &calcBERGFSK;
+		default:      return NULL;
+	}
+}
+
+double Decider802154Narrow::calcBERMSK(double snr, double) {
+	// valid for IEEE 802.15.4 868 MHz BPSK modulation
+	return 0.5 *  ERFC(sqrt(snr));
+}
+
+double Decider802154Narrow::calcBEROQPSK16(double snr, double) {
+	// valid for IEEE 802.15.4 2.45 GHz OQPSK modulation
+	// Following formula is defined in IEEE 802.15.4 standard, please check the 
+	// 2006 standard, page 268, section E.4.1.8 Bit error rate (BER) 
+	// calculations, formula 7). Here you cab see that the factor of 20.0 is correct ;).
+	const double dSNRFct = 20.0 * snr;
+	double       dSumK   = 0;
+	register int k       = 2;
+	/* following loop was optimized by using n_choose_k symmetries
+	for (k=2; k <= 16; ++k) {
+		dSumK += pow(-1.0, k) * n_choose_k(16, k) * exp(dSNRFct * (1.0 / k - 1.0));
+	}
+	*/
+	// n_choose_k(16, k) == n_choose_k(16, 16-k)
+	for (; k < 8; k += 2) {
+		// k will be 2, 4, 6 (symmetric values: 14, 12, 10)
+		dSumK += n_choose_k(16, k) * (exp(dSNRFct * (1.0 / k - 1.0)) + exp(dSNRFct * (1.0 / (16 - k) - 1.0)));
+	}
+	// for k =  8 (which does not have a symmetric value)
+	k = 8; dSumK += n_choose_k(16, k) * exp(dSNRFct * (1.0 / k - 1.0));
+	for (k = 3; k < 8; k += 2) {
+		// k will be 3, 5, 7 (symmetric values: 13, 11, 9)
+		dSumK -= n_choose_k(16, k) * (exp(dSNRFct * (1.0 / k - 1.0)) + exp(dSNRFct * (1.0 / (16 - k) - 1.0)));
+	}
+	// for k = 15 (because of missing k=1 value)
+	k   = 15; dSumK -= n_choose_k(16, k) * exp(dSNRFct * (1.0 / k - 1.0));
+	// for k = 16 (because of missing k=0 value)
+	k   = 16; dSumK += n_choose_k(16, k) * exp(dSNRFct * (1.0 / k - 1.0));
+	return (8.0 / 15) * (1.0 / 16) * dSumK;
+}
+
+double Decider802154Narrow::calcBERGFSK(double snr, double) {
+	// valid for Bluetooth 4.0 PHY mandatory base rate 1 Mbps
+	// Please note that this is not the correct expression for
+	// the enhanced data rates (EDR), which uses another modulation.
+	return 0.5 * ERFC(sqrt(0.5 * snr));
+}
+
 double Decider802154Narrow::getBERFromSNR(double snr) const {
 	double ber = BER_LOWER_BOUND;
-	if(modulation == "msk") {
-		// valid for IEEE 802.15.4 868 MHz BPSK modulation
-		ber = 0.5 *  ERFC(sqrt(snr));
-	} else if (modulation == "oqpsk16") {
-		// valid for IEEE 802.15.4 2.45 GHz OQPSK modulation
-		// Following formula is defined in IEEE 802.15.4 standard, please check the 
-		// 2006 standard, page 268, section E.4.1.8 Bit error rate (BER) 
-		// calculations, formula 7). Here you cab see that the factor of 20.0 is correct ;).
-		const double dSNRFct = 20.0 * snr;
-		double       dSumK   = 0;
-		register int k       = 2;
-		/* following loop was optimized by using n_choose_k symmetries
-		for (k=2; k <= 16; ++k) {
-			dSumK += pow(-1.0, k) * n_choose_k(16, k) * exp(dSNRFct * (1.0 / k - 1.0));
-		}
-		*/
-		// n_choose_k(16, k) == n_choose_k(16, 16-k)
-		for (; k < 8; k += 2) {
-			// k will be 2, 4, 6 (symmetric values: 14, 12, 10)
-			dSumK += n_choose_k(16, k) * (exp(dSNRFct * (1.0 / k - 1.0)) + exp(dSNRFct * (1.0 / (16 - k) - 1.0)));
-		}
-		// for k =  8 (which does not have a symmetric value)
-		k = 8; dSumK += n_choose_k(16, k) * exp(dSNRFct * (1.0 / k - 1.0));
-		for (k = 3; k < 8; k += 2) {
-			// k will be 3, 5, 7 (symmetric values: 13, 11, 9)
-			dSumK -= n_choose_k(16, k) * (exp(dSNRFct * (1.0 / k - 1.0)) + exp(dSNRFct * (1.0 / (16 - k) - 1.0)));
-		}
-		// for k = 15 (because of missing k=1 value)
-		k   = 15; dSumK -= n_choose_k(16, k) * exp(dSNRFct * (1.0 / k - 1.0));
-		// for k = 16 (because of missing k=0 value)
-		k   = 16; dSumK += n_choose_k(16, k) * exp(dSNRFct * (1.0 / k - 1.0));
-		ber = (8.0 / 15) * (1.0 / 16) * dSumK;
-	} else if(modulation == "gfsk") {
-		// valid for Bluetooth 4.0 PHY mandatory base rate 1 Mbps
-		// Please note that this is not the correct expression for
-		// the enhanced data rates (EDR), which uses another modulation.
-		ber = 0.5 * ERFC(sqrt(0.5 * snr));
+	if(berTable.isBuilt()) {
+		ber = berTable.getBER(snr);
 	} else {
-		opp_error("The selected modulation is not supported.");
+		switch(modulation) {
+			case MSK:     ber = calcBERMSK(snr, 0);     break;
+			case OQPSK16: ber = calcBEROQPSK16(snr, 0); break;
+			case GFSK:    ber = calcBERGFSK(snr, 0);    break;
+			default:
+				opp_error("The selected modulation is not supported.");
+				break;
+		}
 	}
 	return std::max(ber, BER_LOWER_BOUND);
 }
@@ -10,6 +10,7 @@
 
 #include "MiXiMDefs.h"
 #include "BaseDecider.h"
+#include "BERTable.h"
 
 /**
  * @brief Decider for the 802.15.4 Narrow band module
@@ -24,6 +25,19 @@ public:
 		RECEPTION_STARTED=LAST_BASE_DECIDER_CONTROL_KIND,
 		LAST_DECIDER802154NARROW_CONTROL_KIND
 	};
+
+	/** @brief The supported modulations, resolved from the "modulation"
+	 * parameter on initialization.*/
+	enum Modulation {
+		/** @brief Unknown or not yet initialized modulation.*/
+		UNKNOWN_MODULATION,
+		/** @brief IEEE 802.15.4 868 MHz ("msk").*/
+		MSK,
+		/** @brief IEEE 802.15.4 2.45 GHz OQPSK ("oqpsk16").*/
+		OQPSK16,
+		/** @brief Bluetooth 4.0 base rate ("gfsk").*/
+		GFSK
+	};
 protected:
 	/** @brief Start Frame Delimiter length in bits. */
 	int sfdLength;
@@ -34,7 +48,11 @@ protected:
 	double BER_LOWER_BOUND;
 
 	/** @brief modulation type */
-	std::string modulation;
+	Modulation modulation;
+
+	/** @brief Bit error rate of the modulation over the SNR, not built if
+	 * "berTableResolution" is not positive.*/
+	BERTable berTable;
 
 	/** log minimum snir values of dropped packets */
 	cOutVector snirDropped;
@@ -87,6 +105,23 @@ public:
 	/** @brief Helper function to compute BER from SNR using analytical formulas */
 	static double n_choose_k(int n, int k);
 
+	/** @brief Returns the modulation with the passed name, UNKNOWN_MODULATION
+	 * if it is not supported.*/
+	static Modulation getModulation(const std::string& name);
+
+	/** @brief Returns the closed form bit error rate of the passed modulation,
+	 * can be passed to BERTable::build().*/
+	static BERTable::ber_function_t getBERFunction(Modulation modulation);
+
+	/** @brief Closed form bit error rate of MSK, the parameter is unused.*/
+	static double calcBERMSK(double snr, double);
+
+	/** @brief Closed form bit error rate of OQPSK16, the parameter is unused.*/
+	static double calcBEROQPSK16(double snr, double);
+
+	/** @brief Closed form bit error rate of GFSK, the parameter is unused.*/
+	static double calcBERGFSK(double snr, double);
+
 	/** @brief Standard Decider constructor.
 	 */
 	Decider802154Narrow( DeciderToPhyInterface* phy
@@ -96,7 +131,8 @@ public:
 	    : BaseDecider(phy, sensitivity, myIndex, debug)
 	    , sfdLength(0)
 	    , BER_LOWER_BOUND(0)
-	    , modulation("")
+	    , modulation(UNKNOWN_MODULATION)
+	    , berTable()
 	    , snirDropped()
 	    , snirReceived()
 	    , snrlog()
@@ -113,6 +149,12 @@ public:
 	 *
 	 * This method should be defined for generic decider initialization.
 	 *
+	 * Builds the bit error rate table of the modulation from the optional
+	 * parameters "berTableResolution" (dB, defaults to 0, the closed form
+	 * is evaluated per frame if not positive), "berTableMaxError" (relative,
+	 * defaults to 1e-3), "berTableMinSNR" and "berTableMaxSNR" (dB, default
+	 * to -20 and 40).
+	 *
 	 * @param params The parameter map which was filled by XML reader.
 	 *
 	 * @return true if the initialization was successfully.
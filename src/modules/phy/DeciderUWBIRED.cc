@@ -4,6 +4,7 @@
 #include "AirFrameUWBIR_m.h"
 #include "DeciderResultUWBIR.h"
 #include "MiXiMAirFrame.h"
+#include "PulseTrainMapping.h"
 
 using std::map;
 using std::vector;
@@ -155,7 +156,6 @@ bool DeciderUWBIRED::attemptSync(const airframe_ptr_t frame) {
 
 	double snrValue;
 	const ConstMapping *const power = frame->getSignal().getReceivingPower();
-	ConstMappingIterator*     mIt   = power->createConstIterator();
 
 	AirFrameVector syncVector;
 	// Retrieve all potentially colliding airFrames
@@ -166,8 +166,7 @@ bool DeciderUWBIRED::attemptSync(const airframe_ptr_t frame) {
 		return false;
 	}
 	Argument posFirstPulse(IEEE802154A::tFirstSyncPulseMax + frame->getSignal().getReceptionStart());
-	mIt->jumpTo(posFirstPulse);
-	snrValue = fabs(mIt->getValue()/getNoiseValue());
+	snrValue = fabs(power->getValue(posFirstPulse)/getNoiseValue());
 	syncThresholds.record(snrValue);
 	if(snrValue > syncThreshold) {
 		return true;
@@ -226,7 +225,7 @@ std::pair<bool, double> DeciderUWBIRED::decodePacket(const airframe_ptr_t frame,
 	burst   = cfg.burst_duration;
 	now     = offset + cfg.pulse_duration / 2;
 	std::pair<double, double> energyZero, energyOne;
-	IEEE802154A::setConfig(cfg);
+	const IEEE802154A::Context& context = IEEE802154A::getContext(cfg);
 
 	// debugging information (start)
 	if (trace && signalPower != NULL) {
@@ -249,10 +248,15 @@ std::pair<bool, double> DeciderUWBIRED::decodePacket(const airframe_ptr_t frame,
 	// debugging information (end)
 
 	int symbol;
+	const int maxSymbols = context.getMaxDataSymbols();
 	// Loop to decode each bit value
 	for (symbol = 0; cfg.preambleLength + symbol * aSymbol < FrameSignal.getDuration(); symbol++) {
 
-//		int hoppingPos = IEEE802154A::getHoppingPos(symbol);
+		if (symbol >= maxSymbols) {
+			throw cRuntimeError("DeciderUWBIRED: the frame has more data symbols than the burst"
+			                    " hopping sequence of the configuration covers (%d)", maxSymbols);
+		}
+//		int hoppingPos = context.getHoppingPos(symbol);
 		int decodedBit;
 
 		if (stats) {
@@ -260,7 +264,7 @@ std::pair<bool, double> DeciderUWBIRED::decodePacket(const airframe_ptr_t frame,
 		}
 
 		// sample in window zero
-		now = now + IEEE802154A::getHoppingPos(symbol)*cfg.burst_duration;
+		now = now + context.getHoppingPos(symbol)*cfg.burst_duration;
 		energyZero = integrateWindow(symbol, now, burst, airFrameVector, signalPower, frame, cfg);
 		// sample in window one
 		now = now + shift;
@@ -295,6 +299,32 @@ std::pair<bool, double> DeciderUWBIRED::decodePacket(const airframe_ptr_t frame,
 	return std::make_pair(isCorrect, snrLastPacket);
 }
 
+void DeciderUWBIRED::sampleReceivingPower(const Signal& signal, const vector<simtime_t>& times, double* values) {
+	const PulseTrainMapping *const pulses = dynamic_cast<const PulseTrainMapping*>(signal.getTransmissionPower());
+	Argument                       arg;
+
+	if (pulses == NULL) {
+		const ConstMapping *const power = signal.getReceivingPower();
+		for (size_t i = 0; i < times.size(); ++i) {
+			arg.setTime(times[i]);
+			values[i] = power->getValue(arg);
+		}
+		return;
+	}
+
+	// the transmission power is not delayed yet, the attenuations are
+	pulses->getValues(&times[0], times.size(), signal.getPropagationDelay(), values);
+
+	const Signal::ConstMappingList&                attenuations = signal.getAttenuation();
+	const Signal::ConstMappingList::const_iterator attEnd       = attenuations.end();
+	for (size_t i = 0; i < times.size(); ++i) {
+		arg.setTime(times[i]);
+		for (Signal::ConstMappingList::const_iterator att = attenuations.begin(); att != attEnd; ++att) {
+			values[i] *= (*att)->getValue(arg);
+		}
+	}
+}
+
 /*
  * @brief Returns a pair with as first value the SNIR (if the signal is not nul in this window, and 0 otherwise)
  * and as second value a "score" associated to this window. This score is equals to the sum for all
@@ -308,8 +338,6 @@ pair<double, double> DeciderUWBIRED::integrateWindow( int
                                                     , const airframe_ptr_t       /*frame*/
                                                     , const IEEE802154A::config& cfg) {
 	std::pair<double, double>       energy = std::make_pair(0.0, 0.0); // first: stores SNIR, second: stores total captured window energy
-	vector<ConstMapping*>::iterator mappingIter;
-	Argument                        arg;
 	simtime_t                       windowEnd = pNow + burst;
 
 	// Triangular baseband pulses
@@ -319,7 +347,26 @@ pair<double, double> DeciderUWBIRED::integrateWindow( int
 
 	// we sample one point per pulse
 	// caller has already set our time reference ("now") at the peak of the pulse
+	vector<simtime_t> times;
 	for (simtime_t now = pNow; now < windowEnd; now += cfg.pulse_duration) {
+		times.push_back(now);
+	}
+	const size_t nbSamples = times.size();
+	if (nbSamples == 0)
+		return energy;
+
+	// sample every signal over the whole window at once
+	const size_t   nbSignals = airFrameVector.size();
+	vector<double> samples(nbSignals * nbSamples);
+	vector<bool>   isSignal(nbSignals);
+	size_t         sig       = 0;
+	for (AirFrameVector::const_iterator airFrameIter = airFrameVector.begin(); airFrameIter != airFrameVector.end(); ++airFrameIter, ++sig) {
+		const Signal& aSignal = (*airFrameIter)->getSignal();
+		isSignal[sig] = (aSignal.getReceivingPower() == signalPower);
+		sampleReceivingPower(aSignal, times, &samples[sig * nbSamples]);
+	}
+
+	for (size_t sample = 0; sample < nbSamples; ++sample) {
 		double signalValue      = 0; // electric field from tracked signal [V/m²]
 		double resPower         = 0; // electric field at antenna = combination of all arriving electric fields [V/m²]
 		double vEfield          = 0; // voltage at antenna caused by electric field Efield [V]
@@ -327,16 +374,12 @@ pair<double, double> DeciderUWBIRED::integrateWindow( int
 		double vmeasured_square = 0; // to the square [V²]
 		double snir             = 0; // burst SNIR estimate
 		double vThermalNoise    = 0; // thermal noise realization
-		int    currSig          = 0;
 
-		arg.setTime(now);
 		// consider all interferers at this point in time
-		for (AirFrameVector::const_iterator airFrameIter = airFrameVector.begin(); airFrameIter != airFrameVector.end(); ++airFrameIter) {
-			Signal&                   aSignal   = (*airFrameIter)->getSignal();
-			const ConstMapping *const currPower = aSignal.getReceivingPower();
-			double                    measure   = currPower->getValue(arg)*peakPulsePower; //TODO: de-normalize (peakPulsePower should be in AirFrame or in Signal, to be set at run-time)
+		for (sig = 0; sig < nbSignals; ++sig) {
+			double measure = samples[sig * nbSamples + sample]*peakPulsePower; //TODO: de-normalize (peakPulsePower should be in AirFrame or in Signal, to be set at run-time)
 //			measure = measure * uniform(0, +1); // random point of Efield at sampling (due to pulse waveform and self interference)
-			if (currPower == signalPower) {
+			if (isSignal[sig]) {
 				signalValue = measure*0.5; // we capture half of the maximum possible pulse energy to account for self  interference
 				resPower    = resPower + signalValue;
 			}
@@ -344,7 +387,6 @@ pair<double, double> DeciderUWBIRED::integrateWindow( int
 				// take a random point within pulse envelope for interferer
 				resPower = resPower + measure * uniform(-1, +1);
 			}
-			++currSig;
 		}
 
 //		double attenuatedPower = resPower / 10; // 10 dB = 6 dB implementation loss + 5 dB noise factor
@@ -168,6 +168,16 @@ protected:
 
 	virtual bool attemptSync(const airframe_ptr_t frame);
 
+	/**
+	 * @brief Writes the receiving power of the signal at the passed
+	 * ascending times to "values".
+	 *
+	 * Equals calling getValue() of the receiving power at every time, but a
+	 * PulseTrainMapping as transmission power is sampled at all times at
+	 * once.
+	 */
+	static void sampleReceivingPower(const Signal& signal, const std::vector<simtime_t>& times, double* values);
+
 	// first value is energy from signal, other value is total window energy
 	static
 	std::pair<double, double> integrateWindow( int                        symbol
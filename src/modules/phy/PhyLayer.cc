@@ -12,6 +12,7 @@
 #include "SimplePathlossModel.h"
 #include "BreakpointPathlossModel.h"
 #include "LogNormalShadowing.h"
+#include "CorrelatedShadowing.h"
 #include "SNRThresholdDecider.h"
 #include "JakesFading.h"
 #include "PERModel.h"
@@ -88,6 +89,9 @@ AnalogueModel* PhyLayer::getAnalogueModelFromName(const std::string& name, Param
 	if (name == "LogNormalShadowing") {
 		return createAnalogueModel<LogNormalShadowing>(params);
 	}
+	if (name == "CorrelatedShadowing") {
+		return createAnalogueModel<CorrelatedShadowing>(params);
+	}
 	if (name == "JakesFading") {
 		return createAnalogueModel<JakesFading>(params);
 	}
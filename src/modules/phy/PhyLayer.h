@@ -18,6 +18,7 @@
  * Knows the following AnalogueModels:
  * - SimplePathlossModel
  * - LogNormalShadowing
+ * - CorrelatedShadowing
  * - JakesFading
  *
  * Knows the following Deciders
@@ -39,6 +40,7 @@ protected:
 	 * Is able to initialize the following AnalogueModels:
 	 * - SimplePathlossModel
 	 * - LogNormalShadowing
+	 * - CorrelatedShadowing
 	 * - JakesFading
 	 * - BreakpointPathlossModel
 	 * - PERModel
@@ -20,6 +20,7 @@
 #include "SimpleBattery.h"
 
 #include <limits>
+#include <algorithm>
 
 #include "FWMath.h"
 #include "BatteryStats.h"
@@ -42,6 +43,7 @@ SimpleBattery::SimpleBattery()
 	, nominalCapmAh(0)
 	, voltage(0)
 	, resolution()
+	, analytic(false)
 	, timeout(NULL)
 	, publish(NULL)
 	, publishDelta(0)
@@ -87,12 +89,13 @@ void SimpleBattery::initialize(int stage) {
 		}
 
 		resolution = par("resolution");
+		analytic   = par("analytic").boolValue();
 
 		debugEV<< "capacity = " << capmAh << "mA-h (nominal = " << nominalCapmAh <<
 		") at " << voltage << "V" << std::endl;
 		debugEV << "publishDelta = " << publishDelta * 100 << "%, publishTime = "
 		<< publishTime << "s, resolution = " << resolution << "sec"
-		<< std::endl;
+		<< (analytic ? " (analytic)" : "") << std::endl;
 
 		capacity = capmAh * 60 * 60 * voltage; // use mW-sec internally
 		nominalCapacity = nominalCapmAh * 60 * 60 * voltage;
@@ -110,7 +113,11 @@ void SimpleBattery::initialize(int stage) {
 
 		timeout = new cMessage("auto-update", AUTO_UPDATE);
 		timeout->setSchedulingPriority(500);
-		scheduleAt(simTime() + resolution, timeout);
+		// in analytic mode the timeout is scheduled as soon as a device
+		// draws current
+		if (!analytic) {
+			scheduleAt(simTime() + resolution, timeout);
+		}
 
 		// publish battery depletion on hostStateCat
 		// periodically publish residual capacity on batteryCat
@@ -203,6 +210,10 @@ void SimpleBattery::draw(int deviceID, DrawAmount& amount, int activity)
 		// set the new current draw in the device vector
 		devices[deviceID].draw            = current;
 		devices[deviceID].currentActivity = activity;
+
+		if (analytic) {
+			scheduleNextUpdate();
+		}
 	}
 
 	else if (amount.getType() == DrawAmount::ENERGY) {
@@ -232,6 +243,10 @@ void SimpleBattery::draw(int deviceID, DrawAmount& amount, int activity)
 		// update the residual capacity (ongoing current draw), mostly
 		// to check whether to publish (or perish)
 		deductAndCheck();
+
+		if (analytic) {
+			scheduleNextUpdate();
+		}
 	}
 	else {
 		error("Unknown power type!");
@@ -244,16 +259,29 @@ void SimpleBattery::handleMessage(cMessage *msg) {
 		switch (msg->getKind()) {
 		case AUTO_UPDATE:
 			// update the residual capacity (ongoing current draw)
-			scheduleAt(simTime() + resolution, timeout);
-			deductAndCheck();
+			if (analytic) {
+				deductAndCheck();
+				scheduleNextUpdate();
+			}
+			else {
+				scheduleAt(simTime() + resolution, timeout);
+				deductAndCheck();
+			}
 			break;
 
 		case PUBLISH:
+			// without periodic updates the state has to be updated first
+			if (analytic) {
+				deductAndCheck();
+			}
 			// publish the state to the BatteryStats module
 			emit(BatteryStats::catBatteryStateSignal, batteryState);
 			lastPublishCapacity = residualCapacity;
 
 			scheduleAt(simTime() + publishTime, publish);
+			if (analytic) {
+				scheduleNextUpdate();
+			}
 			break;
 
 		default:
@@ -368,6 +396,48 @@ void SimpleBattery::deductAndCheck() {
 	residualVec.record(residualCapacity);
 }
 
+void SimpleBattery::scheduleNextUpdate() {
+	Enter_Method_Silent();
+	cancelEvent(timeout);
+
+	if (lessOrEqualNull(residualCapacity)) {
+		return;
+	}
+
+	// the current draw is constant until the next draw() call
+	double power = 0;
+	for (int i = 0; i < numDevices; i++) {
+		if (devices[i].currentActivity > -1) {
+			power += devices[i].draw;
+		}
+	}
+	power *= voltage;
+	if (power <= 0) {
+		return;
+	}
+
+	// energy until the battery is depleted or the next publishDelta
+	// threshold is reached
+	double energy = residualCapacity;
+	if (publishDelta < 1) {
+		const double toPublish = residualCapacity - (lastPublishCapacity - publishDelta * capacity);
+		energy = std::min(energy, std::max(toPublish, 0.0));
+	}
+
+	const double delay = energy / power;
+	if (delay >= SIMTIME_DBL(MAXTIME - simTime())) {
+		return;
+	}
+
+	// the rounding to the simulation time resolution must not let the
+	// battery wait at the threshold forever
+	simtime_t tUpdate = simTime() + delay;
+	if (tUpdate <= simTime()) {
+		tUpdate.setRaw(SIMTIME_RAW(simTime()) + 1);
+	}
+	scheduleAt(tUpdate, timeout);
+}
+
 	// the three functions below should be supported in all battery
 	// modules.  in SimpleBattery, they're trivial.  a more accurate model
 	// would require substantially more complex functionality here
@@ -33,6 +33,11 @@
  * HostState notification on battery depletion, and provides time
  * series and summary information to Battery Stats module.
  *
+ * By default the residual capacity is updated every "resolution" seconds.
+ * If "analytic" is set, it is only updated when a device changes its
+ * draw, and a single timeout is scheduled at the time the constant total
+ * draw reaches the next publishDelta threshold or depletes the battery.
+ *
  * @ingroup power
  * @author Laura Marie Feeney
  * @author Karl Wessel (port for MiXiM)
@@ -105,6 +110,10 @@ protected:
 
 	/** @brief Debit battery at least once every resolution seconds.*/
 	simtime_t resolution;
+	/** @brief Update the capacity only when the current draw changes and
+	 * at the predicted next publishDelta crossing or depletion, instead of
+	 * every resolution seconds.*/
+	bool analytic;
 	cMessage *timeout;
 
 	/** @name publishing of capacity to BatteryStats via the BB. */
@@ -150,6 +159,13 @@ protected:
 	/** @brief Pointer to host module */
 	cModule* 	host;
 	virtual void deductAndCheck();
+
+	/**
+	 * @brief Schedules the timeout at the time the residual capacity
+	 * reaches the next publishDelta threshold or zero with the current
+	 * draw of all devices, used if "analytic" is true.
+	 */
+	virtual void scheduleNextUpdate();
 };
 
 #endif
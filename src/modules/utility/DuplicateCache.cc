@@ -0,0 +1,221 @@
+/* -*- mode:c++ -*- ********************************************************
+ * file:        DuplicateCache.cc
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ *
+ ***************************************************************************
+ * description: hashed, expiring table of already seen packets used by the
+ *              network layers for duplicate suppression
+ **************************************************************************/
+
+#include "DuplicateCache.h"
+
+#include <cassert>
+#include <algorithm>
+
+DuplicateCache::DuplicateCache()
+	: entries()
+	, buckets()
+	, bucketMask(0)
+	, freeList(-1)
+	, head(-1)
+	, tail(-1)
+	, numEntries(0)
+	, hits(0)
+	, evictions(0)
+	, expirations(0)
+	, peakEntries(0)
+{ }
+
+void DuplicateCache::setMaxEntries(size_t maxEntries)
+{
+	assert(maxEntries > 0);
+
+	// at most every second bucket is used on average
+	size_t numBuckets = 1;
+	while (numBuckets < 2 * maxEntries) {
+		numBuckets <<= 1;
+	}
+
+	std::vector<Entry>(maxEntries).swap(entries);
+	std::vector<int>(numBuckets).swap(buckets);
+	bucketMask = numBuckets - 1;
+	clear();
+}
+
+void DuplicateCache::grow(size_t maxEntries)
+{
+	assert(maxEntries >= numEntries);
+
+	std::vector<Entry> kept;
+	kept.reserve(numEntries);
+	for (int i = head; i != -1; i = entries[i].next) {
+		kept.push_back(entries[i]);
+	}
+
+	// re-inserting at time zero neither expires nor evicts anything and the
+	// entries are distinct, so the statistics stay the same
+	setMaxEntries(maxEntries);
+	for (size_t i = 0; i < kept.size(); ++i) {
+		insert(kept[i].source, kept[i].seqNum, kept[i].expiry, SIMTIME_ZERO);
+	}
+}
+
+void DuplicateCache::clear()
+{
+	std::fill(buckets.begin(), buckets.end(), -1);
+	for (size_t i = 0; i < entries.size(); ++i) {
+		entries[i].nextInBucket = (i + 1 < entries.size()) ? static_cast<int>(i + 1) : -1;
+	}
+	freeList   = entries.empty() ? -1 : 0;
+	head       = -1;
+	tail       = -1;
+	numEntries = 0;
+}
+
+int DuplicateCache::find(long source, unsigned long seqNum) const
+{
+	for (int i = buckets[bucketOf(source, seqNum)]; i != -1; i = entries[i].nextInBucket) {
+		if (entries[i].source == source && entries[i].seqNum == seqNum) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+void DuplicateCache::remove(int index)
+{
+	Entry& entry = entries[index];
+
+	// unlink from the bucket
+	int* link = &buckets[bucketOf(entry.source, entry.seqNum)];
+	while (*link != index) {
+		assert(*link != -1);
+		link = &entries[*link].nextInBucket;
+	}
+	*link = entry.nextInBucket;
+
+	// unlink from the insertion order
+	if (entry.prev != -1) entries[entry.prev].next = entry.next;
+	else                  head                     = entry.next;
+	if (entry.next != -1) entries[entry.next].prev = entry.prev;
+	else                  tail                     = entry.prev;
+
+	entry.nextInBucket = freeList;
+	freeList           = index;
+	--numEntries;
+}
+
+void DuplicateCache::moveToTail(int index)
+{
+	if (index == tail) {
+		return;
+	}
+	Entry& entry = entries[index];
+	if (entry.prev != -1) entries[entry.prev].next = entry.next;
+	else                  head                     = entry.next;
+	entries[entry.next].prev = entry.prev;
+
+	entry.prev          = tail;
+	entry.next          = -1;
+	entries[tail].next  = index;
+	tail                = index;
+}
+
+void DuplicateCache::expire(simtime_t_cref now)
+{
+	while (head != -1 && entries[head].expiry < now) {
+		remove(head);
+		++expirations;
+	}
+}
+
+bool DuplicateCache::contains(long source, unsigned long seqNum, simtime_t_cref now)
+{
+	expire(now);
+
+	const int index = find(source, seqNum);
+	if (index == -1) {
+		return false;
+	}
+	if (entries[index].expiry < now) {
+		remove(index);
+		++expirations;
+		return false;
+	}
+	++hits;
+	return true;
+}
+
+bool DuplicateCache::insert(long source, unsigned long seqNum, simtime_t_cref expiry, simtime_t_cref now)
+{
+	assert(!entries.empty());
+	expire(now);
+
+	int index = find(source, seqNum);
+	if (index != -1) {
+		if (entries[index].expiry >= now) {
+			++hits;
+			entries[index].expiry = expiry;
+			moveToTail(index);
+			return false;
+		}
+		remove(index);
+		++expirations;
+	}
+
+	// evict the oldest entry if the cache is full
+	if (freeList == -1) {
+		if (entries[head].expiry < now) ++expirations;
+		else                            ++evictions;
+		remove(head);
+	}
+
+	index    = freeList;
+	freeList = entries[index].nextInBucket;
+
+	Entry& entry = entries[index];
+	entry.source = source;
+	entry.seqNum = seqNum;
+	entry.expiry = expiry;
+
+	const size_t bucket = bucketOf(source, seqNum);
+	entry.nextInBucket = buckets[bucket];
+	buckets[bucket]    = index;
+
+	entry.prev = tail;
+	entry.next = -1;
+	if (tail != -1) entries[tail].next = index;
+	else            head               = index;
+	tail = index;
+
+	if (++numEntries > peakEntries) {
+		peakEntries = numEntries;
+	}
+	return true;
+}
+
+bool DuplicateCache::erase(long source, unsigned long seqNum)
+{
+	const int index = find(source, seqNum);
+	if (index == -1) {
+		return false;
+	}
+	remove(index);
+	return true;
+}
+
+void DuplicateCache::recordScalars(cComponent* module) const
+{
+	module->recordScalar("duplicateCacheHits",        hits);
+	module->recordScalar("duplicateCacheEvictions",   evictions);
+	module->recordScalar("duplicateCacheExpirations", expirations);
+	module->recordScalar("duplicateCachePeakEntries", peakEntries);
+	module->recordScalar("duplicateCacheMemory",      getMemoryUsage());
+}
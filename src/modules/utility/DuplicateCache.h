@@ -0,0 +1,176 @@
+/* -*- mode:c++ -*- ********************************************************
+ * file:        DuplicateCache.h
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ *
+ ***************************************************************************
+ * description: hashed, expiring table of already seen packets used by the
+ *              network layers for duplicate suppression
+ **************************************************************************/
+
+#ifndef DUPLICATECACHE_H_
+#define DUPLICATECACHE_H_
+
+#include <vector>
+#include <cstddef>
+
+#include "MiXiMDefs.h"
+
+/**
+ * @brief Remembers already seen packets by their source address and
+ * sequence number so that network layers can suppress duplicates.
+ *
+ * Every entry has an expiry time after which it is forgotten. The memory
+ * is bounded: the cache holds at most "maxEntries" entries, which are
+ * allocated once by setMaxEntries(). If it is full the oldest entry is
+ * evicted.
+ *
+ * Entries are found by a hash table in constant time. They are also kept
+ * in the order they were inserted or refreshed, expired entries are dropped
+ * from the front of this order on every insert() and contains(). If the
+ * expiry times do not grow with the insertion time, an expired entry
+ * behind a living one stays in memory until it reaches the front, is
+ * looked up or evicted, but it is never reported as contained.
+ *
+ * Hits (lookups of contained entries), evictions and expirations are
+ * counted and can be recorded as scalars together with the size of the
+ * memory used with recordScalars().
+ *
+ * @ingroup netwLayer
+ */
+class MIXIM_API DuplicateCache
+{
+protected:
+	/** @brief An entry, linked into its hash bucket and the insertion order.*/
+	struct Entry {
+		long          source;
+		unsigned long seqNum;
+		simtime_t     expiry;
+		/** @brief Next entry in the same bucket or in the free list.*/
+		int           nextInBucket;
+		/** @brief Neighbours in the insertion order.*/
+		int           prev;
+		int           next;
+	};
+
+	/** @brief Pool of all entries, never reallocated after setMaxEntries().*/
+	std::vector<Entry> entries;
+	/** @brief First entry per bucket, -1 if empty.*/
+	std::vector<int>   buckets;
+	/** @brief Number of buckets minus one, their number is a power of two.*/
+	size_t             bucketMask;
+
+	/** @brief First free entry in the pool, -1 if full.*/
+	int    freeList;
+	/** @brief Oldest and newest entry, -1 if empty.*/
+	int    head;
+	int    tail;
+	/** @brief Number of entries in use.*/
+	size_t numEntries;
+
+	/** @name Statistics*/
+	/*@{*/
+	long   hits;
+	long   evictions;
+	long   expirations;
+	size_t peakEntries;
+	/*@}*/
+
+protected:
+	/** @brief Returns the bucket of the passed key.*/
+	size_t bucketOf(long source, unsigned long seqNum) const {
+		size_t h = static_cast<size_t>(source) * 2654435761u ^ static_cast<size_t>(seqNum) * 40503u;
+		h ^= h >> 15;
+		return h & bucketMask;
+	}
+
+	/** @brief Returns the index of the entry with the passed key, -1 if
+	 * there is none.*/
+	int find(long source, unsigned long seqNum) const;
+
+	/** @brief Unlinks the entry at the passed index and frees it.*/
+	void remove(int index);
+
+	/** @brief Drops the expired entries from the front of the insertion order.*/
+	void expire(simtime_t_cref now);
+
+	/** @brief Moves the entry to the end of the insertion order.*/
+	void moveToTail(int index);
+
+public:
+	/** @brief Creates an empty cache, setMaxEntries() has to be called
+	 * before it is used.*/
+	DuplicateCache();
+
+	/** @brief Clears the cache and allocates the memory for "maxEntries"
+	 * entries.*/
+	void setMaxEntries(size_t maxEntries);
+
+	/**
+	 * @brief Allocates the memory for "maxEntries" entries and keeps the
+	 * entries and their order.
+	 *
+	 * For users which must not lose entries before they expire. It is
+	 * linear in the number of entries, so the cache should grow by a
+	 * factor.
+	 */
+	void grow(size_t maxEntries);
+
+	/**
+	 * @brief Returns true if the passed packet is in the cache and did
+	 * not expire before "now".
+	 */
+	bool contains(long source, unsigned long seqNum, simtime_t_cref now);
+
+	/**
+	 * @brief Remembers the passed packet until "expiry".
+	 *
+	 * Returns false if the packet was already contained, its expiry time is
+	 * updated then. Otherwise the oldest entry is evicted if the cache is
+	 * full and true is returned.
+	 */
+	bool insert(long source, unsigned long seqNum, simtime_t_cref expiry, simtime_t_cref now);
+
+	/** @brief Forgets the passed packet, returns false if it was not
+	 * contained.*/
+	bool erase(long source, unsigned long seqNum);
+
+	/** @brief Forgets all packets, the statistics are kept.*/
+	void clear();
+
+	/** @brief Returns the number of entries, including expired ones which
+	 * were not dropped yet.*/
+	size_t size() const { return numEntries; }
+
+	/** @brief Returns the maximum number of entries.*/
+	size_t getMaxEntries() const { return entries.size(); }
+
+	/** @brief Returns the memory allocated for the entries and the hash
+	 * table in bytes.*/
+	size_t getMemoryUsage() const {
+		return entries.capacity() * sizeof(Entry) + buckets.capacity() * sizeof(int);
+	}
+
+	/** @brief Number of lookups and inserts of contained packets.*/
+	long getHits() const { return hits; }
+	/** @brief Number of entries evicted because the cache was full.*/
+	long getEvictions() const { return evictions; }
+	/** @brief Number of entries dropped because they expired.*/
+	long getExpirations() const { return expirations; }
+
+	/**
+	 * @brief Records the statistics as scalars "duplicateCacheHits",
+	 * "duplicateCacheEvictions", "duplicateCacheExpirations",
+	 * "duplicateCachePeakEntries" and "duplicateCacheMemory" (bytes) of the
+	 * passed module.
+	 */
+	void recordScalars(cComponent* module) const;
+};
+
+#endif /* DUPLICATECACHE_H_ */
@@ -25,6 +25,8 @@
 #include "IEEE802154A.h"
 
 #include <cassert>
+#include <limits>
+#include <map>
 
 using std::vector;
 
@@ -82,14 +84,6 @@ const short IEEE802154A::C31[8][31] = {
 
 const short IEEE802154A::shortSFD[8] = { 0, 1, 0, -1, 1, 0, 0, -1 };
 
-short IEEE802154A::s_array[maxS] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1,
-		0, 0, 0 };
-int IEEE802154A::last_s = 15;
-
-double IEEE802154A::signalStart = 0;
-
-int IEEE802154A::psduLength = 0;
-
 //const_simtime_t IEEE802154A::MaxFrameDuration = IEEE802154A::MaxPSDULength*IEEE802154A::mandatory_symbol + IEEE802154A::mandatory_preambleLength;
 
 const IEEE802154A::config IEEE802154A::cfg_mandatory_16M = {
@@ -130,27 +124,128 @@ const IEEE802154A::config IEEE802154A::cfg_mandatory_4M = {
 		4498				// center frequency
 };
 
-IEEE802154A::config IEEE802154A::cfg = IEEE802154A::cfg_mandatory_16M;
+namespace {
+	/** @brief Orders configurations field by field, for the context registry.*/
+	struct ConfigLess {
+		template<typename T>
+		static int compare(const T& a, const T& b) {
+			return (a < b) ? -1 : ((b < a) ? 1 : 0);
+		}
+
+		bool operator()(const IEEE802154A::config& a, const IEEE802154A::config& b) const {
+			int c = 0;
+			if ((c = compare(a.channel, b.channel)) != 0)                           return c < 0;
+			if ((c = compare(a.prf, b.prf)) != 0)                                   return c < 0;
+			if ((c = compare(a.ranging, b.ranging)) != 0)                           return c < 0;
+			if ((c = compare(a.NSync, b.NSync)) != 0)                               return c < 0;
+			if ((c = compare(a.CLength, b.CLength)) != 0)                           return c < 0;
+			if ((c = compare(a.spreadingdL, b.spreadingdL)) != 0)                   return c < 0;
+			if ((c = compare(a.Ncpb, b.Ncpb)) != 0)                                 return c < 0;
+			if ((c = compare(a.bitrate, b.bitrate)) != 0)                           return c < 0;
+			if ((c = compare(a.nbPulsesPerBurst, b.nbPulsesPerBurst)) != 0)         return c < 0;
+			if ((c = compare(a.sync_symbol_duration, b.sync_symbol_duration)) != 0) return c < 0;
+			if ((c = compare(a.data_symbol_duration, b.data_symbol_duration)) != 0) return c < 0;
+			if ((c = compare(a.shift_duration, b.shift_duration)) != 0)             return c < 0;
+			if ((c = compare(a.pulse_duration, b.pulse_duration)) != 0)             return c < 0;
+			if ((c = compare(a.burst_duration, b.burst_duration)) != 0)             return c < 0;
+			if ((c = compare(a.preambleLength, b.preambleLength)) != 0)             return c < 0;
+			return a.centerFrequency < b.centerFrequency;
+		}
+	};
+
+	/** @brief Owns the contexts of all configurations used so far.*/
+	class ContextRegistry {
+	public:
+		typedef std::map<IEEE802154A::config, IEEE802154A::Context*, ConfigLess> ContextMap;
+
+		ContextMap contexts;
+
+		ContextRegistry(): contexts() {}
+
+		~ContextRegistry() {
+			for (ContextMap::iterator it = contexts.begin(); it != contexts.end(); ++it) {
+				delete it->second;
+			}
+		}
+	};
+}
+
+const IEEE802154A::Context& IEEE802154A::getContext(const config& cfg) {
+	static ContextRegistry registry;
 
-void IEEE802154A::setConfig(config newCfg) {
-	cfg = newCfg;
+	ContextRegistry::ContextMap::iterator it = registry.contexts.lower_bound(cfg);
+	if (it == registry.contexts.end() || registry.contexts.key_comp()(cfg, it->first)) {
+		it = registry.contexts.insert(it, std::make_pair(cfg, new Context(cfg)));
+	}
+	return *it->second;
+}
+
+IEEE802154A::Context::Context(const config& cfg):
+	cfg(cfg),
+	scrambler(maxS, 0),
+	hoppingPositions()
+{
+	// the LFSR starts with a single one at position 12
+	scrambler[12] = 1;
+	for (int n = 15; n < maxS; n++) {
+		scrambler[n] = (scrambler[n - 14] + scrambler[n - 15]) % 2;
+	}
+
+	// with 4 MHz PRF as many symbols as the scrambler sequence covers, with
+	// 16 MHz PRF the position does not depend on the symbol
+	int nbSymbols = 0;
+	switch(cfg.prf) {
+	case NOMINAL_4_M:
+		nbSymbols = (maxS - 5) / cfg.Ncpb + 1;
+		break;
+	case NOMINAL_16_M:
+		nbSymbols = 1;
+		break;
+	case NOMINAL_64_M:
+	case PRF_OFF:
+	default:
+		break;  // unimplemented or invalid PRF value, getHoppingPos() fails
+	}
+	hoppingPositions.reserve(nbSymbols);
+	for (int sym = 0; sym < nbSymbols; sym++) {
+		//int m = 3;  // or 5 with 4M
+		int pos = 0;
+		int kNcpb = 0;
+		if (cfg.prf == NOMINAL_4_M) {
+			kNcpb = sym * cfg.Ncpb;
+			pos = s(kNcpb) + 2*s(1+kNcpb) + 4*s(2+kNcpb) + 8*s(3+kNcpb) + 16*s(4+kNcpb);
+		} else {
+			pos = s(kNcpb) + 2*s(1+kNcpb) + 4*s(2+kNcpb);
+		}
+		// assert(pos > -1 && pos < 8); // TODO: update to reflect number of hopping pos for current config
+		hoppingPositions.push_back(static_cast<short>(pos));
+	}
 }
 
-void IEEE802154A::setPSDULength(int _psduLength) {
-	//assert(_psduLength < IEEE802154A::MaxPSDULength+1);
-	IEEE802154A::psduLength = _psduLength;
+int IEEE802154A::Context::getMaxDataSymbols() const {
+	switch(cfg.prf) {
+	case NOMINAL_4_M:
+		return static_cast<int>(hoppingPositions.size());
+	case NOMINAL_16_M:
+		return std::numeric_limits<int>::max();
+	default:
+		return 0;
+	}
 }
 
-simtime_t IEEE802154A::getMaxFrameDuration() {
+simtime_t IEEE802154A::Context::getMaxFrameDuration() const {
 	return IEEE802154A::MaxPSDULength*cfg.data_symbol_duration + cfg.preambleLength;
 }
 
-IEEE802154A::signalAndData IEEE802154A::generateIEEE802154AUWBSignal(
-		simtime_t_cref signalStart, bool allZeros) {
+IEEE802154A::signalAndData IEEE802154A::Context::generateIEEE802154AUWBSignal(
+		simtime_t_cref signalStart, int psduLength, bool allZeros) const {
 	// 48 R-S parity bits, the 2 symbols phy header is not modeled as it includes its own parity bits
 	// and is thus very robust
-	unsigned int nbBits = IEEE802154A::psduLength * 8 + 48;
-	IEEE802154A::signalStart = SIMTIME_DBL(signalStart);  // use the signalStart time value as a global offset for all Mapping values
+	unsigned int nbBits = psduLength * 8 + 48;
+	if (static_cast<int>(nbBits) > getMaxDataSymbols()) {
+		throw cRuntimeError("IEEE802154A: a PSDU of %d bytes needs %u data symbols, but the burst"
+		                    " hopping sequence of the configuration covers %d", psduLength, nbBits, getMaxDataSymbols());
+	}
 	simtime_t signalDuration = cfg.preambleLength;
 	signalDuration += static_cast<double> (nbBits) * cfg.data_symbol_duration;
 	Signal* s = new Signal(signalStart, signalDuration);
@@ -160,13 +255,14 @@ IEEE802154A::signalAndData IEEE802154A::generateIEEE802154AUWBSignal(
 	int bitValue;
 	// data start time relative to signal->getReceptionStart();
 	simtime_t dataStart = cfg.preambleLength; // = Tsync + Tsfd
-	TimeMapping<Linear>* mapping = new TimeMapping<Linear> ();
-	Argument* arg = new Argument();
-	setBitRate(s);
+	// triangular pulses of mandatory_pulse which follow each other every chip in a burst
+	PulseTrainMapping* mapping = new PulseTrainMapping(IEEE802154A::mandatory_pulse, cfg.pulse_duration, IEEE802154A::maxPulse);
+	// the signalStart time value is used as a global offset for all Mapping values
+	setBitRate(s, signalStart);
 
-	generateSyncPreamble(mapping, arg);
-	generateSFD(mapping, arg);
-	//generatePhyHeader(mapping, arg);
+	generateSyncPreamble(mapping, signalStart);
+	generateSFD(mapping, signalStart);
+	//generatePhyHeader(mapping, signalStart);
 
 	// generate bit values and modulates them according to
 	// the IEEE 802.15.4A specification
@@ -180,7 +276,8 @@ IEEE802154A::signalAndData IEEE802154A::generateIEEE802154AUWBSignal(
 		}
 		bitValues->push_back(static_cast<bool>(bitValue));
 		burstPos = symbolStart + bitValue*cfg.shift_duration + getHoppingPos(burst)*cfg.burst_duration;
-		generateBurst(mapping, arg, burstPos, +1);
+		assert(burstPos < cfg.preambleLength+(psduLength*8+48+2)*cfg.data_symbol_duration);
+		generateBurst(mapping, signalStart, burstPos, +1);
 		symbolStart = symbolStart + cfg.data_symbol_duration;
 	}
 	//assert(uwbirMacPkt->getBitValuesArraySize() == dataLength);
@@ -188,88 +285,71 @@ IEEE802154A::signalAndData IEEE802154A::generateIEEE802154AUWBSignal(
 
 	// associate generated pulse energies to the signal
 	s->setTransmissionPower(mapping);
-	delete arg;
 
 	res.first = s;
 	res.second = bitValues;
 	return res;
 }
 
-void IEEE802154A::generateSyncPreamble(Mapping* mapping, Argument* arg) {
+void IEEE802154A::Context::generateSyncPreamble(PulseTrainMapping* mapping, simtime_t_cref signalStart) const {
 	// NSync repetitions of the Si symbol
 	for (short n = 0; n < cfg.NSync; n = n + 1) {
 		for (short pos = 0; pos < cfg.CLength; pos = pos + 1) {
 			if (C31[Ci - 1][pos] != 0) {
+				simtime_t pulseStart;
 				if(n==0 && pos==0) {
 					// we slide the first pulse slightly in time to get the first point "inside" the signal
-				  arg->setTime(1E-12 + n * cfg.sync_symbol_duration + pos * cfg.spreadingdL * cfg.pulse_duration);
+				  pulseStart = 1E-12 + n * cfg.sync_symbol_duration + pos * cfg.spreadingdL * cfg.pulse_duration;
 				} else {
-				  arg->setTime(n * cfg.sync_symbol_duration + pos * cfg.spreadingdL * cfg.pulse_duration);
+				  pulseStart = n * cfg.sync_symbol_duration + pos * cfg.spreadingdL * cfg.pulse_duration;
 				}
-				//generatePulse(mapping, arg, C31[Ci - 1][pos],
-				//		IEEE802154A::maxPulse, IEEE802154A::mandatory_pulse);
-				generatePulse(mapping, arg, 1,			// always positive polarity
-						IEEE802154A::maxPulse, cfg.pulse_duration);
+				//generatePulse(mapping, signalStart, pulseStart, C31[Ci - 1][pos]);
+				generatePulse(mapping, signalStart, pulseStart, 1);			// always positive polarity
 			}
 		}
 	}
 }
 
-void IEEE802154A::generateSFD(Mapping* mapping, Argument* arg) {
+void IEEE802154A::Context::generateSFD(PulseTrainMapping* mapping, simtime_t_cref signalStart) const {
 	double sfdStart = NSync * Tpsym;
 	for (short n = 0; n < 8; n = n + 1) {
 		if (IEEE802154A::shortSFD[n] != 0) {
 			for (short pos = 0; pos < cfg.CLength; pos = pos + 1) {
 				if (C31[Ci - 1][pos] != 0) {
-					arg->setTime(sfdStart + n*cfg.sync_symbol_duration + pos*cfg.spreadingdL*cfg.pulse_duration);
-					//generatePulse(mapping, arg, C31[Ci - 1][pos] * shortSFD[n]); // change pulse polarity
-					generatePulse(mapping, arg, 1); // always positive polarity
+					//generatePulse(mapping, signalStart, sfdStart + n*cfg.sync_symbol_duration + pos*cfg.spreadingdL*cfg.pulse_duration, C31[Ci - 1][pos] * shortSFD[n]); // change pulse polarity
+					generatePulse(mapping, signalStart, sfdStart + n*cfg.sync_symbol_duration + pos*cfg.spreadingdL*cfg.pulse_duration, 1); // always positive polarity
 				}
 			}
 		}
 	}
 }
 
-void IEEE802154A::generatePhyHeader(Mapping* /*mapping*/, Argument* /*arg*/) {
+void IEEE802154A::Context::generatePhyHeader(PulseTrainMapping* /*mapping*/, simtime_t_cref /*signalStart*/) const {
 	// not implemented
 }
 
-void IEEE802154A::generatePulse(Mapping* mapping, Argument* arg,
-		short polarity, double peak, simtime_t_cref chip) {
+void IEEE802154A::Context::generatePulse(PulseTrainMapping* mapping, simtime_t_cref signalStart, simtime_t_cref pulseStart, short polarity) const {
 	assert(polarity == -1 || polarity == +1);
-	arg->setTime(arg->getTime() + IEEE802154A::signalStart);  // adjust argument so that we use absolute time values in Mapping
-	mapping->setValue(*arg, 0);
-	arg->setTime(arg->getTime() + chip / 2);
-	// Maximum point at symbol half (triangular pulse)
-	mapping->setValue(*arg, peak * polarity);
-	arg->setTime(arg->getTime() + chip / 2);
-	mapping->setValue(*arg, 0);
+	// use absolute time values in Mapping
+	mapping->addBurst(pulseStart + signalStart, 1);
 }
 
-void IEEE802154A::generateBurst(Mapping* mapping, Argument* arg,
-		simtime_t_cref burstStart, short /*polarity*/) {
-	assert(burstStart < cfg.preambleLength+(psduLength*8+48+2)*cfg.data_symbol_duration);
-	// 1. Start point = zeros
-	simtime_t offset = burstStart;
-	for (int pulse = 0; pulse < cfg.nbPulsesPerBurst; pulse++) {
-		arg->setTime(offset);
-		generatePulse(mapping, arg, 1);
-		offset = offset + cfg.pulse_duration;
-	}
+void IEEE802154A::Context::generateBurst(PulseTrainMapping* mapping, simtime_t_cref signalStart, simtime_t_cref burstStart, short /*polarity*/) const {
+	mapping->addBurst(burstStart + signalStart, cfg.nbPulsesPerBurst);
 }
 
-void IEEE802154A::setBitRate(Signal* s) {
+void IEEE802154A::Context::setBitRate(Signal* s, simtime_t_cref signalStart) const {
 	Argument arg = Argument();
 	// set a constant value for bitrate
 	TimeMapping<Linear>* bitrate = new TimeMapping<Linear> ();
-	arg.setTime(IEEE802154A::signalStart); // absolute time (required for compatibility with MiXiM base RSAM code)
+	arg.setTime(signalStart); // absolute time (required for compatibility with MiXiM base RSAM code)
 	bitrate->setValue(arg, cfg.bitrate);
 	arg.setTime(s->getDuration());
 	bitrate->setValue(arg, cfg.bitrate);
 	s->setBitrate(bitrate);
 }
 
-simtime_t IEEE802154A::getThdr() {
+simtime_t IEEE802154A::Context::getThdr() const {
 	switch (cfg.channel) {
 	default:
 		switch (cfg.prf) {
@@ -289,46 +369,11 @@ simtime_t IEEE802154A::getThdr() {
 	return 0;
 }
 
-int IEEE802154A::s(int n) {
-
-	assert(n < maxS);
-
-	for (; last_s < n; last_s = last_s + 1) {
-		// compute missing values as necessary
-		s_array[last_s] = (s_array[last_s - 14] + s_array[last_s - 15]) % 2;
-	}
-	assert(s_array[n] == 0 || s_array[n] == 1);
-	return s_array[n];
-
-}
-
-int IEEE802154A::getHoppingPos(int sym) {
-	//int m = 3;  // or 5 with 4M
-	int pos = 0;
-	int kNcpb = 0;
-	switch(cfg.prf) {
-	case NOMINAL_4_M:
-		kNcpb = sym * cfg.Ncpb;
-		pos = s(kNcpb) + 2*s(1+kNcpb) + 4*s(2+kNcpb) + 8*s(3+kNcpb) + 16*s(4+kNcpb);
-		break;
-	case NOMINAL_16_M:
-		pos = s(kNcpb) + 2*s(1+kNcpb) + 4*s(2+kNcpb);
-		break;
-	case NOMINAL_64_M:
-	case PRF_OFF:
-	default:
-		assert(0==1);  // unimplemented or invalid PRF value
-		break;
-	}
-	// assert(pos > -1 && pos < 8); // TODO: update to reflect number of hopping pos for current config
-	return pos;
-}
-
-simtime_t IEEE802154A::getPhyMaxFrameDuration() {
+simtime_t IEEE802154A::Context::getPhyMaxFrameDuration() const {
 	simtime_t phyMaxFrameDuration = SIMTIME_ZERO;
 	simtime_t TSHR, TPHR, TPSDU, TCCApreamble;
-	TSHR = IEEE802154A::getThdr();
-	TPHR = IEEE802154A::getThdr();
+	TSHR = getThdr();
+	TPHR = getThdr();
 	phyMaxFrameDuration = phyMaxFrameDuration + TSHR;
 	return phyMaxFrameDuration;
 }
@@ -27,17 +27,24 @@
 
 #include <vector>
 #include <utility>
+#include <cassert>
 
 #include "MiXiMDefs.h"
 #include "Signal_.h"
+#include "PulseTrainMapping.h"
 
 /**
  * @brief This class regroups static methods needed to generate
  * a pulse-level representation of an IEEE 802.15.4A UWB PHY frame
  * using the mandatory mode (high PRF).
  *
- *  The main function of interest is
- * static signalAndData generateIEEE802154AUWBSignal(simtime_t signalStart, bool allZeros=false).
+ * The transmission power of the frame is a PulseTrainMapping which
+ * stores the position of every pulse and burst.
+ *
+ * All parameters of a mode of the standard are held by an immutable
+ * Context, which is shared by all nodes using this mode:
+ * getContext(cfg).generateIEEE802154AUWBSignal(signalStart, psduLength)
+ * generates a frame.
  *
  * @ingroup ieee802154a
  */
@@ -71,11 +78,8 @@ class MIXIM_API IEEE802154A
 
         static const_simtime_t MaxFrameDuration;
 
+        /**@brief Number of precomputed scrambler bits */
         static const int maxS = 20000;
-        static short s_array[maxS];
-        static int last_s;
-
-        static double signalStart; // we cannot use a simtime_t here because the scale exponent is not yet known at initialization.
 
         /**@brief Number of Repetitions of the sync symbol in the SYNC preamble */
         static const int NSync = 64; // default sync preamble length
@@ -118,7 +122,7 @@ class MIXIM_API IEEE802154A
         };
 
     public:
-        /**@brief currently unused */
+        /**@brief Parameters of a mode of the standard, see cfg_mandatory_16M and cfg_mandatory_4M. */
         struct config
         {
                 int channel;
@@ -149,54 +153,112 @@ class MIXIM_API IEEE802154A
 
         typedef std::pair<Signal *, std::vector<bool> *> signalAndData;
 
-        /* @brief Sets the configuration of the IEEE802.15.4A standard.
-         *  Use this (and the struct config) to implement optional modes of the standard. */
-        static void setConfig(config newCfg);
-
-        static config getConfig()
+        /**
+         * @brief Everything derived from a config: the scrambler sequence,
+         * the burst hopping positions and the frame generator.
+         *
+         * A context is immutable once it is created and holds no state of a
+         * single frame, so it is shared by all nodes with the same
+         * configuration and its lookups can be used by several threads at
+         * the same time. Only generating a frame draws from the random
+         * number generator of the simulation. Contexts are only created by
+         * getContext(), which returns the same context for equal
+         * configurations.
+         */
+        class MIXIM_API Context
         {
-            return cfg;
-        }
-
-        // sets the number of data bytes to encode in the data structure.
-        static void setPSDULength(int _psduLength);
-
-        /* @brief Generates a frame starting at time signalStart and composed of
-         * psduLength bytes of data (this value must be set before by using setPSDULength()).
-         * If allZeros is set to true, all bit values are equal to zero.
-         * If it is set to false or undefined, bit values are generated randomly.
-         * The returned structure is a pair. Its first component is the Signal*,
-         * and the second component is a vector of bool with the the generated bit values.
-         * */
-        static signalAndData generateIEEE802154AUWBSignal(simtime_t_cref signalStart, bool allZeros = false);
+            protected:
+                /** @brief The configuration this context was created for. */
+                const config cfg;
+
+                /** @brief The first maxS bits of the scrambler (LFSR) sequence. */
+                std::vector<short> scrambler;
+
+                /** @brief The burst hopping position of every data symbol, a
+                 * single one if it does not depend on the symbol (16 MHz PRF). */
+                std::vector<short> hoppingPositions;
+
+                void generateSyncPreamble(PulseTrainMapping* mapping, simtime_t_cref signalStart) const;
+                void generateSFD(PulseTrainMapping* mapping, simtime_t_cref signalStart) const;
+                void generatePhyHeader(PulseTrainMapping* mapping, simtime_t_cref signalStart) const;
+                void generateBurst(PulseTrainMapping* mapping, simtime_t_cref signalStart, simtime_t_cref burstStart, short polarity) const;
+                /* @brief Adds a single pulse starting at pulseStart (relative to the signal start).
+                 * The energy detection receiver does not see the polarity, all pulses have the
+                 * shape of the mapping. */
+                void generatePulse(PulseTrainMapping* mapping, simtime_t_cref signalStart, simtime_t_cref pulseStart, short polarity) const;
+                void setBitRate(Signal* s, simtime_t_cref signalStart) const;
+
+            private:
+                /** @brief Copy constructor is not allowed. */
+                Context(const Context&);
+                /** @brief Assignment operator is not allowed. */
+                Context& operator=(const Context&);
+
+            public:
+                /** @brief Precomputes the scrambler and hopping sequences of the configuration. */
+                explicit Context(const config& cfg);
+
+                const config& getConfig() const
+                {
+                    return cfg;
+                }
+
+                /* @brief Generates a frame starting at time signalStart and composed of
+                 * psduLength bytes of data.
+                 * If allZeros is set to true, all bit values are equal to zero.
+                 * If it is set to false or undefined, bit values are generated randomly
+                 * with the simulation's random number generator 0.
+                 * The returned structure is a pair. Its first component is the Signal*,
+                 * and the second component is a vector of bool with the the generated bit values.
+                 * */
+                signalAndData generateIEEE802154AUWBSignal(simtime_t_cref signalStart, int psduLength, bool allZeros = false) const;
+
+                simtime_t getMaxFrameDuration() const;
+
+                // Compute derived parameters
+                simtime_t getPhyMaxFrameDuration() const;
+                simtime_t getThdr() const;
+
+                /** @brief Returns the n-th bit of the scrambler sequence. */
+                int s(int n) const
+                {
+                    assert(n >= 0 && n < static_cast<int>(scrambler.size()));
+                    return scrambler[n];
+                }
+
+                /**
+                 * @brief Returns the number of data symbols of the longest
+                 * frame the hopping sequence covers, 0 for an unimplemented
+                 * PRF.
+                 */
+                int getMaxDataSymbols() const;
+
+                /** @brief Returns the burst hopping position of data symbol sym. */
+                int getHoppingPos(int sym) const
+                {
+                    assert(sym >= 0 && sym < getMaxDataSymbols());  // checked by the frame generator and decoder
+                    return hoppingPositions[cfg.prf == NOMINAL_4_M ? sym : 0];
+                }
+        };
 
-        static simtime_t getMaxFrameDuration();
+        /**
+         * @brief Returns the context of the passed configuration, which is
+         * created on the first call.
+         *
+         * The contexts live until the end of the program. This function has
+         * to be called from the simulation thread (e.g. during
+         * initialization), the returned context can then be used anywhere.
+         */
+        static const Context& getContext(const config& cfg);
 
 // Constants from standard
         /* @brief Always 16 symbols for the PHY header */
         static const int Nhdr = 16;
 
-    protected:
-        static void generateSyncPreamble(Mapping* mapping, Argument* arg);
-        static void generateSFD(Mapping* mapping, Argument* arg);
-        static void generatePhyHeader(Mapping* mapping, Argument* arg);
-        static void generateBurst(Mapping* mapping, Argument* arg, simtime_t_cref burstStart, short polarity);
-        static void generatePulse(Mapping* mapping, Argument* arg, short polarity, double peak = IEEE802154A::maxPulse,
-                simtime_t_cref chip = IEEE802154A::mandatory_pulse);
-        static void setBitRate(Signal* s);
-        static int s(int n);
-
     public:
-        static int psduLength;
-        static config cfg;
         static const config cfg_mandatory_16M;
         static const config cfg_mandatory_4M;
 
-        // Compute derived parameters
-        static simtime_t getPhyMaxFrameDuration();
-        static simtime_t getThdr();
-        static int getHoppingPos(int sym);
-
 };
 
 #endif	/* _IEEE802154A_H */
@@ -0,0 +1,181 @@
+/* -*- mode:c++ -*- ********************************************************
+ * file:        PulseTrainMapping.cc
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ *
+ ***************************************************************************
+ * description: parametric representation of an UWB-IR pulse train (burst
+ *              positions, triangular pulse shape and channel taps)
+ **************************************************************************/
+
+#include "PulseTrainMapping.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+void PulseTrainMapping::Iterator::jumpTo(const Argument& pos) {
+	position.setTime(pos.getTime());
+	nextEntry = std::upper_bound(keys.begin(), keys.end(), position.getTime()) - keys.begin();
+	updateNextPosition();
+}
+
+void PulseTrainMapping::Iterator::jumpToBegin() {
+	nextEntry = 0;
+	position.setTime(SIMTIME_ZERO);
+	if(!keys.empty()) {
+		position.setTime(keys[nextEntry++]);
+	}
+	updateNextPosition();
+}
+
+PulseTrainMapping::PulseTrainMapping(simtime_t_cref pulseDuration, simtime_t_cref pulseSpacing, double peak):
+	ConstMapping(),
+	bursts(),
+	taps(),
+	pulseDuration(pulseDuration),
+	pulseSpacing(pulseSpacing),
+	peak(peak),
+	maxBurstLength(SIMTIME_ZERO),
+	keys()
+{
+	assert(pulseDuration > 0 && pulseSpacing > 0);
+
+	Tap direct = { SIMTIME_ZERO, 1.0 };
+	taps.push_back(direct);
+}
+
+PulseTrainMapping::PulseTrainMapping(const PulseTrainMapping& o, const TapList& channel):
+	ConstMapping(o),
+	bursts(o.bursts),
+	taps(),
+	pulseDuration(o.pulseDuration),
+	pulseSpacing(o.pulseSpacing),
+	peak(o.peak),
+	maxBurstLength(o.maxBurstLength),
+	keys()
+{
+	taps.reserve(o.taps.size() * channel.size());
+	for(TapList::const_iterator it = o.taps.begin(); it != o.taps.end(); ++it) {
+		for(TapList::const_iterator echo = channel.begin(); echo != channel.end(); ++echo) {
+			Tap tap = { it->delay + echo->delay, it->gain * echo->gain };
+			taps.push_back(tap);
+		}
+	}
+}
+
+PulseTrainMapping::PulseTrainMapping(const PulseTrainMapping& o):
+	ConstMapping(o),
+	bursts(o.bursts),
+	taps(o.taps),
+	pulseDuration(o.pulseDuration),
+	pulseSpacing(o.pulseSpacing),
+	peak(o.peak),
+	maxBurstLength(o.maxBurstLength),
+	keys()
+{}
+
+void PulseTrainMapping::addBurst(simtime_t_cref start, int pulses) {
+	assert(pulses > 0);
+
+	Burst burst = { start, pulses };
+	if(bursts.empty() || !(start < bursts.back().start)) {
+		bursts.push_back(burst);
+	} else {
+		bursts.insert(std::upper_bound(bursts.begin(), bursts.end(), start, StartLess()), burst);
+	}
+	maxBurstLength = std::max(maxBurstLength, (pulses - 1) * pulseSpacing + pulseDuration);
+	keys.clear();
+}
+
+double PulseTrainMapping::getBurstValue(const Burst& burst, double offset) const {
+	if(offset < 0)
+		return 0;
+
+	const double width   = SIMTIME_DBL(pulseDuration);
+	const double spacing = SIMTIME_DBL(pulseSpacing);
+	double       value   = 0;
+
+	// the pulses may be longer than their spacing, so the previous pulses can still contribute
+	for(int pulse = static_cast<int>(std::min<double>(burst.pulses - 1, floor(offset / spacing))); pulse >= 0; --pulse) {
+		const double x = offset - pulse * spacing;
+		if(x >= width)
+			break;
+		value += 1 - fabs(2 * x / width - 1);
+	}
+	return value;
+}
+
+double PulseTrainMapping::getTrainValue(BurstList::const_iterator end, simtime_t_cref t) const {
+	double value = 0;
+	for(BurstList::const_iterator it = end; it != bursts.begin(); ) {
+		--it;
+		// bursts starting earlier than the longest burst before t have already ended
+		if(!(t < it->start + maxBurstLength))
+			break;
+		value += getBurstValue(*it, SIMTIME_DBL(t - it->start));
+	}
+	return value;
+}
+
+Argument::mapped_type PulseTrainMapping::getValue(simtime_t_cref t) const {
+	double value = 0;
+	for(TapList::const_iterator tap = taps.begin(); tap != taps.end(); ++tap) {
+		const simtime_t delayed = t - tap->delay;
+		value += tap->gain * getTrainValue(std::upper_bound(bursts.begin(), bursts.end(), delayed, StartLess()), delayed);
+	}
+	return value * peak;
+}
+
+void PulseTrainMapping::getValues(const simtime_t* times, size_t count, simtime_t_cref offset, double* values) const {
+	std::fill(values, values + count, 0.0);
+	if(count == 0)
+		return;
+
+	for(TapList::const_iterator tap = taps.begin(); tap != taps.end(); ++tap) {
+		const simtime_t            shift = offset + tap->delay;
+		BurstList::const_iterator  end   = std::upper_bound(bursts.begin(), bursts.end(), times[0] - shift, StartLess());
+		for(size_t i = 0; i < count; ++i) {
+			assert(i == 0 || !(times[i] < times[i - 1]));
+
+			const simtime_t delayed = times[i] - shift;
+			while(end != bursts.end() && !(delayed < end->start))
+				++end;
+			values[i] += tap->gain * getTrainValue(end, delayed);
+		}
+	}
+	for(size_t i = 0; i < count; ++i) {
+		values[i] *= peak;
+	}
+}
+
+void PulseTrainMapping::createKeys() const {
+	if(!keys.empty() || bursts.empty())
+		return;
+
+	size_t pulses = 0;
+	for(BurstList::const_iterator it = bursts.begin(); it != bursts.end(); ++it) {
+		pulses += it->pulses;
+	}
+	keys.reserve(taps.size() * pulses * 3);
+
+	const simtime_t half = pulseDuration / 2;
+	for(TapList::const_iterator tap = taps.begin(); tap != taps.end(); ++tap) {
+		for(BurstList::const_iterator it = bursts.begin(); it != bursts.end(); ++it) {
+			simtime_t start = it->start + tap->delay;
+			for(int pulse = 0; pulse < it->pulses; ++pulse, start += pulseSpacing) {
+				keys.push_back(start);
+				keys.push_back(start + half);
+				keys.push_back(start + pulseDuration);
+			}
+		}
+	}
+	std::sort(keys.begin(), keys.end());
+	keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+}
@@ -0,0 +1,252 @@
+/* -*- mode:c++ -*- ********************************************************
+ * file:        PulseTrainMapping.h
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ *
+ ***************************************************************************
+ * description: parametric representation of an UWB-IR pulse train (burst
+ *              positions, triangular pulse shape and channel taps)
+ **************************************************************************/
+
+#ifndef PULSETRAINMAPPING_H_
+#define PULSETRAINMAPPING_H_
+
+#include <vector>
+#include <cstddef>
+
+#include "MiXiMDefs.h"
+#include "MappingBase.h"
+
+/**
+ * @brief Transmission or receiving power of an UWB-IR frame, stored as the
+ * positions of its bursts, the shape of its pulses and the taps of the
+ * channel it went through instead of a key entry per pulse corner.
+ *
+ * A burst is a sequence of triangular pulses of "pulseDuration" which start
+ * every "pulseSpacing" after the start of the burst. A single pulse (as in
+ * the synchronization preamble) is a burst of one pulse. The value of the
+ * mapping at time t is the sum of all pulses delayed by every tap and
+ * multiplied by the gain of the tap and the peak amplitude of the pulses.
+ * Pulses which overlap are added. Without a channel the mapping has a
+ * single tap without delay and with a gain of one.
+ *
+ * getValue() searches the bursts around t logarithmically for every tap,
+ * getValues() samples the mapping at many ascending times at once and only
+ * walks the bursts.
+ *
+ * The iterators iterate over the start, the peak and the end of every
+ * delayed pulse. These key entries are only created on the first call to
+ * createConstIterator().
+ *
+ * @ingroup ieee802154a
+ * @ingroup mapping
+ */
+class MIXIM_API PulseTrainMapping : public ConstMapping
+{
+public:
+	/** @brief A sequence of pulses.*/
+	struct Burst {
+		/** @brief Start of the first pulse (absolute time).*/
+		simtime_t start;
+		/** @brief Number of consecutive pulses.*/
+		int       pulses;
+	};
+
+	/** @brief An echo of the whole pulse train.*/
+	struct Tap {
+		simtime_t delay;
+		double    gain;
+	};
+
+	typedef std::vector<Burst>     BurstList;
+	typedef std::vector<Tap>       TapList;
+	typedef std::vector<simtime_t> KeyList;
+
+protected:
+	/** @brief The bursts ordered by their start.*/
+	BurstList bursts;
+
+	/** @brief The echoes of the pulse train.*/
+	TapList   taps;
+
+	/** @brief Duration of a single triangular pulse.*/
+	simtime_t pulseDuration;
+
+	/** @brief Time between the starts of two pulses of a burst.*/
+	simtime_t pulseSpacing;
+
+	/** @brief Amplitude of a pulse at its peak.*/
+	double    peak;
+
+	/** @brief The time from the start to the end of the longest burst.*/
+	simtime_t maxBurstLength;
+
+	/** @brief Ordered times of all pulse corners, created on demand.*/
+	mutable KeyList keys;
+
+	/** @brief Orders bursts by their start.*/
+	struct StartLess {
+		bool operator()(const Burst& b, simtime_t_cref t) const { return b.start < t; }
+		bool operator()(simtime_t_cref t, const Burst& b) const { return t < b.start; }
+		bool operator()(const Burst& a, const Burst& b) const { return a.start < b.start; }
+	};
+
+	/** @brief Iterates over the ordered key entries of a PulseTrainMapping.*/
+	class Iterator : public ConstMappingIterator {
+	protected:
+		const PulseTrainMapping* mapping;
+		const KeyList&           keys;
+		/** @brief Index of the key entry a call to next() moves to.*/
+		size_t                   nextEntry;
+		Argument                 position;
+		Argument                 nextPosition;
+
+		/** @brief Sets the next position to the key entry at nextEntry.*/
+		void updateNextPosition() {
+			if(nextEntry < keys.size())
+				nextPosition.setTime(keys[nextEntry]);
+		}
+
+	private:
+		/** @brief Copy constructor is not allowed.*/
+		Iterator(const Iterator&);
+		/** @brief Assignment operator is not allowed.*/
+		Iterator& operator=(const Iterator&);
+
+	public:
+		Iterator(const PulseTrainMapping* mapping, const KeyList& keys):
+			ConstMappingIterator(), mapping(mapping), keys(keys), nextEntry(0), position(), nextPosition()
+		{
+			jumpToBegin();
+		}
+
+		Iterator(const PulseTrainMapping* mapping, const KeyList& keys, const Argument& pos):
+			ConstMappingIterator(), mapping(mapping), keys(keys), nextEntry(0), position(), nextPosition()
+		{
+			jumpTo(pos);
+		}
+
+		virtual const Argument& getNextPosition() const {
+			if(nextEntry >= keys.size())
+				throw NoNextIteratorException();
+			return nextPosition;
+		}
+
+		virtual void jumpTo(const Argument& pos);
+
+		virtual void jumpToBegin();
+
+		virtual void iterateTo(const Argument& pos) {
+			position.setTime(pos.getTime());
+			while(nextEntry < keys.size() && !(position.getTime() < keys[nextEntry]))
+				++nextEntry;
+			updateNextPosition();
+		}
+
+		virtual void next() {
+			if(nextEntry >= keys.size())
+				throw NoNextIteratorException();
+			position.setTime(keys[nextEntry++]);
+			updateNextPosition();
+		}
+
+		virtual bool inRange() const {
+			return !keys.empty() && !(position.getTime() < keys.front()) && !(keys.back() < position.getTime());
+		}
+
+		virtual bool hasNext() const { return nextEntry < keys.size(); }
+
+		virtual const Argument& getPosition() const { return position; }
+
+		virtual argument_value_t getValue() const { return mapping->getValue(position.getTime()); }
+	};
+
+	/**
+	 * @brief Returns the value of the burst at "offset" seconds after its
+	 * start, without the peak amplitude.
+	 */
+	double getBurstValue(const Burst& burst, double offset) const;
+
+	/**
+	 * @brief Returns the sum of the bursts before "end" at time t, without
+	 * tap gain and peak amplitude.
+	 */
+	double getTrainValue(BurstList::const_iterator end, simtime_t_cref t) const;
+
+	/** @brief Creates the ordered key entries for the iterators.*/
+	void createKeys() const;
+
+public:
+	/**
+	 * @brief Initializes an empty pulse train without channel with the
+	 * passed pulse shape.
+	 */
+	PulseTrainMapping(simtime_t_cref pulseDuration, simtime_t_cref pulseSpacing, double peak);
+
+	/**
+	 * @brief Initializes the pulse train of "o" as it is received over
+	 * the channel with the passed taps.
+	 *
+	 * Every tap of "o" is echoed by every passed tap.
+	 */
+	PulseTrainMapping(const PulseTrainMapping& o, const TapList& channel);
+
+	PulseTrainMapping(const PulseTrainMapping& o);
+
+	/**
+	 * @brief Adds a burst of "pulses" consecutive pulses starting at
+	 * "start" (absolute time).
+	 *
+	 * Bursts are best added in the order of their start, an earlier burst
+	 * is inserted at its position.
+	 */
+	void addBurst(simtime_t_cref start, int pulses);
+
+	virtual argument_value_t getValue(const Argument& pos) const {
+		return getValue(pos.getTime());
+	}
+
+	/** @brief Returns the value of the pulse train at time t.*/
+	argument_value_t getValue(simtime_t_cref t) const;
+
+	/**
+	 * @brief Writes the values of the pulse train at the passed ascending
+	 * times minus "offset" to "values".
+	 *
+	 * Equals calling getValue() for every time, but every tap only walks
+	 * through the bursts once.
+	 */
+	void getValues(const simtime_t* times, size_t count, simtime_t_cref offset, double* values) const;
+
+	virtual ConstMappingIterator* createConstIterator() const {
+		createKeys();
+		return new Iterator(this, keys);
+	}
+
+	virtual ConstMappingIterator* createConstIterator(const Argument& pos) const {
+		createKeys();
+		return new Iterator(this, keys, pos);
+	}
+
+	virtual ConstMapping* constClone() const {
+		return new PulseTrainMapping(*this);
+	}
+
+	const BurstList& getBursts() const { return bursts; }
+
+	const TapList& getTaps() const { return taps; }
+
+	simtime_t_cref getPulseDuration() const { return pulseDuration; }
+
+	simtime_t_cref getPulseSpacing() const { return pulseSpacing; }
+
+	double getPeak() const { return peak; }
+};
+
+#endif /* PULSETRAINMAPPING_H_ */
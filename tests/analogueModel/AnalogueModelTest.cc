@@ -0,0 +1,195 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#include <omnetpp.h>
+#include <cmath>
+#include <vector>
+
+#include <CorrelatedShadowing.h>
+#include <asserts.h>
+#include <OmnetTestBase.h>
+
+/** Maximum deviation of the estimated variances and correlations.*/
+const double STAT_TOLERANCE = 0.1;
+
+/**
+ * Asserts that the passed value deviates at most "tolerance" from the
+ * expected value.
+ */
+void assertCloseTo(std::string msg, double target, double actual, double tolerance) {
+	if (fabs(target - actual) > tolerance) {
+		fail(msg, target, actual);
+	} else {
+		pass(msg);
+	}
+}
+
+/**
+ * Returns the sample correlation of the passed values.
+ */
+double sampleCorrelation(const std::vector<double>& a, const std::vector<double>& b) {
+	const double n = static_cast<double>(a.size());
+	double meanA = 0, meanB = 0;
+	for (size_t i = 0; i < a.size(); ++i) {
+		meanA += a[i];
+		meanB += b[i];
+	}
+	meanA /= n;
+	meanB /= n;
+
+	double cov = 0, varA = 0, varB = 0;
+	for (size_t i = 0; i < a.size(); ++i) {
+		cov  += (a[i] - meanA) * (b[i] - meanB);
+		varA += (a[i] - meanA) * (a[i] - meanA);
+		varB += (b[i] - meanB) * (b[i] - meanB);
+	}
+	return cov / sqrt(varA * varB);
+}
+
+/**
+ * Returns the values of the field at the passed positions and at the same
+ * positions shifted by (dx, dy).
+ */
+void samplePairs(const ShadowingField& field, double width, double height, double step,
+                 double dx, double dy, std::vector<double>& a, std::vector<double>& b) {
+	a.clear();
+	b.clear();
+	for (double y = 0; y < height; y += step) {
+		for (double x = 0; x < width; x += step) {
+			a.push_back(field.getValue(x, y));
+			b.push_back(field.getValue(x + dx, y + dy));
+		}
+	}
+}
+
+/**
+ * Returns the sample variance of the passed values.
+ */
+double sampleVariance(const std::vector<double>& a, double& mean) {
+	mean = 0;
+	for (size_t i = 0; i < a.size(); ++i)
+		mean += a[i];
+	mean /= a.size();
+
+	double var = 0;
+	for (size_t i = 0; i < a.size(); ++i)
+		var += (a[i] - mean) * (a[i] - mean);
+	return var / (a.size() - 1);
+}
+
+/**
+ * Statistical test of the ShadowingField in the plane:
+ *
+ * - mean and variance of the grid points and of interpolated points
+ * - correlation of neighbouring grid points along both axes, diagonal
+ *   and at the correlation distance
+ */
+void testShadowingFieldPlane() {
+	const double resolution  = 5;
+	const double correlation = 20;
+	const double size        = 2000;
+	ShadowingField field(size, size, resolution, correlation);
+
+	std::vector<double> a, b;
+	double mean;
+
+	samplePairs(field, size, size, resolution, resolution, 0, a, b);
+	assertCloseTo("Variance of the grid points.", 1.0, sampleVariance(a, mean), STAT_TOLERANCE);
+	assertCloseTo("Mean of the grid points.", 0.0, mean, STAT_TOLERANCE);
+	assertCloseTo("Correlation of neighbours along the x-axis.",
+	              exp(-resolution / correlation), sampleCorrelation(a, b), STAT_TOLERANCE);
+
+	samplePairs(field, size, size, resolution, 0, resolution, a, b);
+	assertCloseTo("Correlation of neighbours along the y-axis.",
+	              exp(-resolution / correlation), sampleCorrelation(a, b), STAT_TOLERANCE);
+
+	samplePairs(field, size, size, resolution, resolution, resolution, a, b);
+	assertCloseTo("Correlation of diagonal neighbours.",
+	              exp(-2 * resolution / correlation), sampleCorrelation(a, b), STAT_TOLERANCE);
+
+	samplePairs(field, size, size, resolution, correlation, 0, a, b);
+	assertCloseTo("Correlation at the correlation distance.",
+	              exp(-1.0), sampleCorrelation(a, b), STAT_TOLERANCE);
+
+	// the centers between the grid points have the lowest variance before scaling
+	samplePairs(field, size - resolution, size - resolution, resolution, resolution / 2, resolution / 2, a, b);
+	assertCloseTo("Variance of interpolated points.", 1.0, sampleVariance(b, mean), STAT_TOLERANCE);
+
+	assertClose("Correlation at the correlation distance in the plane.",
+	            exp(-1.0), field.getCorrelation(correlation, 0));
+	assertClose("Correlation of a diagonal in the plane.",
+	            exp(-2.0), field.getCorrelation(-correlation, correlation));
+
+	std::cout << "ShadowingField plane test successful." << std::endl;
+}
+
+/**
+ * Statistical test of the ShadowingField on a torus:
+ *
+ * - variance of the grid points
+ * - correlation across the playground borders
+ * - getCorrelation() is symmetric at the borders
+ */
+void testShadowingFieldTorus() {
+	const double resolution  = 5;
+	const double correlation = 20;
+	// narrow enough to see the wrap around along the x-axis, long enough
+	// along the y-axis for many samples
+	const double width       = 100;
+	const double height      = 20000;
+	ShadowingField torus(width, height, resolution, correlation, true);
+	ShadowingField plane(width, height, resolution, correlation, false);
+
+	std::vector<double> a, b;
+	double mean;
+
+	samplePairs(torus, width, height, resolution, resolution, 0, a, b);
+	assertCloseTo("Variance of the grid points on a torus.", 1.0, sampleVariance(a, mean), STAT_TOLERANCE);
+	assertCloseTo("Correlation of neighbours on a torus.",
+	              torus.getCorrelation(resolution, 0), sampleCorrelation(a, b), STAT_TOLERANCE);
+
+	samplePairs(torus, resolution, height, resolution, width - resolution, 0, a, b);
+	assertCloseTo("Correlation of neighbours across the border of a torus.",
+	              torus.getCorrelation(resolution, 0), sampleCorrelation(a, b), STAT_TOLERANCE);
+
+	samplePairs(torus, resolution, height, resolution, width / 2, 0, a, b);
+	assertCloseTo("Correlation at half of the width of a torus.",
+	              torus.getCorrelation(width / 2, 0), sampleCorrelation(a, b), STAT_TOLERANCE);
+
+	samplePairs(plane, resolution, height, resolution, width - resolution, 0, a, b);
+	assertTrue("Borders are uncorrelated in the plane.",
+	           sampleCorrelation(a, b) < plane.getCorrelation(resolution, 0) / 2);
+
+	assertClose("Correlation across the border of a torus equals the one inside.",
+	            torus.getCorrelation(resolution, 0), torus.getCorrelation(width - resolution, 0));
+	assertClose("Correlation of a torus is periodic.",
+	            torus.getCorrelation(resolution, resolution), torus.getCorrelation(resolution - width, resolution + height));
+	assertClose("Value of a torus is periodic.",
+	            torus.getValue(resolution / 3, resolution / 7), torus.getValue(resolution / 3 + width, resolution / 7 - height));
+
+	std::cout << "ShadowingField torus test successful." << std::endl;
+}
+
+class AnalogueModelTest:public SimpleTest {
+protected:
+	void runTests() {
+		testShadowingFieldPlane();
+		testShadowingFieldTorus();
+
+		testsExecuted = true;
+	}
+};
+
+Define_Module(AnalogueModelTest);
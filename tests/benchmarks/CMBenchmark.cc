@@ -0,0 +1,151 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#include <omnetpp.h>
+#include <cassert>
+#include <ctime>
+#include <vector>
+#include <algorithm>
+
+#include <BaseConnectionManager.h>
+#include <BaseWorldUtility.h>
+#include <FindModule.h>
+
+/**
+ * @brief Nic module without any functionality, only provides the radioIn
+ * gate needed by NicEntryDirect.
+ */
+class BenchNic : public cSimpleModule
+{};
+
+Define_Module(BenchNic);
+
+/**
+ * @brief Measures the number of nic moves per second the connection manager
+ * can handle.
+ *
+ * Registers every "nic" of the network at a random position and then moves
+ * randomly chosen nics by at most "maxStep" through
+ * BaseConnectionManager::updateNicPos(). If "movesPerTick" is bigger than one
+ * the moves are passed in groups of this size to
+ * BaseConnectionManager::updateNicPositions() instead. The moves are
+ * generated before the measurement so only the connection manager is timed. The total number of
+ * links afterwards is printed too, it has to be the same for every grid
+ * type of the connection manager.
+ */
+class CMBenchmark : public cSimpleModule
+{
+protected:
+	/** @brief A single precalculated move of a nic.*/
+	struct Move {
+		int   nic;
+		Coord pos;
+	};
+
+protected:
+	/** @brief Returns the passed value limited to [0, max].*/
+	static double clamp(double v, double max) {
+		return std::max(0.0, std::min(v, max));
+	}
+
+	/** @brief Returns the number of seconds since the passed clock value.*/
+	static double secondsSince(clock_t start) {
+		return static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+	}
+
+public:
+	virtual int numInitStages() const { return 2; }
+
+	virtual void initialize(int stage)
+	{
+		// connection manager and world are initialized in stage 0
+		if(stage != 1)
+			return;
+
+		BaseConnectionManager* cm    = FindModule<BaseConnectionManager*>::findGlobalModule();
+		BaseWorldUtility*      world = FindModule<BaseWorldUtility*>::findGlobalModule();
+		cModule*               net   = getParentModule();
+		assert(cm && world);
+
+		const Coord& pgs      = *world->getPgs();
+		const int    numNics  = net->par("numHosts");
+		const int    numMoves = par("numMoves");
+		const double maxStep  = par("maxStep");
+		const int    tickSize = par("movesPerTick");
+
+		std::vector<cModule*> nics(numNics);
+		std::vector<Coord>    positions(numNics);
+		for(int i = 0; i < numNics; ++i) {
+			nics[i]      = net->getSubmodule("nic", i);
+			positions[i] = Coord(uniform(0, pgs.x), uniform(0, pgs.y), uniform(0, pgs.z));
+		}
+
+		std::vector<Move> moves(numMoves);
+		std::vector<Coord> current(positions);
+		for(int i = 0; i < numMoves; ++i) {
+			Move& m = moves[i];
+			m.nic   = intuniform(0, numNics - 1);
+			Coord& pos = current[m.nic];
+			pos = Coord(clamp(pos.x + uniform(-maxStep, maxStep), pgs.x),
+						clamp(pos.y + uniform(-maxStep, maxStep), pgs.y),
+						clamp(pos.z + uniform(-maxStep, maxStep), pgs.z));
+			m.pos = pos;
+		}
+
+		clock_t start = clock();
+		for(int i = 0; i < numNics; ++i) {
+			cm->registerNic(nics[i], NULL, &positions[i]);
+		}
+		const double registerTime = secondsSince(start);
+
+		std::vector<BaseConnectionManager::NicPositions> ticks;
+		if(tickSize > 1) {
+			ticks.resize((numMoves + tickSize - 1) / tickSize);
+			for(int i = 0; i < numMoves; ++i) {
+				ticks[i / tickSize].push_back(
+					BaseConnectionManager::NicPosition(nics[moves[i].nic]->getId(), moves[i].pos));
+			}
+		}
+
+		start = clock();
+		if(tickSize > 1) {
+			for(size_t i = 0; i < ticks.size(); ++i) {
+				cm->updateNicPositions(ticks[i]);
+			}
+		} else {
+			for(int i = 0; i < numMoves; ++i) {
+				cm->updateNicPos(nics[moves[i].nic]->getId(), &moves[i].pos);
+			}
+		}
+		const double moveTime = secondsSince(start);
+
+		size_t links = 0;
+		for(int i = 0; i < numNics; ++i) {
+			links += cm->getGateList(nics[i]->getId()).size();
+		}
+
+		std::cout << "Benchmark ConnectionManager (" << cm->par("gridType").stringValue()
+				  << " grid, " << cm->par("updateHysteresis").doubleValue()
+				  << "m hysteresis, " << tickSize << " moves per tick, "
+				  << cm->getUpdateThreads() << " threads): " << numNics << " nics, "
+				  << numNics / std::max(registerTime, 1e-9) << " registrations/s, "
+				  << numMoves / std::max(moveTime, 1e-9) << " moves/s, "
+				  << links << " links" << std::endl;
+	}
+
+	virtual void handleMessage(cMessage* msg) { delete msg; }
+};
+
+Define_Module(CMBenchmark);
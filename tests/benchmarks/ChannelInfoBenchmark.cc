@@ -0,0 +1,100 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#include <omnetpp.h>
+#include <ctime>
+#include <vector>
+#include <algorithm>
+
+#include <ChannelInfo.h>
+
+/**
+ * @brief Measures the number of AirFrame interval queries per second of
+ * ChannelInfo on a busy channel.
+ *
+ * Generates "numFrames" AirFrames with exponentially distributed start
+ * intervals so that on average "concurrentFrames" of them are on the channel
+ * at the same time. Like the physical layer the benchmark adds every
+ * AirFrame at its start, asks for all AirFrames intersecting with it at
+ * its end and removes it afterwards.
+ */
+class ChannelInfoBenchmark : public cSimpleModule
+{
+protected:
+	/** @brief Start or end of an AirFrame.*/
+	struct Event {
+		simtime_t time;
+		bool      isStart;
+		int       frame;
+
+		bool operator<(const Event& o) const {
+			return time < o.time || (time == o.time && !isStart && o.isStart);
+		}
+	};
+
+public:
+	virtual void initialize()
+	{
+		const int    numFrames        = par("numFrames");
+		const double concurrentFrames = par("concurrentFrames");
+		const double frameDuration    = par("frameDuration");
+
+		std::vector<ChannelInfo::airframe_ptr_t> frames(numFrames);
+		std::vector<simtime_t>                   starts(numFrames);
+		std::vector<Event>                       events;
+		events.reserve(2 * numFrames);
+
+		simtime_t start = SIMTIME_ZERO;
+		for(int i = 0; i < numFrames; ++i) {
+			start += exponential(frameDuration / concurrentFrames);
+
+			frames[i] = new ChannelInfo::airframe_t();
+			frames[i]->setDuration(uniform(0.5, 1.5) * frameDuration);
+			starts[i] = start;
+
+			Event s = { start, true, i };
+			Event e = { start + frames[i]->getDuration(), false, i };
+			events.push_back(s);
+			events.push_back(e);
+		}
+		std::sort(events.begin(), events.end());
+
+		ChannelInfo                 channel;
+		ChannelInfo::AirFrameVector intersections;
+		size_t                      numIntersections = 0;
+
+		clock_t begin = clock();
+		for(std::vector<Event>::const_iterator it = events.begin(); it != events.end(); ++it) {
+			const int i = it->frame;
+			if(it->isStart) {
+				channel.addAirFrame(frames[i], starts[i]);
+				continue;
+			}
+			intersections.clear();
+			channel.getAirFrames(starts[i], it->time, intersections);
+			numIntersections += intersections.size();
+			channel.removeAirFrame(frames[i]);
+		}
+		const double time = static_cast<double>(clock() - begin) / CLOCKS_PER_SEC;
+
+		std::cout << "Benchmark ChannelInfo: " << numFrames << " frames, "
+				  << concurrentFrames << " concurrent frames, "
+				  << numFrames / std::max(time, 1e-9) << " frames/s, "
+				  << static_cast<double>(numIntersections) / numFrames
+				  << " intersections per frame" << std::endl;
+	}
+};
+
+Define_Module(ChannelInfoBenchmark);
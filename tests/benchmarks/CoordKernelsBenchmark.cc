@@ -0,0 +1,154 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#include <omnetpp.h>
+#include <ctime>
+#include <vector>
+#include <algorithm>
+
+#include <Coord.h>
+#include <PlainCoord.h>
+#include <CoordKernels.h>
+
+/**
+ * @brief Measures how fast the connection manager calculates the distances
+ * between a moved nic and the nics of its grid cells.
+ *
+ * Places "numPositions" nics uniformly on a playground of "playgroundSize"
+ * meters and calculates the squared distances of every nic to all nics
+ * "numRounds" times, in the plane and on a torus: once per pair with Coord
+ * like the connection manager did before, once per pair with PlainCoord and
+ * once per block of "blockSize" nics with CoordKernels, like
+ * FlatNicGrid::sqrdists() does.
+ *
+ * Prints the distances per second of all three, the instruction set of the
+ * kernels and the number of distances which differ from the ones of Coord
+ * (has to be 0 as long as the compiler does not contract to fused
+ * multiply-adds).
+ */
+class CoordKernelsBenchmark : public cSimpleModule
+{
+protected:
+	/** @brief Seconds since "begin".*/
+	static double elapsed(clock_t begin) {
+		return static_cast<double>(clock() - begin) / CLOCKS_PER_SEC;
+	}
+
+	/** @brief Returns the number of different values.*/
+	static int countMismatches(const std::vector<double>& a, const std::vector<double>& b) {
+		int mismatches = 0;
+		for (size_t i = 0; i < a.size(); ++i) {
+			if (a[i] != b[i])
+				++mismatches;
+		}
+		return mismatches;
+	}
+
+	/** @brief Prints the distances per second of the three variants.*/
+	static void print(const char* name, double distances, const double* times, int mismatches) {
+		std::cout << "Benchmark CoordDistance " << name << ": "
+				  << distances / std::max(times[0], 1e-9) << " distances/s with Coord, "
+				  << distances / std::max(times[1], 1e-9) << " distances/s with PlainCoord, "
+				  << distances / std::max(times[2], 1e-9) << " distances/s with CoordKernels ("
+				  << CoordKernels::instructionSet() << "), "
+				  << mismatches << " different distances" << std::endl;
+	}
+
+public:
+	virtual void initialize()
+	{
+		const int    numPositions   = par("numPositions");
+		const int    numRounds      = par("numRounds");
+		const int    blockSize      = par("blockSize");
+		const double playgroundSize = par("playgroundSize");
+
+		const Coord      size(playgroundSize, playgroundSize, playgroundSize);
+		const PlainCoord plainSize(size);
+
+		std::vector<Coord>      coords;
+		std::vector<PlainCoord> plain;
+		std::vector<double>     xs, ys, zs;
+		for (int i = 0; i < numPositions; ++i) {
+			coords.push_back(Coord(uniform(0, playgroundSize), uniform(0, playgroundSize), uniform(0, playgroundSize)));
+			plain.push_back(coords.back());
+			xs.push_back(coords.back().x);
+			ys.push_back(coords.back().y);
+			zs.push_back(coords.back().z);
+		}
+
+		std::vector<double> coordDistances(numPositions);
+		std::vector<double> distances(numPositions);
+		const double        numDistances = static_cast<double>(numRounds) * numPositions * numPositions;
+
+		for (int torus = 0; torus < 2; ++torus) {
+			double  times[3];
+			clock_t begin = clock();
+			for (int r = 0; r < numRounds; ++r) {
+				for (int p = 0; p < numPositions; ++p) {
+					const Coord& pos = coords[p];
+					for (int i = 0; i < numPositions; ++i) {
+						coordDistances[i] = torus ? coords[i].sqrTorusDist(pos, size) : coords[i].sqrdist(pos);
+					}
+				}
+			}
+			times[0] = elapsed(begin);
+
+			begin = clock();
+			for (int r = 0; r < numRounds; ++r) {
+				for (int p = 0; p < numPositions; ++p) {
+					const PlainCoord& pos = plain[p];
+					for (int i = 0; i < numPositions; ++i) {
+						distances[i] = torus ? plain[i].sqrTorusDist(pos, plainSize) : plain[i].sqrdist(pos);
+					}
+				}
+			}
+			times[1] = elapsed(begin);
+
+			begin = clock();
+			for (int r = 0; r < numRounds; ++r) {
+				for (int p = 0; p < numPositions; ++p) {
+					const PlainCoord& pos = plain[p];
+					for (int block = 0; block < numPositions; block += blockSize) {
+						const size_t count = std::min(blockSize, numPositions - block);
+						if (torus)
+							CoordKernels::sqrTorusDist(&xs[block], &ys[block], &zs[block], count, pos, plainSize, &distances[block]);
+						else
+							CoordKernels::sqrdist(&xs[block], &ys[block], &zs[block], count, pos, &distances[block]);
+					}
+				}
+			}
+			times[2] = elapsed(begin);
+
+			// compares the distances of every nic to all nics with the ones of Coord
+			int mismatches = 0;
+			for (int p = 0; p < numPositions; ++p) {
+				for (int i = 0; i < numPositions; ++i) {
+					coordDistances[i] = torus ? coords[i].sqrTorusDist(coords[p], size) : coords[i].sqrdist(coords[p]);
+					distances[i]      = torus ? plain[i].sqrTorusDist(plain[p], plainSize) : plain[i].sqrdist(plain[p]);
+				}
+				mismatches += countMismatches(coordDistances, distances);
+				if (torus)
+					CoordKernels::sqrTorusDist(&xs[0], &ys[0], &zs[0], numPositions, plain[p], plainSize, &distances[0]);
+				else
+					CoordKernels::sqrdist(&xs[0], &ys[0], &zs[0], numPositions, plain[p], &distances[0]);
+				mismatches += countMismatches(coordDistances, distances);
+			}
+
+			print(torus ? "torus" : "plane", numDistances, times, mismatches);
+		}
+	}
+};
+
+Define_Module(CoordKernelsBenchmark);
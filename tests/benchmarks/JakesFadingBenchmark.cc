@@ -0,0 +1,155 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#include <omnetpp.h>
+#include <ctime>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include <JakesFading.h>
+#include <BaseWorldUtility.h>
+
+/**
+ * @brief JakesFading which lets the benchmark switch the evaluation and
+ * calculate the attenuation like JakesFadingMapping::getValue() did before
+ * the phases were evaluated in blocks.
+ */
+class BenchJakesFading : public JakesFading
+{
+public:
+	void setEvaluation(Evaluation e, int tableSize) {
+		evaluation = e;
+		if(e == TABULATED)
+			sineTable.resize(tableSize);
+	}
+
+	double maxTableError() const { return sineTable.maxError(); }
+
+	/** @brief The attenuation at a single point in time, path by path.*/
+	double reference(double relSpeed, double t) const {
+		double f    = carrierFrequency;
+		double re_h = 0;
+		double im_h = 0;
+
+		double doppler_shift = relSpeed * f / BaseWorldUtility::speedOfLight;
+		for (int i = 0; i < fadingPaths; i++) {
+			double phi_d = angleOfArrival[i] * doppler_shift;
+			double phi_i = SIMTIME_DBL(delay[i]) * f;
+			double phi   = 2.00 * M_PI * (phi_d * t - phi_i);
+
+			double attenuation = (1.00 / sqrt(static_cast<double>(fadingPaths)));
+			re_h = re_h + attenuation * cos(phi);
+			im_h = im_h - attenuation * sin(phi);
+		}
+		return re_h * re_h + im_h * im_h;
+	}
+};
+
+/**
+ * @brief Measures how many JakesFading attenuations per second can be
+ * calculated and how exact they are.
+ *
+ * Calculates the attenuation at "numSamples" points in time, "interval"
+ * apart like the key entries of a JakesFadingMapping, for "numRuns" random
+ * relative speeds up to "maxSpeed". The reference calculates every point in
+ * time on its own with std::sin() and std::cos() like
+ * JakesFadingMapping::getValue() did before, it is compared with a single
+ * JakesFading::evaluate() call over all points in time for the "exact",
+ * "vectorised" and "tabulated" evaluation. Prints the throughput and the
+ * maximum absolute difference to the reference of every evaluation.
+ */
+class JakesFadingBenchmark : public cSimpleModule
+{
+protected:
+	/** @brief Accumulated time and maximum error of an evaluation.*/
+	struct Result {
+		double time;
+		double maxError;
+	};
+
+protected:
+	void print(const char* name, const Result& result, int numRuns) const
+	{
+		const double samples = static_cast<double>(numRuns) * par("numSamples").longValue();
+		std::cout << "Benchmark JakesFading " << name << " (" << SinCosKernels::instructionSet() << "): "
+				  << par("fadingPaths").longValue() << " paths, "
+				  << samples / std::max(result.time, 1e-9) << " samples/s, "
+				  << result.maxError << " max error" << std::endl;
+	}
+
+public:
+	virtual void initialize()
+	{
+		const int    fadingPaths = par("fadingPaths");
+		const int    numSamples  = par("numSamples");
+		const int    numRuns     = par("numRuns");
+		const double interval    = par("interval");
+		const double maxSpeed    = par("maxSpeed");
+		const int    tableSize   = par("tableSize");
+
+		AnalogueModel::ParameterMap params;
+		params["fadingPaths"]      = cMsgPar("fadingPaths").setLongValue(fadingPaths);
+		params["delayRMS"]         = cMsgPar("delayRMS").setDoubleValue(par("delayRMS").doubleValue());
+		params["interval"]         = cMsgPar("interval").setDoubleValue(interval);
+		params["carrierFrequency"] = cMsgPar("carrierFrequency").setDoubleValue(par("carrierFrequency").doubleValue());
+
+		BenchJakesFading model;
+		if(!model.initFromMap(params))
+			error("Could not initialize JakesFading.");
+
+		const char* names[] = { "reference", "exact", "vectorised", "tabulated" };
+		Result      results[4] = { { 0, 0 }, { 0, 0 }, { 0, 0 }, { 0, 0 } };
+
+		std::vector<double> times(numSamples);
+		std::vector<double> expected(numSamples);
+		std::vector<double> values(numSamples);
+		for(int run = 0; run < numRuns; ++run) {
+			const double relSpeed = uniform(0, maxSpeed);
+			const double start    = uniform(0, 1000);
+			for(int i = 0; i < numSamples; ++i) {
+				times[i] = start + i * interval;
+			}
+
+			clock_t begin = clock();
+			for(int i = 0; i < numSamples; ++i) {
+				expected[i] = model.reference(relSpeed, times[i]);
+			}
+			results[0].time += static_cast<double>(clock() - begin) / CLOCKS_PER_SEC;
+
+			for(int e = 1; e < 4; ++e) {
+				model.setEvaluation(e == 1 ? JakesFading::EXACT
+				                           : (e == 2 ? JakesFading::VECTORISED : JakesFading::TABULATED),
+				                    tableSize);
+
+				begin = clock();
+				model.evaluate(relSpeed, &times[0], numSamples, &values[0]);
+				results[e].time += static_cast<double>(clock() - begin) / CLOCKS_PER_SEC;
+
+				for(int i = 0; i < numSamples; ++i) {
+					results[e].maxError = std::max(results[e].maxError, std::fabs(values[i] - expected[i]));
+				}
+			}
+		}
+
+		for(int e = 0; e < 4; ++e) {
+			print(names[e], results[e], numRuns);
+		}
+		std::cout << "Benchmark JakesFading tabulated: " << model.maxTableError()
+				  << " max error of sine and cosine" << std::endl;
+	}
+};
+
+Define_Module(JakesFadingBenchmark);
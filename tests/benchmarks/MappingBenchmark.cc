@@ -0,0 +1,217 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#include <omnetpp.h>
+#include <ctime>
+#include <vector>
+#include <algorithm>
+
+#include <MappingUtils.h>
+
+/**
+ * @brief Measures the number of RSSI and SNR calculations per second for
+ * time-only mappings stored as TimeMapping<Linear> and as TimeSeriesMapping.
+ *
+ * Every run creates "numSignals" rectangular receiving powers with random
+ * start and end like BaseMacLayer::createRectangleMapping() does and a
+ * fading attenuation with "fadingPoints" key entries for the first signal,
+ * once as TimeMapping<Linear> (generic path over the virtual mapping
+ * iterators) and once as TimeSeriesMapping (array path with the
+ * vectorised MappingKernels searches).
+ *
+ * The RSSI workload sums up the receiving powers with MappingUtils::add()
+ * like BaseDecider and searches the maximum of the sum inside a window with
+ * MappingUtils::findMax(). The SNR workload follows
+ * Decider80211::createResult(): the receiving power of the first signal is
+ * the product of its transmission power and the attenuations, it is divided
+ * by the sum of thermal noise and the other signals and the minimum SNR
+ * after the PHY header is searched with MappingUtils::findMin(). Only the
+ * calculations are timed. Both paths have to find the same results.
+ */
+class MappingBenchmark : public cSimpleModule
+{
+protected:
+	/** @brief The mappings of a single run.*/
+	struct Workload {
+		std::vector<Mapping*> signals;
+		std::vector<Mapping*> attenuations;
+		Mapping*              zero;
+		Mapping*              thermalNoise;
+
+		~Workload() {
+			deleteAll(signals);
+			deleteAll(attenuations);
+		}
+	};
+
+	/** @brief Accumulated time and number of different results of a path.*/
+	struct Result {
+		double genericTime;
+		double fastTime;
+		int    mismatches;
+	};
+
+protected:
+	/** @brief Sums up the signals and returns the maximum of the sum in [from, to].*/
+	static Argument::mapped_type rssiMax(const Workload& w, simtime_t_cref from, simtime_t_cref to)
+	{
+		Mapping* sum = w.zero->clone();
+		for(std::vector<Mapping*>::const_iterator it = w.signals.begin(); it != w.signals.end(); ++it) {
+			Mapping* tmp = sum;
+			sum = MappingUtils::add(**it, *sum, Argument::MappedZero);
+			delete tmp;
+		}
+		const Argument::mapped_type max = MappingUtils::findMax(*sum, Argument(from), Argument(to));
+		delete sum;
+		return max;
+	}
+
+	/** @brief Returns the minimum SNR of the first signal in [from, to].*/
+	static Argument::mapped_type snrMin(const Workload& w, simtime_t_cref from, simtime_t_cref to)
+	{
+		Mapping* recvPower = w.signals.front()->clone();
+		for(std::vector<Mapping*>::const_iterator it = w.attenuations.begin(); it != w.attenuations.end(); ++it) {
+			Mapping* tmp = recvPower;
+			recvPower = MappingUtils::multiply(*recvPower, **it, Argument::MappedZero);
+			delete tmp;
+		}
+
+		Mapping* noise = MappingUtils::add(*w.zero, *w.thermalNoise);
+		for(std::vector<Mapping*>::const_iterator it = w.signals.begin() + 1; it != w.signals.end(); ++it) {
+			Mapping* tmp = noise;
+			noise = MappingUtils::add(**it, *noise, Argument::MappedZero);
+			delete tmp;
+		}
+
+		Mapping* snr = MappingUtils::divide(*recvPower, *noise, Argument::MappedZero);
+		const Argument::mapped_type min = MappingUtils::findMin(*snr, Argument(from), Argument(to), Argument::MappedZero);
+		delete recvPower;
+		delete noise;
+		delete snr;
+		return min;
+	}
+
+	/** @brief Adds a rectangle with the passed power over [start, end] to
+	 * the passed mapping.*/
+	static void addRectangle(Mapping* m, simtime_t_cref start, simtime_t_cref end, double power)
+	{
+		MappingUtils::addDiscontinuity(m, Argument(start), power, MappingUtils::pre(start), 0.0);
+		MappingUtils::addDiscontinuity(m, Argument(end), 0.0, MappingUtils::pre(end), power);
+	}
+
+	static void deleteAll(std::vector<Mapping*>& mappings)
+	{
+		for(std::vector<Mapping*>::iterator it = mappings.begin(); it != mappings.end(); ++it) {
+			delete *it;
+		}
+		mappings.clear();
+	}
+
+	/** @brief Times the passed calculation for both workloads.*/
+	static void measure(Argument::mapped_type (*calc)(const Workload&, simtime_t_cref, simtime_t_cref),
+	                    const Workload& generic, const Workload& fast, simtime_t_cref from, simtime_t_cref to,
+	                    Result& result)
+	{
+		clock_t begin = clock();
+		const Argument::mapped_type genericValue = calc(generic, from, to);
+		result.genericTime += static_cast<double>(clock() - begin) / CLOCKS_PER_SEC;
+
+		begin = clock();
+		const Argument::mapped_type fastValue = calc(fast, from, to);
+		result.fastTime += static_cast<double>(clock() - begin) / CLOCKS_PER_SEC;
+
+		if(genericValue != fastValue)
+			++result.mismatches;
+	}
+
+	void print(const char* name, const Result& result, int numRuns) const
+	{
+		std::cout << "Benchmark Mapping " << name << " (" << MappingKernels::instructionSet() << "): "
+				  << par("numSignals").longValue() << " signals, "
+				  << par("fadingPoints").longValue() << " fading points, "
+				  << numRuns / std::max(result.genericTime, 1e-9) << " calculations/s with TimeMapping<Linear>, "
+				  << numRuns / std::max(result.fastTime, 1e-9) << " calculations/s with TimeSeriesMapping, "
+				  << result.mismatches << " different results" << std::endl;
+	}
+
+public:
+	virtual void initialize()
+	{
+		const int    numSignals     = par("numSignals");
+		const int    numRuns        = par("numRuns");
+		const int    fadingPoints   = par("fadingPoints");
+		const double signalDuration = par("signalDuration");
+		const double headerDuration = par("headerDuration");
+
+		TimeMapping<Linear> genericZero(Argument::MappedZero);
+		TimeSeriesMapping   fastZero(Argument::MappedZero);
+		TimeMapping<Linear> genericThermal;
+		TimeSeriesMapping   fastThermal;
+		genericThermal.setValue(Argument(SIMTIME_ZERO), 1e-12);
+		fastThermal.setValue(Argument(SIMTIME_ZERO), 1e-12);
+
+		Result rssi = { 0, 0, 0 };
+		Result snr  = { 0, 0, 0 };
+		for(int run = 0; run < numRuns; ++run) {
+			Workload generic;
+			Workload fast;
+			generic.zero         = &genericZero;
+			generic.thermalNoise = &genericThermal;
+			fast.zero            = &fastZero;
+			fast.thermalNoise    = &fastThermal;
+
+			simtime_t start;
+			simtime_t end;
+			for(int i = 0; i < numSignals; ++i) {
+				const simtime_t s     = uniform(0.001, 2 * signalDuration);
+				const simtime_t e     = s + uniform(0.5, 1.5) * signalDuration;
+				const double    power = uniform(1e-10, 1e-7);
+
+				generic.signals.push_back(new TimeMapping<Linear>(Argument::MappedZero));
+				fast.signals.push_back(new TimeSeriesMapping(Argument::MappedZero));
+				addRectangle(generic.signals.back(), s, e, power);
+				addRectangle(fast.signals.back(), s, e, power);
+				if(i == 0) {
+					start = s;
+					end   = e;
+				}
+			}
+
+			// constant pathloss and a fading over the first signal
+			const double pathloss = uniform(1e-3, 1e-1);
+			generic.attenuations.push_back(new TimeMapping<Linear>());
+			fast.attenuations.push_back(new TimeSeriesMapping());
+			generic.attenuations.back()->setValue(Argument(start), pathloss);
+			fast.attenuations.back()->setValue(Argument(start), pathloss);
+
+			generic.attenuations.push_back(new TimeMapping<Linear>());
+			fast.attenuations.push_back(new TimeSeriesMapping());
+			for(int i = 0; i < fadingPoints; ++i) {
+				const Argument pos(start + (end - start) * i / std::max(fadingPoints - 1, 1));
+				const double   fading = exponential(1.0);
+				generic.attenuations.back()->appendValue(pos, fading);
+				fast.attenuations.back()->appendValue(pos, fading);
+			}
+
+			measure(&MappingBenchmark::rssiMax, generic, fast, signalDuration, 2 * signalDuration, rssi);
+			measure(&MappingBenchmark::snrMin, generic, fast, start + headerDuration, end, snr);
+		}
+
+		print("RSSI", rssi, numRuns);
+		print("SNR", snr, numRuns);
+	}
+};
+
+Define_Module(MappingBenchmark);
@@ -0,0 +1,109 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#include <omnetpp.h>
+#include <ctime>
+#include <vector>
+#include <algorithm>
+
+#include <MappingUtils.h>
+
+/**
+ * @brief Measures the lookups per second of a MultiDimMapping<Linear> over
+ * time and frequency.
+ *
+ * Creates a mapping with "numFrequencies" channels and "numTimes" key
+ * entries per channel, like the receiving power of a multi channel signal.
+ * Then "numLookups" random positions between the key entries are looked up
+ * with getValue(), which creates and compares an Argument for every
+ * interpolation step, and the whole mapping is iterated "numIterations"
+ * times with a ConstMappingIterator.
+ *
+ * Prints the lookups and iteration steps per second and a checksum of the
+ * values found, which does not depend on the implementation of Argument
+ * and DimensionSet.
+ */
+class MultiDimMappingBenchmark : public cSimpleModule
+{
+protected:
+	/** @brief Seconds since "begin".*/
+	static double elapsed(clock_t begin) {
+		return static_cast<double>(clock() - begin) / CLOCKS_PER_SEC;
+	}
+
+public:
+	virtual void initialize()
+	{
+		const int    numTimes       = par("numTimes");
+		const int    numFrequencies = par("numFrequencies");
+		const int    numLookups     = par("numLookups");
+		const int    numIterations  = par("numIterations");
+		const double duration       = par("duration");
+		const double bandwidth      = par("bandwidth");
+		const double centerFreq     = par("centerFrequency");
+
+		const Dimension           frequency = Dimension::frequency;
+		MultiDimMapping<Linear>   mapping(DimensionSet::timeFreqDomain);
+		Argument                  pos(DimensionSet::timeFreqDomain);
+		for(int f = 0; f < numFrequencies; ++f) {
+			pos.setArgValue(frequency, centerFreq + f * bandwidth);
+			for(int t = 0; t < numTimes; ++t) {
+				pos.setTime(duration * t / std::max(numTimes - 1, 1));
+				mapping.setValue(pos, uniform(1e-10, 1e-7));
+			}
+		}
+
+		// the random positions are drawn up front so only the lookups are timed
+		std::vector<simtime_t> times(numLookups);
+		std::vector<double>    freqs(numLookups);
+		for(int i = 0; i < numLookups; ++i) {
+			times[i] = uniform(0, duration);
+			freqs[i] = centerFreq + uniform(0, (numFrequencies - 1) * bandwidth);
+		}
+
+		double  lookupSum = 0;
+		clock_t begin     = clock();
+		for(int i = 0; i < numLookups; ++i) {
+			Argument lookup(DimensionSet::timeFreqDomain, times[i]);
+			lookup.setArgValue(frequency, freqs[i]);
+			lookupSum += mapping.getValue(lookup);
+		}
+		const double lookupTime = elapsed(begin);
+
+		double iterationSum = 0;
+		long   steps        = 0;
+		begin = clock();
+		for(int i = 0; i < numIterations; ++i) {
+			ConstMappingIterator* it = mapping.createConstIterator();
+			iterationSum += it->getValue();
+			++steps;
+			while(it->hasNext()) {
+				it->next();
+				iterationSum += it->getValue();
+				++steps;
+			}
+			delete it;
+		}
+		const double iterationTime = elapsed(begin);
+
+		std::cout << "Benchmark MultiDimMapping: " << numFrequencies << " frequencies, "
+				  << numTimes << " times, "
+				  << numLookups / std::max(lookupTime, 1e-9) << " lookups/s, "
+				  << steps / std::max(iterationTime, 1e-9) << " iteration steps/s, checksum "
+				  << lookupSum + iterationSum << std::endl;
+	}
+};
+
+Define_Module(MultiDimMappingBenchmark);
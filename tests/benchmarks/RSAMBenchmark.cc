@@ -0,0 +1,171 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#include <omnetpp.h>
+#include <ctime>
+#include <list>
+#include <vector>
+#include <algorithm>
+
+#include <PhyUtils.h>
+
+/**
+ * @brief Measures how fast the RadioStateAnalogueModel of a duty cycling
+ * radio evaluates the attenuation of received frames.
+ *
+ * While tracking is active the radio switches "numSwitches" times between
+ * receiving (no attenuation) and sleeping (total attenuation), every
+ * "switchInterval", like under BMAC or LMAC. Then "numFrames" frames with
+ * random start and "frameDuration" are evaluated: every frame gets its own
+ * RSAMMapping, its value is looked up at start, middle and end and the
+ * mapping is iterated from start to end. Finally the history is cleaned up
+ * in "numCleanUps" steps.
+ *
+ * The same is done with the std::list timeline the model used before, with
+ * std::upper_bound and std::lower_bound on list iterators. Prints the frames
+ * and clean up steps per second of both and the number of frames with
+ * different values (has to be 0).
+ */
+class RSAMBenchmark : public cSimpleModule
+{
+protected:
+	/** @brief The timeline of the model before it used a ring buffer.*/
+	typedef std::list<std::pair<simtime_t, double> > LegacyTimeline;
+
+	/** @brief Orders a legacy entry and a time like RadioStateAnalogueModel::ListEntry.*/
+	struct LegacyLess {
+		bool operator()(const LegacyTimeline::value_type& e, simtime_t_cref t) const { return e.first < t; }
+		bool operator()(simtime_t_cref t, const LegacyTimeline::value_type& e) const { return t < e.first; }
+	};
+
+	/** @brief Seconds since "begin".*/
+	static double elapsed(clock_t begin) {
+		return static_cast<double>(clock() - begin) / CLOCKS_PER_SEC;
+	}
+
+	/** @brief Value of the legacy timeline at t, like RSAMMapping::getValue().*/
+	static double legacyValue(const LegacyTimeline& timeline, simtime_t_cref t) {
+		LegacyTimeline::const_iterator it = std::upper_bound(timeline.begin(), timeline.end(), t, LegacyLess());
+		return (--it)->second;
+	}
+
+	/**
+	 * @brief Sums the values of the legacy timeline at start, middle and end
+	 * and at every position the RSAMConstMappingIterator visits in
+	 * [start, end]: start and every entry and the time right before it.
+	 */
+	static double legacyFrame(const LegacyTimeline& timeline, simtime_t_cref start, simtime_t_cref end) {
+		double sum = legacyValue(timeline, start) + legacyValue(timeline, (start + end) / 2) + legacyValue(timeline, end);
+
+		LegacyTimeline::const_iterator it = std::upper_bound(timeline.begin(), timeline.end(), start, LegacyLess());
+		double previous = legacyValue(timeline, start);
+		sum += previous;
+		for (; it != timeline.end() && !(end < it->first); ++it) {
+			sum += previous + it->second;
+			previous = it->second;
+		}
+		return sum;
+	}
+
+	/** @brief Sums the values of the model like legacyFrame().*/
+	static double rsamFrame(const RadioStateAnalogueModel& rsam, simtime_t_cref start, simtime_t_cref end) {
+		ConstMapping* mapping = new RSAMMapping(&rsam, start, end);
+		double sum = mapping->getValue(Argument(start))
+		           + mapping->getValue(Argument((start + end) / 2))
+		           + mapping->getValue(Argument(end));
+
+		ConstMappingIterator* it = mapping->createConstIterator();
+		sum += it->getValue();
+		while (it->hasNext()) {
+			it->next();
+			sum += it->getValue();
+		}
+		delete it;
+		delete mapping;
+		return sum;
+	}
+
+public:
+	virtual void initialize()
+	{
+		const int       numSwitches    = par("numSwitches");
+		const int       numFrames      = par("numFrames");
+		const int       numCleanUps    = par("numCleanUps");
+		const simtime_t switchInterval = par("switchInterval").doubleValue();
+		const simtime_t frameDuration  = par("frameDuration").doubleValue();
+		const simtime_t historyEnd     = switchInterval * numSwitches;
+
+		RadioStateAnalogueModel rsam(1.0, true);
+		LegacyTimeline          legacy;
+		legacy.push_back(std::make_pair(SIMTIME_ZERO, 1.0));
+		for (int i = 1; i <= numSwitches; ++i) {
+			const double value = (i % 2) ? 0.0 : 1.0;
+			rsam.writeRecvEntry(switchInterval * i, value);
+			legacy.push_back(std::make_pair(switchInterval * i, value));
+		}
+
+		std::vector<simtime_t> starts(numFrames);
+		for (int i = 0; i < numFrames; ++i) {
+			starts[i] = uniform(0, SIMTIME_DBL(historyEnd - frameDuration));
+		}
+
+		std::vector<double> legacySums(numFrames);
+		clock_t begin = clock();
+		for (int i = 0; i < numFrames; ++i) {
+			legacySums[i] = legacyFrame(legacy, starts[i], starts[i] + frameDuration);
+		}
+		const double legacyTime = elapsed(begin);
+
+		std::vector<double> sums(numFrames);
+		begin = clock();
+		for (int i = 0; i < numFrames; ++i) {
+			sums[i] = rsamFrame(rsam, starts[i], starts[i] + frameDuration);
+		}
+		const double rsamTime = elapsed(begin);
+
+		int mismatches = 0;
+		for (int i = 0; i < numFrames; ++i) {
+			if (sums[i] != legacySums[i])
+				++mismatches;
+		}
+
+		// clean up the history in steps like the phy layer does after every frame
+		begin = clock();
+		for (int i = 1; i <= numCleanUps; ++i) {
+			const simtime_t t = historyEnd * i / numCleanUps;
+			LegacyTimeline::iterator it = std::lower_bound(legacy.begin(), legacy.end(), t, LegacyLess());
+			if (it == legacy.end() || t < it->first)
+				--it;
+			legacy.erase(legacy.begin(), it);
+		}
+		const double legacyCleanUpTime = elapsed(begin);
+
+		begin = clock();
+		for (int i = 1; i <= numCleanUps; ++i) {
+			rsam.cleanUpUntil(historyEnd * i / numCleanUps);
+		}
+		const double cleanUpTime = elapsed(begin);
+
+		std::cout << "Benchmark RSAM frames: " << numSwitches << " switches, "
+				  << numFrames / std::max(legacyTime, 1e-9) << " frames/s with std::list, "
+				  << numFrames / std::max(rsamTime, 1e-9) << " frames/s with ring buffer, "
+				  << mismatches << " different results" << std::endl;
+		std::cout << "Benchmark RSAM clean up: " << numSwitches << " switches, "
+				  << numCleanUps / std::max(legacyCleanUpTime, 1e-9) << " steps/s with std::list, "
+				  << numCleanUps / std::max(cleanUpTime, 1e-9) << " steps/s with ring buffer" << std::endl;
+	}
+};
+
+Define_Module(RSAMBenchmark);
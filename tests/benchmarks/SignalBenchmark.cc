@@ -0,0 +1,168 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#include <omnetpp.h>
+#include <ctime>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include <algorithm>
+
+#include <MiXiMAirFrame.h>
+#include <MappingUtils.h>
+
+namespace {
+	/** @brief Number of allocations done so far.*/
+	unsigned long numAllocations = 0;
+	/** @brief Number of bytes allocated so far.*/
+	unsigned long numBytes       = 0;
+}
+
+// count every allocation of the benchmark binary
+void* operator new(size_t size)
+{
+	++numAllocations;
+	numBytes += size;
+	void* p = malloc(size ? size : 1);
+	if(!p)
+		throw std::bad_alloc();
+	return p;
+}
+
+void operator delete(void* p)
+{
+	free(p);
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete[](void* p)
+{
+	free(p);
+}
+
+/**
+ * @brief Measures allocations, bytes and time per broadcast when
+ * ConnectionManagerAccess::sendToChannel() copies an AirFrame for every
+ * receiver in range.
+ *
+ * Every broadcast creates an AirFrame with a transmission power of
+ * "powerPoints" key entries and a constant bitrate like
+ * BaseMacLayer::createSignal() does. It is copied with dup() for each of the
+ * "numReceivers" receivers and every copy gets a propagation delay and a
+ * pathloss attenuation like BasePhyLayer and SimplePathlossModel add them.
+ *
+ * The copies share the transmission power and the bitrate of the sender. To
+ * compare, the same is done once more with copies which get their own clone
+ * of both mappings like copying a Signal did before (the cloned copies
+ * additionally allocate the reference counts of the clones).
+ */
+class SignalBenchmark : public cSimpleModule
+{
+protected:
+	/** @brief Accumulated allocations, bytes and time of a way to copy.*/
+	struct Result {
+		unsigned long allocations;
+		unsigned long bytes;
+		double        time;
+	};
+
+protected:
+	/** @brief Creates the AirFrame of a single broadcast.*/
+	static MiximAirFrame* createFrame(simtime_t_cref start, simtime_t_cref duration, int powerPoints)
+	{
+		Signal s(start, duration);
+
+		Mapping* power = MappingUtils::createMapping(DimensionSet::timeDomain, Mapping::LINEAR);
+		for(int i = 0; i < powerPoints; ++i) {
+			power->appendValue(Argument(start + duration * i / std::max(powerPoints - 1, 1)), 0.1);
+		}
+		s.setTransmissionPower(power);
+
+		Mapping* bitrate = MappingUtils::createMapping(Argument::MappedZero, DimensionSet::timeDomain, Mapping::LINEAR);
+		bitrate->setValue(Argument(start), 54e6);
+		bitrate->setValue(Argument(start + duration), 54e6);
+		s.setBitrate(bitrate);
+
+		MiximAirFrame* frame = new MiximAirFrame();
+		frame->setSignal(s);
+		frame->setDuration(duration);
+		return frame;
+	}
+
+	/** @brief Sends the passed AirFrame to every receiver and deletes the copies.*/
+	static void broadcast(const MiximAirFrame* frame, int numReceivers, bool deepCopy, Result& result)
+	{
+		std::vector<MiximAirFrame*> copies(numReceivers);
+
+		const unsigned long allocations = numAllocations;
+		const unsigned long bytes       = numBytes;
+		const clock_t       begin       = clock();
+		for(int i = 0; i < numReceivers; ++i) {
+			MiximAirFrame* copy = frame->dup();
+			Signal&        s    = copy->getSignal();
+			if(deepCopy) {
+				s.setTransmissionPower(frame->getSignal().getTransmissionPower()->constClone());
+				s.setBitrate(frame->getSignal().getBitrate()->clone());
+			}
+			s.setPropagationDelay(1e-7 * (i + 1));
+			s.addAttenuation(new ConstantSimpleConstMapping(DimensionSet::timeDomain, 1e-6));
+			copies[i] = copy;
+		}
+		result.time        += static_cast<double>(clock() - begin) / CLOCKS_PER_SEC;
+		result.allocations += numAllocations - allocations;
+		result.bytes       += numBytes - bytes;
+
+		for(int i = 0; i < numReceivers; ++i) {
+			delete copies[i];
+		}
+	}
+
+	void print(const char* name, const Result& result, int numBroadcasts) const
+	{
+		std::cout << "Benchmark Signal " << name << ": "
+				  << par("numReceivers").longValue() << " receivers, "
+				  << par("powerPoints").longValue() << " power points, "
+				  << static_cast<double>(result.allocations) / numBroadcasts << " allocations/broadcast, "
+				  << static_cast<double>(result.bytes) / numBroadcasts << " bytes/broadcast, "
+				  << numBroadcasts / std::max(result.time, 1e-9) << " broadcasts/s" << std::endl;
+	}
+
+public:
+	virtual void initialize()
+	{
+		const int    numReceivers  = par("numReceivers");
+		const int    numBroadcasts = par("numBroadcasts");
+		const int    powerPoints   = par("powerPoints");
+		const double frameDuration = par("frameDuration");
+
+		Result shared = { 0, 0, 0 };
+		Result deep   = { 0, 0, 0 };
+		for(int i = 0; i < numBroadcasts; ++i) {
+			MiximAirFrame* frame = createFrame(i * frameDuration, frameDuration, powerPoints);
+			broadcast(frame, numReceivers, false, shared);
+			broadcast(frame, numReceivers, true, deep);
+			delete frame;
+		}
+
+		print("shared", shared, numBroadcasts);
+		print("cloned", deep, numBroadcasts);
+	}
+};
+
+Define_Module(SignalBenchmark);
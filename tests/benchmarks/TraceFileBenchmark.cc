@@ -0,0 +1,288 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#include <omnetpp.h>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <list>
+#include <vector>
+#include <algorithm>
+#include <queue>
+#include <functional>
+
+#include <BonnMotionFileCache.h>
+#include <Ns2MotionFileCache.h>
+#include <BinaryTraceConverter.h>
+
+/**
+ * @brief Measures how long the mobility modules of all nodes need to read
+ * their part of a ns2 motion or BonnMotion trace at startup.
+ *
+ * Writes a ns2 motion and a BonnMotion trace with "numNodes" nodes and
+ * "waypointsPerNode" waypoints each and reads them the way the mobility
+ * modules did before the traces were cached and indexed:
+ * - ns2: every node parses the whole file and keeps its own lines. Since
+ *   this is quadratic in the number of nodes only "referenceNodes" nodes
+ *   are measured and the time is extrapolated to all nodes.
+ * - BonnMotion: the file is parsed once into a list of lines and every
+ *   node walks the list to its line.
+ * Then both traces are read through Ns2MotionFileCache and
+ * BonnMotionFileCache for all nodes. Prints the startup times and the
+ * number of nodes whose waypoints differ from the old parser (has to be 0).
+ *
+ * Finally the ns2 trace is converted into a binary trace, which is opened
+ * and played back for all nodes like BinaryTraceMobility does. Prints the
+ * startup and playback time and the maximum number of records held in
+ * memory at once.
+ */
+class TraceFileBenchmark : public cSimpleModule
+{
+protected:
+	/** @brief Waypoints of a node as parsed by the old ns2 parser.*/
+	struct LegacyNs2Node {
+		double initial[3];
+		std::vector<std::vector<double> > lines;
+	};
+
+	/** @brief Seconds since "begin".*/
+	static double elapsed(clock_t begin) {
+		return static_cast<double>(clock() - begin) / CLOCKS_PER_SEC;
+	}
+
+	/** @brief The old Ns2MotionMobility::parseFile().*/
+	static void legacyParseNs2(const char* filename, int nodeId, LegacyNs2Node& node)
+	{
+		std::ifstream in(filename, std::ios::in);
+		node.initial[0] = node.initial[1] = node.initial[2] = -1;
+		std::string line;
+		while (std::getline(in, line)) {
+			if (line.find('#') == 0)
+				continue;
+			if (line.find("$node_") == std::string::npos)
+				continue;
+			std::string::size_type pos1 = line.find('(');
+			std::string::size_type pos2 = line.find(')');
+			if (pos2 - pos1 <= 1 || std::atoi(line.substr(pos1 + 1, pos2 - 1).c_str()) != nodeId)
+				continue;
+			std::string::size_type found;
+			if (line.find("set ") != std::string::npos) {
+				if ((found = line.find("X_")) != std::string::npos)
+					node.initial[0] = std::atof(line.substr(found + 3).c_str());
+				if ((found = line.find("Y_")) != std::string::npos)
+					node.initial[1] = std::atof(line.substr(found + 3).c_str());
+				if ((found = line.find("Z_")) != std::string::npos)
+					node.initial[2] = std::atof(line.substr(found + 3).c_str());
+			}
+			if (line.find("setdest") != std::string::npos) {
+				node.lines.push_back(std::vector<double>());
+				std::vector<double>& vec = node.lines.back();
+				vec.push_back(std::atof(line.substr(line.find("at") + 3).c_str()));
+				std::stringstream linestream(line.substr(line.find("setdest ") + 8));
+				double d;
+				while (linestream >> d)
+					vec.push_back(d);
+			}
+		}
+	}
+
+	/** @brief The old BonnMotionFileCache::parseFile().*/
+	static void legacyParseBonnMotion(const char* filename, std::list<std::vector<double> >& lines)
+	{
+		std::ifstream in(filename, std::ios::in);
+		std::string line;
+		while (std::getline(in, line)) {
+			lines.push_back(std::vector<double>());
+			std::stringstream linestream(line);
+			double d;
+			while (linestream >> d)
+				lines.back().push_back(d);
+		}
+	}
+
+	/** @brief Returns true if the cached node equals the old parser's.*/
+	static bool equals(const Ns2MotionFile* node, const LegacyNs2Node& legacy)
+	{
+		if (!node || !std::equal(node->initial, node->initial + 3, legacy.initial))
+			return false;
+		const Ns2MotionFile::WaypointList& waypoints = node->getWaypoints();
+		if (waypoints.size() != legacy.lines.size())
+			return false;
+		for (size_t i = 0; i < waypoints.size(); ++i) {
+			const std::vector<double>& vec = legacy.lines[i];
+			if (vec.size() != 4 || vec[0] != waypoints[i].time || vec[1] != waypoints[i].x
+			    || vec[2] != waypoints[i].y || vec[3] != waypoints[i].speed)
+				return false;
+		}
+		return true;
+	}
+
+	/** @brief Writes the ns2 motion and the BonnMotion trace.*/
+	void writeTraces(const char* ns2Name, const char* bmName, int numNodes, int waypoints)
+	{
+		FILE* ns2 = fopen(ns2Name, "w");
+		FILE* bm  = fopen(bmName, "w");
+		if (!ns2 || !bm)
+			error("Cannot write the traces to the working directory.");
+
+		fprintf(ns2, "# %d nodes, %d waypoints per node\n", numNodes, waypoints);
+		for (int n = 0; n < numNodes; ++n) {
+			fprintf(ns2, "$node_(%d) set X_ %.2f\n", n, uniform(0, 10000));
+			fprintf(ns2, "$node_(%d) set Y_ %.2f\n", n, uniform(0, 10000));
+			fprintf(ns2, "$node_(%d) set Z_ 0.00\n", n);
+		}
+		// the commands of all nodes are sorted by time like in exported traces
+		for (int w = 0; w < waypoints; ++w) {
+			for (int n = 0; n < numNodes; ++n) {
+				fprintf(ns2, "$ns_ at %.2f \"$node_(%d) setdest %.2f %.2f %.2f\"\n",
+				        w * 10.0 + uniform(0, 10), n, uniform(0, 10000), uniform(0, 10000), uniform(0, 30));
+			}
+		}
+
+		for (int n = 0; n < numNodes; ++n) {
+			for (int w = 0; w < waypoints; ++w) {
+				fprintf(bm, "%s%.2f %.2f %.2f", w == 0 ? "" : " ", w * 10.0, uniform(0, 10000), uniform(0, 10000));
+			}
+			fprintf(bm, "\n");
+		}
+		fclose(ns2);
+		fclose(bm);
+	}
+
+public:
+	virtual void initialize()
+	{
+		const int numNodes       = par("numNodes");
+		const int waypoints      = par("waypointsPerNode");
+		const int referenceNodes = std::min(numNodes, static_cast<int>(par("referenceNodes").longValue()));
+		const char* ns2Name      = "TraceFileBenchmark.ns_movements";
+		const char* bmName       = "TraceFileBenchmark.movements";
+
+		writeTraces(ns2Name, bmName, numNodes, waypoints);
+
+		// ns2, old parser for some nodes, extrapolated to all of them
+		std::vector<LegacyNs2Node> legacyNs2(referenceNodes);
+		clock_t begin = clock();
+		for (int n = 0; n < referenceNodes; ++n) {
+			legacyParseNs2(ns2Name, n, legacyNs2[n]);
+		}
+		const double legacyNs2Time = elapsed(begin) * numNodes / std::max(referenceNodes, 1);
+
+		// ns2, cache
+		std::vector<const Ns2MotionFile*> ns2Nodes(numNodes);
+		begin = clock();
+		Ns2MotionFileCache* ns2Cache = Ns2MotionFileCache::acquireInstance();
+		for (int n = 0; n < numNodes; ++n) {
+			ns2Nodes[n] = ns2Cache->getFile(ns2Name, n);
+		}
+		const double ns2Time = elapsed(begin);
+
+		int ns2Errors = 0;
+		for (int n = 0; n < referenceNodes; ++n) {
+			if (!equals(ns2Nodes[n], legacyNs2[n]))
+				++ns2Errors;
+		}
+
+		// BonnMotion, old list
+		std::vector<const std::vector<double>*> legacyBm(numNodes);
+		begin = clock();
+		std::list<std::vector<double> > lines;
+		legacyParseBonnMotion(bmName, lines);
+		for (int n = 0; n < numNodes; ++n) {
+			std::list<std::vector<double> >::const_iterator it = lines.begin();
+			for (int i = 0; i < n && it != lines.end(); ++i)
+				++it;
+			legacyBm[n] = (it == lines.end()) ? NULL : &(*it);
+		}
+		const double legacyBmTime = elapsed(begin);
+
+		// BonnMotion, cache
+		std::vector<const BonnMotionFile::Line*> bmNodes(numNodes);
+		begin = clock();
+		BonnMotionFileCache* bmCache = BonnMotionFileCache::acquireInstance();
+		for (int n = 0; n < numNodes; ++n) {
+			bmNodes[n] = bmCache->getFile(bmName)->getLine(n);
+		}
+		const double bmTime = elapsed(begin);
+
+		int bmErrors = 0;
+		for (int n = 0; n < numNodes; ++n) {
+			if (!bmNodes[n] || !legacyBm[n] || *bmNodes[n] != *legacyBm[n])
+				++bmErrors;
+		}
+
+		Ns2MotionFileCache::releaseInstance();
+		BonnMotionFileCache::releaseInstance();
+
+		// binary trace, every node consumes its records at their time
+		const char* binName = "TraceFileBenchmark.mtrace";
+		BinaryTraceWriter writer;
+		BinaryTraceConverter::convertNs2(ns2Name, writer);
+		writer.write(binName, 4096);
+
+		begin = clock();
+		BinaryTraceReader* trace = BinaryTraceReader::open(binName);
+		typedef std::pair<double, int> Wakeup;
+		std::priority_queue<Wakeup, std::vector<Wakeup>, std::greater<Wakeup> > wakeups;
+		for (int n = 0; n < numNodes; ++n) {
+			BinaryTraceReader::Record first;
+			if (trace->registerNode(n, first))
+				wakeups.push(Wakeup(first.time, n));
+		}
+		const double binTime = elapsed(begin);
+
+		begin = clock();
+		size_t maxPending = 0;
+		while (!wakeups.empty()) {
+			const Wakeup w = wakeups.top();
+			wakeups.pop();
+			const simtime_t now = w.first;
+			trace->advanceTo(now);
+			double next = -1;
+			const BinaryTraceReader::Record* record;
+			while ((record = trace->peekRecord(w.second)) != NULL && simtime_t(record->time) <= now) {
+				next = record->nextTime;
+				trace->popRecord(w.second);
+			}
+			if (next >= 0)
+				wakeups.push(Wakeup(next, w.second));
+			maxPending = std::max(maxPending, trace->getNumPendingRecords());
+		}
+		const double playbackTime = elapsed(begin);
+		const unsigned long numRecords = trace->getHeader().numRecords;
+		BinaryTraceReader::release(trace);
+
+		remove(ns2Name);
+		remove(bmName);
+		remove(binName);
+
+		std::cout << "Benchmark TraceFile ns2 legacy: " << numNodes << " nodes, "
+				  << legacyNs2Time << " s startup (extrapolated from " << referenceNodes << " nodes)" << std::endl;
+		std::cout << "Benchmark TraceFile ns2 cached: " << numNodes << " nodes, "
+				  << ns2Time << " s startup, " << ns2Errors << " differing nodes" << std::endl;
+		std::cout << "Benchmark TraceFile BonnMotion legacy: " << numNodes << " nodes, "
+				  << legacyBmTime << " s startup" << std::endl;
+		std::cout << "Benchmark TraceFile BonnMotion cached: " << numNodes << " nodes, "
+				  << bmTime << " s startup, " << bmErrors << " differing nodes" << std::endl;
+		std::cout << "Benchmark TraceFile binary: " << numNodes << " nodes, "
+				  << binTime << " s startup, " << playbackTime << " s playback, "
+				  << maxPending << " of " << numRecords << " records in memory at most" << std::endl;
+	}
+};
+
+Define_Module(TraceFileBenchmark);
@@ -0,0 +1,131 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#include <omnetpp.h>
+#include <ctime>
+#include <algorithm>
+
+#include <IEEE802154A.h>
+
+/**
+ * @brief Measures how fast the decoder looks up the burst hopping positions
+ * of IEEE 802.15.4A frames.
+ *
+ * Decodes the hopping positions of "numFrames" frames of "psduLength" bytes
+ * for both mandatory configurations like DeciderUWBIRED::decodePacket()
+ * does: once with the shared IEEE802154A::Context of the configuration of
+ * the frame, once like IEEE802154A did before, which copied the
+ * configuration into a global and extended a global scrambler sequence on
+ * demand for every position.
+ *
+ * The global scrambler returned 0 for the newest bit it had not computed
+ * yet, so it is extended to its full length before, which also leaves only
+ * the lookups to be timed.
+ *
+ * Prints the frames per second of both and the number of different hopping
+ * positions (has to be 0).
+ */
+class UWBContextBenchmark : public cSimpleModule
+{
+protected:
+	/** @brief The global state of IEEE802154A before it had contexts.*/
+	struct Legacy {
+		IEEE802154A::config cfg;
+		short               s_array[IEEE802154A::maxS];
+		int                 last_s;
+
+		Legacy(): cfg(IEEE802154A::cfg_mandatory_16M), last_s(15) {
+			std::fill(s_array, s_array + IEEE802154A::maxS, 0);
+			s_array[12] = 1;
+		}
+
+		int s(int n) {
+			assert(n < IEEE802154A::maxS);
+			for (; last_s < n; last_s = last_s + 1) {
+				s_array[last_s] = (s_array[last_s - 14] + s_array[last_s - 15]) % 2;
+			}
+			return s_array[n];
+		}
+
+		int getHoppingPos(int sym) {
+			int kNcpb = 0;
+			if (cfg.prf == IEEE802154A::NOMINAL_4_M) {
+				kNcpb = sym * cfg.Ncpb;
+				return s(kNcpb) + 2*s(1+kNcpb) + 4*s(2+kNcpb) + 8*s(3+kNcpb) + 16*s(4+kNcpb);
+			}
+			return s(kNcpb) + 2*s(1+kNcpb) + 4*s(2+kNcpb);
+		}
+	};
+
+	/** @brief Seconds since "begin".*/
+	static double elapsed(clock_t begin) {
+		return static_cast<double>(clock() - begin) / CLOCKS_PER_SEC;
+	}
+
+public:
+	virtual void initialize()
+	{
+		const int psduLength = par("psduLength");
+		const int numFrames  = par("numFrames");
+		const int nbSymbols  = psduLength * 8 + 48;
+
+		const IEEE802154A::config configs[2] = { IEEE802154A::cfg_mandatory_4M, IEEE802154A::cfg_mandatory_16M };
+
+		// extend the global scrambler and create the contexts before timing
+		Legacy* legacy = new Legacy();
+		legacy->s(IEEE802154A::maxS - 1);
+		IEEE802154A::getContext(configs[0]);
+		IEEE802154A::getContext(configs[1]);
+
+		long    legacySum = 0;
+		clock_t begin     = clock();
+		for (int i = 0; i < numFrames; ++i) {
+			legacy->cfg = configs[i % 2];
+			for (int symbol = 0; symbol < nbSymbols; ++symbol) {
+				legacySum += legacy->getHoppingPos(symbol);
+			}
+		}
+		const double legacyTime = elapsed(begin);
+
+		long sum = 0;
+		begin    = clock();
+		for (int i = 0; i < numFrames; ++i) {
+			const IEEE802154A::Context& context = IEEE802154A::getContext(configs[i % 2]);
+			for (int symbol = 0; symbol < nbSymbols; ++symbol) {
+				sum += context.getHoppingPos(symbol);
+			}
+		}
+		const double contextTime = elapsed(begin);
+
+		int mismatches = 0;
+		for (int c = 0; c < 2; ++c) {
+			const IEEE802154A::Context& context = IEEE802154A::getContext(configs[c]);
+			legacy->cfg = configs[c];
+			for (int symbol = 0; symbol < nbSymbols; ++symbol) {
+				if (context.getHoppingPos(symbol) != legacy->getHoppingPos(symbol))
+					++mismatches;
+			}
+		}
+		delete legacy;
+
+		std::cout << "Benchmark UWBContext: " << nbSymbols << " symbols per frame, "
+				  << numFrames / std::max(legacyTime, 1e-9) << " frames/s with global scrambler, "
+				  << numFrames / std::max(contextTime, 1e-9) << " frames/s with shared context, "
+				  << mismatches << " different hopping positions (checksums "
+				  << legacySum << ", " << sum << ")" << std::endl;
+	}
+};
+
+Define_Module(UWBContextBenchmark);
@@ -0,0 +1,193 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#include <omnetpp.h>
+#include <ctime>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include <MappingUtils.h>
+#include <IEEE802154A.h>
+#include <PulseTrainMapping.h>
+
+/**
+ * @brief Measures how fast IEEE 802.15.4A UWB-IR frames are generated and
+ * sampled by the energy detection receiver.
+ *
+ * Generates "numFrames" frames of "psduLength" bytes with IEEE802154A as
+ * PulseTrainMapping and writes the same pulses into a TimeMapping<Linear>,
+ * three key entries per pulse, as IEEE802154A did before. Then both are
+ * sampled like DeciderUWBIRED::integrateWindow() does: one sample per
+ * pulse peak of every data burst of the first frame and of the window
+ * shifted by the burst position modulation, once per sample with
+ * getValue() for the TimeMapping, once per window with getValues() for
+ * the pulse train.
+ * Finally the pulse train is sampled after a channel with "numTaps" taps.
+ *
+ * Prints the frames per second for generation and sampling, the number of
+ * key entries and bursts per frame and the largest difference between the
+ * sampled values (below 1e-3, both round the pulse corners to the
+ * simulation time resolution differently).
+ */
+class UWBPulseTrainBenchmark : public cSimpleModule
+{
+protected:
+	/** @brief Seconds since "begin".*/
+	static double elapsed(clock_t begin) {
+		return static_cast<double>(clock() - begin) / CLOCKS_PER_SEC;
+	}
+
+	/** @brief Writes the pulses of the train like IEEE802154A did.*/
+	static TimeMapping<Linear>* createLegacyMapping(const PulseTrainMapping& train, const IEEE802154A::config& cfg) {
+		TimeMapping<Linear>* mapping = new TimeMapping<Linear>();
+		Argument             arg;
+		const PulseTrainMapping::BurstList& bursts = train.getBursts();
+		for (PulseTrainMapping::BurstList::const_iterator it = bursts.begin(); it != bursts.end(); ++it) {
+			simtime_t offset = it->start;
+			for (int pulse = 0; pulse < it->pulses; ++pulse) {
+				arg.setTime(offset);
+				mapping->setValue(arg, 0);
+				arg.setTime(arg.getTime() + IEEE802154A::mandatory_pulse / 2);
+				mapping->setValue(arg, train.getPeak());
+				arg.setTime(arg.getTime() + IEEE802154A::mandatory_pulse / 2);
+				mapping->setValue(arg, 0);
+				offset = offset + cfg.pulse_duration;
+			}
+		}
+		return mapping;
+	}
+
+	/**
+	 * @brief Appends the sample times of the decoder windows of every data
+	 * burst, returns the number of samples per window.
+	 */
+	static size_t createSampleTimes(const PulseTrainMapping& train, const IEEE802154A::config& cfg, std::vector<simtime_t>& times) {
+		const PulseTrainMapping::BurstList& bursts = train.getBursts();
+		size_t samplesPerWindow = 0;
+		for (PulseTrainMapping::BurstList::const_iterator it = bursts.begin(); it != bursts.end(); ++it) {
+			if (it->pulses == 1)
+				continue; // preamble
+			for (int window = 0; window < 2; ++window) {
+				const simtime_t windowStart = it->start + cfg.pulse_duration / 2 + window * cfg.shift_duration;
+				const simtime_t windowEnd   = windowStart + cfg.burst_duration;
+				samplesPerWindow = 0;
+				for (simtime_t now = windowStart; now < windowEnd; now += cfg.pulse_duration) {
+					times.push_back(now);
+					++samplesPerWindow;
+				}
+			}
+		}
+		return samplesPerWindow;
+	}
+
+public:
+	virtual void initialize()
+	{
+		const int psduLength = par("psduLength");
+		const int numFrames  = par("numFrames");
+		const int numTaps    = par("numTaps");
+
+		const IEEE802154A::Context& context = IEEE802154A::getContext(IEEE802154A::cfg_mandatory_16M);
+		const IEEE802154A::config&  cfg     = context.getConfig();
+
+		std::vector<IEEE802154A::signalAndData> frames(numFrames);
+		clock_t begin = clock();
+		for (int i = 0; i < numFrames; ++i) {
+			frames[i] = context.generateIEEE802154AUWBSignal(simTime(), psduLength);
+		}
+		const double trainTime = elapsed(begin);
+
+		std::vector<const PulseTrainMapping*> trains(numFrames);
+		for (int i = 0; i < numFrames; ++i) {
+			trains[i] = dynamic_cast<const PulseTrainMapping*>(frames[i].first->getTransmissionPower());
+			if (trains[i] == NULL)
+				error("IEEE802154A did not generate a PulseTrainMapping.");
+		}
+
+		std::vector<TimeMapping<Linear>*> legacy(numFrames);
+		begin = clock();
+		for (int i = 0; i < numFrames; ++i) {
+			legacy[i] = createLegacyMapping(*trains[i], cfg);
+		}
+		const double legacyTime = elapsed(begin);
+
+		// every window is sampled at once, like integrateWindow() does
+		std::vector<simtime_t> times;
+		const size_t           samplesPerWindow = createSampleTimes(*trains[0], cfg, times);
+		std::vector<double>    legacyValues(times.size());
+		std::vector<double>    values(times.size());
+
+		begin = clock();
+		for (int i = 0; i < numFrames; ++i) {
+			Argument arg;
+			for (size_t s = 0; s < times.size(); ++s) {
+				arg.setTime(times[s]);
+				legacyValues[s] = legacy[i]->getValue(arg);
+			}
+		}
+		const double legacySampleTime = elapsed(begin);
+
+		begin = clock();
+		for (int i = 0; i < numFrames; ++i) {
+			for (size_t s = 0; s < times.size(); s += samplesPerWindow) {
+				trains[i]->getValues(&times[s], std::min(samplesPerWindow, times.size() - s), SIMTIME_ZERO, &values[s]);
+			}
+		}
+		const double sampleTime = elapsed(begin);
+
+		double maxDifference = 0;
+		for (size_t s = 0; s < times.size(); ++s) {
+			maxDifference = std::max(maxDifference, fabs(values[s] - legacyValues[s]));
+		}
+
+		PulseTrainMapping::TapList taps(numTaps);
+		for (int t = 0; t < numTaps; ++t) {
+			taps[t].delay = exponential(5e-9) + (t > 0 ? taps[t - 1].delay : SIMTIME_ZERO);
+			taps[t].gain  = exp(-t / 10.0);
+		}
+		begin = clock();
+		for (int i = 0; i < numFrames; ++i) {
+			PulseTrainMapping echoed(*trains[i], taps);
+			for (size_t s = 0; s < times.size(); s += samplesPerWindow) {
+				echoed.getValues(&times[s], std::min(samplesPerWindow, times.size() - s), SIMTIME_ZERO, &values[s]);
+			}
+		}
+		const double echoTime = elapsed(begin);
+
+		const size_t bursts = trains[0]->getBursts().size();
+		size_t       pulses = 0;
+		for (PulseTrainMapping::BurstList::const_iterator it = trains[0]->getBursts().begin(); it != trains[0]->getBursts().end(); ++it) {
+			pulses += it->pulses;
+		}
+
+		for (int i = 0; i < numFrames; ++i) {
+			delete legacy[i];
+			delete frames[i].first;
+			delete frames[i].second;
+		}
+
+		std::cout << "Benchmark UWBPulseTrain generation: " << psduLength << " bytes, "
+				  << numFrames / std::max(legacyTime, 1e-9) << " frames/s with TimeMapping (" << 3 * pulses << " key entries), "
+				  << numFrames / std::max(trainTime, 1e-9) << " frames/s with pulse train (" << bursts << " bursts)" << std::endl;
+		std::cout << "Benchmark UWBPulseTrain sampling: " << times.size() << " samples per frame, "
+				  << numFrames / std::max(legacySampleTime, 1e-9) << " frames/s with TimeMapping, "
+				  << numFrames / std::max(sampleTime, 1e-9) << " frames/s with pulse train, "
+				  << numFrames / std::max(echoTime, 1e-9) << " frames/s with pulse train and " << numTaps << " taps, "
+				  << "max difference " << maxDifference << std::endl;
+	}
+};
+
+Define_Module(UWBPulseTrainBenchmark);
@@ -17,6 +17,7 @@
 
 #include <omnetpp.h>
 #include <ChannelInfo.h>
+#include <InterferenceTimeline.h>
 #include <asserts.h>
 #include <OmnetTestBase.h>
 
@@ -278,6 +279,115 @@ void testIntersections() {
 	assertEqual("Should be empty now..", 0u, v.size());
 }
 
+/**
+ * Unit test for the per channel AirFrame view of ChannelInfo
+ *
+ * - test with AirFrames on two channels
+ * - test with removed AirFrame
+ */
+void testChannelPartition() {
+
+	ChannelInfo testChannel;
+
+	ChannelInfo::airframe_ptr_t frame1 = new ChannelInfo::airframe_t();
+	frame1->setDuration(2.0);
+	frame1->setChannel(0);
+	testChannel.addAirFrame(frame1, 1.0);
+
+	ChannelInfo::airframe_ptr_t frame2 = new ChannelInfo::airframe_t();
+	frame2->setDuration(1.0);
+	frame2->setChannel(1);
+	testChannel.addAirFrame(frame2, 1.5);
+
+	ChannelInfo::airframe_ptr_t frame3 = new ChannelInfo::airframe_t();
+	frame3->setDuration(1.0);
+	frame3->setChannel(0);
+	testChannel.addAirFrame(frame3, 2.0);
+
+	ChannelInfo::AirFrameVector v;
+	testChannel.getAirFrames(0.0, 4.0, v);
+	assertEqual("All AirFrames should be returned independent of channel.", 3u, v.size());
+
+	v.clear();
+	testChannel.getChannelAirFrames(0.0, 4.0, v);
+	assertEqual("Channel 0 should be the default channel.", 2u, v.size());
+	assertEqual("Channel 0 should return AirFrames in order of their end.", frame1, v.front());
+	assertEqual("Channel 0 should return AirFrames in order of their end.", frame3, v.back());
+
+	testChannel.setCurrentChannel(1);
+	v.clear();
+	testChannel.getChannelAirFrames(0.0, 4.0, v);
+	assertEqual("Channel 1 should return only its AirFrame.", 1u, v.size());
+	assertEqual("Channel 1 should return only its AirFrame.", frame2, v.front());
+
+	v.clear();
+	testChannel.getChannelAirFrames(2.6, 4.0, v);
+	assertTrue("Channel 1 should return no AirFrame after its end.", v.empty());
+
+	testChannel.setCurrentChannel(2);
+	v.clear();
+	testChannel.getChannelAirFrames(0.0, 4.0, v);
+	assertTrue("Channel without AirFrames should return none.", v.empty());
+
+	//frame2 still intersects with active frames on channel 0
+	testChannel.removeAirFrame(frame2);
+	testChannel.setCurrentChannel(1);
+	v.clear();
+	testChannel.getChannelAirFrames(0.0, 4.0, v);
+	assertEqual("Removed AirFrame intersecting active ones should be still returned.", 1u, v.size());
+	assertEqual("Removed AirFrame intersecting active ones should be still returned.", frame2, v.front());
+
+	testChannel.removeAirFrame(frame1);
+	testChannel.removeAirFrame(frame3);
+	v.clear();
+	testChannel.getChannelAirFrames(0.0, 4.0, v);
+	assertTrue("Channel 1 should be empty after all AirFrames are removed.", v.empty());
+	testChannel.setCurrentChannel(0);
+	v.clear();
+	testChannel.getChannelAirFrames(0.0, 4.0, v);
+	assertTrue("Channel 0 should be empty after all AirFrames are removed.", v.empty());
+	assertTrue("ChannelInfo should be empty after all AirFrames are removed.", testChannel.isChannelEmpty());
+}
+
+/**
+ * Unit test for the summed receiving power kept by the phy layer
+ *
+ * - test with overlapping and disjoint powers
+ * - test with truncated and pruned timeline
+ */
+void testInterferenceTimeline() {
+
+	InterferenceTimeline timeline;
+	assertEqual("Empty timeline should be zero.", 0.0, timeline.getMax(0.0, 10.0));
+
+	timeline.add(1.0, 3.0, 2.0);
+	timeline.add(2.0, 4.0, 1.0);
+	timeline.add(5.0, 6.0, 4.0);
+
+	assertEqual("Power before first AirFrame should be zero.", 0.0, timeline.getValue(0.5));
+	assertEqual("Power of single AirFrame.", 2.0, timeline.getValue(1.0));
+	assertEqual("Power of overlapping AirFrames should be summed up.", 3.0, timeline.getValue(2.5));
+	assertEqual("Power should end with end of AirFrame.", 1.0, timeline.getValue(3.0));
+	assertEqual("Power between AirFrames should be zero.", 0.0, timeline.getValue(4.5));
+	assertEqual("Maximum should contain overlap.", 3.0, timeline.getMax(0.0, 4.5));
+	assertEqual("Maximum inside a single step.", 2.0, timeline.getMax(1.5, 1.5));
+	assertEqual("Minimum should contain gap.", 0.0, timeline.getMin(3.5, 5.5));
+	assertEqual("Minimum inside AirFrames.", 1.0, timeline.getMin(1.5, 3.5));
+
+	timeline.truncate(2.5);
+	assertEqual("Truncate should keep power before.", 3.0, timeline.getValue(2.0));
+	assertEqual("Truncate should remove power after.", 0.0, timeline.getMax(2.5, 10.0));
+
+	timeline.add(2.5, 4.0, 0.5);
+	assertEqual("Power added after truncate.", 0.5, timeline.getValue(3.5));
+
+	timeline.removeBefore(2.0);
+	assertEqual("Pruning should keep power at prune point.", 3.0, timeline.getValue(2.0));
+	assertEqual("Pruning should remove power before prune point.", 0.0, timeline.getValue(1.5));
+
+	timeline.removeBefore(4.0);
+	assertTrue("Should be empty after pruning all AirFrames.", timeline.empty());
+}
 
 class ChannelInfoTest:public SimpleTest {
 protected:
@@ -421,6 +531,8 @@ protected:
 
 	void runTests() {
 		testIntersections();
+		testChannelPartition();
+		testInterferenceTimeline();
 
 		testRecordingFlag();
 		testsExecuted = true;
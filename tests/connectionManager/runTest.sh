@@ -48,6 +48,48 @@ fi
 ./${lSingle} -c Test3 "${LIBSREF[@]}">> out.tmp 2>> err.tmp
 ./${lSingle} -c Test4 "${LIBSREF[@]}">> out.tmp 2>> err.tmp
 
+# the flat grid and the connection update hysteresis must not change any
+# connection, so their runs are compared with the runs they extend
+iFailed=0
+while read lConfig lRef
+do
+    ./${lSingle} -c ${lRef}    "${LIBSREF[@]}"> ref.tmp  2>> err.tmp </dev/null
+    ./${lSingle} -c ${lConfig} "${LIBSREF[@]}"> test.tmp 2>> err.tmp </dev/null
+    diff -I '^Preparing for running configuration' \
+         -I '^Assigned runID=' \
+         -I '^     Speed:' \
+         -I '^** Event #' \
+         -w ref.tmp test.tmp >diff-${lConfig}.log 2>/dev/null
+    if [ -s diff-${lConfig}.log ]; then
+        echo "FAILED ${lConfig} differs from ${lRef}; see $(basename $(cd $(dirname $0);pwd) )/diff-${lConfig}.log"
+        iFailed=1
+    else
+        rm -f diff-${lConfig}.log
+    fi
+done <<EOF
+Test1Flat       Test1
+Test2Flat       Test2
+Test3Flat       Test3
+Test4Flat       Test4
+Test3Hysteresis Test3
+Test4Hysteresis Test4
+EOF
+
+# only the results of the assertions of the move back run are checked
+./${lSingle} -c TestHysteresisMoveBack "${LIBSREF[@]}"> test.tmp 2>> err.tmp
+grep -e '^Passed: ' -e '^FAILED: ' test.tmp >asserts.tmp
+diff -w - asserts.tmp >diff-TestHysteresisMoveBack.log 2>/dev/null <<EOF
+Passed: Test Node 0: Should have received no broadcast.
+Passed: Test Node 1: Broadcast should not be answered by any node.
+EOF
+if [ -s diff-TestHysteresisMoveBack.log ]; then
+    echo "FAILED TestHysteresisMoveBack; see $(basename $(cd $(dirname $0);pwd) )/diff-TestHysteresisMoveBack.log"
+    iFailed=1
+else
+    rm -f diff-TestHysteresisMoveBack.log
+fi
+rm -f ref.tmp test.tmp asserts.tmp
+
 [ x$lIsComb = x1 ] && rm -f ${lSingle} ${lSingle}.exe >/dev/null 2>&1
 diff -I '^Assigned runID=' \
      -I '^Loading NED files from' \
@@ -64,6 +106,7 @@ if [ -s diff.log ]; then
         cat out.tmp >exp-output
     exit 1
 else
+    [ x$iFailed = x0 ] || exit 1
     echo "PASSED $(basename $(cd $(dirname $0);pwd) )"
     rm -f out.tmp diff.log err.tmp
 fi
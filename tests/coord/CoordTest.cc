@@ -16,6 +16,8 @@
  ***************************************************************************/
 
 #include <Coord.h>
+#include <PlainCoord.h>
+#include <CoordKernels.h>
 #include <asserts.h>
 #include <OmnetTestBase.h>
 
@@ -368,6 +370,69 @@ void testIsInBoundary() {
 	std::cout << "Is in rectangle test successful." << std::endl;
 }
 
+/**
+ * Unit test for PlainCoord and CoordKernels
+ *
+ * - test conversion from and to Coord
+ * - test that the distances are exactly the ones of Coord
+ * - test that the kernels calculate the distances of Coord, for a number of
+ *   positions which is no multiple of the vector width, with positions
+ *   equal to and outside of the playground
+ * - test 2D/3D
+ */
+void testPlainCoord() {
+	Coord a(X, Y, Z);
+	Coord b(X2, Y2, Z2);
+
+	PlainCoord pa(a);
+	assertEqual("x-value of PlainCoord(Coord&).", X, pa.x);
+	assertEqual("y-value of PlainCoord(Coord&).", Y, pa.y);
+	assertEqual("z-value of PlainCoord(Coord&).", Z, pa.z);
+	assertTrue("PlainCoord::toCoord() == Coord.", pa.toCoord() == a);
+
+	assertEqual("3D: square distance a<->b equals Coord.", a.sqrdist(b), pa.sqrdist(b));
+	assertEqual("3D: distance a<->b equals Coord.", a.distance(b), pa.distance(b));
+
+	Coord ul1(X1_IN_UPPER_LEFT_HALF, Y1_IN_UPPER_LEFT_HALF, Z1_IN_UPPER_LEFT_HALF);
+	Coord lr1(X1_IN_LOWER_RIGHT_HALF, Y1_IN_LOWER_RIGHT_HALF, Z1_IN_LOWER_RIGHT_HALF);
+	Coord pg(PG_X, PG_Y, PG_Z);
+
+	assertEqual("3D: square torus distance ul1<->lr1 equals Coord.", ul1.sqrTorusDist(lr1, pg), PlainCoord(ul1).sqrTorusDist(lr1, pg));
+
+	//2D and 3D positions in one array, the first one equal to ul1
+	const size_t NUM_POSITIONS = 11;
+	double xs[NUM_POSITIONS];
+	double ys[NUM_POSITIONS];
+	double zs[NUM_POSITIONS];
+	for(size_t i = 0; i < NUM_POSITIONS; ++i) {
+		xs[i] = X1_IN_UPPER_LEFT_HALF + i * X;
+		ys[i] = Y1_IN_UPPER_LEFT_HALF - i * Y2;
+		zs[i] = (i % 2 == 0) ? Z1_IN_UPPER_LEFT_HALF + i * Z2 : 0.0;
+	}
+
+	double distances[NUM_POSITIONS];
+	double torusDistances[NUM_POSITIONS];
+	CoordKernels::sqrdist(xs, ys, zs, NUM_POSITIONS, ul1, distances);
+	CoordKernels::sqrTorusDist(xs, ys, zs, NUM_POSITIONS, ul1, pg, torusDistances);
+
+	//the compiler may contract the scalar code of Coord to fused
+	//multiply-adds, which rounds differently in the last bit
+	const double ROUNDING = 1e-12;
+	bool equalDistances = true;
+	bool equalTorusDistances = true;
+	for(size_t i = 0; i < NUM_POSITIONS; ++i) {
+		Coord c(xs[i], ys[i], zs[i]);
+		equalDistances = equalDistances && fabs(distances[i] - c.sqrdist(ul1)) <= ROUNDING * c.sqrdist(ul1);
+		equalTorusDistances = equalTorusDistances && fabs(torusDistances[i] - c.sqrTorusDist(ul1, pg)) <= ROUNDING * c.sqrTorusDist(ul1, pg);
+	}
+	assertEqual("square distance of position equal to ul1.", 0.0, distances[0]);
+	assertEqual("square torus distance of position equal to ul1.", 0.0, torusDistances[0]);
+	assertTrue("CoordKernels::sqrdist() equals Coord::sqrdist().", equalDistances);
+	assertTrue("CoordKernels::sqrTorusDist() equals Coord::sqrTorusDist().", equalTorusDistances);
+
+	std::cout << "PlainCoord test successful." << std::endl;
+}
+
 class CoordTest:public SimpleTest {
 protected:
 	void runTests() {
@@ -377,6 +442,7 @@ protected:
 	    testLength();
 	    testDistance();
 	    testIsInBoundary();
+	    testPlainCoord();
 
 	    testsExecuted = true;
 	}
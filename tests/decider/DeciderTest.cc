@@ -1,6 +1,9 @@
 #include "DeciderTest.h"
 #include "../testUtils/asserts.h"
 #include "TestSNRThresholdDeciderNew.h"
+#include <Decider802154Narrow.h>
+#include <Decider80211.h>
+#include <BERTable.h>
 
 Define_Module(DeciderTest);
 
@@ -183,9 +186,56 @@ void DeciderTest::runTests()
 	// start the test of the decider
 	runDeciderTests("SNRThresholdDeciderNew");
 
+	testBERTables();
+
 	testsExecuted = true;
 }
 
+void DeciderTest::testBERTables()
+{
+	const char*                   names[]     = { "msk", "oqpsk16", "gfsk", "CCK 5.5 Mbit/s", "CCK 11 Mbit/s" };
+	const BERTable::ber_function_t functions[] = { Decider802154Narrow::getBERFunction(Decider802154Narrow::MSK),
+	                                               Decider802154Narrow::getBERFunction(Decider802154Narrow::OQPSK16),
+	                                               Decider802154Narrow::getBERFunction(Decider802154Narrow::GFSK),
+	                                               Decider80211::getBERFunction(5.5E+6),
+	                                               Decider80211::getBERFunction(11E+6) };
+	const double                  parameters[] = { 0, 0, 0, 5.5E+6, 11E+6 };
+
+	for(unsigned m = 0; m < sizeof(parameters) / sizeof(parameters[0]); ++m) {
+		const std::string name(names[m]);
+
+		// a resolution of 0.1 dB and the default bounds of the deciders
+		BERTable table;
+		assertTrue("BER table of " + name + " reached the maximum error.",
+		           table.build(functions[m], parameters[m], -20, 40, 0.1, 1e-3));
+		assertTrue("BER table of " + name + " matches the closed form.",
+		           table.validate(-25, 45, 70001) <= 1e-3);
+
+		bool   monotone = true;
+		double last     = table.getBER(pow(10.0, -2.5));
+		for(int i = 1; i <= 70000; ++i) {
+			const double ber = table.getBER(pow(10.0, (-25 + i * 0.001) / 10.0));
+			monotone = monotone && ber <= last;
+			last     = ber;
+		}
+		assertTrue("BER table of " + name + " does not increase with the SNR.", monotone);
+
+		assertEqual("BER table of " + name + " uses the closed form below its range.",
+		            functions[m](0.001, parameters[m]), table.getBER(0.001));
+		assertEqual("BER table of " + name + " uses the closed form for zero SNR.",
+		            functions[m](0, parameters[m]), table.getBER(0));
+
+		// a coarse resolution has to be refined until the error bound is met
+		BERTable coarse;
+		assertTrue("Coarse BER table of " + name + " reached the maximum error.",
+		           coarse.build(functions[m], parameters[m], -10, 20, 3, 1e-5));
+		assertTrue("Coarse BER table of " + name + " was refined.",
+		           coarse.getResolution() < 3 && coarse.getMaxError() <= 1e-5);
+		assertTrue("Coarse BER table of " + name + " matches the closed form.",
+		           coarse.validate(-10, 20, 30001) <= 1e-5);
+	}
+}
+
 
 
 /*
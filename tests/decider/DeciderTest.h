@@ -82,6 +82,10 @@ protected:
 
 	void runDeciderTests(std::string name);
 
+	/** @brief Compares the bit error rate tables of the deciders with the
+	 * closed forms they replace.*/
+	void testBERTables();
+
 	enum TestCaseIdentifier
 	{
 		//NOTE: The form of the comments and the position of the
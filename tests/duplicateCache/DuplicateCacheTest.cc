@@ -0,0 +1,221 @@
+#include <sstream>
+#include <string>
+
+#include <DuplicateCache.h>
+#include <asserts.h>
+#include <OmnetTestBase.h>
+
+/**
+ * Gives access to the hash buckets and the insertion order of the cache.
+ */
+class InspectableCache : public DuplicateCache
+{
+public:
+	size_t numBuckets() const { return buckets.size(); }
+
+	size_t bucket(long source, unsigned long seqNum) const { return bucketOf(source, seqNum); }
+
+	/** returns the sequence numbers from the oldest to the newest entry */
+	std::string order() const {
+		std::ostringstream o;
+		for (int i = head; i != -1; i = entries[i].next) {
+			o << (i == head ? "" : " ") << entries[i].seqNum;
+		}
+		return o.str();
+	}
+};
+
+/**
+ * unit test for the hash table of class DuplicateCache
+ *
+ * - test the number of buckets
+ * - test lookup of many packets from several sources
+ * - test packets of the same bucket
+ * - test erase()
+ */
+void testHashing() {
+	InspectableCache cache;
+	cache.setMaxEntries(100);
+	assertEqual("number of buckets is a power of two above 2 * maxEntries.", (size_t)256, cache.numBuckets());
+	assertEqual("maximum number of entries.", (size_t)100, cache.getMaxEntries());
+
+	bool inserted = true;
+	for (long source = -1; source < 9; ++source) {
+		for (unsigned long seqNum = 0; seqNum < 10; ++seqNum) {
+			inserted = cache.insert(source, seqNum, 10.0, SIMTIME_ZERO) && inserted;
+		}
+	}
+	assertTrue("distinct packets are inserted.", inserted);
+	assertEqual("size after inserting distinct packets.", (size_t)100, cache.size());
+
+	bool contained = true;
+	for (long source = -1; source < 9; ++source) {
+		for (unsigned long seqNum = 0; seqNum < 10; ++seqNum) {
+			contained = contained && cache.contains(source, seqNum, 1.0);
+		}
+	}
+	assertTrue("all inserted packets are contained.", contained);
+	assertEqual("hits of the lookups.", 100L, cache.getHits());
+	assertFalse("other sequence number is not contained.", cache.contains(0, 10, 1.0));
+	assertFalse("other source is not contained.", cache.contains(9, 0, 1.0));
+
+	// find a packet in the bucket of (0, 0)
+	unsigned long other = 1;
+	while (cache.bucket(7, other) != cache.bucket(0, 0)) {
+		++other;
+	}
+	cache.clear();
+	assertEqual("size after clear().", (size_t)0, cache.size());
+	assertEqual("hits are kept by clear().", 100L, cache.getHits());
+	cache.insert(0, 0, 10.0, SIMTIME_ZERO);
+	cache.insert(7, other, 10.0, SIMTIME_ZERO);
+	cache.insert(7, 0, 10.0, SIMTIME_ZERO);
+	assertTrue("first packet of a bucket is contained.", cache.contains(0, 0, 1.0));
+	assertTrue("second packet of a bucket is contained.", cache.contains(7, other, 1.0));
+	assertTrue("erase() of the first packet of a bucket.", cache.erase(0, 0));
+	assertFalse("erased packet is not contained.", cache.contains(0, 0, 1.0));
+	assertTrue("other packet of the bucket is still contained.", cache.contains(7, other, 1.0));
+	assertFalse("erase() of a packet which is not contained.", cache.erase(0, 0));
+	assertEqual("order after erase().", toString(other) + " 0", cache.order());
+	assertEqual("size after erase().", (size_t)2, cache.size());
+
+	std::cout << "Hashing tests successful." << std::endl;
+}
+
+/**
+ * unit test for the expiry of entries
+ *
+ * - test that a packet is contained until its expiry time
+ * - test dropping expired entries from the front of the insertion order
+ * - test an expired entry behind a living one
+ * - test inserting an expired packet again
+ */
+void testExpiry() {
+	InspectableCache cache;
+	cache.setMaxEntries(8);
+
+	cache.insert(0, 1, 5.0, SIMTIME_ZERO);
+	cache.insert(0, 2, 3.0, 1.0);
+	cache.insert(0, 3, 10.0, 2.0);
+	assertTrue("packet is contained at its expiry time.", cache.contains(0, 2, 3.0));
+
+	// the expired packet 2 is behind the living packet 1
+	assertEqual("expired entry behind a living one is kept.", (size_t)3, cache.size());
+	assertFalse("expired packet is not contained.", cache.contains(0, 2, 4.0));
+	assertEqual("expired packet is dropped on lookup.", (size_t)2, cache.size());
+	assertEqual("expirations after lookup of an expired packet.", 1L, cache.getExpirations());
+	assertEqual("order after dropping an expired packet.", std::string("1 3"), cache.order());
+
+	// packet 1 expires at the front of the insertion order
+	assertTrue("living packet is contained.", cache.contains(0, 3, 6.0));
+	assertEqual("expired packets are dropped from the front.", (size_t)1, cache.size());
+	assertEqual("expirations after dropping from the front.", 2L, cache.getExpirations());
+
+	// an expired packet is inserted as new one
+	cache.insert(0, 4, 7.0, 6.0);
+	cache.insert(0, 5, 20.0, 6.0);
+	assertTrue("expired packet is inserted again.", cache.insert(0, 4, 30.0, 8.0));
+	assertEqual("expirations after inserting an expired packet.", 3L, cache.getExpirations());
+	assertEqual("order after inserting an expired packet.", std::string("3 5 4"), cache.order());
+	assertEqual("hits are not changed by expired packets.", 2L, cache.getHits());
+
+	std::cout << "Expiry tests successful." << std::endl;
+}
+
+/**
+ * unit test for the eviction of the oldest entry of a full cache
+ *
+ * - test eviction at maxEntries
+ * - test that a refreshed packet is moved behind the others (moveToTail)
+ * - test refreshing the newest packet
+ */
+void testEviction() {
+	InspectableCache cache;
+	cache.setMaxEntries(3);
+
+	cache.insert(1, 1, 100.0, SIMTIME_ZERO);
+	cache.insert(1, 2, 100.0, SIMTIME_ZERO);
+	cache.insert(1, 3, 100.0, SIMTIME_ZERO);
+	assertTrue("packet is inserted into a full cache.", cache.insert(1, 4, 100.0, 1.0));
+	assertEqual("size of a full cache.", (size_t)3, cache.size());
+	assertEqual("evictions of a full cache.", 1L, cache.getEvictions());
+	assertFalse("oldest packet is evicted.", cache.contains(1, 1, 1.0));
+	assertEqual("order after eviction.", std::string("2 3 4"), cache.order());
+
+	// refreshing packet 2 moves it behind the others, so 3 is evicted next
+	assertFalse("inserting a contained packet returns false.", cache.insert(1, 2, 200.0, 2.0));
+	assertEqual("hits after refreshing a packet.", 1L, cache.getHits());
+	assertEqual("order after refreshing the oldest packet.", std::string("3 4 2"), cache.order());
+	cache.insert(1, 5, 100.0, 3.0);
+	assertFalse("packet after the refreshed one is evicted.", cache.contains(1, 3, 3.0));
+	assertTrue("refreshed packet is not evicted.", cache.contains(1, 2, 3.0));
+	assertEqual("evictions after refreshing.", 2L, cache.getEvictions());
+
+	// refreshing a packet in the middle and the newest packet
+	assertFalse("refreshing a packet in the middle.", cache.insert(1, 5, 300.0, 4.0));
+	assertEqual("order after refreshing a packet in the middle.", std::string("4 2 5"), cache.order());
+	assertFalse("refreshing the newest packet.", cache.insert(1, 5, 150.0, 4.0));
+	assertEqual("order after refreshing the newest packet.", std::string("4 2 5"), cache.order());
+
+	// the refreshed expiry time is used
+	assertTrue("refreshed packet is contained until its new expiry time.", cache.contains(1, 5, 150.0));
+	assertFalse("refreshed packet expires after its new expiry time.", cache.contains(1, 5, 151.0));
+	assertEqual("expirations of the cache.", 2L, cache.getExpirations());
+	assertEqual("order after the expirations.", std::string("2"), cache.order());
+
+	std::cout << "Eviction tests successful." << std::endl;
+}
+
+/**
+ * unit test for grow()
+ *
+ * - test that the entries, their order and expiry times are kept
+ * - test that the statistics are kept
+ * - test the eviction order after growing
+ */
+void testGrow() {
+	InspectableCache cache;
+	cache.setMaxEntries(2);
+
+	cache.insert(2, 1, 5.0, SIMTIME_ZERO);
+	cache.insert(2, 2, 100.0, SIMTIME_ZERO);
+	cache.insert(2, 1, 50.0, 1.0);
+	assertEqual("order before grow().", std::string("2 1"), cache.order());
+
+	cache.grow(5);
+	assertEqual("maximum number of entries after grow().", (size_t)5, cache.getMaxEntries());
+	assertEqual("number of buckets after grow().", (size_t)16, cache.numBuckets());
+	assertEqual("size after grow().", (size_t)2, cache.size());
+	assertEqual("order after grow().", std::string("2 1"), cache.order());
+	assertEqual("hits after grow().", 1L, cache.getHits());
+	assertEqual("evictions after grow().", 0L, cache.getEvictions());
+	assertEqual("expirations after grow().", 0L, cache.getExpirations());
+
+	bool inserted = true;
+	for (unsigned long seqNum = 3; seqNum <= 5; ++seqNum) {
+		inserted = cache.insert(2, seqNum, 100.0, 2.0) && inserted;
+	}
+	assertTrue("packets are inserted after grow().", inserted);
+	assertEqual("no evictions until the new maximum.", 0L, cache.getEvictions());
+	cache.insert(2, 6, 100.0, 2.0);
+	assertEqual("eviction at the new maximum.", 1L, cache.getEvictions());
+	assertFalse("oldest packet before grow() is evicted first.", cache.contains(2, 2, 2.0));
+	assertTrue("refreshed expiry time is kept by grow().", cache.contains(2, 1, 50.0));
+	assertFalse("expiry time is kept by grow().", cache.contains(2, 1, 51.0));
+
+	std::cout << "Grow tests successful." << std::endl;
+}
+
+class DuplicateCacheTest:public SimpleTest {
+protected:
+	void runTests() {
+		testHashing();
+		testExpiry();
+		testEviction();
+		testGrow();
+
+		testsExecuted = true;
+	}
+};
+
+Define_Module(DuplicateCacheTest);
@@ -6,7 +6,10 @@
 #include "../testUtils/asserts.h"
 #include "../testUtils/OmnetTestBase.h"
 #include "FWMath.h"
+#include "InterferenceAccumulator.h"
+#include "Signal_.h"
 #include "Decider802154Narrow.h"
+#include "PulseTrainMapping.h"
 
 void assertEqualSilent(std::string msg, double target, simtime_t_cref actual) {
 
@@ -2631,8 +2634,480 @@ protected:
 		delete multi1;
 	}
 
+	/**
+	 * @brief Checks that the InterferenceAccumulator calculates the same sum
+	 * as the chain of MappingUtils operations BaseDecider used before.
+	 */
+	void testInterferenceAccumulator() {
+		ConstantSimpleConstMapping thermal(DimensionSet::timeDomain, 0.5);
+
+		// rectangular receiving powers like the ones created by
+		// MappingUtils::addDiscontinuity, overlapping and disjoint
+		std::vector<Mapping*> frames;
+		const double starts[] = { 1.0, 1.5, 2.0, 4.0, 1.5 };
+		const double ends[]   = { 3.0, 2.5, 5.0, 4.5, 2.5 };
+		for(int i = 0; i < 5; ++i) {
+			Mapping* f = MappingUtils::createMapping(Argument::MappedZero, DimensionSet::timeDomain);
+			MappingUtils::addDiscontinuity(f, A(starts[i]), 1.0 + i, MappingUtils::pre(starts[i]), 0.0);
+			MappingUtils::addDiscontinuity(f, A(ends[i]), 0.0, MappingUtils::pre(ends[i]), 1.0 + i);
+			frames.push_back(f);
+		}
+		// a linear slope and a step function
+		Mapping* slope = createTestMapping(0.5, 3.5, 4);
+		frames.push_back(slope);
+		Mapping* steps = new TimeMapping<NextSmaller>();
+		steps->setValue(A(2.25), 3.0);
+		steps->setValue(A(3.75), 1.0);
+		frames.push_back(steps);
+
+		InterferenceAccumulator acc;
+		for(size_t exclude = 0; exclude <= frames.size(); ++exclude) {
+			for(int withThermal = 0; withThermal < 2; ++withThermal) {
+				Mapping* expected = MappingUtils::createMapping(Argument::MappedZero, DimensionSet::timeDomain);
+				acc.reset();
+				if(withThermal) {
+					Mapping* tmp = expected;
+					expected = MappingUtils::add(*expected, thermal);
+					delete tmp;
+					acc.add(thermal);
+				}
+				for(size_t i = 0; i < frames.size(); ++i) {
+					Mapping* tmp = expected;
+					if(i == exclude) {
+						if(!withThermal)
+							continue;
+						Mapping* plus  = MappingUtils::add(*frames[i], thermal);
+						Mapping* minus = MappingUtils::subtract(*plus, *frames[i]);
+						expected = MappingUtils::add(*expected, *minus);
+						delete plus;
+						delete minus;
+						acc.addDifference(*frames[i], thermal);
+					} else {
+						expected = MappingUtils::add(*frames[i], *expected, Argument::MappedZero);
+						acc.addTo(*frames[i]);
+					}
+					delete tmp;
+				}
+
+				std::ostringstream msg;
+				msg << "Accumulated interference (excluded " << exclude << ", thermal " << withThermal << ")";
+				Mapping* actual = acc.createMapping();
+				assertMappingEqual(msg.str(), expected, actual);
+				for(simtime_t t = SIMTIME_ZERO; t <= 6.0; t += 0.125) {
+					assertEqual(msg.str() + " value", expected->getValue(A(t)), actual->getValue(A(t)));
+				}
+				delete actual;
+				delete expected;
+			}
+		}
+
+		for(size_t i = 0; i < frames.size(); ++i) {
+			delete frames[i];
+		}
+	}
+
+	/**
+	 * @brief Fills the passed mappings with the same rectangles and slopes.
+	 */
+	void fillTimeSeries(Mapping* generic, Mapping* fast, int seed) {
+		const double start = 0.5 + 0.5 * (seed % 4);
+		const double end   = start + 1.0 + 0.75 * (seed % 3);
+		Mapping* const mappings[] = { generic, fast };
+		for(int i = 0; i < 2; ++i) {
+			MappingUtils::addDiscontinuity(mappings[i], A(start), 1.0 + seed, MappingUtils::pre(start), 0.0);
+			MappingUtils::addDiscontinuity(mappings[i], A(end), 0.0, MappingUtils::pre(end), 1.0 + seed);
+			if(seed % 2) {
+				mappings[i]->setValue(A((start + end) / 2), 2.0 * seed);
+			}
+		}
+	}
+
+	void testTimeSeriesMapping() {
+		Mapping* created = MappingUtils::createMapping(DimensionSet::timeDomain);
+		assertTrue("Linear time mappings should be TimeSeriesMappings.", dynamic_cast<TimeSeriesMapping*>(created) != 0);
+		delete created;
+
+		std::vector<Mapping*> generic;
+		std::vector<Mapping*> fast;
+		for(int i = 0; i < 6; ++i) {
+			generic.push_back(new TimeMapping<Linear>(Argument::MappedZero));
+			fast.push_back(new TimeSeriesMapping(Argument::MappedZero));
+			fillTimeSeries(generic.back(), fast.back(), i);
+		}
+		generic.push_back(new TimeMapping<Linear>());
+		fast.push_back(new TimeSeriesMapping());
+
+		for(size_t i = 0; i < generic.size(); ++i) {
+			std::ostringstream msg;
+			msg << "TimeSeriesMapping " << i;
+			assertMappingEqual(msg.str(), generic[i], fast[i]);
+			assertEqual(msg.str() + " max", MappingUtils::findMax(*generic[i]), MappingUtils::findMax(*fast[i]));
+			assertEqual(msg.str() + " min", MappingUtils::findMin(*generic[i]), MappingUtils::findMin(*fast[i]));
+			for(simtime_t t = SIMTIME_ZERO; t <= 4.0; t += 0.25) {
+				assertEqual(msg.str() + " max in range", MappingUtils::findMax(*generic[i], A(t), A(t + 0.75)),
+				                                         MappingUtils::findMax(*fast[i], A(t), A(t + 0.75)));
+				assertEqual(msg.str() + " min in range", MappingUtils::findMin(*generic[i], A(t), A(t + 0.75)),
+				                                         MappingUtils::findMin(*fast[i], A(t), A(t + 0.75)));
+			}
+
+			for(size_t j = 0; j < generic.size(); ++j) {
+				std::ostringstream opMsg;
+				opMsg << msg.str() << " with " << j;
+
+				Mapping* expected = MappingUtils::add(*generic[i], *generic[j]);
+				Mapping* actual   = MappingUtils::add(*fast[i], *fast[j]);
+				assertMappingEqual(opMsg.str() + " add", expected, actual);
+				delete expected;
+				delete actual;
+
+				expected = MappingUtils::subtract(*generic[i], *generic[j], Argument::MappedZero);
+				actual   = MappingUtils::subtract(*fast[i], *fast[j], Argument::MappedZero);
+				assertMappingEqual(opMsg.str() + " subtract", expected, actual);
+				for(simtime_t t = SIMTIME_ZERO; t <= 5.0; t += 0.125) {
+					assertEqual(opMsg.str() + " subtract value", expected->getValue(A(t)), actual->getValue(A(t)));
+				}
+				delete expected;
+				delete actual;
+
+				expected = MappingUtils::multiply(*generic[i], *generic[j]);
+				actual   = MappingUtils::multiply(*fast[i], *fast[j]);
+				assertMappingEqual(opMsg.str() + " multiply", expected, actual);
+				delete expected;
+				delete actual;
+			}
+		}
+
+		for(size_t i = 0; i < generic.size(); ++i) {
+			delete generic[i];
+			delete fast[i];
+		}
+	}
+
+	void testMappingKernels() {
+		const size_t n = 37;
+		double a[n];
+		for(size_t i = 0; i < n; ++i) {
+			a[i] = std::sin(0.3 * i) * 10.0;
+		}
+		for(size_t count = 0; count <= n; count += 3) {
+			double max = -1.0;
+			double min = 1.0;
+			for(size_t i = 0; i < count; ++i) {
+				max = std::max(max, a[i]);
+				min = std::min(min, a[i]);
+			}
+			assertEqual("Vectorised max.", max, MappingKernels::max(a, count, 1, -1.0));
+			assertEqual("Vectorised min.", min, MappingKernels::min(a, count, 1, 1.0));
+		}
+
+		// the values of a TimeSeriesMapping are searched with a stride
+		TimeMapping<Linear> generic;
+		TimeSeriesMapping   fast;
+		for(size_t i = 0; i < n; ++i) {
+			generic.setValue(A(0.25 * i), a[i]);
+			fast.setValue(A(0.25 * i), a[i]);
+		}
+		assertEqual("Vectorised max.", MappingUtils::findMax(generic), MappingUtils::findMax(fast));
+		assertEqual("Vectorised min.", MappingUtils::findMin(generic), MappingUtils::findMin(fast));
+		for(simtime_t t = SIMTIME_ZERO; t <= 9.0; t += 0.375) {
+			assertEqual("Vectorised max in range.", MappingUtils::findMax(generic, A(t), A(t + 3.0)), MappingUtils::findMax(fast, A(t), A(t + 3.0)));
+			assertEqual("Vectorised min in range.", MappingUtils::findMin(generic, A(t), A(t + 3.0)), MappingUtils::findMin(fast, A(t), A(t + 3.0)));
+		}
+
+		// NaN values are skipped unless they are the first value
+		const double nan = std::numeric_limits<double>::quiet_NaN();
+		generic.setValue(A(2.0), nan);
+		fast.setValue(A(2.0), nan);
+		assertEqual("Max should skip NaN.", MappingUtils::findMax(generic), MappingUtils::findMax(fast));
+		assertEqual("Min should skip NaN.", MappingUtils::findMin(generic), MappingUtils::findMin(fast));
+		generic.setValue(A(0.0), nan);
+		fast.setValue(A(0.0), nan);
+		assertTrue("Max should be NaN for a leading NaN.", MappingUtils::findMax(fast) != MappingUtils::findMax(fast));
+		assertTrue("Min should be NaN for a leading NaN.", MappingUtils::findMin(fast) != MappingUtils::findMin(fast));
+	}
+
+	void testSharedSignal() {
+		Signal* sender = new Signal(1.0, 2.0);
+		Mapping* power = new TimeSeriesMapping(Argument::MappedZero);
+		MappingUtils::addDiscontinuity(power, A(1.0), 0.0, MappingUtils::post(1.0), 2.0);
+		MappingUtils::addDiscontinuity(power, A(3.0), 0.0, MappingUtils::pre(3.0), 2.0);
+		sender->setTransmissionPower(power);
+		Mapping* bitrate = new TimeSeriesMapping();
+		bitrate->setValue(A(1.0), 54e6);
+		sender->setBitrate(bitrate);
+
+		// the copies share the transmission power and bitrate of the sender
+		Signal* first  = new Signal(*sender);
+		Signal* second = new Signal(*sender);
+		assertTrue("Copies should share the transmission power.", first->getTransmissionPower() == power);
+		assertTrue("Copies should share the bitrate.", second->getBitrate() == bitrate);
+		delete sender;
+
+		// the propagation delay and the attenuations belong to every copy
+		first->setPropagationDelay(0.5);
+		ConstMapping* attenuation = new ConstantSimpleConstMapping(DimensionSet::timeDomain, 0.5);
+		first->addAttenuation(attenuation);
+		assertEqual("Delayed bitrate.", 54e6, first->getBitrate()->getValue(A(1.5)));
+		assertEqual("Undelayed bitrate.", 54e6, second->getBitrate()->getValue(A(1.0)));
+		assertEqual("Delayed receiving power.", 1.0, first->getReceivingPower()->getValue(A(2.0)));
+		assertEqual("Delayed receiving power before reception.", 0.0, first->getReceivingPower()->getValue(A(1.25)));
+		assertEqual("Undelayed receiving power.", 2.0, second->getReceivingPower()->getValue(A(1.25)));
+		assertTrue("Copy should not share the attenuations.", second->getAttenuation().empty());
+
+		// copying a received signal keeps its delay and clones its attenuations
+		Signal third(*first);
+		assertTrue("Copy should share the transmission power.", third.getTransmissionPower() == power);
+		assertTrue("Copy should clone the attenuations.", third.getAttenuation().front() != attenuation);
+		assertEqual("Copied delayed bitrate.", 54e6, third.getBitrate()->getValue(A(1.5)));
+		assertEqual("Copied receiving power.", 1.0, third.getReceivingPower()->getValue(A(2.0)));
+		delete first;
+		assertEqual("Receiving power after deleting the original.", 1.0, third.getReceivingPower()->getValue(A(2.0)));
+
+		// setting a new transmission power only changes one copy
+		second->setTransmissionPower(new ConstantSimpleConstMapping(DimensionSet::timeDomain, 4.0));
+		assertEqual("Changed transmission power.", 4.0, second->getReceivingPower()->getValue(A(1.25)));
+		assertEqual("Unchanged transmission power.", 1.0, third.getReceivingPower()->getValue(A(2.0)));
+
+		third = *second;
+		assertTrue("Assignment should share the transmission power.", third.getTransmissionPower() == second->getTransmissionPower());
+		assertEqual("Assigned receiving power.", 4.0, third.getReceivingPower()->getValue(A(1.25)));
+		delete second;
+		assertEqual("Assigned receiving power after deleting the original.", 4.0, third.getReceivingPower()->getValue(A(1.25)));
+	}
+
+	void testReceivingPower() {
+		Signal s(1.0, 2.0);
+		Mapping* power = new TimeSeriesMapping(Argument::MappedZero);
+		MappingUtils::addDiscontinuity(power, A(1.0), 0.0, MappingUtils::post(1.0), 2.0);
+		MappingUtils::addDiscontinuity(power, A(3.0), 0.0, MappingUtils::pre(3.0), 2.0);
+		s.setTransmissionPower(power);
+		s.setPropagationDelay(0.25);
+
+		const Signal::ReceivingPowerMapping* rcvPower = s.getReceivingPower();
+		assertTrue("Without attenuations the delayed power is the product.", dynamic_cast<const ConstDelayedMapping*>(rcvPower->getProduct()) != NULL);
+
+		TimeMapping<Linear>* fading = new TimeMapping<Linear>();
+		for(int i = 0; i <= 8; ++i) {
+			fading->setValue(A(1.25 + 0.25 * i), 0.5 + 0.125 * (i % 3));
+		}
+		s.addAttenuation(new ConstantSimpleConstMapping(DimensionSet::timeDomain, 0.25));
+		s.addAttenuation(fading);
+
+		// the product is calculated once and equals the concatenated mapping
+		ConstMapping* product = const_cast<ConstMapping*>(rcvPower->getProduct());
+		assertTrue("Product should be reused.", product == rcvPower->getProduct());
+		assertTrue("Time-only product should be a time series.", dynamic_cast<const TimeSeriesMapping*>(product) != NULL);
+		Mapping* expected = rcvPower->createConcatenatedMapping();
+		assertMappingEqual("Receiving power product.", expected, product);
+		assertEqual("Maximum of the receiving power.", MappingUtils::findMax(*expected), MappingUtils::findMax(*rcvPower));
+		assertEqual("Minimum of the receiving power.", MappingUtils::findMin(*expected, A(1.5), A(3.0)), MappingUtils::findMin(*rcvPower, A(1.5), A(3.0)));
+		delete expected;
+
+		// adding an attenuation discards the product
+		s.addAttenuation(new ConstantSimpleConstMapping(DimensionSet::timeDomain, 2.0));
+		expected = rcvPower->createConcatenatedMapping();
+		assertMappingEqual("Receiving power product after adding an attenuation.", expected, const_cast<ConstMapping*>(rcvPower->getProduct()));
+		delete expected;
+
+		// a changed attenuation discards the whole receiving power
+		fading->setValue(A(2.25), 4.0);
+		s.attenuationChanged();
+		rcvPower = s.getReceivingPower();
+		expected = rcvPower->createConcatenatedMapping();
+		assertMappingEqual("Receiving power product after changing an attenuation.", expected, const_cast<ConstMapping*>(rcvPower->getProduct()));
+		assertEqual("Changed receiving power.", 4.0, rcvPower->getProduct()->getValue(A(2.25)));
+		delete expected;
+	}
+
+	/**
+	 * @brief Returns the value of "m" at time t as sum of the pulses of its
+	 * bursts, calculated independently of PulseTrainMapping.
+	 */
+	double pulseTrainValue(const PulseTrainMapping& m, simtime_t_cref t) {
+		const double width = SIMTIME_DBL(m.getPulseDuration());
+		double value = 0;
+		const PulseTrainMapping::TapList& taps = m.getTaps();
+		for(size_t tap = 0; tap < taps.size(); ++tap) {
+			const PulseTrainMapping::BurstList& bursts = m.getBursts();
+			for(size_t b = 0; b < bursts.size(); ++b) {
+				for(int p = 0; p < bursts[b].pulses; ++p) {
+					const double x = SIMTIME_DBL(t - taps[tap].delay - bursts[b].start - p * m.getPulseSpacing());
+					if(x >= 0 && x < width)
+						value += taps[tap].gain * (1 - fabs(2 * x / width - 1));
+				}
+			}
+		}
+		return value * m.getPeak();
+	}
+
+	void assertPulseTrainValues(std::string msg, const PulseTrainMapping& m, simtime_t_cref from, simtime_t_cref to) {
+		for(simtime_t t = from; t <= to; t += 0.125) {
+			assertClose(msg + " at " + toString(t), pulseTrainValue(m, t), m.getValue(t));
+			assertClose(msg + " at " + toString(t), m.getValue(t), m.getValue(A(t)));
+		}
+	}
+
+	void testPulseTrainMapping() {
+		// a single pulse
+		PulseTrainMapping single(1.0, 2.0, 2.0);
+		single.addBurst(10.0, 1);
+		assertEqual("Value before the pulse.", 0.0, single.getValue(simtime_t(9.5)));
+		assertEqual("Value at the start of the pulse.", 0.0, single.getValue(simtime_t(10.0)));
+		assertClose("Value on the rising edge.", 1.0, single.getValue(simtime_t(10.25)));
+		assertClose("Value at the peak.", 2.0, single.getValue(simtime_t(10.5)));
+		assertClose("Value on the falling edge.", 1.0, single.getValue(simtime_t(10.75)));
+		assertEqual("Value at the end of the pulse.", 0.0, single.getValue(simtime_t(11.0)));
+
+		// a burst of three pulses starting every 2s
+		single.addBurst(20.0, 3);
+		assertClose("Peak of the second pulse of a burst.", 2.0, single.getValue(simtime_t(22.5)));
+		assertEqual("Value between two pulses of a burst.", 0.0, single.getValue(simtime_t(23.5)));
+		assertClose("Rising edge of the last pulse of a burst.", 1.0, single.getValue(simtime_t(24.25)));
+		assertEqual("Value after the last pulse of a burst.", 0.0, single.getValue(simtime_t(26.5)));
+		assertPulseTrainValues("Single pulse and burst", single, 9.0, 27.0);
+
+		// pulses which are longer than their spacing overlap
+		PulseTrainMapping overlapping(3.0, 2.0, 1.0);
+		overlapping.addBurst(0.0, 3);
+		assertClose("Overlapping pulses of a burst.", 2.0 / 3.0, overlapping.getValue(simtime_t(2.5)));
+		assertPulseTrainValues("Overlapping pulses of a burst", overlapping, 0.0, 8.0);
+
+		// overlapping bursts and bursts of different lengths
+		PulseTrainMapping bursts(1.0, 1.5, 1.0);
+		bursts.addBurst(0.0, 1);
+		bursts.addBurst(0.5, 4);
+		bursts.addBurst(1.0, 2);
+		bursts.addBurst(6.0, 1);
+		assertClose("Overlapping bursts.", 1.0, bursts.getValue(simtime_t(0.75)));
+		assertPulseTrainValues("Overlapping bursts", bursts, 0.0, 8.0);
+
+		// bursts added out of order are inserted at their start
+		PulseTrainMapping unordered(1.0, 1.5, 1.0);
+		unordered.addBurst(6.0, 1);
+		unordered.addBurst(0.5, 4);
+		unordered.addBurst(1.0, 2);
+		unordered.addBurst(0.0, 1);
+		assertEqual("Number of bursts added out of order.", bursts.getBursts().size(), unordered.getBursts().size());
+		for(size_t i = 0; i < unordered.getBursts().size(); ++i) {
+			assertEqual("Start of burst added out of order.", bursts.getBursts()[i].start, unordered.getBursts()[i].start);
+			assertEqual("Pulses of burst added out of order.", bursts.getBursts()[i].pulses, unordered.getBursts()[i].pulses);
+		}
+		for(simtime_t t = SIMTIME_ZERO; t <= 8.0; t += 0.125) {
+			assertEqual("Value of bursts added out of order at " + toString(t), bursts.getValue(t), unordered.getValue(t));
+		}
+
+		// every tap of the pulse train is echoed by every tap of the channel
+		PulseTrainMapping::TapList channel;
+		PulseTrainMapping::Tap direct = { SIMTIME_ZERO, 1.0 };
+		PulseTrainMapping::Tap echo   = { 0.25, -0.5 };
+		channel.push_back(direct);
+		channel.push_back(echo);
+		PulseTrainMapping received(bursts, channel);
+		assertEqual("Taps of the received pulse train.", (size_t)2, received.getTaps().size());
+		PulseTrainMapping::TapList second;
+		PulseTrainMapping::Tap delayed = { 2.0, 0.5 };
+		second.push_back(direct);
+		second.push_back(delayed);
+		PulseTrainMapping twice(received, second);
+		const PulseTrainMapping::TapList& taps = twice.getTaps();
+		assertEqual("Taps of the twice received pulse train.", (size_t)4, taps.size());
+		const double delays[] = { 0.0, 2.0, 0.25, 2.25 };
+		const double gains[]  = { 1.0, 0.5, -0.5, -0.25 };
+		for(size_t i = 0; i < taps.size(); ++i) {
+			assertEqual("Delay of echoed tap.", delays[i], SIMTIME_DBL(taps[i].delay));
+			assertEqual("Gain of echoed tap.", gains[i], taps[i].gain);
+		}
+		for(simtime_t t = SIMTIME_ZERO; t <= 10.0; t += 0.125) {
+			const double expected = bursts.getValue(t) - 0.5 * bursts.getValue(t - 0.25)
+			                      + 0.5 * bursts.getValue(t - 2.0) - 0.25 * bursts.getValue(t - 2.25);
+			assertClose("Value of the twice received pulse train at " + toString(t), expected, twice.getValue(t));
+		}
+		assertPulseTrainValues("Twice received pulse train", twice, 0.0, 10.0);
+
+		// getValues() equals getValue() at the times minus the offset
+		const size_t count = 97;
+		simtime_t times[count];
+		double    values[count];
+		for(size_t i = 0; i < count; ++i) {
+			times[i] = 100.0 + 0.125 * (i / 2);
+		}
+		const simtime_t offset = 100.0 - 0.0625;
+		twice.getValues(times, count, offset, values);
+		for(size_t i = 0; i < count; ++i) {
+			assertClose("getValues() at " + toString(times[i]), twice.getValue(times[i] - offset), values[i]);
+		}
+		twice.getValues(times, 0, offset, values);
+
+		// the key entries are the start, the peak and the end of every
+		// delayed pulse
+		PulseTrainMapping keyed(1.0, 2.0, 1.0);
+		ConstMappingIterator* it = keyed.createConstIterator();
+		assertFalse("Empty pulse train has no next key entry.", it->hasNext());
+		assertFalse("Empty pulse train is not in range.", it->inRange());
+		delete it;
+
+		keyed.addBurst(0.0, 2);
+		PulseTrainMapping keyedEcho(keyed, channel);
+		const double keys[] = { 0.0, 0.25, 0.5, 0.75, 1.0, 1.25, 2.0, 2.25, 2.5, 2.75, 3.0, 3.25 };
+		const size_t numKeys = sizeof(keys) / sizeof(keys[0]);
+		it = keyedEcho.createConstIterator();
+		for(size_t i = 0; i < numKeys; ++i) {
+			assertEqual("Key entry of the iterator.", keys[i], SIMTIME_DBL(it->getPosition().getTime()));
+			assertTrue("Key entry of the iterator should be in range.", it->inRange());
+			assertEqual("Value of the iterator.", keyedEcho.getValue(it->getPosition().getTime()), it->getValue());
+			assertEqual("Next key entry of the iterator.", i + 1 < numKeys, it->hasNext());
+			if(i + 1 < numKeys) {
+				assertEqual("Next position of the iterator.", keys[i + 1], SIMTIME_DBL(it->getNextPosition().getTime()));
+				it->next();
+			}
+		}
+		bool thrown = false;
+		try {
+			it->next();
+		} catch(NoNextIteratorException&) {
+			thrown = true;
+		}
+		assertTrue("next() after the last key entry should throw.", thrown);
+
+		it->jumpTo(A(1.5));
+		assertEqual("Position after jumpTo().", 1.5, SIMTIME_DBL(it->getPosition().getTime()));
+		assertEqual("Next position after jumpTo().", 2.0, SIMTIME_DBL(it->getNextPosition().getTime()));
+		assertTrue("Position between the key entries should be in range.", it->inRange());
+		it->jumpTo(A(2.25));
+		assertEqual("Next position after jumpTo() a key entry.", 2.5, SIMTIME_DBL(it->getNextPosition().getTime()));
+		it->iterateTo(A(2.75));
+		assertEqual("Position after iterateTo().", 2.75, SIMTIME_DBL(it->getPosition().getTime()));
+		assertEqual("Next position after iterateTo().", 3.0, SIMTIME_DBL(it->getNextPosition().getTime()));
+		it->iterateTo(A(3.5));
+		assertFalse("No next key entry after iterateTo() behind the last.", it->hasNext());
+		assertFalse("Position behind the last key entry should not be in range.", it->inRange());
+		it->jumpToBegin();
+		assertEqual("Position after jumpToBegin().", 0.0, SIMTIME_DBL(it->getPosition().getTime()));
+		delete it;
+
+		it = keyedEcho.createConstIterator(A(1.125));
+		assertEqual("Position of an iterator created at a position.", 1.125, SIMTIME_DBL(it->getPosition().getTime()));
+		assertEqual("Next position of an iterator created at a position.", 1.25, SIMTIME_DBL(it->getNextPosition().getTime()));
+		delete it;
+
+		// adding a burst recreates the key entries
+		keyedEcho.addBurst(10.0, 1);
+		it = keyedEcho.createConstIterator(A(3.25));
+		assertEqual("Key entry of an added burst.", 10.0, SIMTIME_DBL(it->getNextPosition().getTime()));
+		it->next();
+		it->next();
+		assertEqual("Key entry of the echo of an added burst.", 10.25, SIMTIME_DBL(it->getPosition().getTime()));
+		delete it;
+	}
+
 	void testMappingUtils() {
 		testFindMinMax();
+		testInterferenceAccumulator();
+		testTimeSeriesMapping();
+		testMappingKernels();
+		testSharedSignal();
+		testReceivingPower();
+		testPulseTrainMapping();
 	}
 
 	void runTests() {
@@ -2642,6 +3117,7 @@ protected:
 		//testDoubleCompareLess();
 
 	    testSimpleFunction<TimeMapping<Linear> >();
+	    testSimpleFunction<TimeSeriesMapping>();
 	    const char cSaveFill = std::cout.fill();
 
 	    std::cout << std::setw(80) << std::setfill('-') << std::internal << " TimeMapping tests done. " << std::setw(48) << "" << std::setfill(cSaveFill) << std::endl; std::cout.flush();
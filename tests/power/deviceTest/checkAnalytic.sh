@@ -0,0 +1,88 @@
+#!/bin/bash
+#
+# Compares the results of the analytic runs with the ones of the periodic
+# runs they extend.  The periodic results are checked against valid/ by
+# checkResults.sh, so this script has to run before it.
+#
+# For every analytic run:
+#  - the lifetime is at most one resolution earlier than the periodic one
+#    (both are -1 if the battery does not fail)
+#  - the capacity drops to 0 in the time series at the lifetime
+#  - if publishTime > 0, every publish of the periodic run is preceded by
+#    a publish of the analytic run at most one resolution before it
+#
+# The results of the analytic runs are removed afterwards, they have no
+# reference in valid/.
+
+iFailed=0
+
+# prints the lifetime recorded in the scalar file $1
+lifetime() {
+ awk '$1 == "scalar" && $3 == "lifetime" { print $4 }' "$1"
+}
+
+# prints "time value" of every publish of the capacity vector in file $1
+capacity() {
+ awk '$1 == "vector" && $4 == "capacity" { id = $2 }
+      id != "" && $1 == id && NF == 4 { print $3, $4 }' "$1"
+}
+
+while read lAnalytic lPeriodic lVecA lVecP dRes iPublishTime
+do
+ lSca="results/${lAnalytic}-0.sca"
+ lPSca="results/${lPeriodic}-0.sca"
+ lVec="omnetpp_${lVecA}.vec"
+ lPVec="omnetpp_${lVecP}.vec"
+ lres="diff-${lAnalytic}.log"
+ rm -f "$lres"
+ if [ ! -f "$lSca" -o ! -f "$lPSca" -o ! -f "$lVec" -o ! -f "$lPVec" ]; then
+  echo "  FAILED $lAnalytic: results of $lAnalytic or $lPeriodic are missing"
+  iFailed=$(( $iFailed + 1 ))
+  continue
+ fi
+
+ dLife="$(lifetime "$lSca")"
+ dPLife="$(lifetime "$lPSca")"
+ awk -v a="$dLife" -v p="$dPLife" -v res="$dRes" 'BEGIN {
+  if (!(a == p || (a >= 0 && p >= 0 && a <= p + 1e-9 && p - a < res - 1e-9)))
+   printf("lifetime %s is not within one resolution (%s) before %s\n", a, res, p)
+ }' >>"$lres"
+
+ capacity "$lVec" | awk -v life="$dLife" '
+  $2 == 0 && zero == "" { zero = $1 }
+  END {
+   if (life >= 0 && (zero == "" || zero - life > 1e-9 || life - zero > 1e-9))
+    printf("capacity drops to 0 at %s instead of the lifetime %s\n", zero, life)
+  }' >>"$lres"
+
+ if [ x$iPublishTime = x1 ]; then
+  capacity "$lVec" >out.tmp
+  capacity "$lPVec" | awk -v res="$dRes" '
+   NR == FNR { t[NR] = $1; n = NR; next }
+   {
+    for (i = 1; i <= n; ++i)
+     if (t[i] <= $1 + 1e-9 && $1 - t[i] < res - 1e-9)
+      next
+    printf("no publish within one resolution (%s) before %s\n", res, $1)
+   }' out.tmp - >>"$lres"
+  rm -f out.tmp
+ fi
+
+ if [ -s "$lres" ]; then
+  echo "  FAILED $lAnalytic counted $(grep -c . "$lres") differences to $lPeriodic; see $(basename $(pwd) )/$lres"
+  iFailed=$(( $iFailed + 1 ))
+ else
+  echo "  PASSED $lAnalytic against $lPeriodic"
+  rm -f "$lres"
+ fi
+ rm -f "$lSca" "$lVec" "omnetpp_${lVecA}.vci"
+done <<EOF
+OneAnalytic    One    1a  1  0.1 1
+FourAnalytic   Four   4a  4  0.1 1
+FiveAnalytic   Five   5a  5  0.1 1
+SevenAnalytic  Seven  7a  7  0.1 1
+NineAnalytic   Nine   9a  9  0.1 0
+TwelveAnalytic Twelve 12a 12 0.1 1
+EOF
+
+exit $iFailed
@@ -45,7 +45,8 @@ if [ ! -e "${lSingle}" -a ! -e "${lSingle}.exe" ]; then
 fi
           
 rm *.vec *.sca 2>/dev/null
-for i in One Two Three Four Five Six Seven Eight Nine Ten Eleven Twelve Thirteen Fourteen
+for i in One Two Three Four Five Six Seven Eight Nine Ten Eleven Twelve Thirteen Fourteen \
+         OneAnalytic FourAnalytic FiveAnalytic SevenAnalytic NineAnalytic TwelveAnalytic
 do
  ./${lSingle} -c $i "${LIBSREF[@]}"
 done
@@ -19,6 +19,14 @@ for f in deviceTest deviceTestMulti deviceTestAccts deviceTestAll #Nic80211Test
 do
  if [ -d "${BasePath}/$f" -a -f "${BasePath}/checkResults.sh" ]; then
   echo " -------------$f${e:${#f}}"
+  # compares the analytic runs with the periodic ones before checkResults.sh
+  # removes the results of the latter
+  if [ -f "${BasePath}/$f/checkAnalytic.sh" ]; then
+   ( cd "${BasePath}/$f" && \
+     ./checkAnalytic.sh )
+   st=$?
+   [ x$st = x0 ] || iErrs=$(( $iErrs + 1 ))
+  fi
   ( cd "${BasePath}/$f" && \
     ../checkResults.sh )
   st=$?
@@ -50,6 +50,14 @@ if [ -d coord ]; then
     st=$?
     [ x$st = x0 ] || ilErrs=$(( $ilErrs + 1 ))
 fi
+if [ -d duplicateCache ]; then
+    ilCout=$(( $ilCout + 1 ))
+    echo '----------------DuplicateCache----------------'
+    ( ( cd duplicateCache >/dev/null 2>&1 && \
+    ./runTest.sh $1 ) && echo "PASSED" ) || ( echo "FAILED" && false )
+    st=$?
+    [ x$st = x0 ] || ilErrs=$(( $ilErrs + 1 ))
+fi
 if [ -d channelInfo ]; then
     ilCout=$(( $ilCout + 1 ))
     echo '----------------ChannelInfo-------------------'
@@ -58,6 +66,14 @@ if [ -d channelInfo ]; then
     st=$?
     [ x$st = x0 ] || ilErrs=$(( $ilErrs + 1 ))
 fi
+if [ -d analogueModel ]; then
+    ilCout=$(( $ilCout + 1 ))
+    echo '---------------AnalogueModel------------------'
+    ( ( cd analogueModel >/dev/null 2>&1 && \
+    ./runTest.sh $1 ) && echo "PASSED" ) || ( echo "FAILED" && false )
+    st=$?
+    [ x$st = x0 ] || ilErrs=$(( $ilErrs + 1 ))
+fi
 if [ -d radioState ]; then
     ilCout=$(( $ilCout + 1 ))
     echo '-----------------RadioState-------------------'
@@ -82,6 +98,14 @@ if [ -d mapping ]; then
     st=$?
     [ x$st = x0 ] || ilErrs=$(( $ilErrs + 1 ))
 fi
+if [ -d traceMobility ]; then
+    ilCout=$(( $ilCout + 1 ))
+    echo '-------------TraceMobility--------------------'
+    ( ( cd traceMobility >/dev/null 2>&1 && \
+    ./runTest.sh $1 ) && echo "PASSED" ) || ( echo "FAILED" && false )
+    st=$?
+    [ x$st = x0 ] || ilErrs=$(( $ilErrs + 1 ))
+fi
 if [ -d power ]; then
     ilCout=$(( $ilCout + 1 ))
     echo '-----------------Power------------------------'
@@ -0,0 +1,125 @@
+#include <cassert>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <asserts.h>
+#include <OmnetTestBase.h>
+#include <IMobility.h>
+
+/**
+ * @brief Compares the text mobility models with BinaryTraceMobility playing
+ * back the same trace after its conversion by BinaryTraceConverter.
+ *
+ * For every trace "t" in the parameter "traces" the hosts "tText[i]" play
+ * the text trace back and the hosts "tBinary[i]" the converted one. Their
+ * positions are sampled at the times of the parameter "checkTimes" and
+ * compared in finish(), so that the output does not depend on the order of
+ * the events at the same time.
+ */
+class TraceMobilityTest : public SimpleTest
+{
+protected:
+	/** @brief Maximum distance between the text and the binary position.*/
+	static const double TOLERANCE;
+
+	std::vector<std::string> traces;
+	int numNodes;
+	std::vector<double> checkTimes;
+	size_t nextCheck;
+	cMessage* checkTimer;
+
+	/** @brief Mobility modules indexed by trace and node.*/
+	std::vector<std::vector<IMobility*> > textMobilities;
+	std::vector<std::vector<IMobility*> > binaryMobilities;
+
+	/** @brief Sampled positions indexed by trace, node and check.*/
+	std::vector<std::vector<std::vector<Coord> > > textPositions;
+	std::vector<std::vector<std::vector<Coord> > > binaryPositions;
+
+protected:
+	IMobility* getMobility(const std::string& hostName, int index) {
+		cModule* host = getParentModule()->getSubmodule(hostName.c_str(), index);
+		if(!host)
+			error("Host %s[%d] not found.", hostName.c_str(), index);
+		return check_and_cast<IMobility*>(host->getSubmodule("mobility"));
+	}
+
+	virtual void runTests() {
+		traces = cStringTokenizer(par("traces").stringValue()).asVector();
+		numNodes = par("numNodes");
+		checkTimes = cStringTokenizer(par("checkTimes").stringValue()).asDoubleVector();
+
+		textMobilities.resize(traces.size());
+		binaryMobilities.resize(traces.size());
+		textPositions.resize(traces.size());
+		binaryPositions.resize(traces.size());
+		for(size_t t = 0; t < traces.size(); t++) {
+			for(int i = 0; i < numNodes; i++) {
+				textMobilities[t].push_back(getMobility(traces[t] + "Text", i));
+				binaryMobilities[t].push_back(getMobility(traces[t] + "Binary", i));
+			}
+			textPositions[t].resize(numNodes);
+			binaryPositions[t].resize(numNodes);
+		}
+
+		nextCheck = 0;
+		if(!checkTimes.empty())
+			scheduleAt(checkTimes[0], checkTimer);
+	}
+
+	virtual void handleMessage(cMessage* msg) {
+		assert(msg == checkTimer);
+
+		for(size_t t = 0; t < traces.size(); t++) {
+			for(int i = 0; i < numNodes; i++) {
+				textPositions[t][i].push_back(textMobilities[t][i]->getCurrentPosition());
+				binaryPositions[t][i].push_back(binaryMobilities[t][i]->getCurrentPosition());
+			}
+		}
+
+		nextCheck++;
+		if(nextCheck < checkTimes.size())
+			scheduleAt(checkTimes[nextCheck], checkTimer);
+	}
+
+public:
+	TraceMobilityTest()
+		: SimpleTest()
+		, numNodes(0)
+		, nextCheck(0)
+		, checkTimer(new cMessage("check"))
+	{}
+
+	virtual ~TraceMobilityTest() {
+		cancelAndDelete(checkTimer);
+	}
+
+	virtual void finish() {
+		assertEqual("All positions have been checked.", checkTimes.size(), nextCheck);
+
+		for(size_t t = 0; t < traces.size(); t++) {
+			for(int i = 0; i < numNodes; i++) {
+				std::string node = traces[t] + " node " + toString(i);
+				bool passed = true;
+				for(size_t k = 0; k < textPositions[t][i].size(); k++) {
+					const Coord& text = textPositions[t][i][k];
+					const Coord& binary = binaryPositions[t][i][k];
+					if(text.distance(binary) > TOLERANCE) {
+						fail(node + " at t=" + toString(checkTimes[k])
+							 + ": binary trace position", text.info(), binary.info());
+						passed = false;
+					}
+				}
+				if(passed)
+					pass(node + ": text and binary trace positions match.");
+			}
+		}
+
+		testsExecuted = true;
+	}
+};
+
+const double TraceMobilityTest::TOLERANCE = 0.001;
+
+Define_Module(TraceMobilityTest);